@@ -15,6 +15,13 @@ return {
 
 	apply: (e) => {
 		e.game.advance_turn(e.data.turn_id);
+		if (e.game.is_slave() && e.data.turn_id != 1) {
+			// let host verify that game state is same as on its side
+			e.game.event('turn_checksum', {
+				turn_id: e.data.turn_id,
+				checksum: e.game.get_turn_checksum(),
+			});
+		}
 	},
 
 	rollback: (e) => {
@@ -0,0 +1,23 @@
+return {
+
+	validate: (e) => {
+		if (e.caller == 0) {
+			return 'Host doesn\'t send turn checksums';
+		}
+		if (e.data.turn_id != e.game.get_turn_id()) {
+			return 'Turn checksum is for turn ' + #to_string(e.data.turn_id) + ', but current turn is ' + #to_string(e.game.get_turn_id());
+		}
+	},
+
+	apply: (e) => {
+		if (e.game.is_master()) {
+			if (!e.game.verify_turn_checksum(e.caller, e.data.checksum)) {
+				e.game.message('Game state of player ' + #to_string(e.caller) + ' is out of sync');
+			}
+		}
+	},
+
+	rollback: (e) => {
+	},
+
+};
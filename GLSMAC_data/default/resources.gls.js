@@ -22,57 +22,71 @@ const define = (game, id, levels_y, minusplus_y) => {
 
 };
 
-const result = {
-
-	configure: (game) => {
-
-		game.rm.on('get_yield', (e) => {
+const get_yield = (tile, resource) => {
 
-			if (e.resource == 'Nutrients') {
-				if (!e.tile.has_fungus) {
-					if (e.tile.is_land) {
-						return e.tile.moisture - 1;
-					} else {
-						return 1;
-					}
-				} else {
-					// TODO: fungus tiles
-				}
+	if (resource == 'Nutrients') {
+		if (!tile.has_fungus) {
+			if (tile.is_land) {
+				return tile.moisture - 1;
+			} else {
+				return 1;
 			}
-			if (e.resource == 'Minerals') {
-				if (!e.tile.has_fungus) {
-					if (e.tile.is_land) {
-						let result = 0;
-						if (e.tile.rockiness > 1) {
-							result = result + 1;
-						}
-						return result;
-					} else {
-						return 0;
-					}
-				} else {
-					// TODO: fungus tiles
+		} else {
+			// TODO: fungus tiles
+		}
+	}
+	if (resource == 'Minerals') {
+		if (!tile.has_fungus) {
+			if (tile.is_land) {
+				let result = 0;
+				if (tile.rockiness > 1) {
+					result = result + 1;
 				}
+				return result;
+			} else {
+				return 0;
 			}
-			if (e.resource == 'Energy') {
-				if (!e.tile.has_fungus) {
-					if (e.tile.is_land) {
-						let result = e.tile.elevation / 1000;
-						if (e.tile.has_river) {
-							result = result + 1;
-						}
-						return result;
-					} else {
-						return 1;
-					}
-				} else {
-					// TODO: fungus tiles
+		} else {
+			// TODO: fungus tiles
+		}
+	}
+	if (resource == 'Energy') {
+		if (!tile.has_fungus) {
+			if (tile.is_land) {
+				let result = tile.elevation / 1000;
+				if (tile.has_river) {
+					result = result + 1;
 				}
+				return result;
+			} else {
+				return 1;
 			}
+		} else {
+			// TODO: fungus tiles
+		}
+	}
 
-			// unknown resource
-			return 0;
+	// unknown resource
+	return 0;
 
+};
+
+const result = {
+
+	configure: (game) => {
+
+		// called once for many tiles, returns array of yields ( one per tile ) for each resource
+		// results are cached by terrain of tile and player, call game.rm.set_yields_cached(false) if they depend on anything else
+		game.rm.on('get_yields', (e) => {
+			let yields = {};
+			for (resource of e.resources) {
+				let values = [];
+				for (tile of e.tiles) {
+					values :+ get_yield(tile, resource);
+				}
+				yields[resource] = values;
+			}
+			return yields;
 		});
 	},
 
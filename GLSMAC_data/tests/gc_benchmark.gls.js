@@ -0,0 +1,69 @@
+// builds deep and wide object graphs and reports how long gc takes to mark and sweep them
+
+// values are copied on assignment, so building deep chain takes quadratic time, keep it short enough for test runs
+const DEEP_DEPTH = 1000;
+const WIDE_WIDTH = 200;
+const WIDE_CHILDREN = 50;
+
+const build_deep = () => {
+	let node = null;
+	let i = 0;
+	while (i < DEEP_DEPTH) {
+		node = {
+			value: i++,
+			next: node,
+		};
+	}
+	return node;
+};
+
+const build_wide = () => {
+	let root = [];
+	let i = 0;
+	while (i++ < WIDE_WIDTH) {
+		let children = [];
+		let j = 0;
+		while (j < WIDE_CHILDREN) {
+			children :+ {
+				value: j++,
+			};
+		}
+		root :+ {
+			children: children,
+		};
+	}
+	return root;
+};
+
+const report = (label, stats) => {
+	#print(label + ': marked ' + #to_string(stats.objects_marked) + ' of ' + #to_string(stats.objects_total) + ' objects in ' + #to_string(stats.mark_us) + 'us, swept ' + #to_string(stats.objects_swept) + ' objects in ' + #to_string(stats.sweep_us) + 'us');
+};
+
+// calls f with stats of first cycle that starts after now, once its sweep is finished
+// if more cycles pass meanwhile - latest one is measured instead
+const after_next_cycle = (f) => {
+	const cycles = test.gc_stats().cycles;
+	#async(100, () => {
+		const stats = test.gc_stats();
+		if (stats.cycles == cycles || !stats.is_cycle_finished) {
+			return true;
+		}
+		f(stats);
+		return false;
+	});
+};
+
+let deep = build_deep();
+let wide = build_wide();
+
+after_next_cycle((alive_stats) => {
+	report('deep and wide graphs alive', alive_stats);
+
+	deep = null;
+	wide = null;
+	after_next_cycle((stats) => {
+		report('deep and wide graphs released', stats);
+		// any cycle after release doesn't reach them anymore, even if it's not the one that swept them
+		test.assert(alive_stats.objects_marked - stats.objects_marked >= DEEP_DEPTH + WIDE_WIDTH * WIDE_CHILDREN);
+	});
+});
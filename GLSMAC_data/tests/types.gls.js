@@ -454,6 +454,72 @@ test.assert(#to_string(testobj6) == '{ key1: value1, key2: value2, key3: null }'
 testobj6.key2 = #undefined;
 test.assert(#to_string(testobj6) == '{ key1: value1, key3: null }');
 
+{
+	// properties are iterated by key regardless of order they were added in
+	const shaped1 = {b: 2, a: 1, c: 3};
+	const shaped2 = {c: 3, a: 1, b: 2};
+	test.assert(shaped1 == shaped2);
+	test.assert(#to_string(shaped2) == '{ a: 1, b: 2, c: 3 }');
+	let keys = [];
+	for (k in shaped2) {
+		keys :+ k;
+	}
+	test.assert(keys == ['a', 'b', 'c']);
+	shaped1.a = #undefined;
+	shaped1.d = 4;
+	test.assert(#to_string(shaped1) == '{ b: 2, c: 3, d: 4 }');
+	test.assert(shaped2.a == 1);
+	const getb = (o) => {
+		return o.b;
+	};
+	test.assert(getb(shaped1) == 2);
+	test.assert(getb({x: 1, b: 'x'}) == 'x');
+	test.assert(getb(shaped2) == 2);
+
+	// objects with many properties
+	let many = {};
+	let i = 0;
+	while (i < 100) {
+		many['k' + #to_string(i)] = i;
+		i++;
+	}
+	i = 0;
+	while (i < 100) {
+		if (i % 2 == 0) {
+			many['k' + #to_string(i)] = #undefined;
+		}
+		i++;
+	}
+	let sum = 0;
+	for (v of many) {
+		sum += v;
+	}
+	test.assert(sum == 2500);
+	test.assert(many.k99 == 99);
+	test.assert(#typeof(many.k98) == 'Undefined');
+}
+
+{
+	// wrapped native objects are reused and read their properties on access
+	const counter = test.get_counter();
+	const count = counter.count;
+	const wrappers_created = test.get_wrappers_created();
+	let i = 0;
+	while (i < 10) {
+		test.get_counter().increment();
+		i++;
+	}
+	test.assert(test.get_wrappers_created() == wrappers_created);
+	test.assert(counter.count == count + 10);
+	test.assert(test.get_counter().count == count + 10);
+	test.assert(count == counter.count - 10); // value that was read before is unchanged
+	let keys = [];
+	for (k in counter) {
+		keys :+ k;
+	}
+	test.assert(keys == ['count', 'increment']);
+}
+
 {
 	let pushpop = ['asd', 'qwe'];
 	pushpop :+ 'zxc';
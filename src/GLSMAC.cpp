@@ -165,7 +165,7 @@ WRAPIMPL_BEGIN( GLSMAC )
 			NATIVE_CALL( this ) {
 				N_EXPECT_ARGS( 0 );
 				S_Init( GSE_CALL, {} );
-				return VALUE( gse::value::Undefined );
+				return VALUE_SHARED( gse::value::Undefined );
 			} )
 		},
 		{
@@ -173,7 +173,7 @@ WRAPIMPL_BEGIN( GLSMAC )
 			NATIVE_CALL( this ) {
 				N_EXPECT_ARGS( 0 );
 				g_engine->ShutDown();
-				return VALUE( gse::value::Undefined );
+				return VALUE_SHARED( gse::value::Undefined );
 			} )
 		},
 		{
@@ -181,7 +181,7 @@ WRAPIMPL_BEGIN( GLSMAC )
 			NATIVE_CALL( this ) {
 				N_EXPECT_ARGS( 0 );
 				DeinitGameState( GSE_CALL );
-				return VALUE( gse::value::Undefined );
+				return VALUE_SHARED( gse::value::Undefined );
 			} )
 		},
 		{
@@ -189,14 +189,14 @@ WRAPIMPL_BEGIN( GLSMAC )
 			NATIVE_CALL( this ) {
 				N_EXPECT_ARGS( 0 );
 				InitGameState( GSE_CALL );
-				return VALUE( gse::value::Undefined );
+				return VALUE_SHARED( gse::value::Undefined );
 			} ),
 		},
 		{
 			"reset",
 			NATIVE_CALL( this ) {
 				S_Reset( GSE_CALL );
-				return VALUE( gse::value::Undefined );
+				return VALUE_SHARED( gse::value::Undefined );
 			} )
 		},
 		{
@@ -250,7 +250,7 @@ WRAPIMPL_BEGIN( GLSMAC )
 					AddSinglePlayerSlot( nullptr );
 				}
 				StartGame( GSE_CALL );
-				return VALUE( gse::value::Undefined );
+				return VALUE_SHARED( gse::value::Undefined );
 			} )
 		},
 	};
@@ -311,11 +311,16 @@ gse::Value* const GLSMAC::TriggerObject( gse::Wrappable* object, const std::stri
 	return object->Trigger( m_gc_space, m_ctx, {}, ep, event, f_args );
 }
 
+gse::Value* const GLSMAC::TriggerObject( gse::Wrappable* object, const gse::value::atom_t event, const f_args_t& f_args ) {
+	gse::ExecutionPointer ep;
+	return object->Trigger( m_gc_space, m_ctx, {}, ep, event, f_args );
+}
+
 void GLSMAC::WithGSE( const std::function<void( GSE_CALLABLE )>& f ) {
 	m_state->WithGSE( this, f );
 }
 
-void GLSMAC::GetReachableObjects( std::unordered_set< gc::Object* >& reachable_objects ) {
+void GLSMAC::GetReachableObjects( gc::MarkStack& reachable_objects ) {
 	gse::GCWrappable::GetReachableObjects( reachable_objects );
 
 	g_engine->GetGame()->GetReachableObjects( reachable_objects );
@@ -378,7 +383,7 @@ void GLSMAC::S_Init( GSE_CALLABLE, const std::optional< std::string >& path ) {
 						N_EXPECT_ARGS( 1 );
 						N_GETVALUE( path, 0, String );
 						S_Init( GSE_CALL, path );
-						return VALUE( gse::value::Undefined );
+						return VALUE_SHARED( gse::value::Undefined );
 					} )
 				}
 			};
@@ -412,7 +417,7 @@ void GLSMAC::S_Intro( GSE_CALLABLE ) {
 			"mainmenu", NATIVE_CALL( this ) {
 				N_EXPECT_ARGS( 0 );
 				S_MainMenu( GSE_CALL );
-				return VALUE( gse::value::Undefined );
+				return VALUE_SHARED( gse::value::Undefined );
 			} )
 		}
 	}; } );
@@ -600,6 +605,6 @@ void GLSMAC::AddToContext( gc::Space* const gc_space, gse::context::Context* ctx
 		const auto& main = arguments.at(0);
 		N_CHECKARG( main, 0, Callable );
 		m_main_callables.push_back( main );
-		return VALUE( gse::value::Undefined );
+		return VALUE_SHARED( gse::value::Undefined );
 	} ), ep );
 }
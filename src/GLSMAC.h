@@ -55,10 +55,11 @@ CLASS2( GLSMAC, gse::GCWrappable, gse::Bindings )
 
 	typedef std::function< void( GSE_CALLABLE, gse::value::object_properties_t& args ) > f_args_t;
 	gse::Value* const TriggerObject( gse::Wrappable* object, const std::string& event, const f_args_t& f_args = nullptr );
+	gse::Value* const TriggerObject( gse::Wrappable* object, const gse::value::atom_t event, const f_args_t& f_args = nullptr );
 
 	void WithGSE( const std::function< void( GSE_CALLABLE ) >& f );
 
-	void GetReachableObjects( std::unordered_set< gc::Object* >& reachable_objects ) override;
+	void GetReachableObjects( gc::MarkStack& reachable_objects ) override;
 
 private:
 	gse::GSE* m_gse = nullptr;
@@ -0,0 +1,137 @@
+#include "Mixer.h"
+
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+#include <thread>
+
+#if defined( __SSE2__ )
+#define MIXER_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#include "scene/actor/Sound.h"
+
+namespace audio {
+
+static constexpr float SAMPLE_MIN = -32768.0f;
+static constexpr float SAMPLE_MAX = 32767.0f;
+
+// acc += in * gain
+static void Accumulate( float* const __restrict acc, const Mixer::sample_t* const __restrict in, const float gain, const size_t length ) {
+	size_t i = 0;
+#if defined( MIXER_SSE2 )
+	const __m128 g = _mm_set1_ps( gain );
+	for ( ; i + 8 <= length ; i += 8 ) {
+		const __m128i s = _mm_loadu_si128( (const __m128i*)( in + i ) );
+		// sign-extend 16-bit samples to 32 bits
+		const __m128 lo = _mm_cvtepi32_ps( _mm_srai_epi32( _mm_unpacklo_epi16( s, s ), 16 ) );
+		const __m128 hi = _mm_cvtepi32_ps( _mm_srai_epi32( _mm_unpackhi_epi16( s, s ), 16 ) );
+		_mm_storeu_ps( acc + i, _mm_add_ps( _mm_loadu_ps( acc + i ), _mm_mul_ps( lo, g ) ) );
+		_mm_storeu_ps( acc + i + 4, _mm_add_ps( _mm_loadu_ps( acc + i + 4 ), _mm_mul_ps( hi, g ) ) );
+	}
+#endif
+	for ( ; i < length ; i++ ) {
+		acc[ i ] += in[ i ] * gain;
+	}
+}
+
+// out = round( clamp( acc ) ), both paths round to nearest
+static void Saturate( const float* const __restrict acc, Mixer::sample_t* const __restrict out, const size_t length ) {
+	size_t i = 0;
+#if defined( MIXER_SSE2 )
+	const __m128 min = _mm_set1_ps( SAMPLE_MIN );
+	const __m128 max = _mm_set1_ps( SAMPLE_MAX );
+	for ( ; i + 8 <= length ; i += 8 ) {
+		const __m128i lo = _mm_cvtps_epi32( _mm_min_ps( _mm_max_ps( _mm_loadu_ps( acc + i ), min ), max ) );
+		const __m128i hi = _mm_cvtps_epi32( _mm_min_ps( _mm_max_ps( _mm_loadu_ps( acc + i + 4 ), min ), max ) );
+		_mm_storeu_si128( (__m128i*)( out + i ), _mm_packs_epi32( lo, hi ) );
+	}
+#endif
+	for ( ; i < length ; i++ ) {
+		out[ i ] = (Mixer::sample_t)std::lrintf( std::min( std::max( acc[ i ], SAMPLE_MIN ), SAMPLE_MAX ) );
+	}
+}
+
+Mixer::Mixer( const size_t block_length, const float volume, const float lowering_per_voice )
+	: m_block_length( block_length )
+	, m_volume( volume )
+	, m_lowering_per_voice( lowering_per_voice )
+	, m_accumulator( block_length )
+	, m_voice_buffer( block_length ) {
+	ASSERT( block_length > 0, "block length is zero" );
+	Publish();
+}
+
+Mixer::~Mixer() {
+	delete m_published.load();
+}
+
+void Mixer::AddVoice( scene::actor::Sound* actor ) {
+	ASSERT( std::find( m_voices.begin(), m_voices.end(), actor ) == m_voices.end(), "voice already added" );
+	m_voices.push_back( actor );
+	Publish();
+}
+
+void Mixer::RemoveVoice( scene::actor::Sound* actor ) {
+	const auto it = std::find( m_voices.begin(), m_voices.end(), actor );
+	ASSERT( it != m_voices.end(), "voice not found" );
+	m_voices.erase( it );
+	Publish();
+}
+
+const std::vector< scene::actor::Sound* >& Mixer::GetVoices() const {
+	return m_voices;
+}
+
+void Mixer::Mix( sample_t* out ) {
+	// claim version before reading snapshot, so that it isn't deleted while in use ( see Publish )
+	m_mixing_version = m_version.load();
+	const auto* voices = m_published.load();
+
+	std::fill( m_accumulator.begin(), m_accumulator.end(), 0.0f );
+	if ( !voices->empty() ) {
+		// helps with clicks a bit
+		const float lowering = std::pow( m_lowering_per_voice, (float)voices->size() );
+		const int len = m_block_length * sizeof( sample_t );
+		for ( const auto& actor : *voices ) {
+			if ( actor->IsActive() ) {
+				actor->GetNextBuffer( (uint8_t*)m_voice_buffer.data(), len );
+				const float gain = actor->GetVolume() * m_volume * lowering;
+				if ( gain > 0.0f ) {
+					Accumulate( m_accumulator.data(), m_voice_buffer.data(), gain, m_block_length );
+				}
+			}
+		}
+	}
+	m_mixing_version = 0;
+
+	Saturate( m_accumulator.data(), out, m_block_length );
+}
+
+void Mixer::Render( sample_t* out, const size_t length ) {
+	size_t pos = 0;
+	for ( ; pos + m_block_length <= length ; pos += m_block_length ) {
+		Mix( out + pos );
+	}
+	if ( pos < length ) {
+		std::vector< sample_t > block( m_block_length );
+		Mix( block.data() );
+		memcpy( out + pos, block.data(), ( length - pos ) * sizeof( sample_t ) );
+	}
+}
+
+void Mixer::Publish() {
+	const auto* old = m_published.exchange( new voices_t( m_voices ) );
+	const size_t version = ++m_version;
+	if ( old ) {
+		// wait until mixing thread is done with snapshots older than this one, it takes one block at most
+		size_t mixing_version;
+		while ( ( mixing_version = m_mixing_version.load() ) && mixing_version < version ) {
+			std::this_thread::yield();
+		}
+		delete old;
+	}
+}
+
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <vector>
+#include <atomic>
+#include <cstdint>
+
+#include "common/Common.h"
+
+namespace scene::actor {
+class Sound;
+}
+
+namespace audio {
+
+/**
+ * Mixes sound actors into mono 16-bit stream, independent of audio device.
+ *   voice list is published to mixing thread as immutable snapshot, so Mix() never locks
+ *   gain of every voice is computed once per block, accumulation and saturation are vectorized ( SSE2 where available )
+ */
+CLASS( Mixer, common::Class )
+
+	typedef int16_t sample_t;
+
+	// native format, sound loaders convert everything to it
+	static constexpr size_t FREQUENCY = 22050;
+	static constexpr uint8_t CHANNELS = 1;
+
+	Mixer( const size_t block_length, const float volume, const float lowering_per_voice );
+	~Mixer();
+
+	// these are called from one thread ( i.e. MAIN ), they wait until concurrent Mix() stops using old voice list
+	void AddVoice( scene::actor::Sound* actor );
+	void RemoveVoice( scene::actor::Sound* actor );
+
+	const std::vector< scene::actor::Sound* >& GetVoices() const;
+
+	// mixes next block_length samples of all active voices, called from audio thread
+	void Mix( sample_t* out );
+
+	// mixes length samples block by block, without audio device
+	void Render( sample_t* out, const size_t length );
+
+private:
+	typedef std::vector< scene::actor::Sound* > voices_t;
+
+	const size_t m_block_length;
+	const float m_volume;
+	const float m_lowering_per_voice;
+
+	// owned by adding/removing thread
+	voices_t m_voices = {};
+
+	// snapshot used by mixing thread, replaced on every change
+	std::atomic< const voices_t* > m_published = nullptr;
+	std::atomic< size_t > m_version = 0;
+	// version of snapshot that is currently being mixed, 0 if none
+	std::atomic< size_t > m_mixing_version = 0;
+
+	std::vector< float > m_accumulator;
+	std::vector< sample_t > m_voice_buffer;
+
+	void Publish();
+
+};
+
+}
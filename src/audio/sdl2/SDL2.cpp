@@ -1,11 +1,12 @@
 #include <algorithm>
+#include <type_traits>
 
 #define SDL_MAIN_HANDLED 1
 #include <SDL.h>
 
 #include "SDL2.h"
 
-#include "Sound.h"
+#include "audio/Mixer.h"
 #include "engine/Engine.h"
 #include "config/Config.h"
 #include "scene/actor/Sound.h"
@@ -13,14 +14,16 @@
 namespace audio {
 namespace sdl2 {
 
+static_assert( AUDIO_FREQUENCY == Mixer::FREQUENCY && AUDIO_CHANNELS == Mixer::CHANNELS, "device format differs from mixer format" );
+static_assert( std::is_same< AUDIO_SAMPLE_TYPE, Mixer::sample_t >::value, "device sample type differs from mixer sample type" );
+
 SDL2::SDL2() {
 
 }
 
 SDL2::~SDL2() {
-	std::lock_guard guard( m_actors_mutex );
-	for ( auto& actor : m_actors ) {
-		DELETE( actor.second );
+	if ( m_mixer ) {
+		DELETE( m_mixer );
 	}
 }
 
@@ -42,11 +45,7 @@ void SDL2::Start() {
 		return;
 	}
 
-	m_buffer_length = AUDIO_SAMPLES * AUDIO_CHANNELS;
-	m_buffer_size = sizeof( AUDIO_SAMPLE_TYPE ) * m_buffer_length;
-	m_mix_buffer_size = sizeof( AUDIO_MIX_TYPE ) * m_buffer_length;
-	m_mix_buffer = (AUDIO_MIX_TYPE*)malloc( m_mix_buffer_size );
-	m_buffer = (AUDIO_SAMPLE_TYPE*)malloc( m_buffer_size );
+	NEW( m_mixer, Mixer, AUDIO_SAMPLES * AUDIO_CHANNELS, AUDIO_VOLUME, AUDIO_VOLUME_LOWERING_FROM_ACTORS );
 
 	SDL_AudioSpec wav_spec;
 	wav_spec.freq = AUDIO_FREQUENCY;
@@ -77,10 +76,6 @@ void SDL2::Stop() {
 
 	Log( "Deinitializing SDL2" );
 	SDL_CloseAudio();
-
-	free( m_buffer );
-	free( m_mix_buffer );
-
 }
 
 void SDL2::Iterate() {
@@ -96,21 +91,17 @@ void SDL2::AddActor( scene::actor::Sound* actor ) {
 		return;
 	}
 
-	std::lock_guard guard( m_actors_mutex );
-
 	// check if same sound was double-added (can happen if two popups close at same time, for example)
 	// in this case we'll ignore second sound to avoid volume spike
-	for ( const auto& a : m_actors ) {
-		if ( a.first->GetPos() == 0 && a.first->GetSound() == actor->GetSound() ) {
+	for ( const auto& a : m_mixer->GetVoices() ) {
+		if ( a->GetPos() == 0 && a->GetSound() == actor->GetSound() ) {
 			Log( "Muting " + actor->GetName() + " to prevent double-sound" );
 			actor->Mute();
 		}
 	}
 
 	Log( "Adding sound actor " + actor->GetName() );
-	ASSERT( m_actors.find( actor ) == m_actors.end(), "sound actor already added" );
-	NEWV( sound_actor, Sound, actor );
-	m_actors[ actor ] = sound_actor;
+	m_mixer->AddVoice( actor );
 }
 
 void SDL2::RemoveActor( scene::actor::Sound* actor ) {
@@ -118,37 +109,16 @@ void SDL2::RemoveActor( scene::actor::Sound* actor ) {
 		return;
 	}
 
-	std::lock_guard guard( m_actors_mutex );
-
 	Log( "Removing sound actor " + actor->GetName() );
-	auto it = m_actors.find( actor );
-	ASSERT( it != m_actors.end(), "sound actor not found" );
-	DELETE( it->second );
-	m_actors.erase( it );
+	// waits if actor is being mixed right now, so it can be deleted after this
+	m_mixer->RemoveVoice( actor );
 }
 
 void SDL2::Mix( Uint8* stream, int len ) {
 	ASSERT( m_is_sound_enabled, "SDL2::Mix() called while sound not enabled" );
-	ASSERT( len == m_buffer_size, "sample type or size mismatch" );
-
-	memset( ptr( m_mix_buffer, 0, m_mix_buffer_size ), 0, m_mix_buffer_size );
-	{
-		std::lock_guard guard( m_actors_mutex );
-
-		for ( auto& actor : m_actors ) {
-			if ( actor.second->IsActive() ) {
-				actor.second->GetNextBuffer( (uint8_t*)m_buffer, len );
-				for ( size_t i = 0 ; i < m_buffer_length ; i++ ) {
-					m_mix_buffer[ i ] = m_mix_buffer[ i ] + m_buffer[ i ] * actor.second->GetVolume() * AUDIO_VOLUME * pow( AUDIO_VOLUME_LOWERING_FROM_ACTORS, m_actors.size() );
-				}
-			}
-		}
-	}
-	for ( size_t i = 0 ; i < m_buffer_length ; i++ ) {
-		m_buffer[ i ] = floor( m_mix_buffer[ i ] );
-	}
+	ASSERT( len == AUDIO_SAMPLES * AUDIO_CHANNELS * sizeof( AUDIO_SAMPLE_TYPE ), "sample type or size mismatch" );
 
-	SDL_memcpy( stream, (uint8_t*)m_buffer, len );
+	m_mixer->Mix( (AUDIO_SAMPLE_TYPE*)stream );
 }
 
 }
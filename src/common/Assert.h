@@ -4,10 +4,16 @@
 
 #define THROW( _text ) throw std::runtime_error( _text )
 
+namespace logger {
+// writes out logs that are still buffered, so that last lines before crash aren't lost
+void FlushAll();
+}
+
 #if defined( DEBUG ) || defined( FASTDEBUG )
 
 #define ASSERT( _condition, _text ) \
     if ( !( _condition ) ) { \
+        logger::FlushAll(); \
         THROW( _text ); \
     }
 
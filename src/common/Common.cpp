@@ -1,8 +1,5 @@
 #include <atomic>
-
-#ifdef DEBUG
 #include <chrono>
-#endif
 
 #include "Common.h"
 
@@ -39,24 +36,24 @@ const std::string& Class::GetLocalName() const {
 	return m_name;
 }
 
-#ifdef DEBUG
-static uint64_t last_time = 0;
-#endif
+const bool Class::IsLogged( const logger::level_t level ) {
+	return level >= logger::g_level && g_engine != NULL && g_engine->HasLoggers();
+}
 
 void Class::Log( const std::string& text ) const {
-	if ( g_engine != NULL ) {
-#ifdef DEBUG
-		const auto time = std::chrono::high_resolution_clock::now().time_since_epoch().count();
-		const auto duration = last_time
-			? time - last_time
-			: 0;
-		last_time = time;
-#endif
+	Log( logger::LL_INFO, text );
+}
+
+void Class::Log( const logger::level_t level, const std::string& text ) const {
+	if ( IsLogged( level ) ) {
+		// formatting is up to loggers
 		g_engine->Log(
-#ifdef DEBUG
-			"[+" + std::to_string( duration ) + "ns] " +
-#endif
-				"<" + GetName() + "> " + text
+			{
+				level,
+				(uint64_t)std::chrono::high_resolution_clock::now().time_since_epoch().count(),
+				GetName(),
+				text
+			}
 		);
 	}
 }
@@ -6,6 +6,8 @@
 
 #include "Assert.h"
 
+#include "logger/Types.h"
+
 // used in multiline ToString() implementations
 
 #define TS_DEF() const std::string ToString( const std::string& prefix ) const override;
@@ -42,6 +44,14 @@
 
 #define TS_OF( _what ) ( _what )->ToString( TS_PREFIX_NEXT )
 
+// text is only built if message passes level filters, use it for frequent or expensive messages
+#define LOG_AT( _level, _text ) \
+    do { \
+        if ( ( _level ) >= GLSMAC_LOG_LEVEL && ::common::Class::IsLogged( _level ) ) { \
+            Log( _level, _text ); \
+        } \
+    } while ( false )
+
 namespace common {
 
 class Class {
@@ -54,6 +64,9 @@ public:
 	const std::string& GetLocalName() const;
 	virtual const std::string GetClassName() const = 0;
 
+	// false if message of this level would be discarded anyway
+	static const bool IsLogged( const logger::level_t level );
+
 #ifdef DEBUG
 	// use these to track lifecycle of specific object
 	void SetTesting( const bool testing );
@@ -63,10 +76,10 @@ public:
 
 protected:
 	size_t m_object_id = 0;
-	std::string m_class_name = "";
 	std::string m_name = "";
 
 	void Log( const std::string& text ) const;
+	void Log( const logger::level_t level, const std::string& text ) const;
 
 private:
 
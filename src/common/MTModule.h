@@ -1,18 +1,20 @@
 #pragma once
 
 #include <mutex>
+#include <condition_variable>
 #include <atomic>
 #include <functional>
-#include <map>
+#include <vector>
 #include <thread>
+#include <cstdint>
 
 #include "Module.h"
 #include "MTTypes.h"
 
 namespace common {
 
-static std::mutex s_next_mt_id_mutex;
-static mt_id_t s_next_mt_id = 0;
+// shared by all modules and translation units
+inline std::atomic< mt_id_t > s_next_mt_id = 0;
 
 // requests and responses should be structs that contain operation type and unions of variables for every op type
 // if you need to pass something non-trivial - use raw pointers
@@ -20,55 +22,73 @@ static mt_id_t s_next_mt_id = 0;
 //   create/malloc objects when creating request, delete/free in target thread when processing it
 //   for response it's opposite - create/malloc when creating response, delete/free in original thread when reading response
 
+// every request lives in its own slot until response is read or request is canceled
+//   new requests are pushed to lock-free queue that is consumed by module thread
+//   mt_id contains slot index, so responses are found without searching
 template< typename REQUEST_TYPE, typename RESPONSE_TYPE >
 class MTModule : public Module {
 public:
 
+	virtual ~MTModule() {
+		for ( auto& chunk : m_slot_chunks ) {
+			delete[] chunk.load();
+		}
+	}
+
 	virtual void Iterate() {
 		ProcessRequests();
 	}
 
 	virtual void Stop() {
-		std::lock_guard guard( m_mt_states_mutex );
-		for ( const auto& state : m_mt_states ) {
-			ASSERT( !state.second.is_processing, "mt request still processing" );
-			DestroyRequest( state.second.request );
-			DestroyResponse( state.second.response );
+		// unlink queued ones, they are destroyed below with the rest
+		TakeQueued();
+		std::lock_guard guard( m_slots_mutex );
+		for ( size_t i = 0 ; i < m_slots_count ; i++ ) {
+			auto& slot = GetSlotByIndex( i );
+			const auto state = slot.state.load();
+			if ( state == S_FREE ) {
+				continue;
+			}
+			ASSERT( state != S_PROCESSING, "mt request still processing" );
+			if ( state != S_CANCELED ) {
+				DestroyRequest( slot.request );
+				DestroyResponse( slot.response );
+			}
+			slot.mt_id = 0;
+			slot.state = S_FREE;
+			m_free_slots.push_back( i );
 		}
-		m_mt_states.clear();
 	}
 
 	// use these to pass data from/to other threads
 	mt_id_t MT_CreateRequest( const REQUEST_TYPE& data ) {
-		mt_state_t state = {};
-		s_next_mt_id_mutex.lock();
-		mt_id_t mt_id = ++s_next_mt_id;
-		s_next_mt_id_mutex.unlock();
-		state.is_executed = false;
-		state.request = data;
-		m_mt_states_mutex.lock();
-		ASSERT( m_mt_states.find( mt_id ) == m_mt_states.end(), "duplicate mt_id" );
-		m_mt_states[ mt_id ] = state;
-		m_mt_states_mutex.unlock();
+		const auto index = AllocateSlot();
+		// low bits keep ids unique over time, high bits point to slot
+		const mt_id_t mt_id = ( ( index + 1 ) << MT_ID_SEQUENCE_BITS ) | ( ++s_next_mt_id & MT_ID_SEQUENCE_MASK );
+		auto& slot = GetSlotByIndex( index );
+		slot.request = data;
+		slot.response = {};
+		slot.mt_id = mt_id;
+		slot.state = S_PENDING;
+		PushQueued( &slot );
+		OnRequestQueued();
 		//Log( "MT Request " + to_string( mt_id ) + " created" );
 		return mt_id;
 	}
 
 	const RESPONSE_TYPE MT_GetResponse( const mt_id_t mt_id ) {
 		RESPONSE_TYPE response = {};
-		m_mt_states_mutex.lock();
-		auto it = m_mt_states.find( mt_id );
-		if ( it == m_mt_states.end() ) {
+		auto* slot = GetSlot( mt_id );
+		if ( !slot ) {
 			return response;
 		}
-		if ( it->second.is_executed ) {
-			response = it->second.response;
-			DestroyRequest( it->second.request );
-			m_mt_states.erase( it );
+		auto expected = S_EXECUTED;
+		if ( slot->state.compare_exchange_strong( expected, S_FREE ) ) {
+			response = slot->response;
+			DestroyRequest( slot->request );
+			ReleaseSlot( slot );
 			//Log( "MT Request " + to_string( mt_id ) + " result returned" );
 		}
-		m_mt_states_mutex.unlock();
-
 		return response;
 	}
 
@@ -78,29 +98,36 @@ public:
 	}
 
 	void MT_Cancel( const mt_id_t mt_id ) {
-		m_mt_states_mutex.lock();
-		auto it = m_mt_states.find( mt_id );
-		if ( it == m_mt_states.end() ) {
+		auto* slot = GetSlot( mt_id );
+		if ( !slot ) {
 			return; // already gone
 		}
 		if ( mt_id == m_current_request_id ) {
 			m_is_canceled = true;
 		}
-		if ( !it->second.is_executed ) {
-			if ( it->second.is_processing ) {
-				Log( "Waiting for MT Request " + std::to_string( mt_id ) + " to finish" );
-				while ( it->second.is_processing ) {
-					m_mt_states_mutex.unlock();
-					std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
-					m_mt_states_mutex.lock();
-				}
-			}
+		auto expected = S_PENDING;
+		if ( slot->state.compare_exchange_strong( expected, S_CANCELED ) ) {
+			// still queued, module thread will release slot when it gets to it
 			//Log( "MT Request " + to_string( mt_id ) + " canceled" );
-			DestroyRequest( it->second.request );
-			DestroyResponse( it->second.response );
-			m_mt_states.erase( it );
+			DestroyRequest( slot->request );
+			return;
+		}
+		if ( expected == S_PROCESSING ) {
+			Log( "Waiting for MT Request " + std::to_string( mt_id ) + " to finish" );
+			std::unique_lock lock( m_processed_mutex );
+			m_processed_cv.wait(
+				lock, [ slot ]() {
+					return slot->state != S_PROCESSING;
+				}
+			);
+		}
+		expected = S_EXECUTED;
+		if ( slot->state.compare_exchange_strong( expected, S_FREE ) ) {
+			// not read yet
+			DestroyRequest( slot->request );
+			DestroyResponse( slot->response );
+			ReleaseSlot( slot );
 		}
-		m_mt_states_mutex.unlock();
 	}
 
 protected:
@@ -110,75 +137,137 @@ protected:
 	virtual void DestroyRequest( const REQUEST_TYPE& request ) = 0;
 	virtual void DestroyResponse( const RESPONSE_TYPE& response ) = 0;
 
+	// called from requesting thread after request was queued, module may use it to wake up its thread
+	virtual void OnRequestQueued() {}
+
+	// may be called recursively from ProcessRequest(), in that case only requests that were created since are processed
 	void ProcessRequests() {
-		mt_request_map_t requests = MT_GetRequests();
-		if ( !requests.empty() ) {
-			//Log( "MT Processing " + to_string( requests.size() ) + " requests" );
-			mt_response_map_t responses = {};
-			for ( auto& request : requests ) {
-				m_mt_states_mutex.lock();
+		auto* slot = TakeQueued();
+		while ( slot ) {
+			auto* const next = slot->next_queued;
+			auto expected = S_PENDING;
+			if ( slot->state.compare_exchange_strong( expected, S_PROCESSING ) ) {
 				const mt_id_t previous_request_id = m_current_request_id;
 				const bool was_canceled = m_is_canceled;
-				m_current_request_id = request.first;
+				m_current_request_id = slot->mt_id.load();
 				m_is_canceled = false;
-				m_mt_states_mutex.unlock();
-				responses[ request.first ] = ProcessRequest( request.second, m_is_canceled );
-				m_mt_states_mutex.lock();
+				slot->response = ProcessRequest( slot->request, m_is_canceled );
 				m_current_request_id = previous_request_id;
 				m_is_canceled = was_canceled;
-				m_mt_states_mutex.unlock();
+				{
+					std::lock_guard guard( m_processed_mutex );
+					slot->state = S_EXECUTED;
+					//Log( "MT Request " + to_string( slot->mt_id ) + " executed" );
+				}
+				m_processed_cv.notify_all();
 			}
-			if ( !responses.empty() ) {
-				MT_SetResponses( responses );
+			else {
+				ASSERT( expected == S_CANCELED, "unexpected mt request state" );
+				ReleaseSlot( slot );
 			}
+			slot = next;
 		}
 	}
 
 private:
 
-	struct mt_state_t {
+	static constexpr size_t MT_ID_SEQUENCE_BITS = sizeof( mt_id_t ) * 4;
+	static constexpr mt_id_t MT_ID_SEQUENCE_MASK = ( (mt_id_t)1 << MT_ID_SEQUENCE_BITS ) - 1;
+	static constexpr size_t SLOTS_PER_CHUNK = 64;
+	static constexpr size_t MAX_SLOT_CHUNKS = 4096;
+
+	enum mt_slot_state_t : uint8_t {
+		S_FREE,
+		S_PENDING,
+		S_PROCESSING,
+		S_EXECUTED,
+		S_CANCELED,
+	};
+
+	struct mt_slot_t {
+		std::atomic< mt_id_t > mt_id = 0;
+		std::atomic< mt_slot_state_t > state = S_FREE;
 		REQUEST_TYPE request = {};
-		bool is_processing = false;
-		bool is_executed = false;
 		RESPONSE_TYPE response = {};
+		mt_slot_t* next_queued = nullptr;
 	};
-	typedef std::map< mt_id_t, REQUEST_TYPE > mt_request_map_t;
-	typedef std::map< mt_id_t, RESPONSE_TYPE > mt_response_map_t;
-
-	mt_request_map_t MT_GetRequests() {
-		mt_request_map_t result = {};
-		m_mt_states_mutex.lock();
-		for ( auto& it : m_mt_states ) {
-			if ( !it.second.is_executed && !it.second.is_processing ) {
-				it.second.is_processing = true;
-				result[ it.first ] = it.second.request;
-			}
+
+	// chunks are never moved or freed while module exists, so slots can be accessed without locking
+	std::atomic< mt_slot_t* > m_slot_chunks[ MAX_SLOT_CHUNKS ] = {};
+	std::mutex m_slots_mutex; // only for allocating and releasing slots
+	size_t m_slots_count = 0;
+	std::vector< size_t > m_free_slots = {};
+
+	// newest first, pushed by any thread, taken all at once by module thread
+	std::atomic< mt_slot_t* > m_queue_head = nullptr;
+
+	std::mutex m_processed_mutex;
+	std::condition_variable m_processed_cv;
+
+	mt_flag_t m_is_canceled = false;
+	std::atomic< mt_id_t > m_current_request_id = 0;
+
+	mt_slot_t& GetSlotByIndex( const size_t index ) {
+		return m_slot_chunks[ index / SLOTS_PER_CHUNK ].load( std::memory_order_acquire )[ index % SLOTS_PER_CHUNK ];
+	}
+
+	// null if mt_id is invalid or its request is already gone
+	mt_slot_t* GetSlot( const mt_id_t mt_id ) {
+		const size_t index = mt_id >> MT_ID_SEQUENCE_BITS;
+		if ( !index || index > MAX_SLOT_CHUNKS * SLOTS_PER_CHUNK ) {
+			return nullptr;
 		}
-		m_mt_states_mutex.unlock();
-		return result;
+		auto* const chunk = m_slot_chunks[ ( index - 1 ) / SLOTS_PER_CHUNK ].load( std::memory_order_acquire );
+		if ( !chunk ) {
+			return nullptr;
+		}
+		auto* const slot = &chunk[ ( index - 1 ) % SLOTS_PER_CHUNK ];
+		return slot->mt_id == mt_id
+			? slot
+			: nullptr;
 	}
 
-	void MT_SetResponses( const mt_response_map_t& responses ) {
-		if ( !responses.empty() ) {
-			m_mt_states_mutex.lock();
-			for ( auto& response : responses ) {
-				auto it = m_mt_states.find( response.first );
-				ASSERT( it != m_mt_states.end(), "invalid response mt_id" );
-				ASSERT( it->second.is_processing, "setting response on non-processed request" );
-				it->second.response = response.second;
-				it->second.is_executed = true;
-				it->second.is_processing = false;
-				//Log( "MT Request " + to_string( response.first ) + " executed" );
-			}
-			m_mt_states_mutex.unlock();
+	const size_t AllocateSlot() {
+		std::lock_guard guard( m_slots_mutex );
+		if ( !m_free_slots.empty() ) {
+			const auto index = m_free_slots.back();
+			m_free_slots.pop_back();
+			return index;
+		}
+		const auto index = m_slots_count++;
+		if ( !( index % SLOTS_PER_CHUNK ) ) {
+			ASSERT( index / SLOTS_PER_CHUNK < MAX_SLOT_CHUNKS, "too many mt requests" );
+			m_slot_chunks[ index / SLOTS_PER_CHUNK ].store( new mt_slot_t[ SLOTS_PER_CHUNK ], std::memory_order_release );
 		}
+		return index;
+	}
+
+	void ReleaseSlot( mt_slot_t* const slot ) {
+		const size_t index = ( slot->mt_id >> MT_ID_SEQUENCE_BITS ) - 1;
+		slot->mt_id = 0;
+		slot->state = S_FREE;
+		std::lock_guard guard( m_slots_mutex );
+		m_free_slots.push_back( index );
+	}
+
+	void PushQueued( mt_slot_t* const slot ) {
+		slot->next_queued = m_queue_head.load( std::memory_order_relaxed );
+		while ( !m_queue_head.compare_exchange_weak( slot->next_queued, slot, std::memory_order_release, std::memory_order_relaxed ) ) {}
+	}
+
+	// takes everything that was queued, oldest first
+	mt_slot_t* TakeQueued() {
+		auto* slot = m_queue_head.exchange( nullptr, std::memory_order_acquire );
+		mt_slot_t* result = nullptr;
+		while ( slot ) {
+			auto* const next = slot->next_queued;
+			slot->next_queued = result;
+			result = slot;
+			slot = next;
+		}
+		return result;
 	}
 
-	typedef std::map< mt_id_t, mt_state_t > mt_states_t;
-	std::mutex m_mt_states_mutex;
-	mt_states_t m_mt_states = {};
-	mt_flag_t m_is_canceled = false;
-	std::atomic< mt_id_t > m_current_request_id = 0;
 };
 
 }
@@ -0,0 +1,235 @@
+#include <algorithm>
+
+#include "ThreadPool.h"
+
+namespace common {
+
+// set for worker threads only, so that tasks know which queue they may push to without locking others
+static thread_local ThreadPool* s_current_pool = nullptr;
+static thread_local size_t s_current_worker_index = 0;
+
+ThreadPool::ThreadPool( const size_t workers_count )
+	: m_workers_count( workers_count )
+	, m_queues( workers_count + 1 ) {
+	//
+}
+
+ThreadPool::~ThreadPool() {
+	if ( m_is_running ) {
+		Stop();
+	}
+}
+
+void ThreadPool::Start() {
+	ASSERT( !m_is_running, "thread pool already running" );
+	Log( "Starting " + std::to_string( m_workers_count ) + " workers" );
+	m_is_running = true;
+	m_workers.reserve( m_workers_count );
+	for ( size_t i = 0 ; i < m_workers_count ; i++ ) {
+		m_workers.emplace_back( &ThreadPool::WorkerLoop, this, i );
+	}
+}
+
+void ThreadPool::Stop() {
+	ASSERT( m_is_running, "thread pool not running" );
+	Log( "Stopping workers" );
+	{
+		std::lock_guard< std::mutex > guard( m_idle_mutex );
+		m_is_running = false;
+	}
+	m_idle_cv.notify_all();
+	for ( auto& worker : m_workers ) {
+		worker.join();
+	}
+	m_workers.clear();
+}
+
+const size_t ThreadPool::GetWorkersCount() const {
+	return m_workers_count;
+}
+
+const size_t ThreadPool::GetConcurrency() const {
+	return m_workers_count + 1;
+}
+
+ThreadPool::TaskGroup::TaskGroup( ThreadPool* pool, MT_CANCELABLE )
+	: m_pool( pool )
+	, m_canceled( MT_C ) {
+	ASSERT( m_pool, "thread pool is null" );
+}
+
+ThreadPool::TaskGroup::~TaskGroup() {
+	// can't throw from destructor, so wait for tasks that still reference this group and drop their exceptions
+	if ( m_pending ) {
+		m_pool->Log( "WARNING: task group destroyed with pending tasks, waiting for them" );
+		try {
+			Wait();
+		}
+		catch ( const std::exception& e ) {
+			m_pool->Log( (std::string)"WARNING: exception in pending task dropped: " + e.what() );
+		}
+		catch ( ... ) {
+			m_pool->Log( "WARNING: exception in pending task dropped" );
+		}
+	}
+}
+
+void ThreadPool::TaskGroup::Run( const task_t& task ) {
+	if ( !m_pool->m_is_running || !m_pool->m_workers_count ) {
+		// nobody to delegate to
+		Execute( task );
+		return;
+	}
+	m_pending++;
+	m_pool->Push(
+		{
+			task,
+			this
+		}
+	);
+}
+
+void ThreadPool::TaskGroup::Wait() {
+	while ( m_pending ) {
+		if ( !m_pool->TryRunOne() ) {
+			// remaining tasks are already being processed by other threads, sleep until they finish or something new is queued
+			std::unique_lock< std::mutex > lock( m_pool->m_idle_mutex );
+			m_pool->m_idle_cv.wait(
+				lock, [ this ]() {
+					return !m_pending || m_pool->m_queued_count;
+				}
+			);
+		}
+	}
+	if ( m_exception ) {
+		const auto e = m_exception;
+		m_exception = nullptr;
+		std::rethrow_exception( e );
+	}
+}
+
+void ThreadPool::TaskGroup::Execute( const task_t& task ) {
+	if ( m_canceled ) {
+		return;
+	}
+	try {
+		task();
+	}
+	catch ( ... ) {
+		std::lock_guard< std::mutex > guard( m_exception_mutex );
+		if ( !m_exception ) {
+			m_exception = std::current_exception();
+		}
+	}
+}
+
+void ThreadPool::ParallelFor( const size_t begin, const size_t end, const range_task_t& f, MT_CANCELABLE, size_t chunk_size ) {
+	if ( begin >= end ) {
+		return;
+	}
+	const size_t total = end - begin;
+	if ( !chunk_size ) {
+		// few chunks per thread so that faster threads can steal from slower ones
+		chunk_size = total / ( GetConcurrency() * 4 );
+		if ( !chunk_size ) {
+			chunk_size = 1;
+		}
+	}
+	TaskGroup group( this, MT_C );
+	for ( size_t from = begin ; from < end ; from += chunk_size ) {
+		const size_t to = std::min( from + chunk_size, end );
+		group.Run(
+			[ &f, from, to ]() {
+				f( from, to );
+			}
+		);
+	}
+	group.Wait();
+}
+
+void ThreadPool::Push( job_t&& job ) {
+	auto& queue = s_current_pool == this
+		? m_queues[ s_current_worker_index ]
+		: m_queues[ m_workers_count ];
+	{
+		// counted before it's queued so that counter never goes below zero
+		std::lock_guard< std::mutex > guard( m_idle_mutex );
+		m_queued_count++;
+	}
+	{
+		std::lock_guard< std::mutex > guard( queue.mutex );
+		queue.jobs.push_back( std::move( job ) );
+	}
+	m_idle_cv.notify_one();
+}
+
+bool ThreadPool::TryPop( job_t& job ) {
+	if ( !m_queued_count ) {
+		return false;
+	}
+	const bool is_worker = s_current_pool == this;
+	const size_t own_index = is_worker
+		? s_current_worker_index
+		: m_workers_count;
+
+	// own queue first, newest tasks are most likely to be hot in cache
+	{
+		auto& queue = m_queues[ own_index ];
+		std::lock_guard< std::mutex > guard( queue.mutex );
+		if ( !queue.jobs.empty() ) {
+			job = std::move( queue.jobs.back() );
+			queue.jobs.pop_back();
+			m_queued_count--;
+			return true;
+		}
+	}
+
+	// steal oldest tasks from others ( shared queue included )
+	const size_t queues_count = m_queues.size();
+	for ( size_t i = 1 ; i < queues_count ; i++ ) {
+		auto& queue = m_queues[ ( own_index + i ) % queues_count ];
+		std::lock_guard< std::mutex > guard( queue.mutex );
+		if ( !queue.jobs.empty() ) {
+			job = std::move( queue.jobs.front() );
+			queue.jobs.pop_front();
+			m_queued_count--;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool ThreadPool::TryRunOne() {
+	job_t job;
+	if ( !TryPop( job ) ) {
+		return false;
+	}
+	job.group->Execute( job.task );
+	if ( !--job.group->m_pending ) {
+		// group may be destroyed by waiter right after this, so only pool is touched from now on
+		{
+			std::lock_guard< std::mutex > guard( m_idle_mutex );
+		}
+		m_idle_cv.notify_all();
+	}
+	return true;
+}
+
+void ThreadPool::WorkerLoop( const size_t worker_index ) {
+	s_current_pool = this;
+	s_current_worker_index = worker_index;
+	while ( m_is_running ) {
+		if ( !TryRunOne() ) {
+			std::unique_lock< std::mutex > lock( m_idle_mutex );
+			m_idle_cv.wait(
+				lock, [ this ]() {
+					return m_queued_count || !m_is_running;
+				}
+			);
+		}
+	}
+	s_current_pool = nullptr;
+}
+
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <exception>
+
+#include "Common.h"
+#include "MTTypes.h"
+
+namespace common {
+
+/**
+ * Engine-wide work-stealing job system.
+ *   each worker has own queue, takes newest tasks from it first and steals oldest tasks from other workers when it's empty
+ *   tasks submitted from non-worker threads ( MAIN, GAME, etc ) go to shared queue
+ *   threads waiting for results ( TaskGroup::Wait, ParallelFor ) process pending tasks, and only sleep when all remaining ones are taken by others
+ */
+CLASS( ThreadPool, Class )
+
+	typedef std::function< void() > task_t;
+	typedef std::function< void( const size_t from, const size_t to ) > range_task_t;
+
+	ThreadPool( const size_t workers_count );
+	~ThreadPool();
+
+	void Start();
+	void Stop();
+
+	const size_t GetWorkersCount() const;
+	// workers + thread that waits for results
+	const size_t GetConcurrency() const;
+
+	// fork/join, tasks that didn't start before cancellation are skipped
+	class TaskGroup {
+	public:
+		TaskGroup( ThreadPool* pool, MT_CANCELABLE );
+		~TaskGroup();
+
+		void Run( const task_t& task );
+		// blocks until all tasks are finished, rethrows first exception thrown by them
+		void Wait();
+
+	private:
+		friend class ThreadPool;
+
+		ThreadPool* const m_pool;
+		const mt_flag_t& m_canceled;
+
+		std::atomic< size_t > m_pending = 0;
+		std::mutex m_exception_mutex;
+		std::exception_ptr m_exception = nullptr;
+
+		void Execute( const task_t& task );
+	};
+
+	// splits [begin, end) into chunks and processes them in parallel, blocks until all are done
+	// chunk_size 0 means pick automatically
+	void ParallelFor( const size_t begin, const size_t end, const range_task_t& f, MT_CANCELABLE, size_t chunk_size = 0 );
+
+private:
+
+	struct job_t {
+		task_t task;
+		TaskGroup* group;
+	};
+
+	struct queue_t {
+		std::mutex mutex;
+		std::deque< job_t > jobs;
+	};
+
+	const size_t m_workers_count;
+	std::vector< std::thread > m_workers = {};
+	// one per worker, last one is shared by non-worker threads
+	std::vector< queue_t > m_queues;
+
+	std::atomic< bool > m_is_running = false;
+	std::atomic< size_t > m_queued_count = 0;
+	std::mutex m_idle_mutex;
+	std::condition_variable m_idle_cv;
+
+	void Push( job_t&& job );
+	bool TryPop( job_t& job );
+	bool TryRunOne();
+	void WorkerLoop( const size_t worker_index );
+
+};
+
+}
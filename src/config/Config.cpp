@@ -296,6 +296,57 @@ Config::Config( const std::string& path )
 			m_mainscript = value;
 		}
 	);
+	m_manager->AddRule(
+		"gc-slice", "MS", "Time budget of single garbage collector sweep slice, marking is not sliced (default: 2)", AH( this ) {
+			long int i = 0;
+			if ( !util::String::ParseInt( value, i ) || i < 1 || i > 1000 ) {
+				Error( "Invalid --gc-slice value specified! Expected number of milliseconds ( 1 to 1000 ), got: " + value );
+			}
+			m_gc_slice_ms = i;
+		}
+	);
+	m_manager->AddRule(
+		"download-chunk", "BYTES", "Size of world snapshot chunks sent to joining players when hosting (default: 16384)", AH( this ) {
+			long int i = 0;
+			if ( !util::String::ParseInt( value, i ) || i < 1024 || i > 32768 ) { // whole packet must fit into network::Network::BUFFER_SIZE
+				Error( "Invalid --download-chunk value specified! Expected number of bytes ( 1024 to 32768 ), got: " + value );
+			}
+			m_download_chunk_size = i;
+		}
+	);
+	m_manager->AddRule(
+		"download-window", "CHUNKS", "Number of world snapshot chunks requested at once when joining (default: 8)", AH( this ) {
+			long int i = 0;
+			if ( !util::String::ParseInt( value, i ) || i < 1 || i > 256 ) {
+				Error( "Invalid --download-window value specified! Expected number of chunks ( 1 to 256 ), got: " + value );
+			}
+			m_download_window = i;
+		}
+	);
+	m_manager->AddRule(
+		"download-compression", "Compress world snapshot chunks sent to joining players when hosting", AH( this ) {
+			m_launch_flags |= LF_DOWNLOAD_COMPRESSION;
+		}
+	);
+	m_manager->AddRule(
+		"gse-runner", "RUNNER", "Specify how scripts are executed: interpreter, vm (default: interpreter)", AH( this ) {
+			const std::unordered_map< std::string, gse_runner_t > values = {
+				{ "interpreter", GR_INTERPRETER },
+				{ "vm",          GR_VM },
+			};
+			const auto& it = values.find( value );
+			if ( it != values.end() ) {
+				m_gse_runner = it->second;
+			}
+			else {
+				std::string errmsg = "Invalid --gse-runner value specified! Possible choices:";
+				for ( const auto& it : values ) {
+					errmsg += " " + it.first;
+				}
+				Error( errmsg );
+			}
+		}
+	);
 
 #if defined( DEBUG ) || defined( FASTDEBUG )
 	m_manager->AddRule(
@@ -323,6 +374,37 @@ Config::Config( const std::string& path )
 			m_debug_flags |= DF_QUIET;
 		}
 	);
+	m_manager->AddRule(
+		"log-level", "LEVEL", "Skip debug logs below this level: debug, info, warning, error (default: debug)", AH( this ) {
+			const std::unordered_map< std::string, logger::level_t > values = {
+				{ "debug",   logger::LL_DEBUG },
+				{ "info",    logger::LL_INFO },
+				{ "warning", logger::LL_WARNING },
+				{ "error",   logger::LL_ERROR },
+			};
+			const auto& it = values.find( value );
+			if ( it != values.end() ) {
+				m_log_level = it->second;
+			}
+			else {
+				std::string errmsg = "Invalid --log-level value specified! Possible choices:";
+				for ( const auto& it : values ) {
+					errmsg += " " + it.first;
+				}
+				Error( errmsg );
+			}
+		}
+	);
+	m_manager->AddRule(
+		"log-bounded", "Drop debug logs instead of waiting when log buffers are full (for long-running servers)", AH( this ) {
+			m_debug_flags |= DF_LOG_BOUNDED;
+		}
+	);
+	m_manager->AddRule(
+		"log-sync", "Write debug logs immediately from logging thread (slower, but nothing is lost even on hard crash)", AH( this ) {
+			m_debug_flags |= DF_LOG_SYNC;
+		}
+	);
 	m_manager->AddRule(
 		"gse-prompt-js", "Open interactive JS prompt", AH( this ) {
 			m_debug_flags |= DF_GSE_ONLY | DF_GSE_PROMPT_JS;
@@ -342,6 +424,11 @@ Config::Config( const std::string& path )
 			m_gse_tests_script = value;
 		}
 	);
+	m_manager->AddRule(
+		"benchmarks", "Run performance benchmarks and exit", AH( this ) {
+			m_debug_flags |= DF_GSE_ONLY | DF_BENCHMARKS;
+		}
+	);
 	m_manager->AddRule(
 		"single-thread", "Run everything in same thread", AH( this ) {
 			m_debug_flags |= DF_SINGLE_THREAD;
@@ -489,6 +576,22 @@ const std::string& Config::GetMainScript() const {
 	return m_mainscript;
 }
 
+const uint16_t Config::GetGCSliceMs() const {
+	return m_gc_slice_ms;
+}
+
+const size_t Config::GetDownloadChunkSize() const {
+	return m_download_chunk_size;
+}
+
+const size_t Config::GetDownloadWindow() const {
+	return m_download_window;
+}
+
+const gse_runner_t Config::GetGSERunner() const {
+	return m_gse_runner;
+}
+
 #if defined( DEBUG ) || defined( FASTDEBUG )
 
 const bool Config::HasDebugFlag( const debug_flag_t flag ) const {
@@ -503,6 +606,10 @@ const std::string& Config::GetGSETestsScript() const {
 	return m_gse_tests_script;
 }
 
+const logger::level_t Config::GetLogLevel() const {
+	return m_log_level;
+}
+
 #endif
 
 }
@@ -48,6 +48,7 @@ CLASS2( Config, common::Module, gse::Wrappable )
 		LF_HOST = 1 << 18,
 		LF_JOIN = 1 << 19,
 		LF_LEGACY_UI = 1 << 20,
+		LF_DOWNLOAD_COMPRESSION = 1 << 21,
 	};
 
 #if defined( DEBUG ) || defined( FASTDEBUG )
@@ -63,6 +64,9 @@ CLASS2( Config, common::Module, gse::Wrappable )
 		DF_VERBOSE_GC = 1 << 7,
 		DF_NO_GC = 1 << 8,
 		DF_SINGLE_THREAD = 1 << 9,
+		DF_BENCHMARKS = 1 << 13,
+		DF_LOG_BOUNDED = 1 << 14,
+		DF_LOG_SYNC = 1 << 15,
 #ifdef DEBUG
 		DF_MAPDUMP = 1 << 10,
 		DF_MEMORYDEBUG = 1 << 11,
@@ -98,12 +102,17 @@ CLASS2( Config, common::Module, gse::Wrappable )
 	const std::vector< std::string >& GetModPaths() const;
 	const std::string& GetJoinAddress() const;
 	const std::string& GetMainScript() const;
+	const uint16_t GetGCSliceMs() const;
+	const size_t GetDownloadChunkSize() const;
+	const size_t GetDownloadWindow() const;
+	const gse_runner_t GetGSERunner() const;
 
 #if defined( DEBUG ) || defined( FASTDEBUG )
 
 	const bool HasDebugFlag( const debug_flag_t flag ) const;
 	const std::string& GetQuickstartMapDump() const;
 	const std::string& GetGSETestsScript() const;
+	const logger::level_t GetLogLevel() const;
 
 #endif
 
@@ -143,6 +152,10 @@ private:
 	std::vector< std::string > m_mod_paths = {};
 	std::string m_join_address = "";
 	std::string m_mainscript = "main";
+	uint16_t m_gc_slice_ms = 2;
+	size_t m_download_chunk_size = 16384;
+	size_t m_download_window = 8;
+	gse_runner_t m_gse_runner = GR_INTERPRETER;
 
 #if defined( DEBUG ) || defined( FASTDEBUG )
 
@@ -151,6 +164,8 @@ private:
 
 	std::string m_gse_tests_script = "";
 
+	logger::level_t m_log_level = logger::LL_DEBUG;
+
 #endif
 
 };
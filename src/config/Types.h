@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+
 namespace config {
 
 enum smac_type_t : uint8_t {
@@ -12,4 +14,11 @@ enum smac_type_t : uint8_t {
 
 };
 
+enum gse_runner_t : uint8_t {
+
+	GR_INTERPRETER,
+	GR_VM,
+
+};
+
 }
@@ -1,9 +1,11 @@
 #include <ctime>
 #include <thread>
+#include <algorithm>
 
 #include "Engine.h"
 #include "config/Config.h"
 #include "common/Thread.h"
+#include "common/ThreadPool.h"
 #include "error_handler/ErrorHandler.h"
 #include "logger/Logger.h"
 #include "resource/ResourceManager.h"
@@ -125,7 +127,7 @@ Engine::Engine(
 		NEW( t_gc, common::Thread, "GC" );
 		m_threads.push_back( t_gc );
 	}
-	t_gc->SetIPS( gc::GC::COLLECTS_PER_SECOND );
+	t_gc->SetIPS( gc::GC::ITERATIONS_PER_SECOND );
 	NEW( m_gc, gc::GC );
 	t_gc->AddModule( m_gc );
 
@@ -144,6 +146,15 @@ Engine::Engine(
 		t_game->SetIPS( g_max_fps );
 		t_game->AddModule( m_game );
 	}
+
+	// thread that waits for results participates too, so one less worker is enough to use all cores
+	size_t workers_count = std::max( std::thread::hardware_concurrency(), 1u ) - 1;
+#if defined( DEBUG ) || defined ( FASTDEBUG )
+	if ( m_config->HasDebugFlag( config::Config::DF_SINGLE_THREAD ) ) {
+		workers_count = 0;
+	}
+#endif
+	NEW( m_thread_pool, common::ThreadPool, workers_count );
 };
 
 Engine::~Engine() {
@@ -157,12 +168,14 @@ Engine::~Engine() {
 		}
 	}
 	DELETE( m_gc );
+	DELETE( m_thread_pool );
 }
 
 int Engine::Run() {
 	int result = EXIT_SUCCESS;
 
-	// TODO: dynamic threadpool
+	// long-running modules keep their own threads, heavy jobs are split between thread pool workers
+	m_thread_pool->Start();
 
 	for ( auto& thread : m_threads ) {
 		thread->T_Start();
@@ -212,9 +225,12 @@ int Engine::Run() {
 	}
 	catch ( std::runtime_error& e ) {
 		result = EXIT_FAILURE;
+		logger::FlushAll();
 		m_error_handler->HandleError( e );
 	}
 
+	m_thread_pool->Stop();
+
 	return result;
 }
 
@@ -229,4 +245,10 @@ void Engine::Log( const std::string& text ) const {
 	}
 }
 
+void Engine::Log( const logger::record_t& record ) const {
+	for ( const auto& logger : m_loggers ) {
+		logger->Log( record );
+	}
+}
+
 }
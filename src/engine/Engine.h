@@ -10,6 +10,7 @@ extern const size_t g_max_fps;
 
 namespace common {
 class Thread;
+class ThreadPool;
 }
 
 namespace config {
@@ -22,6 +23,7 @@ class ErrorHandler;
 
 namespace logger {
 class Logger;
+struct record_t;
 }
 
 namespace resource {
@@ -116,14 +118,18 @@ public:
 	ui_legacy::UI* GetUI() const { return m_ui; }
 	game::backend::Game* GetGame() const { return m_game; }
 	gc::GC* GetGC() const { return m_gc; }
+	common::ThreadPool* GetThreadPool() const { return m_thread_pool; }
 
+	const bool HasLoggers() const { return !m_loggers.empty(); }
 	void Log( const std::string& text ) const;
+	void Log( const logger::record_t& record ) const;
 
 protected:
 
 	std::atomic< bool > m_is_shutting_down = false;
 
 	std::vector< common::Thread* > m_threads = {};
+	common::ThreadPool* m_thread_pool = nullptr;
 
 	config::Config* const m_config = nullptr;
 	error_handler::ErrorHandler* m_error_handler = nullptr;
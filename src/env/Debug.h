@@ -30,7 +30,17 @@
     D( opengl_draw_calls ) \
     D( ui_elements_created ) \
     D( ui_elements_destroyed )\
-    D( ui_elements_active )
+    D( ui_elements_active ) \
+    D( gc_cycles ) \
+    D( gc_pauses ) \
+    D( gc_pause_us ) \
+    D( gc_max_pause_us ) \
+    D( gc_max_mark_us ) \
+    D( gc_objects_freed ) \
+    D( turns_processed ) \
+    D( turn_processing_us ) \
+    D( turn_unit_hooks_us ) \
+    D( turn_base_hooks_us )
 
 #define D( _stat ) struct { \
         ssize_t total = 0; \
@@ -82,6 +92,19 @@ extern debug_stats_t g_debug_stats;
 }
 #define DEBUG_STAT_INC( _stat ) DEBUG_STAT_CHANGE_BY( _stat, 1 )
 #define DEBUG_STAT_DEC( _stat ) DEBUG_STAT_CHANGE_BY( _stat, -1 )
+// raises stat to value if it's bigger ( current is max since last clear )
+#define DEBUG_STAT_MAX( _stat, _value ) { \
+    g_debug_stats._mutex.lock(); \
+    if ( !g_debug_stats._readonly ) { \
+        if ( _value > g_debug_stats._stat.total ) { \
+            g_debug_stats._stat.total = _value; \
+        } \
+        if ( _value > g_debug_stats._stat.current ) { \
+            g_debug_stats._stat.current = _value; \
+        } \
+    } \
+    g_debug_stats._mutex.unlock(); \
+}
 
 #define NEW( _var, _class, ... ) \
     _var = new _class( __VA_ARGS__ ); \
@@ -5,6 +5,7 @@
 #define DEBUG_STAT_CHANGE_BY( _stat, _by )
 #define DEBUG_STAT_INC( _stat )
 #define DEBUG_STAT_DEC( _stat )
+#define DEBUG_STAT_MAX( _stat, _value )
 
 #define NEW( _var, _class, ... ) _var = new _class( __VA_ARGS__ )
 #define NEWV( _var, _class, ... ) auto* _var = new _class( __VA_ARGS__ )
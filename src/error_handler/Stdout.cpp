@@ -4,6 +4,7 @@ namespace error_handler {
 
 void Stdout::HandleError( const std::runtime_error& e ) const {
 	printf( "FATAL ERROR: %s\n", e.what() );
+	fflush( stdout );
 	//exit( EXIT_FAILURE );
 	throw e;
 }
@@ -33,7 +33,8 @@ FrontendRequest::FrontendRequest( const FrontendRequest& other )
 			break;
 		}
 		case FR_UPDATE_TILES: {
-			NEW( data.update_tiles.tile_updates, tile_updates_t, *other.data.update_tiles.tile_updates );
+			data.update_tiles.count = other.data.update_tiles.count;
+			NEW( data.update_tiles.tile_deltas, tile_deltas_t, *other.data.update_tiles.tile_deltas );
 			break;
 		}
 		case FR_FACTION_DEFINE: {
@@ -117,7 +118,7 @@ FrontendRequest::~FrontendRequest() {
 			break;
 		}
 		case FR_UPDATE_TILES: {
-			DELETE( data.update_tiles.tile_updates );
+			DELETE( data.update_tiles.tile_deltas );
 			break;
 		}
 		case FR_FACTION_DEFINE: {
@@ -65,7 +65,8 @@ public:
 	};
 	typedef std::vector< slot_define_t > slot_defines_t;
 
-	typedef std::vector< std::pair< backend::map::tile::Tile*, backend::map::tile::TileState* > > tile_updates_t;
+	// concatenated map::tile::View deltas
+	typedef std::vector< uint8_t > tile_deltas_t;
 
 	struct base_pop_t {
 		std::string type;
@@ -87,7 +88,8 @@ public:
 			const std::string* message;
 		} global_message;
 		struct {
-			const tile_updates_t* tile_updates;
+			size_t count;
+			const tile_deltas_t* tile_deltas;
 		} update_tiles;
 		struct {
 			size_t tile_x;
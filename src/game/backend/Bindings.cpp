@@ -48,7 +48,7 @@ void Bindings::AddToContext( gc::Space* const gc_space, gse::context::Context* c
 		const auto& main = arguments.at(0);
 		N_CHECKARG( main, 0, Callable );
 		m_main_callables.push_back( main );
-		return VALUE( gse::value::Undefined );
+		return VALUE_SHARED( gse::value::Undefined );
 	} ), ep );
 }
 
@@ -89,6 +89,15 @@ gse::context::Context* const Bindings::GetContext() const {
 }
 
 gse::Value* const Bindings::Trigger( gse::GCWrappable* object, const std::string& event, const f_args_t& f_args ) {
+	return TriggerImpl( object, event, f_args );
+}
+
+gse::Value* const Bindings::Trigger( gse::GCWrappable* object, const gse::value::atom_t event, const f_args_t& f_args ) {
+	return TriggerImpl( object, event, f_args );
+}
+
+template< typename EVENT_T >
+gse::Value* const Bindings::TriggerImpl( gse::GCWrappable* object, const EVENT_T& event, const f_args_t& f_args ) {
 	CHECKACCUM( m_gse->GetGCSpace() );
 	auto* gc_space = m_gse->GetGCSpace();
 	gse::Value* result = nullptr;
@@ -104,7 +113,7 @@ gse::Value* const Bindings::Trigger( gse::GCWrappable* object, const std::string
 		}
 		if ( !result ) {
 			// return undefined by default
-			return VALUEEXT( gse::value::Undefined, gc_space );
+			return gse::value::Undefined::Shared( gc_space );
 		}
 	}
 	catch ( const gse::Exception& e ) {
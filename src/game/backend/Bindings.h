@@ -43,6 +43,7 @@ public:
 
 	typedef std::function< void( GSE_CALLABLE, gse::value::object_properties_t& args ) > f_args_t;
 	gse::Value* const Trigger( gse::GCWrappable* object, const std::string& event, const f_args_t& f_args );
+	gse::Value* const Trigger( gse::GCWrappable* object, const gse::value::atom_t event, const f_args_t& f_args );
 
 	State* GetState() const;
 	Game* GetGame( GSE_CALLABLE ) const;
@@ -58,6 +59,9 @@ private:
 
 	const std::string m_entry_script;
 
+	template< typename EVENT_T >
+	gse::Value* const TriggerImpl( gse::GCWrappable* object, const EVENT_T& event, const f_args_t& f_args );
+
 	gse::GSE* m_gse = nullptr;
 	gse::context::GlobalContext* m_gse_context = nullptr;
 };
@@ -1,6 +1,9 @@
 #include "Game.h"
 
+#include <algorithm>
+
 #include "engine/Engine.h"
+#include "common/ThreadPool.h"
 #include "types/Exception.h"
 #include "types/texture/Texture.h"
 #include "types/mesh/Render.h"
@@ -24,6 +27,7 @@
 #include "gse/value/Int.h"
 #include "gse/value/Undefined.h"
 #include "gse/value/Array.h"
+#include "gse/value/Shape.h"
 #include "ui_legacy/UI.h"
 #include "map/tile/TileManager.h"
 #include "map/tile/Tiles.h"
@@ -43,6 +47,7 @@
 #include "gc/Space.h"
 #include "game/backend/event/Event.h"
 #include "game/backend/event/EventHandler.h"
+#include "game/backend/turn/Pipeline.h"
 #include "gse/value/Bool.h"
 
 namespace game {
@@ -239,7 +244,7 @@ void Game::Iterate() {
 					) {
 					MTModule::Log( (std::string)"Saving map dump to " + config->GetDebugPath() + map::s_consts.debug.lastdump_filename );
 					SetLoaderText( "Saving dump" );
-					util::FS::WriteFile( config->GetDebugPath() + map::s_consts.debug.lastdump_filename, m_map->Serialize().ToString() );
+					util::FS::WriteFile( config->GetDebugPath() + map::s_consts.debug.lastdump_filename, m_map->Serialize().ToStringView() );
 				}
 #endif
 
@@ -263,11 +268,11 @@ void Game::Iterate() {
 				m_response_map_data->sprites.instances = &m_map->m_sprite_instances;
 
 				m_state->WithGSE( this, [ this ]( GSE_CALLABLE ) {
-					for ( auto& tile : m_map->m_tiles->GetVector( m_init_cancel ) ) {
-						UpdateYields( GSE_CALL, tile );
-					}
+					UpdateYields( GSE_CALL, m_map->m_tiles->GetVector( m_init_cancel ) );
 				});
 
+				InitTileViews( m_init_cancel );
+
 				m_response_map_data->tiles = m_map->GetTilesPtr()->GetTilesPtr();
 				m_response_map_data->tile_states = m_map->GetMapState()->GetTileStatesPtr();
 
@@ -568,6 +573,7 @@ void Game::Iterate() {
 	if ( m_bm ) {
 		m_bm->PushUpdates();
 	}
+	PushTileUpdates();
 	if ( m_tm ) {
 		m_tm->ProcessTileLockRequests();
 	}
@@ -663,13 +669,13 @@ WRAPIMPL_BEGIN( Game )
 		{
 			"is_master",
 			NATIVE_CALL( this ) {
-				return VALUE( gse::value::Bool, , m_state->IsMaster() );
+				return VALUE_SHARED( gse::value::Bool, , m_state->IsMaster() );
 			} ),
 		},
 		{
 			"is_slave",
 			NATIVE_CALL( this ) {
-			return VALUE( gse::value::Bool, , m_state->IsSlave() );
+			return VALUE_SHARED( gse::value::Bool, , m_state->IsSlave() );
 		} ),
 		},
 		{
@@ -682,7 +688,7 @@ WRAPIMPL_BEGIN( Game )
 				N_EXPECT_ARGS( 1 );
 				N_GETVALUE( text, 0, String );
 				Message( text );
-				return VALUE( gse::value::Undefined );
+				return VALUE_SHARED( gse::value::Undefined );
 			})
 		},
 		{
@@ -739,7 +745,7 @@ WRAPIMPL_BEGIN( Game )
 
 				const auto& slot = slots.at( slot_id );
 				ASSERT( slot.GetState() != slot::Slot::SS_PLAYER || slot.GetPlayer(), "player is null" );
-				return VALUE( gse::value::Bool,,
+				return VALUE_SHARED( gse::value::Bool,,
 					slot.GetState() == slot::Slot::SS_PLAYER
 						? slot.GetPlayer()->IsTurnCompleted()
 						: true // ai has always turn completed during turns of players
@@ -768,7 +774,7 @@ WRAPIMPL_BEGIN( Game )
 				ASSERT( !slot.GetPlayer()->IsTurnCompleted(), "player turn already completed" );
 				CompleteTurn( GSE_CALL, slot_id );
 
-				return VALUE( gse::value::Undefined );
+				return VALUE_SHARED( gse::value::Undefined );
 			} )
 		},
 		{
@@ -793,7 +799,7 @@ WRAPIMPL_BEGIN( Game )
 				ASSERT( slot.GetPlayer()->IsTurnCompleted(), "player turn not completed" );
 				UncompleteTurn( slot_id );
 
-				return VALUE( gse::value::Undefined );
+				return VALUE_SHARED( gse::value::Undefined );
 			} )
 		},
 		{
@@ -807,7 +813,33 @@ WRAPIMPL_BEGIN( Game )
 
 				AdvanceTurn( turn_id );
 
-				return VALUE( gse::value::Undefined );
+				return VALUE_SHARED( gse::value::Undefined );
+			} )
+		},
+		{
+			"get_turn_checksum",
+			NATIVE_CALL( this ) {
+				N_EXPECT_ARGS( 0 );
+
+				return VALUE( gse::value::Int,, m_turn_checksum );
+			} )
+		},
+		{
+			"verify_turn_checksum",
+			NATIVE_CALL( this ) {
+
+				N_EXPECT_ARGS( 2 );
+				N_GETVALUE( slot_id, 0, Int );
+				N_GETVALUE( checksum, 1, Int );
+
+				if ( !m_state->IsMaster() ) {
+					GSE_ERROR( gse::EC.GAME_ERROR, "Only host can verify turn checksums" );
+				}
+				if ( m_verified_turn_checksum_slots.find( slot_id ) != m_verified_turn_checksum_slots.end() ) {
+					GSE_ERROR( gse::EC.GAME_ERROR, "Turn checksum of player " + std::to_string( slot_id ) + " was already verified" );
+				}
+
+				return VALUE_SHARED( gse::value::Bool,, VerifyTurnChecksum( slot_id, checksum ) );
 			} )
 		},
 		{
@@ -864,7 +896,7 @@ WRAPIMPL_BEGIN( Game )
 						) }
 					);
 				}
-				return VALUE( gse::value::Undefined );
+				return VALUE_SHARED( gse::value::Undefined );
 			} )
 		},
 		{
@@ -884,7 +916,7 @@ WRAPIMPL_BEGIN( Game )
 					GSE_ERROR( gse::EC.GAME_ERROR, "Invalid event data - expected: primitive object, found: " + args->object_class );
 				}
 				AddEvent( new event::Event( this, event::Event::ES_LOCAL, m_slot_num, GSE_CALL, name, args->value ) );
-				return VALUE( gse::value::Undefined );
+				return VALUE_SHARED( gse::value::Undefined );
 			} )
 		},
 		{
@@ -893,7 +925,7 @@ WRAPIMPL_BEGIN( Game )
 				N_EXPECT_ARGS( 0 );
 				return m_state
 					? m_state->GetFM()->Wrap( GSE_CALL, true )
-					: VALUE( gse::value::Undefined )
+					: VALUE_SHARED( gse::value::Undefined )
 					;
 			} )
 		},
@@ -901,7 +933,7 @@ WRAPIMPL_BEGIN( Game )
 			"is_started",
 			NATIVE_CALL( this ) {
 				N_EXPECT_ARGS( 0 );
-				return VALUE( gse::value::Bool,, m_game_state != GS_NONE );
+				return VALUE_SHARED( gse::value::Bool,, m_game_state != GS_NONE );
 			} )
 		},
 	};
@@ -950,7 +982,7 @@ WRAPIMPL_END_PTR()
 
 UNWRAPIMPL_PTR( Game )
 
-void Game::GetReachableObjects( std::unordered_set< Object* >& reachable_objects ) {
+void Game::GetReachableObjects( gc::MarkStack& reachable_objects ) {
 	gse::GCWrappable::GetReachableObjects( reachable_objects );
 
 	GC_DEBUG_BEGIN( "Game" );
@@ -1103,9 +1135,32 @@ const MT_Response Game::ProcessRequest( const MT_Request& request, MT_CANCELABLE
 
 			m_map_editor->SelectTool( request.data.edit_map.tool );
 			m_map_editor->SelectBrush( request.data.edit_map.brush );
-			const auto tiles_to_reload = m_map_editor->Draw( m_map->GetTile( request.data.edit_map.tile_x, request.data.edit_map.tile_y ), request.data.edit_map.draw_mode );
+			const auto dirty_tiles = m_map_editor->Draw( m_map->GetTile( request.data.edit_map.tile_x, request.data.edit_map.tile_y ), request.data.edit_map.draw_mode );
+
+			if ( !dirty_tiles.empty() ) {
+
+				// recompute only what depends on changed attributes
+				std::vector< map::tile::Tile* > yields_tiles = {};
+				std::vector< map::tile::Tile* > textures_tiles = {};
+				std::vector< map::tile::Tile* > sprites_tiles = {};
+				for ( auto* tile : dirty_tiles ) {
+					if ( tile->dirty & map::tile::ATTRIBUTE_YIELDS ) {
+						yields_tiles.push_back( tile );
+					}
+					if ( tile->dirty & map::tile::ATTRIBUTE_TEXTURES ) {
+						textures_tiles.push_back( tile ); // sprites are reloaded with rest of tile
+					}
+					else if ( tile->dirty & map::tile::ATTRIBUTE_SPRITES ) {
+						sprites_tiles.push_back( tile );
+					}
+				}
+
+				if ( !yields_tiles.empty() ) {
+					m_state->WithGSE( this, [ this, yields_tiles ]( GSE_CALLABLE ) {
+						UpdateYields( GSE_CALL, yields_tiles );
+					});
+				}
 
-			if ( !tiles_to_reload.empty() ) {
 				auto* graphics = g_engine->GetGraphics();
 
 				m_map->m_sprite_actors_to_add.clear();
@@ -1113,10 +1168,19 @@ const MT_Response Game::ProcessRequest( const MT_Request& request, MT_CANCELABLE
 				m_map->m_sprite_instances_to_add.clear();
 
 				graphics->Lock(); // needed to avoid tearing artifacts
-				m_map->LoadTiles( tiles_to_reload, MT_C );
-				m_map->FixNormals( tiles_to_reload, MT_C );
+				if ( !textures_tiles.empty() ) {
+					m_map->LoadTiles( textures_tiles, MT_C );
+					m_map->FixNormals( textures_tiles, MT_C );
+				}
+				if ( !sprites_tiles.empty() ) {
+					m_map->LoadSprites( sprites_tiles, MT_C );
+				}
 				graphics->Unlock();
 
+				for ( auto* tile : dirty_tiles ) {
+					tile->Validate( tile->dirty );
+				}
+
 				typedef std::unordered_map< std::string, map::sprite_actor_t > t1; // can't use comma in macro below
 				NEW( response.data.edit_map.sprites.actors_to_add, t1 );
 				*response.data.edit_map.sprites.actors_to_add = m_map->m_sprite_actors_to_add;
@@ -1131,19 +1195,7 @@ const MT_Response Game::ProcessRequest( const MT_Request& request, MT_CANCELABLE
 
 				// TODO: remove invalid units and terraforming
 
-				auto fr = FrontendRequest( FrontendRequest::FR_UPDATE_TILES );
-				NEWV( tile_updates, FrontendRequest::tile_updates_t );
-				tile_updates->reserve( tiles_to_reload.size() );
-				for ( const auto& tile : tiles_to_reload ) {
-					tile_updates->push_back(
-						{
-							tile,
-							m_map->GetTileState( tile )
-						}
-					);
-				}
-				fr.data.update_tiles.tile_updates = tile_updates;
-				AddFrontendRequest( fr );
+				QueueTileUpdates( dirty_tiles );
 			}
 
 			response.result = R_SUCCESS;
@@ -1374,9 +1426,15 @@ void Game::UncompleteTurn( const size_t slot_num ) {
 
 void Game::AdvanceTurn( const size_t turn_id ) {
 	auto* gc_space = GetGCSpace();
+	if ( m_state->m_connection && m_current_turn.GetId() ) {
+		// every slot hashes state at same point, slaves send it to master afterwards ( see turn_checksum event )
+		FinalizeTurn();
+	}
 	m_current_turn.AdvanceTurn( turn_id );
 	m_is_turn_complete = false;
 	MTModule::Log( "Turn started: " + std::to_string( turn_id ) );
+	MTModule::Log( "Script wrappers created during previous turn: " + std::to_string( gse::Wrappable::GetWrappersCreated() ) );
+	gse::Wrappable::ResetWrappersCreated();
 
 	{
 		auto fr = FrontendRequest( FrontendRequest::FR_TURN_ADVANCE );
@@ -1384,44 +1442,107 @@ void Game::AdvanceTurn( const size_t turn_id ) {
 		AddFrontendRequest( fr );
 	}
 
-	m_state->WithGSE( this, [ this ]( GSE_CALLABLE ) {
-		for ( auto& it : m_um->GetUnits() ) {
-			auto* unit = it.second;
-			m_state->TriggerObject(
-				m_um, "unit_turn", ARGS_F( &unit ) {
-					{
-						"unit",
-						unit->Wrap( GSE_CALL, true )
-					},
-				}; }
-			);
-			unit->m_moved_this_turn = false;
-			m_um->RefreshUnit( GSE_CALL, unit );
-		}
+	// script hooks run serially in id order because all scripts share one gc space and can touch any game object,
+	// and every hook must see objects before it already reset and refreshed
+	std::vector< size_t > unit_ids = {};
+	std::vector< size_t > base_ids = {};
+	turn::Pipeline pipeline;
 
-		for ( auto& it : m_bm->GetBases() ) {
-			auto* base = it.second;
-			m_state->TriggerObject(
-				m_bm, "base_turn", ARGS_F( &base ) {
-					{
-						"base",
-						base->Wrap( GSE_CALL, true )
-					},
-				}; }
-			);
-			m_bm->RefreshBase( base );
-		}
+	m_state->WithGSE( this, [ this, &pipeline, &unit_ids, &base_ids ]( GSE_CALLABLE ) {
+
+		pipeline.AddStage(
+			"collect", [ this, &unit_ids, &base_ids ]() {
+				unit_ids = m_um->GetUnitIds();
+				base_ids.reserve( m_bm->GetBases().size() );
+				for ( const auto& it : m_bm->GetBases() ) {
+					base_ids.push_back( it.first );
+				}
+			}
+		);
+
+		pipeline.AddStage(
+			"unit hooks", [ this, &unit_ids, &gc_space, &ctx, &si, &ep ]() {
+				// interned once, so that per-unit triggers don't look up event name
+				static const auto s_unit_turn = gse::value::Shape::Intern( "unit_turn" );
+				const bool has_handlers = m_um->HasHandlers( s_unit_turn );
+				for ( const auto unit_id : unit_ids ) {
+					auto* unit = m_um->GetUnit( unit_id );
+					if ( !unit ) {
+						continue; // despawned by handler of other unit
+					}
+					if ( has_handlers ) {
+						m_state->TriggerObject(
+							m_um, s_unit_turn, ARGS_F( &unit ) {
+								{
+									"unit",
+									unit->Wrap( GSE_CALL, true )
+								},
+							}; }
+						);
+						// handler may have despawned unit itself
+						unit = m_um->GetUnit( unit_id );
+						if ( !unit ) {
+							continue;
+						}
+					}
+					// next hooks must see this unit already reset and refreshed, same as before
+					unit->m_moved_this_turn = false;
+					m_um->RefreshUnit( GSE_CALL, unit );
+				}
+			}
+		);
+
+		pipeline.AddStage(
+			"base hooks", [ this, &base_ids ]() {
+				static const auto s_base_turn = gse::value::Shape::Intern( "base_turn" );
+				const bool has_handlers = m_bm->HasHandlers( s_base_turn );
+				for ( const auto base_id : base_ids ) {
+					auto* base = m_bm->GetBase( base_id );
+					if ( !base ) {
+						continue; // despawned by handler of other base
+					}
+					if ( has_handlers ) {
+						m_state->TriggerObject(
+							m_bm, s_base_turn, ARGS_F( &base ) {
+								{
+									"base",
+									base->Wrap( GSE_CALL, true )
+								},
+							}; }
+						);
+						// handler may have despawned base itself
+						base = m_bm->GetBase( base_id );
+						if ( !base ) {
+							continue;
+						}
+					}
+					m_bm->RefreshBase( base );
+				}
+			}
+		);
 
 		if ( m_state->IsMaster() ) {
-			m_state->TriggerObject( this, "turn", ARGS_F( this ) {
-				{
-					"game",
-					Wrap( GSE_CALL )
+			pipeline.AddStage(
+				"turn hook", [ this ]() {
+					m_state->TriggerObject( this, "turn", ARGS_F( this ) {
+						{
+							"game",
+							Wrap( GSE_CALL )
+						}
+					}; } );
 				}
-			}; } );
+			);
 		}
+
+		pipeline.Run();
 	});
 
+	MTModule::Log( "Turn processed in " + std::to_string( pipeline.GetTotalTime() ) + "us ( " + pipeline.GetTimingsString() + " )" );
+	DEBUG_STAT_INC( turns_processed );
+	DEBUG_STAT_CHANGE_BY( turn_processing_us, pipeline.GetTotalTime() );
+	DEBUG_STAT_CHANGE_BY( turn_unit_hooks_us, pipeline.GetTime( "unit hooks" ) );
+	DEBUG_STAT_CHANGE_BY( turn_base_hooks_us, pipeline.GetTime( "base hooks" ) );
+
 	for ( const auto& slot : m_state->m_slots->GetSlots() ) {
 		if ( slot.GetState() == slot::Slot::SS_PLAYER ) {
 			slot.GetPlayer()->UncompleteTurn();
@@ -1438,12 +1559,23 @@ void Game::AdvanceTurn( const size_t turn_id ) {
 
 }
 
-void Game::GlobalFinalizeTurn( GSE_CALLABLE ) {
-	ASSERT( m_state->IsMaster(), "not master" );
-	ASSERT( m_verified_turn_checksum_slots.empty(), "turn finalization slots not empty" );
+void Game::FinalizeTurn() {
+	types::Buffer buf;
+	SerializeState( buf );
+	m_turn_checksum = m_current_turn.FinalizeAndChecksum( buf );
+	m_verified_turn_checksum_slots.clear();
 	MTModule::Log( "Finalizing turn ( checksum = " + std::to_string( m_turn_checksum ) + " )" );
-	THROW( "TODO: GLOBAL FINALIZE TURN");
-	//AddEvent( GSE_CALL, new event::FinalizeTurn( m_slot_num ) );
+}
+
+const bool Game::VerifyTurnChecksum( const size_t slot_num, const util::crc32::crc_t checksum ) {
+	ASSERT( m_state->IsMaster(), "not master" );
+	if ( !IsTurnChecksumValid( checksum ) ) {
+		MTModule::Log( "WARNING: turn checksum mismatch for slot " + std::to_string( slot_num ) + " ( " + std::to_string( checksum ) + " != " + std::to_string( m_turn_checksum ) + " ), game state is out of sync" );
+		return false;
+	}
+	m_verified_turn_checksum_slots.insert( slot_num );
+	MTModule::Log( "Turn checksum verified for slot " + std::to_string( slot_num ) );
+	return true;
 }
 
 static size_t s_turn_id = 0;
@@ -1463,6 +1595,24 @@ void Game::GlobalAdvanceTurn( GSE_CALLABLE ) {
 	});
 }
 
+void Game::SerializeState( types::Buffer& buf ) const {
+
+	// map
+	m_map->SaveToBuffer( buf );
+
+	// resources
+	buf.WriteNested( [ this ]( types::Buffer& b ) { m_rm->Serialize( b ); } );
+
+	// units
+	buf.WriteNested( [ this ]( types::Buffer& b ) { m_um->Serialize( b ); } );
+
+	// bases
+	buf.WriteNested( [ this ]( types::Buffer& b ) { m_bm->Serialize( b ); } );
+
+	// animations
+	buf.WriteNested( [ this ]( types::Buffer& b ) { m_am->Serialize( b ); } );
+}
+
 faction::Faction* Game::GetFaction( const std::string& id ) const {
 	auto* faction = m_state->GetFM()->Get( id ); // TODO: store factions in Game itself?
 	ASSERT( faction, "faction not found: " + id );
@@ -1510,14 +1660,66 @@ const types::Vec3 Game::GetTileRenderCoords( const map::tile::Tile* tile ) {
 	};
 }
 
-void Game::UpdateYields( GSE_CALLABLE, map::tile::Tile* tile ) const {
-	tile->yields = m_rm->GetYields(
-		GSE_CALL,
-		tile,
-		m_slot
+void Game::UpdateYields( GSE_CALLABLE, const std::vector< map::tile::Tile* >& tiles ) const {
+	m_rm->UpdateYields( GSE_CALL, tiles, m_slot );
+}
+
+void Game::InitTileViews( MT_CANCELABLE ) {
+	const auto& tiles = *m_map->GetTilesPtr()->GetTilesPtr();
+	const auto& tile_states = *m_map->GetMapState()->GetTileStatesPtr();
+	ASSERT( tiles.size() == tile_states.size(), "tiles and tile states count mismatch" );
+	m_tile_views.clear();
+	m_tile_views.resize( tiles.size() );
+	m_tile_updates.clear();
+	g_engine->GetThreadPool()->ParallelFor(
+		0, tiles.size(), [ this, &tiles, &tile_states ]( const size_t from, const size_t to ) {
+			for ( size_t i = from ; i < to ; i++ ) {
+				m_tile_views[ i ].Set( &tiles[ i ], &tile_states[ i ] );
+			}
+		}, MT_C
 	);
 }
 
+void Game::QueueTileUpdates( const std::vector< map::tile::Tile* >& tiles ) {
+	m_tile_updates.insert( m_tile_updates.end(), tiles.begin(), tiles.end() );
+}
+
+void Game::PushTileUpdates() {
+	if ( m_tile_updates.empty() ) {
+		return;
+	}
+	ASSERT( m_map, "map not set" );
+	const auto* first_tile = m_map->GetTilesPtr()->GetTilesPtr()->data();
+
+	// same order as tiles in map
+	std::sort( m_tile_updates.begin(), m_tile_updates.end() );
+	m_tile_updates.erase( std::unique( m_tile_updates.begin(), m_tile_updates.end() ), m_tile_updates.end() );
+
+	NEWV( tile_deltas, FrontendRequest::tile_deltas_t );
+	size_t count = 0;
+	map::tile::View view;
+	for ( const auto& tile : m_tile_updates ) {
+		auto& sent_view = m_tile_views.at( tile - first_tile );
+		view.Set( tile, m_map->GetTileState( tile ) );
+		const auto fields = view.Compare( sent_view );
+		if ( fields ) {
+			view.WriteDelta( *tile_deltas, tile->coord, fields );
+			std::swap( sent_view, view );
+			count++;
+		}
+	}
+	m_tile_updates.clear();
+
+	if ( !count ) {
+		DELETE( tile_deltas );
+		return;
+	}
+	auto fr = FrontendRequest( FrontendRequest::FR_UPDATE_TILES );
+	fr.data.update_tiles.count = count;
+	fr.data.update_tiles.tile_deltas = tile_deltas;
+	AddFrontendRequest( fr );
+}
+
 void Game::WithRW( const std::function< void() >& f ) {
 	m_rw_counter++;
 	f();
@@ -1723,36 +1925,7 @@ void Game::InitGame( MT_Response& response, MT_CANCELABLE ) {
 					MTModule::Log( "Preparing snapshot for download" );
 					types::Buffer buf;
 
-					// map
-					m_map->SaveToBuffer( buf );
-
-					// resources
-					{
-						types::Buffer b;
-						m_rm->Serialize( b );
-						buf.WriteString( b.ToString() );
-					}
-
-					// units
-					{
-						types::Buffer b;
-						m_um->Serialize( b );
-						buf.WriteString( b.ToString() );
-					}
-
-					// bases
-					{
-						types::Buffer b;
-						m_bm->Serialize( b );
-						buf.WriteString( b.ToString() );
-					}
-
-					// animations
-					{
-						types::Buffer b;
-						m_am->Serialize( b );
-						buf.WriteString( b.ToString() );
-					}
+					SerializeState( buf );
 
 					// send turn info
 					MTModule::Log( "Sending turn ID: " + std::to_string( s_turn_id ) );
@@ -1927,32 +2100,32 @@ void Game::InitGame( MT_Response& response, MT_CANCELABLE ) {
 							auto buf = types::Buffer( serialized_snapshot );
 
 							// map
-							auto b = types::Buffer( buf.ReadString() );
+							auto b = buf.ReadNested();
 							NEW( m_map, map::Map, this );
 							const auto ec = m_map->LoadFromBuffer( b );
 							if ( ec == map::Map::EC_NONE ) {
 
 								// resources
 								{
-									auto ub = types::Buffer( buf.ReadString() );
+									auto ub = buf.ReadNested();
 									m_rm->Deserialize( ub );
 								}
 
 								// units
 								{
-									auto ub = types::Buffer( buf.ReadString() );
+									auto ub = buf.ReadNested();
 									m_um->Deserialize( GSE_CALL, ub );
 								}
 
 								// bases
 								{
-									auto bb = types::Buffer( buf.ReadString() );
+									auto bb = buf.ReadNested();
 									m_bm->Deserialize( GSE_CALL, bb );
 								}
 
 								// animations
 								{
-									auto ab = types::Buffer( buf.ReadString() );
+									auto ab = buf.ReadNested();
 									m_am->Deserialize( ab );
 								}
 
@@ -2040,6 +2213,8 @@ void Game::ResetGame() {
 		DELETE( m_map );
 		m_map = nullptr;
 	}
+	m_tile_views.clear();
+	m_tile_updates.clear();
 
 	ASSERT( m_pending_frontend_requests, "pending events not set" );
 	m_pending_frontend_requests->clear();
@@ -2060,14 +2235,7 @@ void Game::ResetGame() {
 
 void Game::CheckTurnComplete() {
 
-	bool is_turn_complete = true;
-
-	for ( const auto& unit : m_um->GetUnits() ) {
-		if ( unit.second->m_owner == m_slot && unit.second->HasMovesLeft() ) {
-			is_turn_complete = false;
-			break;
-		}
-	}
+	const bool is_turn_complete = !m_um->HasUnitsWithMovesLeft( m_slot );
 
 	if ( m_is_turn_complete != is_turn_complete ) {
 		m_is_turn_complete = is_turn_complete;
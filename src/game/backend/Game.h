@@ -22,6 +22,7 @@
 // TODO: remove those
 #include "game/backend/map/tile/Tile.h"
 #include "game/backend/map/tile/TileState.h"
+#include "game/backend/map/tile/View.h"
 
 class GLSMAC;
 
@@ -340,7 +341,7 @@ CLASS2( Game, MTModule, gse::GCWrappable )
 
 	WRAPDEFS_PTR( Game )
 
-	void GetReachableObjects( std::unordered_set< Object* >& reachable_objects ) override;
+	void GetReachableObjects( gc::MarkStack& reachable_objects ) override;
 
 protected:
 
@@ -363,9 +364,13 @@ public:
 	void UncompleteTurn( const size_t slot_num );
 	void AdvanceTurn( const size_t turn_id );
 
-	void GlobalFinalizeTurn( GSE_CALLABLE );
 	void GlobalAdvanceTurn( GSE_CALLABLE );
 
+	// calculates checksum of current game state, it's done by every slot when turn advances in multiplayer
+	void FinalizeTurn();
+	// master compares checksum sent by slave with own one, returns false on desync
+	const bool VerifyTurnChecksum( const size_t slot_num, const util::crc32::crc_t checksum );
+
 	faction::Faction* GetFaction( const std::string& id ) const;
 
 	map::tile::TileManager* GetTM() const;
@@ -384,7 +389,15 @@ private:
 
 	const types::Vec3 GetTileRenderCoords( const map::tile::Tile* tile );
 
-	void UpdateYields( GSE_CALLABLE, map::tile::Tile* tile ) const;
+	void UpdateYields( GSE_CALLABLE, const std::vector< map::tile::Tile* >& tiles ) const;
+
+	// what frontend currently knows about every tile ( same order as map tiles ), only changes since then are sent
+	std::vector< map::tile::View > m_tile_views = {};
+	// repeated updates of same tile are merged until next push
+	std::vector< map::tile::Tile* > m_tile_updates = {};
+	void InitTileViews( MT_CANCELABLE );
+	void QueueTileUpdates( const std::vector< map::tile::Tile* >& tiles );
+	void PushTileUpdates();
 
 	map::tile::TileManager* m_tm = nullptr;
 	resource::ResourceManager* m_rm = nullptr;
@@ -415,6 +428,9 @@ private:
 
 	std::vector< FrontendRequest >* m_pending_frontend_requests = nullptr;
 
+	// map and managers, same data is sent to clients as snapshot and hashed for turn checksum
+	void SerializeState( types::Buffer& buf ) const;
+
 	void InitGame( MT_Response& response, MT_CANCELABLE );
 	void ResetGame();
 
@@ -104,32 +104,25 @@ void Player::UncompleteTurn() {
 	m_is_turn_completed = false;
 }
 
-WRAPIMPL_BEGIN( Player )
-	auto* const game = g_engine->GetGame();
+WRAPIMPL_CACHED_BEGIN( Player )
+	WRAPIMPL_LAZY_BEGIN
+		WRAPIMPL_LAZY_SHARED( "id", Int, self->m_slotnum )
+		WRAPIMPL_LAZY( "type", String, "human" )
+		WRAPIMPL_LAZY( "name", String, self->m_name )
+		WRAPIMPL_LAZY_SHARED( "is_master", Bool, self->m_role == PR_SINGLE || self->m_role == PR_HOST )
+	WRAPIMPL_LAZY_END
 	WRAPIMPL_PROPS
-			{
-				"id",
-				VALUE( gse::value::Int, , m_slotnum )
-			},
-			{
-				"type",
-				VALUE( gse::value::String, , "human" )
-			},
-			{
-				"name",
-				VALUE( gse::value::String, , m_name )
-			},
 			{
 				"is_ready",
 				NATIVE_CALL( this ) {
 					N_EXPECT_ARGS( 0 );
-					return VALUE( gse::value::Bool, , m_slot->HasPlayerFlag( ::game::backend::slot::PF_READY ) );
+					return VALUE_SHARED( gse::value::Bool, , m_slot->HasPlayerFlag( ::game::backend::slot::PF_READY ) );
 				} )
 			},
 			{
 				"set_ready",
-				NATIVE_CALL( this, game ) {
-
+				NATIVE_CALL( this ) {
+					auto* const game = g_engine->GetGame();
 					game->CheckRW( GSE_CALL );
 
 					N_EXPECT_ARGS( 1 );
@@ -142,7 +135,7 @@ WRAPIMPL_BEGIN( Player )
 						m_slot->UnsetPlayerFlag( ::game::backend::slot::PF_READY );
 					}
 
-					return VALUE( gse::value::Undefined );
+					return VALUE_SHARED( gse::value::Undefined );
 				} )
 			},
 			{
@@ -151,13 +144,13 @@ WRAPIMPL_BEGIN( Player )
 					N_EXPECT_ARGS( 0 );
 					return m_faction
 						? m_faction->Wrap( GSE_CALL, gc_space )
-						: VALUE( gse::value::Undefined );
+						: VALUE_SHARED( gse::value::Undefined );
 				} )
 			},
 			{
 				"set_faction_by_id",
-				NATIVE_CALL( this, game ) {
-
+				NATIVE_CALL( this ) {
+					auto* const game = g_engine->GetGame();
 					game->CheckRW( GSE_CALL );
 
 					N_EXPECT_ARGS( 1 );
@@ -171,27 +164,23 @@ WRAPIMPL_BEGIN( Player )
 					}
 					m_faction = faction;
 
-					return VALUE( gse::value::Undefined );
+					return VALUE_SHARED( gse::value::Undefined );
 				} )
 			},
 			{
 				"unset_faction",
-				NATIVE_CALL( this, game ) {
-
+				NATIVE_CALL( this ) {
+					auto* const game = g_engine->GetGame();
 					game->CheckRW( GSE_CALL );
 
 					N_EXPECT_ARGS( 0 );
 					m_faction = nullptr;
 
-					return VALUE( gse::value::Undefined );
+					return VALUE_SHARED( gse::value::Undefined );
 				} )
 			},
-			{
-				"is_master",
-				VALUE( gse::value::Bool, , m_role == PR_SINGLE || m_role == PR_HOST )
-			},
 		};
-WRAPIMPL_END_PTR()
+WRAPIMPL_CACHED_END_PTR()
 
 UNWRAPIMPL_PTR( Player )
 
@@ -202,7 +191,7 @@ const types::Buffer Player::Serialize() const {
 	buf.WriteInt( m_role );
 	buf.WriteBool( m_faction != nullptr );
 	if ( m_faction ) {
-		buf.WriteString( m_faction->Serialize().ToString() );
+		buf.WriteNested( *m_faction );
 	}
 	buf.WriteString( m_difficulty_level );
 
@@ -216,7 +205,7 @@ void Player::Deserialize( types::Buffer buf ) {
 	m_faction = {};
 	if ( buf.ReadBool() ) {
 		m_faction = new faction::Faction();
-		m_faction->Deserialize( buf.ReadString() );
+		m_faction->Deserialize( buf.ReadNested() );
 	}
 	m_difficulty_level = buf.ReadString();
 
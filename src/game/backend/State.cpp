@@ -229,6 +229,16 @@ gse::Value* const State::TriggerObject( gse::GCWrappable* object, const std::str
 	}
 }
 
+gse::Value* const State::TriggerObject( gse::GCWrappable* object, const gse::value::atom_t event, const f_args_t& f_args ) {
+	CHECKACCUM( m_gc_space );
+	if ( m_glsmac ) {
+		return m_glsmac->TriggerObject( object, event, f_args );
+	}
+	else {
+		return m_bindings->Trigger( object, event, f_args );
+	}
+}
+
 WRAPIMPL_BEGIN( State )
 	WRAPIMPL_PROPS
 		WRAPIMPL_TRIGGERS
@@ -244,18 +254,18 @@ UNWRAPIMPL_PTR( State )
 const types::Buffer State::Serialize() const {
 	types::Buffer buf;
 
-	buf.WriteString( m_settings.global.Serialize().ToString() );
-	buf.WriteString( m_fm->Serialize().ToString() );
+	buf.WriteNested( m_settings.global );
+	buf.WriteNested( [ this ]( types::Buffer& b ) { m_fm->Serialize( b ); } );
 
 	return buf;
 }
 
 void State::Deserialize( types::Buffer buf ) {
-	m_settings.global.Deserialize( buf.ReadString() );
-	m_fm->Deserialize( buf.ReadString() );
+	m_settings.global.Deserialize( buf.ReadNested() );
+	m_fm->Deserialize( buf.ReadNested() );
 }
 
-void State::GetReachableObjects( std::unordered_set< Object* >& reachable_objects ) {
+void State::GetReachableObjects( gc::MarkStack& reachable_objects ) {
 	gse::GCWrappable::GetReachableObjects( reachable_objects );
 
 	GC_DEBUG_BEGIN( "State" );
@@ -78,6 +78,7 @@ CLASS( State, gse::GCWrappable )
 	faction::FactionManager* GetFM() const;
 
 	gse::Value* const TriggerObject( gse::GCWrappable* object, const std::string& event, const f_args_t& f_args );
+	gse::Value* const TriggerObject( gse::GCWrappable* object, const gse::value::atom_t event, const f_args_t& f_args );
 
 	WRAPDEFS_PTR( State )
 
@@ -88,7 +89,7 @@ CLASS( State, gse::GCWrappable )
 	gc::Space* m_gc_space = nullptr;
 	gse::context::Context* m_ctx = nullptr;
 
-	void GetReachableObjects( std::unordered_set< Object* >& reachable_objects ) override;
+	void GetReachableObjects( gc::MarkStack& reachable_objects ) override;
 
 	connection::Connection* m_connection = nullptr;
 
@@ -53,7 +53,7 @@ void Animation::Abort() {
 	m_sequence->m_am->AbortAnimation( m_animation_id );
 }
 
-void Animation::GetReachableObjects( std::unordered_set< gc::Object* >& reachable_objects ) {
+void Animation::GetReachableObjects( gc::MarkStack& reachable_objects ) {
 	gc::Object::GetReachableObjects( reachable_objects );
 
 	GC_DEBUG_BEGIN( "Animation" );
@@ -32,7 +32,7 @@ public:
 	void Run( GSE_CALLABLE );
 	void Abort();
 
-	void GetReachableObjects( std::unordered_set< gc::Object* >& reachable_objects ) override;
+	void GetReachableObjects( gc::MarkStack& reachable_objects ) override;
 
 private:
 	friend class AnimationSequence;
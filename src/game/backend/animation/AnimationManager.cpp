@@ -66,6 +66,9 @@ void AnimationManager::DefineAnimation( animation::Def* def ) {
 		}
 	);
 
+	// decode sound in background so that showing animation doesn't need to load it
+	g_engine->GetSoundLoader()->PrefetchCustomSound( def->m_sound_file );
+
 	auto fr = FrontendRequest( FrontendRequest::FR_ANIMATION_DEFINE );
 	NEW( fr.data.animation_define.serialized_animation, std::string, animation::Def::Serialize( def ).ToString() );
 	m_game->AddFrontendRequest( fr );
@@ -176,7 +179,7 @@ WRAPIMPL_BEGIN( AnimationManager )
 						sound
 					);
 					DefineAnimation( def );
-					return VALUE( gse::value::Undefined );
+					return VALUE_SHARED( gse::value::Undefined );
 				}
 				else {
 					GSE_ERROR( gse::EC.GAME_ERROR, "Unsupported animation type: " + type );
@@ -220,7 +223,7 @@ WRAPIMPL_BEGIN( AnimationManager )
 					throw;
 				}
 
-				return VALUE( gse::value::Undefined );
+				return VALUE_SHARED( gse::value::Undefined );
 			} )
 		},
 		{
@@ -237,7 +240,7 @@ WRAPIMPL_BEGIN( AnimationManager )
 					}
 				}
 
-				return VALUE( gse::value::Undefined );
+				return VALUE_SHARED( gse::value::Undefined );
 			} )
 		},
 		{
@@ -250,7 +253,7 @@ WRAPIMPL_BEGIN( AnimationManager )
 
 				if ( animations.empty() ) {
 					// nothing to do
-					return VALUE( gse::value::Undefined );
+					return VALUE_SHARED( gse::value::Undefined );
 				}
 
 				std::unordered_set< map::tile::Tile* > unique_tiles = {};
@@ -311,7 +314,7 @@ WRAPIMPL_BEGIN( AnimationManager )
 
 				UndefineAnimation( id );
 
-				return VALUE( gse::value::Undefined );
+				return VALUE_SHARED( gse::value::Undefined );
 			} )
 		}
 	};
@@ -324,7 +327,7 @@ void AnimationManager::Serialize( types::Buffer& buf ) const {
 	buf.WriteInt( m_animation_defs.size() );
 	for ( const auto& it : m_animation_defs ) {
 		buf.WriteString( it.first );
-		buf.WriteString( animation::Def::Serialize( it.second ).ToString() );
+		buf.WriteString( animation::Def::Serialize( it.second ).ToStringView() );
 	}
 	buf.WriteInt( m_next_running_animation_id );
 	Log( "Saved next animation id: " + std::to_string( m_next_running_animation_id ) );
@@ -337,7 +340,7 @@ void AnimationManager::Deserialize( types::Buffer& buf ) {
 	m_animation_defs.reserve( sz );
 	for ( size_t i = 0 ; i < sz ; i++ ) {
 		const auto name = buf.ReadString();
-		auto b = types::Buffer( buf.ReadString() );
+		auto b = buf.ReadNested();
 		DefineAnimation( animation::Def::Deserialize( b ) );
 	}
 	m_next_running_animation_id = buf.ReadInt();
@@ -355,7 +358,7 @@ const size_t AnimationManager::AddAnimationCallback( const cb_oncomplete& on_com
 	return running_animation_id;
 }
 
-void AnimationManager::GetReachableObjects( std::unordered_set< gc::Object* >& reachable_objects ) {
+void AnimationManager::GetReachableObjects( gc::MarkStack& reachable_objects ) {
 	gse::GCWrappable::GetReachableObjects( reachable_objects );
 
 	GC_DEBUG_BEGIN( "animation_sequences" );
@@ -40,7 +40,7 @@ public:
 	void Serialize( types::Buffer& buf ) const;
 	void Deserialize( types::Buffer& buf );
 
-	void GetReachableObjects( std::unordered_set< gc::Object* >& reachable_objects ) override;
+	void GetReachableObjects( gc::MarkStack& reachable_objects ) override;
 
 private:
 	friend class AnimationSequence;
@@ -49,7 +49,7 @@ void AnimationSequence::Abort() {
 	Finish();
 }
 
-void AnimationSequence::GetReachableObjects( std::unordered_set< gc::Object* >& reachable_objects ) {
+void AnimationSequence::GetReachableObjects( gc::MarkStack& reachable_objects ) {
 	gc::Object::GetReachableObjects( reachable_objects );
 
 	GC_DEBUG_BEGIN( "AnimationSequence" );
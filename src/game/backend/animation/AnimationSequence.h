@@ -29,7 +29,7 @@ public:
 
 	void Abort();
 
-	void GetReachableObjects( std::unordered_set< gc::Object* >& reachable_objects ) override;
+	void GetReachableObjects( gc::MarkStack& reachable_objects ) override;
 
 private:
 	friend class Animation;
@@ -153,7 +153,7 @@ WRAPIMPL_DYNAMIC_GETTERS( Base )
 
 			RemovePop( pop_id );
 
-			return VALUE( gse::value::Undefined );
+			return VALUE_SHARED( gse::value::Undefined );
 		} )
 	}
 WRAPIMPL_DYNAMIC_SETTERS( Base )
@@ -124,7 +124,7 @@ void BaseManager::SpawnBase( GSE_CALLABLE, base::Base* base ) {
 	}
 	m_registered_base_names.insert( base->m_name );
 
-	Log( "Spawning base #" + std::to_string( base->m_id ) + " ( " + base->m_name + " ) at " + base->GetTile()->ToString() );
+	LOG_AT( logger::LL_DEBUG, "Spawning base #" + std::to_string( base->m_id ) + " ( " + base->m_name + " ) at " + base->GetTile()->ToString() );
 
 	ASSERT( m_bases.find( base->m_id ) == m_bases.end(), "duplicate base id" );
 	m_bases.insert_or_assign( base->m_id, base );
@@ -153,7 +153,7 @@ void BaseManager::DespawnBase( GSE_CALLABLE, const size_t base_id ) {
 
 	auto* base = it->second;
 
-	Log( "Despawning base #" + std::to_string( base->m_id ) + " at " + base->GetTile()->ToString() );
+	LOG_AT( logger::LL_DEBUG, "Despawning base #" + std::to_string( base->m_id ) + " at " + base->GetTile()->ToString() );
 
 	QueueBaseUpdate( base, BUO_DESPAWN );
 
@@ -300,7 +300,7 @@ WRAPIMPL_BEGIN( BaseManager )
 
 				DefinePop( new base::PopDef( id, name, rh, rp, flags ) );
 
-				return VALUE( gse::value::Undefined );
+				return VALUE_SHARED( gse::value::Undefined );
 			} )
 		},
 		{
@@ -314,7 +314,7 @@ WRAPIMPL_BEGIN( BaseManager )
 
 				UndefinePop( id );
 
-				return VALUE( gse::value::Undefined );
+				return VALUE_SHARED( gse::value::Undefined );
 			} )
 		},
 		{
@@ -366,7 +366,7 @@ WRAPIMPL_BEGIN( BaseManager )
 					DespawnBase( GSE_CALL, base->m_id );
 				}
 
-				return VALUE( gse::value::Undefined );
+				return VALUE_SHARED( gse::value::Undefined );
 			} )
 		},
 		{
@@ -393,13 +393,13 @@ void BaseManager::Serialize( types::Buffer& buf ) const {
 	buf.WriteInt( m_base_popdefs.size() );
 	for ( const auto& it : m_base_popdefs ) {
 		buf.WriteString( it.first );
-		buf.WriteString( base::PopDef::Serialize( it.second ).ToString() );
+		buf.WriteString( base::PopDef::Serialize( it.second ).ToStringView() );
 	}
 
 	Log( "Serializing " + std::to_string( m_bases.size() ) + " bases" );
 	buf.WriteInt( m_bases.size() );
 	for ( const auto& it : m_bases ) {
-		buf.WriteString( base::Base::Serialize( it.second ).ToString() );
+		buf.WriteString( base::Base::Serialize( it.second ).ToStringView() );
 	}
 	buf.WriteInt( base::Base::GetNextId() );
 
@@ -416,7 +416,7 @@ void BaseManager::Deserialize( GSE_CALLABLE, types::Buffer& buf ) {
 	Log( "Unserializing " + std::to_string( sz ) + " base pop defs" );
 	for ( size_t i = 0 ; i < sz ; i++ ) {
 		const auto name = buf.ReadString();
-		auto b = types::Buffer( buf.ReadString() );
+		auto b = buf.ReadNested();
 		DefinePop( base::PopDef::Deserialize( b ) );
 	}
 
@@ -426,7 +426,7 @@ void BaseManager::Deserialize( GSE_CALLABLE, types::Buffer& buf ) {
 		m_unprocessed_bases.reserve( sz );
 	}
 	for ( size_t i = 0 ; i < sz ; i++ ) {
-		auto b = types::Buffer( buf.ReadString() );
+		auto b = buf.ReadNested();
 		if ( m_game->IsRunning() ) {
 			SpawnBase( GSE_CALL, base::Base::Deserialize( b, m_game ) );
 		}
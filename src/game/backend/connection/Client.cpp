@@ -2,12 +2,14 @@
 
 #include <algorithm>
 
+#include "Snapshot.h"
 #include "game/backend/State.h"
 #include "game/backend/slot/Slots.h"
 #include "game/backend/event/Event.h"
 #include "game/backend/Player.h"
 #include "game/backend/Game.h"
 #include "engine/Engine.h"
+#include "config/Config.h"
 #include "types/Packet.h"
 #include "network/Network.h"
 #include "gse/value/Array.h"
@@ -207,11 +209,18 @@ void Client::ProcessEvent( const network::Event& event ) {
 								Log( "No download response received from server" );
 								Disconnect( "No download response received from server" );
 							}
+							else if ( packet.udata.download.size == 0 ) {
+								Error( "download chunk size is zero" );
+							}
 							else {
 								m_download_state.total_size = packet.data.num;
+								m_download_state.chunk_size = packet.udata.download.size;
+								m_download_state.downloaded_size = 0;
+								m_download_state.requested_size = 0;
 								Log( "Allocating download buffer (" + std::to_string( m_download_state.total_size ) + " bytes)" );
+								m_download_state.buffer.clear();
 								m_download_state.buffer.reserve( m_download_state.total_size );
-								DownloadNextChunk();
+								DownloadNextChunks();
 							}
 							break;
 						}
@@ -228,20 +237,21 @@ void Client::ProcessEvent( const network::Event& event ) {
 								Error( "inconsistent chunk offset ( " + std::to_string( packet.udata.download.offset ) + " != " + std::to_string( m_download_state.downloaded_size ) + " )" );
 							}
 							else if (
-								packet.udata.download.size != DOWNLOAD_CHUNK_SIZE &&
+								packet.udata.download.size != m_download_state.chunk_size &&
 									end != m_download_state.total_size // last chunk can be smaller
 								) {
-								Error( "inconsistent map chunk size ( " );
+								Error( "inconsistent map chunk size ( " + std::to_string( packet.udata.download.size ) + " != " + std::to_string( m_download_state.chunk_size ) + " )" );
+							}
+							else if ( !Snapshot::ReadChunk( packet, m_download_state.buffer ) ) {
+								Error( "malformed map chunk ( offset=" + std::to_string( packet.udata.download.offset ) + " )" );
 							}
 							else {
-								ASSERT( packet.data.str.size() == packet.udata.download.size, "download buffer size mismatch" );
-								m_download_state.buffer.append( packet.data.str );
+								m_download_state.downloaded_size = end;
 								if ( end < m_download_state.total_size ) {
 									if ( m_on_download_progress ) {
 										m_on_download_progress( (float)m_download_state.downloaded_size / m_download_state.total_size );
 									}
-									m_download_state.downloaded_size = end;
-									DownloadNextChunk();
+									DownloadNextChunks();
 								}
 								else {
 									Log( "Download completed successfully" );
@@ -367,16 +377,24 @@ void Client::Error( const std::string& reason ) {
 	Disconnect( "Network protocol error" );
 }
 
-void Client::DownloadNextChunk() {
+void Client::DownloadNextChunks() {
 	ASSERT( m_download_state.is_downloading, "download not initialized" );
 	ASSERT( m_download_state.buffer.size() == m_download_state.downloaded_size, "download buffer size mismatch" );
 	ASSERT( m_download_state.downloaded_size < m_download_state.total_size, "download already finished" );
-	const size_t size = std::min( DOWNLOAD_CHUNK_SIZE, m_download_state.total_size - m_download_state.downloaded_size );
-	Log( "Requesting next chunk ( offset=" + std::to_string( m_download_state.downloaded_size ) + " size=" + std::to_string( size ) + " )" );
-	types::Packet p( types::Packet::PT_DOWNLOAD_NEXT_CHUNK_REQUEST );
-	p.udata.download.offset = m_download_state.downloaded_size;
-	p.udata.download.size = size;
-	m_network->MT_SendPacket( &p );
+	// keep window full so that round trips overlap instead of adding up
+	const size_t window_size = g_engine->GetConfig()->GetDownloadWindow() * m_download_state.chunk_size;
+	while (
+		m_download_state.requested_size < m_download_state.total_size &&
+			m_download_state.requested_size - m_download_state.downloaded_size < window_size
+		) {
+		const size_t size = std::min( m_download_state.chunk_size, m_download_state.total_size - m_download_state.requested_size );
+		Log( "Requesting next chunk ( offset=" + std::to_string( m_download_state.requested_size ) + " size=" + std::to_string( size ) + " )" );
+		types::Packet p( types::Packet::PT_DOWNLOAD_NEXT_CHUNK_REQUEST );
+		p.udata.download.offset = m_download_state.requested_size;
+		p.udata.download.size = size;
+		m_network->MT_SendPacket( &p );
+		m_download_state.requested_size += size;
+	}
 }
 
 }
@@ -35,11 +35,13 @@ private:
 
 	struct {
 		bool is_downloading = false;
-		int total_size = 0;
-		int downloaded_size = 0;
+		size_t total_size = 0;
+		size_t chunk_size = 0;
+		size_t downloaded_size = 0;
+		size_t requested_size = 0; // up to window of chunks is requested ahead of downloaded ones
 		std::string buffer = "";
 	} m_download_state = {};
-	void DownloadNextChunk();
+	void DownloadNextChunks();
 };
 
 }
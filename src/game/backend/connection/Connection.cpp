@@ -1,5 +1,6 @@
 #include "Connection.h"
 
+#include "Server.h"
 #include "game/backend/State.h"
 #include "engine/Engine.h"
 #include "network/Network.h"
@@ -273,6 +274,12 @@ void Connection::IfServer( std::function< void( Server* ) > cb ) {
 }
 
 void Connection::SendGameEvent( backend::event::Event* event ) {
+	IfServer(
+		[]( Server* server ) {
+			// world changes with every event, players that join after it need fresh snapshot
+			server->InvalidateSnapshot();
+		}
+	);
 	if ( m_pending_game_events.size() >= PENDING_GAME_EVENTS_LIMIT ) {
 		SendGameEvents( m_pending_game_events );
 		m_pending_game_events.clear();
@@ -324,7 +331,7 @@ WRAPIMPL_BEGIN( Connection )
 				if ( !m_mt_ids.connect ) {
 					Connect();
 				}
-				return VALUE( gse::value::Undefined );
+				return VALUE_SHARED( gse::value::Undefined );
 			} )
 		},
 		{
@@ -348,7 +355,7 @@ WRAPIMPL_BEGIN( Connection )
 						Disconnect();
 					}
 				}
-				return VALUE( gse::value::Undefined );
+				return VALUE_SHARED( gse::value::Undefined );
 			} )
 		},
 	};
@@ -99,8 +99,6 @@ public:
 	virtual void SendMessage( const std::string& message ) = 0;
 
 protected:
-	const int DOWNLOAD_CHUNK_SIZE = 16384;
-
 	network::Network* const m_network;
 
 	virtual void ProcessEvent( const network::Event& event );
@@ -1,6 +1,7 @@
 #include "Server.h"
 
 #include "engine/Engine.h"
+#include "config/Config.h"
 #include "types/Packet.h"
 #include "network/Network.h"
 #include "game/backend/Game.h"
@@ -307,17 +308,36 @@ void Server::ProcessEvent( const network::Event& event ) {
 					case types::Packet::PT_DOWNLOAD_REQUEST: {
 						Log( "Got download request from " + std::to_string( event.cid ) );
 						types::Packet p( types::Packet::PT_DOWNLOAD_RESPONSE );
+						p.data.num = 0;
 						if ( m_on_download_request ) {
-							m_download_data[ event.cid ] = download_data_t{ // override previous request
-								0,
-								m_on_download_request()
-							};
-							p.data.num = m_download_data.at( event.cid ).serialized_snapshot.size();
+							auto snapshot = m_snapshot.lock();
+							if ( snapshot ) {
+								Log( "Reusing snapshot that is being downloaded by others" );
+							}
+							else {
+								auto serialized_snapshot = m_on_download_request();
+								if ( !serialized_snapshot.empty() ) {
+									snapshot = std::make_shared< const Snapshot >(
+										std::move( serialized_snapshot ),
+										g_engine->GetConfig()->GetDownloadChunkSize(),
+										g_engine->GetConfig()->HasLaunchFlag( config::Config::LF_DOWNLOAD_COMPRESSION )
+									);
+									m_snapshot = snapshot;
+									Log( "Prepared snapshot ( " + std::to_string( snapshot->GetSize() ) + " bytes, " + std::to_string( snapshot->GetCompressedSize() ) + " to send )" );
+								}
+							}
+							if ( snapshot ) {
+								m_download_data[ event.cid ] = download_data_t{ // override previous request
+									0,
+									snapshot
+								};
+								p.data.num = snapshot->GetSize();
+								p.udata.download.size = snapshot->GetChunkSize();
+							}
 						}
 						else {
 							// no handler set - no data to return
 							Log( "WARNING: download requested but no download handler was set, sending empty header" );
-							p.data.num = 0;
 						}
 						m_network->MT_SendPacket( &p, event.cid );
 						break;
@@ -329,25 +349,23 @@ void Server::ProcessEvent( const network::Event& event ) {
 						if ( it == m_download_data.end() ) {
 							Error( event.cid, "download not initialized" );
 						}
-						else if ( end > it->second.serialized_snapshot.size() ) {
-							Error( event.cid, "download offset overflow ( " + std::to_string( packet.udata.download.offset ) + " + " + std::to_string( packet.udata.download.size ) + " >= " + std::to_string( it->second.serialized_snapshot.size() ) + " )" );
+						else if ( end > it->second.snapshot->GetSize() ) {
+							Error( event.cid, "download offset overflow ( " + std::to_string( packet.udata.download.offset ) + " + " + std::to_string( packet.udata.download.size ) + " >= " + std::to_string( it->second.snapshot->GetSize() ) + " )" );
 						}
 						else if ( packet.udata.download.offset != it->second.next_expected_offset ) {
 							Error( event.cid, "inconsistent download offset ( " + std::to_string( packet.udata.download.offset ) + " != " + std::to_string( it->second.next_expected_offset ) + " )" );
 						}
 						else if (
-							packet.udata.download.size != DOWNLOAD_CHUNK_SIZE &&
-								end != it->second.serialized_snapshot.size() // last chunk can be smaller
+							packet.udata.download.size != it->second.snapshot->GetChunkSize() &&
+								end != it->second.snapshot->GetSize() // last chunk can be smaller
 							) {
-							Error( event.cid, "inconsistent download size ( " );
+							Error( event.cid, "inconsistent download size ( " + std::to_string( packet.udata.download.size ) + " != " + std::to_string( it->second.snapshot->GetChunkSize() ) + " )" );
 						}
 						else {
 							types::Packet p( types::Packet::PT_DOWNLOAD_NEXT_CHUNK_RESPONSE );
-							p.udata.download.offset = packet.udata.download.offset;
-							p.udata.download.size = packet.udata.download.size;
-							p.data.str = it->second.serialized_snapshot.substr( packet.udata.download.offset, packet.udata.download.size );
+							it->second.snapshot->WriteChunk( packet.udata.download.offset, p );
 							m_network->MT_SendPacket( &p, event.cid );
-							if ( end < it->second.serialized_snapshot.size() ) {
+							if ( end < it->second.snapshot->GetSize() ) {
 								it->second.next_expected_offset = end;
 							}
 							else {
@@ -522,6 +540,10 @@ void Server::ResetHandlers() {
 	m_on_download_request = nullptr;
 }
 
+void Server::InvalidateSnapshot() {
+	m_snapshot.reset();
+}
+
 void Server::UpdateGameSettings() {
 	Broadcast(
 		[ this ]( const network::cid_t cid ) -> void {
@@ -2,8 +2,10 @@
 
 #include <unordered_map>
 #include <string>
+#include <memory>
 
 #include "Connection.h"
+#include "Snapshot.h"
 
 namespace game {
 namespace backend {
@@ -22,6 +24,9 @@ public:
 	std::function< void() > m_on_listen = nullptr;
 	std::function< const std::string() > m_on_download_request = nullptr; // return serialized snapshot of world
 
+	// next download request will build new snapshot instead of reusing one that is being downloaded by others
+	void InvalidateSnapshot();
+
 	void SendGameEventResponse( const size_t cid, const std::string& event_id, const bool result, const gse::Value* const resolved );
 
 	void UpdateSlot( const size_t slot_num, slot::Slot* slot, const bool only_flags = false ) override;
@@ -55,9 +60,12 @@ private:
 
 	struct download_data_t {
 		size_t next_expected_offset = 0; // for extra consistency checks
-		std::string serialized_snapshot = "";
+		std::shared_ptr< const Snapshot > snapshot = nullptr;
 	};
-	std::unordered_map< network::cid_t, download_data_t > m_download_data = {}; // cid -> serialized snapshot of world
+	std::unordered_map< network::cid_t, download_data_t > m_download_data = {}; // cid -> snapshot of world being downloaded
+
+	// shared by all concurrent downloads, freed when last of them finishes
+	std::weak_ptr< const Snapshot > m_snapshot = {};
 
 	void ClearReadyFlags();
 };
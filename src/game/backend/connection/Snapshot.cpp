@@ -0,0 +1,93 @@
+#include "Snapshot.h"
+
+#include <algorithm>
+
+#include "engine/Engine.h"
+#include "common/ThreadPool.h"
+#include "types/Packet.h"
+#include "util/lz/LZ.h"
+
+namespace game {
+namespace backend {
+namespace connection {
+
+Snapshot::Snapshot( std::string&& data, const size_t chunk_size, const bool compress )
+	: m_data( std::move( data ) )
+	, m_chunk_size( chunk_size ) {
+	ASSERT( m_chunk_size > 0, "snapshot chunk size is zero" );
+	if ( compress ) {
+		m_compressed_chunks.resize( ( m_data.size() + m_chunk_size - 1 ) / m_chunk_size );
+		common::mt_flag_t canceled = false;
+		g_engine->GetThreadPool()->ParallelFor(
+			0, m_compressed_chunks.size(), [ this ]( const size_t from, const size_t to ) {
+				for ( size_t i = from ; i < to ; i++ ) {
+					const size_t offset = i * m_chunk_size;
+					const size_t size = std::min( m_chunk_size, m_data.size() - offset );
+					auto& compressed = m_compressed_chunks[ i ];
+					util::lz::LZ::Compress( m_data.data() + offset, size, compressed );
+					if ( compressed.size() >= size ) {
+						compressed.clear();
+						compressed.shrink_to_fit();
+					}
+				}
+			}, canceled, 1
+		);
+	}
+}
+
+const size_t Snapshot::GetSize() const {
+	return m_data.size();
+}
+
+const size_t Snapshot::GetChunkSize() const {
+	return m_chunk_size;
+}
+
+const size_t Snapshot::GetCompressedSize() const {
+	size_t size = 0;
+	for ( size_t i = 0 ; i * m_chunk_size < m_data.size() ; i++ ) {
+		size += i < m_compressed_chunks.size() && !m_compressed_chunks[ i ].empty()
+			? m_compressed_chunks[ i ].size()
+			: std::min( m_chunk_size, m_data.size() - i * m_chunk_size );
+	}
+	return size;
+}
+
+void Snapshot::WriteChunk( const size_t offset, types::Packet& packet ) const {
+	ASSERT( offset % m_chunk_size == 0, "snapshot chunk offset not aligned" );
+	ASSERT( offset < m_data.size(), "snapshot chunk offset overflow" );
+	const size_t index = offset / m_chunk_size;
+	const size_t size = std::min( m_chunk_size, m_data.size() - offset );
+	packet.udata.download.offset = offset;
+	packet.udata.download.size = size;
+	if ( index < m_compressed_chunks.size() && !m_compressed_chunks[ index ].empty() ) {
+		packet.data.boolean = true;
+		packet.data.str = m_compressed_chunks[ index ];
+	}
+	else {
+		packet.data.boolean = false;
+		packet.data.str.assign( m_data, offset, size );
+	}
+}
+
+const bool Snapshot::ReadChunk( const types::Packet& packet, std::string& buffer ) {
+	const size_t size_before = buffer.size();
+	if ( packet.data.boolean ) {
+		if ( !util::lz::LZ::Decompress( packet.data.str.data(), packet.data.str.size(), buffer, packet.udata.download.size ) ) {
+			buffer.resize( size_before );
+			return false;
+		}
+	}
+	else {
+		buffer.append( packet.data.str );
+	}
+	if ( buffer.size() - size_before != packet.udata.download.size ) {
+		buffer.resize( size_before );
+		return false;
+	}
+	return true;
+}
+
+}
+}
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace types {
+class Packet;
+}
+
+namespace game {
+namespace backend {
+namespace connection {
+
+// serialized world that is sent to joining players, immutable so one instance is shared by all concurrent downloads
+// chunks are optionally compressed once, each one independently so that client can unpack them as they arrive
+class Snapshot {
+public:
+
+	Snapshot( std::string&& data, const size_t chunk_size, const bool compress );
+
+	const size_t GetSize() const;
+	const size_t GetChunkSize() const;
+	const size_t GetCompressedSize() const;
+
+	// fills chunk response packet, offset must be at chunk boundary
+	void WriteChunk( const size_t offset, types::Packet& packet ) const;
+
+	// appends chunk from response packet to buffer, returns false if it's malformed
+	static const bool ReadChunk( const types::Packet& packet, std::string& buffer );
+
+private:
+	const std::string m_data;
+	const size_t m_chunk_size;
+
+	// empty if compression is disabled, chunk is left empty if compressing didn't make it smaller
+	std::vector< std::string > m_compressed_chunks = {};
+
+};
+
+}
+}
+}
@@ -67,7 +67,7 @@ const std::string Event::ToString() const {
 	return "Event#" + m_id + "( " + m_name + " )"; // TODO
 }
 
-void Event::GetReachableObjects( std::unordered_set< gc::Object* >& reachable_objects ) {
+void Event::GetReachableObjects( gc::MarkStack& reachable_objects ) {
 	gc::Object::GetReachableObjects( reachable_objects );
 
 	GC_DEBUG_BEGIN( "Event" );
@@ -28,7 +28,7 @@ public:
 
 	const std::string ToString() const;
 
-	void GetReachableObjects( std::unordered_set< Object* >& reachable_objects ) override;
+	void GetReachableObjects( gc::MarkStack& reachable_objects ) override;
 
 	const source_t GetSource() const;
 	const size_t GetCaller() const;
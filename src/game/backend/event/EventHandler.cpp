@@ -25,7 +25,7 @@ EventHandler::EventHandler(
 	ASSERT( rollback, "rollback not set" );
 }
 
-void EventHandler::GetReachableObjects( std::unordered_set< gc::Object* >& reachable_objects ) {
+void EventHandler::GetReachableObjects( gc::MarkStack& reachable_objects ) {
 	gc::Object::GetReachableObjects( reachable_objects );
 
 	GC_DEBUG_BEGIN( "Event" );
@@ -18,7 +18,7 @@ public:
 		gse::value::Callable* const rollback
 	);
 
-	void GetReachableObjects( std::unordered_set< Object* >& reachable_objects ) override;
+	void GetReachableObjects( gc::MarkStack& reachable_objects ) override;
 
 	const std::string* const Validate( GSE_CALLABLE, const gse::value::function_arguments_t& args ) const;
 	const bool HasResolve() const;
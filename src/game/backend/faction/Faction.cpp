@@ -84,11 +84,11 @@ WRAPIMPL_BEGIN( Faction )
 			},
 			{
 				"is_naval",
-				VALUE( gse::value::Bool, , m_flags & Faction::FF_NAVAL )
+				VALUE_SHARED( gse::value::Bool, , m_flags & Faction::FF_NAVAL )
 			},
 			{
 				"is_progenitor",
-				VALUE( gse::value::Bool, , m_flags & Faction::FF_PROGENITOR )
+				VALUE_SHARED( gse::value::Bool, , m_flags & Faction::FF_PROGENITOR )
 			},
 		};
 WRAPIMPL_END_PTR()
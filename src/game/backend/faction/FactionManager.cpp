@@ -206,7 +206,7 @@ WRAPIMPL_BEGIN( FactionManager )
 					GSE_ERROR( gse::EC.GAME_ERROR, "Unknown faction: " + id );
 				}
 				Remove( id );
-				return VALUE( gse::value::Undefined );
+				return VALUE_SHARED( gse::value::Undefined );
 			} )
 		},
 		{
@@ -228,15 +228,17 @@ UNWRAPIMPL_PTR( FactionManager )
 
 const types::Buffer FactionManager::Serialize() const {
 	types::Buffer buf;
+	Serialize( buf );
+	return buf;
+}
 
+void FactionManager::Serialize( types::Buffer& buf ) const {
 	buf.WriteInt( m_factions_order.size() );
 	for ( auto& it : m_factions_order ) {
 		const auto* faction = m_factions.at( it.second ).faction;
 		buf.WriteString( it.second );
-		buf.WriteString( faction->Serialize().ToString() );
+		buf.WriteNested( *faction );
 	}
-
-	return buf;
 }
 
 void FactionManager::Deserialize( types::Buffer buf ) {
@@ -246,7 +248,7 @@ void FactionManager::Deserialize( types::Buffer buf ) {
 	for ( size_t i = 0 ; i < factions_count ; i++ ) {
 		const auto faction_id = buf.ReadString();
 		ASSERT( m_factions.find( faction_id ) == m_factions.end(), "duplicate faction id" );
-		m_factions.insert({ faction_id, { new Faction(), ++m_next_faction_idx }}).first->second.faction->Deserialize( buf.ReadString() );
+		m_factions.insert({ faction_id, { new Faction(), ++m_next_faction_idx }}).first->second.faction->Deserialize( buf.ReadNested() );
 		m_factions_order.insert( { m_next_faction_idx, faction_id } );
 	}
 }
@@ -23,6 +23,8 @@ public:
 	WRAPDEFS_PTR( FactionManager )
 
 	const types::Buffer Serialize() const;
+	// writes into existing buffer, without temporary one
+	void Serialize( types::Buffer& buf ) const;
 	void Deserialize( types::Buffer buf );
 
 private:
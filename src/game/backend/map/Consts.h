@@ -495,6 +495,9 @@ struct Consts {
 		const std::string default_map_directory = "maps";
 		const std::string default_map_filename = "untitled";
 		const std::string default_map_extension = ".gsm";
+		// files without signature predate crc32c buffer checksums
+		const std::string file_signature = "GLSMAC map";
+		const long long int file_version = 1;
 	} fs;
 	const std::unordered_map< settings::map_config_value_t, types::Vec2< size_t > > map_sizes = {
 		// original SMAC sizes (1:1)
@@ -1,11 +1,15 @@
+#include <algorithm>
+
 #include "Map.h"
 
 #include "game/backend/Game.h"
 #include "game/backend/settings/Settings.h"
 #include "game/backend/map/generator/SimplePerlin.h"
 #include "engine/Engine.h"
+#include "common/ThreadPool.h"
 #include "config/Config.h"
 #include "game/backend/Random.h"
+#include "util/random/Random.h"
 #include "util/FS.h"
 #include "ui_legacy/UI.h"
 #include "loader/texture/TextureLoader.h"
@@ -38,6 +42,8 @@ namespace game {
 namespace backend {
 namespace map {
 
+thread_local Map::tile_context_t* Map::s_tile_context = nullptr;
+
 #define B( x ) S_to_binary_(#x)
 
 static inline unsigned char S_to_binary_( const char* s ) {
@@ -156,9 +162,14 @@ Map::Map( Game* game )
 		module_pass.clear();
 		NEW( m, module::WaterSurfacePP, this );
 		module_pass.push_back( m );
+		m_modules_deferred.push_back( module_pass );
+	}
+	{ // separate pass because sprite actors can't be registered in parallel
+		module_pass.clear();
 		NEW( m, module::Sprites, this );
 		module_pass.push_back( m );
 		m_modules_deferred.push_back( module_pass );
+		m_modules_sprites.push_back( module_pass );
 	}
 
 }
@@ -183,20 +194,23 @@ Map::~Map() {
 }
 
 const types::Buffer Map::Serialize() const {
-
 	types::Buffer buf;
+	Serialize( buf );
+	return buf;
+}
 
-	buf.WriteString( m_tiles->Serialize().ToString() );
-	buf.WriteString( m_map_state->Serialize().ToString() );
+void Map::Serialize( types::Buffer& buf ) const {
+	buf.WriteNested( *m_tiles );
+	buf.WriteNested( [ this ]( types::Buffer& b ) { m_map_state->Serialize( b ); } );
 
-	buf.WriteString( m_meshes.terrain->Serialize().ToString() );
-	buf.WriteString( m_meshes.terrain_data->Serialize().ToString() );
+	buf.WriteNested( *m_meshes.terrain );
+	buf.WriteNested( *m_meshes.terrain_data );
 
-	buf.WriteString( m_textures.terrain->Serialize().ToString() );
+	buf.WriteNested( *m_textures.terrain );
 
 	buf.WriteInt( m_sprite_actors.size() );
 	for ( auto& it : m_sprite_actors ) {
-		buf.WriteString( SerializeSpriteActor( it.second ).ToString() );
+		buf.WriteString( SerializeSpriteActor( it.second ).ToStringView() );
 		buf.WriteString( it.first );
 	}
 	buf.WriteInt( m_sprite_instances.size() );
@@ -206,24 +220,22 @@ const types::Buffer Map::Serialize() const {
 		buf.WriteInt( it.first );
 	}
 	buf.WriteInt( m_next_sprite_instance_id );
-
-	return buf;
 }
 
 void Map::Deserialize( types::Buffer buf ) {
 
 	ASSERT( !m_tiles, "tiles already set" );
 	NEW( m_tiles, tile::Tiles );
-	m_tiles->Deserialize( buf.ReadString() );
+	m_tiles->Deserialize( buf.ReadNested() );
 
 	ASSERT( !m_map_state, "map state already set" );
 	NEW( m_map_state, MapState );
-	m_map_state->Deserialize( buf.ReadString() );
+	m_map_state->Deserialize( buf.ReadNested() );
 
 	InitTextureAndMesh();
-	m_meshes.terrain->Deserialize( buf.ReadString() );
-	m_meshes.terrain_data->Deserialize( buf.ReadString() );
-	m_textures.terrain->Deserialize( buf.ReadString() );
+	m_meshes.terrain->Deserialize( buf.ReadNested() );
+	m_meshes.terrain_data->Deserialize( buf.ReadNested() );
+	m_textures.terrain->Deserialize( buf.ReadNested() );
 
 	size_t sz = buf.ReadInt();
 	m_sprite_actors.clear();
@@ -283,20 +295,20 @@ const MapState* Map::GetMapState() const {
 
 void Map::ClearTexture() {
 	ASSERT( m_map_state, "map state not set" );
-	ASSERT( m_current_ts, "ClearTexture called outside of tile generation" );
+	ASSERT( s_tile_context, "ClearTexture called outside of tile generation" );
 	for ( auto lt = 0 ; lt < tile::LAYER_MAX ; lt++ ) {
 		m_textures.terrain->Erase(
-			m_current_ts->tex_coord.x1,
-			lt * m_map_state->dimensions.y * s_consts.tc.texture_pcx.dimensions.y + m_current_ts->tex_coord.y1,
-			m_current_ts->tex_coord.x2 - 1,
-			lt * m_map_state->dimensions.y * s_consts.tc.texture_pcx.dimensions.y + m_current_ts->tex_coord.y2 - 1
+			s_tile_context->ts->tex_coord.x1,
+			lt * m_map_state->dimensions.y * s_consts.tc.texture_pcx.dimensions.y + s_tile_context->ts->tex_coord.y1,
+			s_tile_context->ts->tex_coord.x2 - 1,
+			lt * m_map_state->dimensions.y * s_consts.tc.texture_pcx.dimensions.y + s_tile_context->ts->tex_coord.y2 - 1
 		);
 	}
 }
 
 void Map::AddTexture( const tile::tile_layer_type_t tile_layer, const pcx_texture_coordinates_t& tc, const types::texture::add_flag_t mode, const uint8_t rotate, const float alpha, util::Perlin* perlin ) {
 	ASSERT( m_map_state, "map state not set" );
-	ASSERT( m_current_ts, "AddTexture called outside of tile generation" );
+	ASSERT( s_tile_context, "AddTexture called outside of tile generation" );
 	ASSERT( m_textures.terrain, "terrain texture not set" );
 	m_textures.terrain->AddFrom(
 		m_textures.source.texture_pcx,
@@ -305,8 +317,8 @@ void Map::AddTexture( const tile::tile_layer_type_t tile_layer, const pcx_textur
 		tc.y,
 		tc.x + s_consts.tc.texture_pcx.dimensions.x - 1,
 		tc.y + s_consts.tc.texture_pcx.dimensions.y - 1,
-		m_current_ts->tex_coord.x1,
-		tile_layer * m_map_state->dimensions.y * s_consts.tc.texture_pcx.dimensions.y + m_current_ts->tex_coord.y1,
+		s_tile_context->ts->tex_coord.x1,
+		tile_layer * m_map_state->dimensions.y * s_consts.tc.texture_pcx.dimensions.y + s_tile_context->ts->tex_coord.y1,
 		rotate,
 		alpha,
 		GetRandom(),
@@ -316,7 +328,7 @@ void Map::AddTexture( const tile::tile_layer_type_t tile_layer, const pcx_textur
 
 void Map::CopyTextureFromLayer( const tile::tile_layer_type_t tile_layer_from, const size_t tx_from, const size_t ty_from, const tile::tile_layer_type_t tile_layer, const types::texture::add_flag_t mode, const uint8_t rotate, const float alpha, util::Perlin* perlin ) {
 	ASSERT( m_map_state, "map state not set" );
-	ASSERT( m_current_ts, "CopyTextureFromLayer called outside of tile generation" );
+	ASSERT( s_tile_context, "CopyTextureFromLayer called outside of tile generation" );
 	m_textures.terrain->AddFrom(
 		m_textures.terrain,
 		mode,
@@ -324,8 +336,8 @@ void Map::CopyTextureFromLayer( const tile::tile_layer_type_t tile_layer_from, c
 		tile_layer_from * m_map_state->dimensions.y * s_consts.tc.texture_pcx.dimensions.y + ty_from,
 		tx_from + s_consts.tc.texture_pcx.dimensions.x - 1,
 		tile_layer_from * m_map_state->dimensions.y * s_consts.tc.texture_pcx.dimensions.y + ty_from + s_consts.tc.texture_pcx.dimensions.y - 1,
-		m_current_ts->tex_coord.x1,
-		tile_layer * m_map_state->dimensions.y * s_consts.tc.texture_pcx.dimensions.y + m_current_ts->tex_coord.y1,
+		s_tile_context->ts->tex_coord.x1,
+		tile_layer * m_map_state->dimensions.y * s_consts.tc.texture_pcx.dimensions.y + s_tile_context->ts->tex_coord.y1,
 		rotate,
 		alpha,
 		GetRandom(),
@@ -334,11 +346,11 @@ void Map::CopyTextureFromLayer( const tile::tile_layer_type_t tile_layer_from, c
 };
 
 void Map::CopyTexture( const tile::tile_layer_type_t tile_layer_from, const tile::tile_layer_type_t tile_layer, const types::texture::add_flag_t mode, const uint8_t rotate, const float alpha, util::Perlin* perlin ) {
-	ASSERT( m_current_ts, "CopyTexture called outside of tile generation" );
+	ASSERT( s_tile_context, "CopyTexture called outside of tile generation" );
 	CopyTextureFromLayer(
 		tile_layer_from,
-		m_current_ts->tex_coord.x1,
-		m_current_ts->tex_coord.y1,
+		s_tile_context->ts->tex_coord.x1,
+		s_tile_context->ts->tex_coord.y1,
 		tile_layer,
 		mode,
 		rotate,
@@ -349,16 +361,16 @@ void Map::CopyTexture( const tile::tile_layer_type_t tile_layer_from, const tile
 
 void Map::CopyTextureDeferred( const tile::tile_layer_type_t tile_layer_from, const size_t tx_from, const size_t ty_from, const tile::tile_layer_type_t tile_layer, const types::texture::add_flag_t mode, const uint8_t rotate, const float alpha, util::Perlin* perlin ) {
 	ASSERT( m_map_state, "map state not set" );
-	ASSERT( m_current_ts, "CopyTextureDeferred called outside of tile generation" );
-	m_map_state->copy_from_after.push_back(
+	ASSERT( s_tile_context, "CopyTextureDeferred called outside of tile generation" );
+	s_tile_context->generation->copy_from_after.push_back(
 		{
 			mode,
 			tx_from,
 			tile_layer_from * m_map_state->dimensions.y * s_consts.tc.texture_pcx.dimensions.y + ty_from,
 			tx_from + s_consts.tc.texture_pcx.dimensions.x - 1,
 			tile_layer_from * m_map_state->dimensions.y * s_consts.tc.texture_pcx.dimensions.y + ty_from + s_consts.tc.texture_pcx.dimensions.y - 1,
-			(size_t)m_current_ts->tex_coord.x1,
-			tile_layer * m_map_state->dimensions.y * s_consts.tc.texture_pcx.dimensions.y + (size_t)m_current_ts->tex_coord.y1,
+			(size_t)s_tile_context->ts->tex_coord.x1,
+			tile_layer * m_map_state->dimensions.y * s_consts.tc.texture_pcx.dimensions.y + (size_t)s_tile_context->ts->tex_coord.y1,
 			rotate,
 			alpha,
 			perlin
@@ -367,7 +379,7 @@ void Map::CopyTextureDeferred( const tile::tile_layer_type_t tile_layer_from, co
 };
 
 void Map::GetTexture( types::texture::Texture* dest_texture, const pcx_texture_coordinates_t& tc, const types::texture::add_flag_t mode, const uint8_t rotate, const float alpha ) {
-	ASSERT( m_current_ts, "GetTexture called outside of tile generation" );
+	ASSERT( s_tile_context, "GetTexture called outside of tile generation" );
 	ASSERT( dest_texture->GetWidth() == s_consts.tc.texture_pcx.dimensions.x, "tile dest texture width mismatch" );
 	ASSERT( dest_texture->GetHeight() == s_consts.tc.texture_pcx.dimensions.y, "tile dest texture height mismatch" );
 	dest_texture->AddFrom(
@@ -406,7 +418,7 @@ void Map::GetTextureFromLayer( types::texture::Texture* dest_texture, const tile
 
 void Map::SetTexture( const tile::tile_layer_type_t tile_layer, tile::TileState* ts, types::texture::Texture* src_texture, const types::texture::add_flag_t mode, const uint8_t rotate, const float alpha ) {
 	ASSERT( m_map_state, "map state not set" );
-	ASSERT( m_current_ts, "SetTexture called outside of tile generation" );
+	ASSERT( s_tile_context, "SetTexture called outside of tile generation" );
 	ASSERT( m_textures.terrain, "terrain texture not set" );
 	ASSERT( src_texture->GetWidth() == s_consts.tc.texture_pcx.dimensions.x, "tile src texture width mismatch" );
 	ASSERT( src_texture->GetHeight() == s_consts.tc.texture_pcx.dimensions.y, "tile src texture height mismatch" );
@@ -426,11 +438,11 @@ void Map::SetTexture( const tile::tile_layer_type_t tile_layer, tile::TileState*
 }
 
 void Map::SetTexture( const tile::tile_layer_type_t tile_layer, types::texture::Texture* src_texture, const types::texture::add_flag_t mode, const uint8_t rotate, const float alpha ) {
-	SetTexture( tile_layer, m_current_ts, src_texture, mode, rotate, alpha );
+	SetTexture( tile_layer, s_tile_context->ts, src_texture, mode, rotate, alpha );
 }
 
 const Map::tile_texture_info_t Map::GetTileTextureInfo( const texture_variants_type_t type, const tile::Tile* tile, const tile_grouping_criteria_t criteria, const uint16_t value ) const {
-	ASSERT( m_current_ts, "GetTileTextureInfo called outside of tile generation" );
+	ASSERT( s_tile_context, "GetTileTextureInfo called outside of tile generation" );
 	Map::tile_texture_info_t info;
 
 	bool matches[16] = {};
@@ -515,7 +527,10 @@ const Map::tile_texture_info_t Map::GetTileTextureInfo( const texture_variants_t
 	return info;
 }
 
-Random* Map::GetRandom() const {
+util::random::Random* Map::GetRandom() const {
+	if ( s_tile_context ) {
+		return s_tile_context->random;
+	}
 	return m_game->GetRandom();
 }
 
@@ -652,7 +667,7 @@ const Map::error_code_t Map::Generate( settings::MapSettings* map_settings, MT_C
 	// if crash happens - it's handy to have a map file to reproduce it
 	if ( !c->HasLaunchFlag( config::Config::LF_QUICKSTART_MAP_FILE ) ) { // no point saving if we just loaded it
 		Log( (std::string)"Saving map to " + c->GetDebugPath() + s_consts.debug.lastmap_filename );
-		util::FS::WriteFile( c->GetDebugPath() + s_consts.debug.lastmap_filename, m_tiles->Serialize().ToString() );
+		util::FS::WriteFile( c->GetDebugPath() + s_consts.debug.lastmap_filename, SerializeFile().ToStringView() );
 	}
 #endif
 
@@ -681,16 +696,43 @@ const Map::error_code_t Map::LoadFromFile( const std::string& path ) {
 
 	Log( "Loading map from " + path );
 	auto b = types::Buffer( util::FS::ReadTextFile( path ) );
+	if ( b.IsNextString() ) {
+		try {
+			if ( b.ReadString() != s_consts.fs.file_signature ) {
+				THROW( "invalid map file signature" );
+			}
+			const auto version = b.ReadInt();
+			if ( version > s_consts.fs.file_version ) {
+				THROW( "unsupported map file version ( " + std::to_string( version ) + " )" );
+			}
+		}
+		catch ( std::runtime_error& e ) {
+			Log( e.what() );
+			return EC_MAPFILE_FORMAT_ERROR;
+		}
+	}
+	else {
+		Log( "Map file has no header, reading as legacy format" );
+		b.SetChecksumVersion( types::Buffer::CV_XOR );
+	}
 	return LoadFromBuffer( b );
 }
 
 void Map::SaveToBuffer( types::Buffer& buffer ) const {
-	buffer.WriteString( m_tiles->Serialize().ToString() );
+	buffer.WriteNested( *m_tiles );
+}
+
+const types::Buffer Map::SerializeFile() const {
+	types::Buffer buf;
+	buf.WriteString( s_consts.fs.file_signature );
+	buf.WriteInt( s_consts.fs.file_version );
+	m_tiles->Serialize( buf );
+	return buf;
 }
 
 const Map::error_code_t Map::SaveToFile( const std::string& path ) const {
 	try {
-		util::FS::WriteFile( path, m_tiles->Serialize().ToString() );
+		util::FS::WriteFile( path, SerializeFile().ToStringView() );
 		return EC_NONE;
 	}
 	catch ( std::runtime_error& e ) {
@@ -748,9 +790,6 @@ const Map::error_code_t Map::Initialize( MT_CANCELABLE ) {
 
 	m_map_state->first_run = false;
 
-	m_current_tile = nullptr;
-	m_current_ts = nullptr;
-
 	return EC_NONE;
 }
 
@@ -779,8 +818,9 @@ void Map::InitTextureAndMesh() {
 	m_map_state->ter1_pcx = m_textures.source.ter1_pcx;
 }
 
-void Map::ProcessTiles( module_passes_t& module_passes, const tiles_t& tiles, MT_CANCELABLE ) {
+void Map::ProcessTiles( module_passes_t& module_passes, const tiles_t& tiles, tile_generations_t& generations, MT_CANCELABLE ) {
 	ASSERT( m_map_state, "map state not set" );
+	ASSERT( generations.size() == tiles.size(), "tile generations size mismatch" );
 
 	// small optimization to avoid reallocations
 	const size_t percent_len = 2;
@@ -797,56 +837,150 @@ void Map::ProcessTiles( module_passes_t& module_passes, const tiles_t& tiles, MT
 
 	uint8_t percent = 0, last_percent = 0;
 
-	size_t state_iterate_eta = ITERATE_STATE_EVERY_N_TILES;
+	const auto f_update_progress = [ this, &tile_i, &total, &percent, &last_percent, &sp, &percent_len, &loading_text, &percent_pos ]( const size_t processed ) {
+		tile_i += processed;
+		percent = (uint8_t)ceil( ( (float)tile_i * 100.0f / total ) ) - 1;
 
-	for ( auto& module_pass : module_passes ) {
-		for ( const auto& tile : tiles ) {
-			m_current_tile = tile;
-			m_current_ts = GetTileState( tile->coord.x, tile->coord.y );
+		if ( percent != last_percent ) {
+			last_percent = percent;
+			sp = std::to_string( percent );
+			if ( sp.size() < percent_len ) {
+				sp = std::string( percent_len - sp.size(), ' ' ) + sp;
+			}
+			loading_text.replace( percent_pos, sp.size(), sp.c_str() );
+			m_game->SetLoaderText( loading_text );
+		}
+	};
 
-			for ( auto& m : module_pass ) {
+	auto* pool = g_engine->GetThreadPool();
 
-				m->GenerateTile( m_current_tile, m_current_ts, m_map_state );
+	// parallel passes are split into batches so that loader text and state keep updating
+	const size_t batch_size = ITERATE_STATE_EVERY_N_TILES * pool->GetConcurrency();
 
-				tile_i++;
-				percent = (uint8_t)ceil( ( (float)tile_i * 100.0f / total ) ) - 1;
+	size_t state_iterate_eta = ITERATE_STATE_EVERY_N_TILES;
 
-				if ( percent != last_percent ) {
-					last_percent = percent;
-					sp = std::to_string( percent );
-					if ( sp.size() < percent_len ) {
-						sp = std::string( percent_len - sp.size(), ' ' ) + sp;
-					}
-					loading_text.replace( percent_pos, sp.size(), sp.c_str() );
-					m_game->SetLoaderText( loading_text );
+	for ( auto& module_pass : module_passes ) {
+
+		bool is_parallel = pool->GetWorkersCount() > 0;
+		for ( auto& m : module_pass ) {
+			if ( !m->IsParallelizable() ) {
+				is_parallel = false;
+				break;
+			}
+		}
+
+		if ( is_parallel ) {
+			const auto f_process_range = [ this, &module_pass, &tiles, &generations ]( const size_t from, const size_t to ) {
+				for ( size_t i = from ; i < to ; i++ ) {
+					ProcessTile( module_pass, tiles.at( i ), generations.at( i ) );
 				}
+			};
+			for ( size_t from = 0 ; from < tiles.size() ; from += batch_size ) {
+				const size_t to = std::min( from + batch_size, tiles.size() );
 
+				pool->ParallelFor( from, to, f_process_range, MT_C );
 				MT_RETIF();
-			}
 
-			if ( !--state_iterate_eta ) {
+				f_update_progress( ( to - from ) * module_pass.size() );
+
 				// keep processing state (i.e. network events) while loading
 				m_game->GetState()->Iterate();
-				state_iterate_eta = ITERATE_STATE_EVERY_N_TILES;
 			}
 		}
+		else {
+			for ( size_t i = 0 ; i < tiles.size() ; i++ ) {
+
+				ProcessTile( module_pass, tiles.at( i ), generations.at( i ) );
+
+				f_update_progress( module_pass.size() );
+
+				MT_RETIF();
+
+				if ( !--state_iterate_eta ) {
+					// keep processing state (i.e. network events) while loading
+					m_game->GetState()->Iterate();
+					state_iterate_eta = ITERATE_STATE_EVERY_N_TILES;
+				}
+			}
+		}
+	}
+}
+
+void Map::ProcessTile( const module_pass_t& module_pass, const tile::Tile* tile, tile_generation_t& generation ) {
+	util::random::Random random( generation.random_state );
+	tile_context_t context = {
+		GetTileState( tile->coord.x, tile->coord.y ),
+		&random,
+		&generation
+	};
+
+	ASSERT( !s_tile_context, "tile context already set" );
+	s_tile_context = &context;
+	try {
+		for ( auto& m : module_pass ) {
+			m->GenerateTile( tile, context.ts, m_map_state );
+		}
+	}
+	catch ( ... ) {
+		// worker threads will keep running after exception
+		s_tile_context = nullptr;
+		throw;
+	}
+	s_tile_context = nullptr;
+
+	generation.random_state = random.GetState();
+}
+
+const Map::tile_generations_t Map::GetTileGenerations( const tiles_t& tiles ) {
+	// one value from game random per load, tile streams are derived from it and tile coordinates
+	const auto seed = m_game->GetRandom()->GetUInt();
+	tile_generations_t generations( tiles.size() );
+	for ( size_t i = 0 ; i < tiles.size() ; i++ ) {
+		const auto* tile = tiles.at( i );
+		generations.at( i ).random_state = util::random::Random::GetSeedState( seed + (util::random::value_t)( tile->coord.y * m_map_state->dimensions.x + tile->coord.x ) * 0x9e3779b9 );
 	}
+	return generations;
 }
 
 void Map::LoadTiles( const tiles_t& tiles, MT_CANCELABLE ) {
 
 	Log( "Loading " + std::to_string( tiles.size() ) + " tiles" );
 
-	ProcessTiles( m_modules, tiles, MT_C );
+	auto generations = GetTileGenerations( tiles );
+
+	ProcessTiles( m_modules, tiles, generations, MT_C );
 	MT_RETIF();
 
-	for ( auto& c : m_map_state->copy_from_after ) {
-		m_textures.terrain->AddFrom( m_textures.terrain, c.mode, c.tx1_from, c.ty1_from, c.tx2_from, c.ty2_from, c.tx_to, c.ty_to, c.rotate, c.alpha, GetRandom(), c.perlin );
-	}
-	m_map_state->copy_from_after.clear();
+	// every copy reads from land layer and writes to water layer of own tile, so tiles don't interfere with each other
+	g_engine->GetThreadPool()->ParallelFor(
+		0, tiles.size(), [ this, &generations ]( const size_t from, const size_t to ) {
+			for ( size_t i = from ; i < to ; i++ ) {
+				auto& generation = generations.at( i );
+				if ( generation.copy_from_after.empty() ) {
+					continue;
+				}
+				util::random::Random random( generation.random_state );
+				for ( auto& c : generation.copy_from_after ) {
+					m_textures.terrain->AddFrom( m_textures.terrain, c.mode, c.tx1_from, c.ty1_from, c.tx2_from, c.ty2_from, c.tx_to, c.ty_to, c.rotate, c.alpha, &random, c.perlin );
+				}
+				generation.copy_from_after.clear();
+				generation.random_state = random.GetState();
+			}
+		}, MT_C
+	);
 	MT_RETIF();
 
-	ProcessTiles( m_modules_deferred, tiles, MT_C );
+	ProcessTiles( m_modules_deferred, tiles, generations, MT_C );
+	MT_RETIF();
+}
+
+void Map::LoadSprites( const tiles_t& tiles, MT_CANCELABLE ) {
+
+	Log( "Loading sprites of " + std::to_string( tiles.size() ) + " tiles" );
+
+	auto generations = GetTileGenerations( tiles );
+
+	ProcessTiles( m_modules_sprites, tiles, generations, MT_C );
 	MT_RETIF();
 }
 
@@ -923,19 +1057,24 @@ void Map::FixNormals( const tiles_t& tiles, MT_CANCELABLE ) {
 		f_combine_normals_maybe( tile->SE );
 	}
 
-	// average center normals
-	for ( const auto& tile : tiles ) {
-		auto* ts = GetTileState( tile->coord.x, tile->coord.y );
-
-		m_meshes.terrain->SetVertexNormal(
-			ts->layers[ tile::LAYER_LAND ].indices.center, (
-				m_meshes.terrain->GetVertexNormal( ts->layers[ tile::LAYER_LAND ].indices.left ) +
-					m_meshes.terrain->GetVertexNormal( ts->layers[ tile::LAYER_LAND ].indices.top ) +
-					m_meshes.terrain->GetVertexNormal( ts->layers[ tile::LAYER_LAND ].indices.right ) +
-					m_meshes.terrain->GetVertexNormal( ts->layers[ tile::LAYER_LAND ].indices.bottom )
-			) / 4
-		);
-	}
+	// average center normals ( every tile writes only to it's own center vertex, so it's safe to do in parallel )
+	g_engine->GetThreadPool()->ParallelFor(
+		0, tiles.size(), [ this, &tiles ]( const size_t from, const size_t to ) {
+			for ( size_t i = from ; i < to ; i++ ) {
+				const auto* tile = tiles[ i ];
+				const auto* ts = GetTileState( tile->coord.x, tile->coord.y );
+
+				m_meshes.terrain->SetVertexNormal(
+					ts->layers[ tile::LAYER_LAND ].indices.center, (
+						m_meshes.terrain->GetVertexNormal( ts->layers[ tile::LAYER_LAND ].indices.left ) +
+							m_meshes.terrain->GetVertexNormal( ts->layers[ tile::LAYER_LAND ].indices.top ) +
+							m_meshes.terrain->GetVertexNormal( ts->layers[ tile::LAYER_LAND ].indices.right ) +
+							m_meshes.terrain->GetVertexNormal( ts->layers[ tile::LAYER_LAND ].indices.bottom )
+					) / 4
+				);
+			}
+		}, MT_C
+	);
 }
 
 void Map::CalculateTextureVariants( const texture_variants_type_t type, const texture_variants_rules_t& rules ) {
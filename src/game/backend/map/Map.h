@@ -10,6 +10,7 @@
 #include "common/MTTypes.h"
 #include "game/backend/map/tile/Types.h"
 #include "types/texture/Types.h"
+#include "util/random/Types.h"
 
 #include "types/Buffer.h"
 
@@ -25,6 +26,9 @@ class Data;
 
 namespace util {
 class Perlin;
+namespace random {
+class Random;
+}
 }
 
 namespace game {
@@ -74,6 +78,7 @@ CLASS( Map, types::Serializable )
 	const error_code_t Initialize( MT_CANCELABLE );
 
 	const types::Buffer Serialize() const override;
+	void Serialize( types::Buffer& buf ) const override;
 	void Deserialize( types::Buffer buf ) override;
 
 	static const std::string& GetErrorString( const error_code_t& code );
@@ -111,7 +116,8 @@ CLASS( Map, types::Serializable )
 	void SetTexture( const tile::tile_layer_type_t tile_layer, types::texture::Texture* src_texture, const types::texture::add_flag_t mode, const uint8_t rotate = 0, const float alpha = 1.0f );
 
 	const tile_texture_info_t GetTileTextureInfo( const texture_variants_type_t type, const tile::Tile* tile, const tile_grouping_criteria_t criteria, const tile::feature_t feature = tile::FEATURE_NONE ) const;
-	Random* GetRandom() const;
+	// during tile generation returns random stream of current tile, otherwise game random
+	util::random::Random* GetRandom() const;
 
 	const size_t GetWidth() const;
 	const size_t GetHeight() const;
@@ -130,6 +136,9 @@ private:
 	friend class module::Finalize;
 	friend class backend::Game;
 
+	// tiles with file header
+	const types::Buffer SerializeFile() const;
+
 	struct {
 		types::mesh::Render* terrain = nullptr;
 		types::mesh::Data* terrain_data = nullptr;
@@ -166,10 +175,30 @@ private:
 	typedef std::vector< module_pass_t > module_passes_t;
 	module_passes_t m_modules; // before finalizing and deferred calls
 	module_passes_t m_modules_deferred; // after finalizing and deferred calls
+	module_passes_t m_modules_sprites; // last of deferred passes, for when only sprites of tiles need to change ( not owned )
+
+	// per-tile data that lives across all passes of LoadTiles
+	struct tile_generation_t {
+		// every tile has own random stream so that results don't depend on order ( or thread ) in which tiles are processed
+		util::random::state_t random_state;
+		std::vector< copy_from_after_t > copy_from_after;
+	};
+	typedef std::vector< tile_generation_t > tile_generations_t;
+
+	// per-thread because tiles may be processed in parallel, set only while tile is being generated
+	struct tile_context_t {
+		tile::TileState* ts;
+		util::random::Random* random;
+		tile_generation_t* generation;
+	};
+	static thread_local tile_context_t* s_tile_context;
 
 	void InitTextureAndMesh();
-	void ProcessTiles( module_passes_t& module_passes, const tiles_t& tiles, MT_CANCELABLE );
+	void ProcessTiles( module_passes_t& module_passes, const tiles_t& tiles, tile_generations_t& generations, MT_CANCELABLE );
+	void ProcessTile( const module_pass_t& module_pass, const tile::Tile* tile, tile_generation_t& generation );
+	const tile_generations_t GetTileGenerations( const tiles_t& tiles );
 	void LoadTiles( const tiles_t& tiles, MT_CANCELABLE );
+	void LoadSprites( const tiles_t& tiles, MT_CANCELABLE );
 	void FixNormals( const tiles_t& tiles, MT_CANCELABLE );
 
 	// texture.pcx contains some textures grouped in certain way based on adjactent neighbours
@@ -183,9 +212,6 @@ private:
 	std::unordered_map< texture_variants_type_t, texture_variants_t > m_texture_variants = {};
 	void CalculateTextureVariants( const texture_variants_type_t type, const texture_variants_rules_t& rules );
 
-	tile::TileState* m_current_ts = nullptr;
-	const tile::Tile* m_current_tile = nullptr;
-
 };
 
 }
@@ -81,9 +81,7 @@ void MapState::LinkTileStates( MT_CANCELABLE ) {
 	}
 }
 
-const types::Buffer MapState::Serialize() const {
-	types::Buffer buf;
-
+void MapState::Serialize( types::Buffer& buf ) const {
 	buf.WriteBool( first_run );
 	buf.WriteVec2f( coord );
 	buf.WriteVec2u( dimensions );
@@ -93,13 +91,9 @@ const types::Buffer MapState::Serialize() const {
 	for ( auto y = 0 ; y < dimensions.y ; y++ ) {
 		for ( auto x = y & 1 ; x < dimensions.x ; x += 2 ) {
 			const auto* ts = AtConst( x, y );
-			const auto b = ts->Serialize();
-			const auto s = b.ToString();
-			buf.WriteString( s );
+			buf.WriteNested( [ ts ]( types::Buffer& b ) { ts->Serialize( b ); } );
 		}
 	}
-
-	return buf;
 }
 
 void MapState::Deserialize( types::Buffer buf ) {
@@ -115,11 +109,9 @@ void MapState::Deserialize( types::Buffer buf ) {
 
 	for ( auto y = 0 ; y < dimensions.y ; y++ ) {
 		for ( auto x = y & 1 ; x < dimensions.x ; x += 2 ) {
-			At( x, y )->Deserialize( buf.ReadString() );
+			At( x, y )->Deserialize( buf.ReadNested() );
 		}
 	}
-
-	copy_from_after.clear();
 }
 
 }
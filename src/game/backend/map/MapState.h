@@ -17,10 +17,6 @@ namespace types {
 class Texture;
 }
 
-namespace util {
-class Perlin;
-}
-
 namespace game {
 namespace backend {
 namespace map {
@@ -29,26 +25,12 @@ CLASS( MapState, common::Class )
 
 	~MapState();
 
-	struct copy_from_after_t {
-		types::texture::add_flag_t mode;
-		size_t tx1_from;
-		size_t ty1_from;
-		size_t tx2_from;
-		size_t ty2_from;
-		size_t tx_to;
-		size_t ty_to;
-		uint8_t rotate;
-		float alpha;
-		util::Perlin* perlin = nullptr;
-	};
-
 	bool first_run;
 	types::Vec2< float > coord;
 	types::Vec2< uint32_t > dimensions;
 	struct {
 		types::Vec2< float > texture_scaling;
 	} variables;
-	std::vector< copy_from_after_t > copy_from_after;
 
 	const types::texture::Texture* terrain_texture;
 	const types::texture::Texture* ter1_pcx;
@@ -59,7 +41,7 @@ CLASS( MapState, common::Class )
 
 	void LinkTileStates( MT_CANCELABLE );
 
-	const types::Buffer Serialize() const;
+	void Serialize( types::Buffer& buf ) const;
 	void Deserialize( types::Buffer buf );
 
 private:
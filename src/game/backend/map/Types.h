@@ -1,8 +1,14 @@
 #pragma once
 
 #include <cstdint>
+#include <string>
 
 #include "types/Vec2.h"
+#include "types/texture/Types.h"
+
+namespace util {
+class Perlin;
+}
 
 namespace game {
 namespace backend {
@@ -17,6 +23,20 @@ struct sprite_actor_t {
 	float z_index = 0.5f;
 };
 
+// terrain texture copy that needs to wait until all tiles are generated
+struct copy_from_after_t {
+	types::texture::add_flag_t mode;
+	size_t tx1_from;
+	size_t ty1_from;
+	size_t tx2_from;
+	size_t ty2_from;
+	size_t tx_to;
+	size_t ty_to;
+	uint8_t rotate;
+	float alpha;
+	util::Perlin* perlin = nullptr;
+};
+
 }
 }
 }
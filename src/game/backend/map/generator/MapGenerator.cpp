@@ -5,6 +5,7 @@
 #include "game/backend/map/Consts.h"
 #include "game/backend/map/tile/Tiles.h"
 #include "engine/Engine.h"
+#include "common/ThreadPool.h"
 #include "ui_legacy/UI.h"
 #include "util/Clamper.h"
 #include "util/random/Random.h"
@@ -214,17 +215,24 @@ void MapGenerator::SetLandAmount( tile::Tiles* tiles, const float amount, MT_CAN
 }
 
 const float MapGenerator::GetLandAmount( tile::Tiles* tiles, MT_CANCELABLE, tile::elevation_t elevation_diff ) {
-	size_t land_tiles = 0;
+	// called repeatedly while bisecting, so rows are counted in parallel
+	std::atomic< size_t > land_tiles = 0;
 	const auto w = tiles->GetWidth();
 	const auto h = tiles->GetHeight();
-	for ( auto y = 0 ; y < h ; y++ ) {
-		for ( auto x = y & 1 ; x < w ; x += 2 ) {
-			if ( *tiles->AtConst( x, y ).elevation.center > -elevation_diff ) {
-				land_tiles++;
+	g_engine->GetThreadPool()->ParallelFor(
+		0, h, [ tiles, w, elevation_diff, &land_tiles ]( const size_t from, const size_t to ) {
+			size_t count = 0;
+			for ( auto y = from ; y < to ; y++ ) {
+				for ( auto x = y & 1 ; x < w ; x += 2 ) {
+					if ( *tiles->AtConst( x, y ).elevation.center > -elevation_diff ) {
+						count++;
+					}
+				}
 			}
-			MT_RETIFV( 0.0f );
-		}
-	}
+			land_tiles += count;
+		}, MT_C
+	);
+	MT_RETIFV( 0.0f );
 	return (float)land_tiles / ( w * h / 2 );
 }
 
@@ -1,4 +1,5 @@
 #include <cmath>
+#include <array>
 
 #include "SimplePerlin.h"
 
@@ -7,6 +8,8 @@
 #include "util/Clamper.h"
 
 #include "game/backend/map/tile/Tiles.h"
+#include "engine/Engine.h"
+#include "common/ThreadPool.h"
 
 // higher values generate more interesting maps, at cost of longer map generation (isn't noticeable before 200 or so)
 #define PERLIN_PASSES 128
@@ -61,23 +64,36 @@ void SimplePerlin::GenerateElevations( tile::Tiles* tiles, const backend::settin
 	std::vector< tile::Tile* > randomtiles = GetTilesInRandomOrder( tiles, MT_C );
 	MT_RETIF();
 
-	for ( auto& tile : randomtiles ) {
-
 #define PERLIN_S( _x, _y, _z, _scale ) perlin.Noise( (float) ( (float)_x ) * _scale, (float) ( (float)_y ) * _scale, _z * _scale, PERLIN_PASSES )
 #define PERLIN( _x, _y, _z ) PERLIN_S( _x, _y, _z, 1.0f )
 
-		*tile->elevation.left = *tile->elevation.top = *tile->elevation.right = *tile->elevation.bottom = *tile->elevation.center = 0;
-
-		const float z_elevation = 0;
-
-		*tile->elevation.left = perlin_to_elevation.Clamp( PERLIN( tile->coord.x, tile->coord.y + 0.5f, z_elevation ) );
-		*tile->elevation.top = perlin_to_elevation.Clamp( PERLIN( tile->coord.x + 0.5f, tile->coord.y, z_elevation ) );
-		*tile->elevation.right = perlin_to_elevation.Clamp( PERLIN( tile->coord.x + 1.0f, tile->coord.y + 0.5f, z_elevation ) );
-		*tile->elevation.bottom = perlin_to_elevation.Clamp( PERLIN( tile->coord.x + 0.5f, tile->coord.y + 1.0f, z_elevation ) );
+	// noise is the slowest part and depends only on tile coordinates, so it's calculated in parallel
+	// corners are shared between neighbours, so results are applied in same random order as before
+	std::vector< std::array< tile::elevation_t, 4 > > corners( randomtiles.size() );
+	g_engine->GetThreadPool()->ParallelFor(
+		0, randomtiles.size(), [ &randomtiles, &corners, &perlin, &perlin_to_elevation ]( const size_t from, const size_t to ) {
+			const float z_elevation = 0;
+			for ( size_t i = from ; i < to ; i++ ) {
+				const auto* tile = randomtiles[ i ];
+				corners[ i ] = {
+					(tile::elevation_t)perlin_to_elevation.Clamp( PERLIN( tile->coord.x, tile->coord.y + 0.5f, z_elevation ) ),
+					(tile::elevation_t)perlin_to_elevation.Clamp( PERLIN( tile->coord.x + 0.5f, tile->coord.y, z_elevation ) ),
+					(tile::elevation_t)perlin_to_elevation.Clamp( PERLIN( tile->coord.x + 1.0f, tile->coord.y + 0.5f, z_elevation ) ),
+					(tile::elevation_t)perlin_to_elevation.Clamp( PERLIN( tile->coord.x + 0.5f, tile->coord.y + 1.0f, z_elevation ) ),
+				};
+			}
+		}, MT_C
+	);
+	MT_RETIF();
 
+	for ( size_t i = 0 ; i < randomtiles.size() ; i++ ) {
+		tile = randomtiles[ i ];
+		const auto& c = corners[ i ];
+		*tile->elevation.left = c[ 0 ];
+		*tile->elevation.top = c[ 1 ];
+		*tile->elevation.right = c[ 2 ];
+		*tile->elevation.bottom = c[ 3 ];
 		tile->Update();
-
-		MT_RETIF();
 	}
 
 	for ( auto y = 0 ; y < h ; y++ ) {
@@ -18,6 +18,9 @@ CLASS( Coastlines1, Coastlines )
 	~Coastlines1();
 
 	void GenerateTile( const tile::Tile* tile, tile::TileState* ts, MapState* ms ) override;
+	const bool IsParallelizable() const override {
+		return true;
+	}
 
 private:
 	util::Perlin* m_perlin = nullptr;
@@ -24,6 +24,10 @@ CLASS( Module, common::Class )
 
 	virtual void GenerateTile( const tile::Tile* tile, tile::TileState* ts, MapState* ms ) = 0;
 
+	// true if module only writes to own tile state and own area of terrain texture
+	// pass is processed in parallel if all of its modules are parallelizable
+	virtual const bool IsParallelizable() const;
+
 protected:
 	Map* const m_map;
 
@@ -13,6 +13,9 @@ CLASS( WaterSurface, Module )
 		: Module( map ) {}
 
 	void GenerateTile( const tile::Tile* tile, tile::TileState* ts, MapState* ms ) override;
+	const bool IsParallelizable() const override {
+		return true;
+	}
 
 };
 
@@ -79,6 +79,91 @@ void Tile::Clear() {
 	moisture = rockiness = bonus = features = terraforming = is_water_tile = 0;
 }
 
+void Tile::Touch( const attribute_t attribute, std::vector< Tile* >& dirty_tiles, const uint16_t flags ) {
+	ASSERT( ( attribute & ATTRIBUTES_BASE ) && !( attribute & ( attribute - 1 ) ), "expected one base attribute" );
+
+	// what needs to be recomputed for this tile, for neighbours and for neighbours of neighbours
+	attribute_t self = ATTRIBUTE_YIELDS;
+	attribute_t ring1 = ATTRIBUTE_NONE;
+	attribute_t ring2 = ATTRIBUTE_NONE;
+	switch ( attribute ) {
+		case ATTRIBUTE_ELEVATION: {
+			// corners are shared with neighbours, so their elevation and water state change too ( same as if they were touched ),
+			// coastlines are drawn up to 2 tiles away
+			self |= ATTRIBUTE_TEXTURES | ATTRIBUTE_SPRITES;
+			ring1 = self;
+			ring2 = ATTRIBUTE_TEXTURES;
+			break;
+		}
+		case ATTRIBUTE_MOISTURE: {
+			// farm sprites depend on moisture
+			self |= ATTRIBUTE_TEXTURES | ATTRIBUTE_SPRITES;
+			ring1 = ATTRIBUTE_TEXTURES;
+			break;
+		}
+		case ATTRIBUTE_ROCKINESS: {
+			self |= ATTRIBUTE_TEXTURES;
+			ring1 = ATTRIBUTE_TEXTURES;
+			break;
+		}
+		case ATTRIBUTE_BONUS: {
+			self |= ATTRIBUTE_SPRITES;
+			break;
+		}
+		case ATTRIBUTE_FEATURES: {
+			if ( flags & FEATURES_TEXTURED ) {
+				self |= ATTRIBUTE_TEXTURES;
+			}
+			if ( flags & FEATURES_BLENDED ) {
+				ring1 = ATTRIBUTE_TEXTURES;
+			}
+			if ( flags & FEATURES_SPRITES ) {
+				self |= ATTRIBUTE_SPRITES;
+			}
+			break;
+		}
+		case ATTRIBUTE_TERRAFORMING: {
+			if ( flags & TERRAFORMING_TEXTURED ) {
+				self |= ATTRIBUTE_TEXTURES;
+			}
+			if ( flags & TERRAFORMING_BLENDED ) {
+				ring1 = ATTRIBUTE_TEXTURES;
+			}
+			if ( flags & TERRAFORMING_SPRITES ) {
+				self |= ATTRIBUTE_SPRITES;
+			}
+			break;
+		}
+		default:
+			THROW( "unknown tile attribute: " + std::to_string( attribute ) );
+	}
+
+	Invalidate( self, dirty_tiles );
+	if ( ring1 | ring2 ) {
+		for ( auto& n : neighbours ) {
+			n->Invalidate( ring1 | ring2, dirty_tiles );
+			if ( ring2 ) {
+				for ( auto& nn : n->neighbours ) {
+					nn->Invalidate( ring2, dirty_tiles );
+				}
+			}
+		}
+	}
+}
+
+void Tile::Invalidate( const attribute_t attributes, std::vector< Tile* >& dirty_tiles ) {
+	ASSERT( !( attributes & ~ATTRIBUTES_DERIVED ), "only derived attributes can be invalidated" );
+	if ( !dirty && attributes ) {
+		dirty_tiles.push_back( this );
+	}
+	dirty |= attributes;
+}
+
+void Tile::Validate( const attribute_t attributes ) {
+	ASSERT( !( attributes & ~ATTRIBUTES_DERIVED ), "only derived attributes can be validated" );
+	dirty &= ~attributes;
+}
+
 const bool Tile::IsAdjactentTo( const Tile* other ) const {
 	for ( const auto& n : neighbours ) {
 		if ( n == other ) {
@@ -88,9 +173,7 @@ const bool Tile::IsAdjactentTo( const Tile* other ) const {
 	return false;
 }
 
-const types::Buffer Tile::Serialize() const {
-	types::Buffer buf;
-
+void Tile::Serialize( types::Buffer& buf ) const {
 	buf.WriteInt( coord.x );
 	buf.WriteInt( coord.y );
 
@@ -112,8 +195,6 @@ const types::Buffer Tile::Serialize() const {
 		buf.WriteString( y.first );
 		buf.WriteInt( y.second );
 	}
-
-	return buf;
 }
 
 void Tile::Deserialize( types::Buffer buf ) {
@@ -169,55 +250,27 @@ const std::string Tile::ToString() const {
 	NATIVE_CALL( this ) { return _n->Wrap( GSE_CALL ); } ) \
 }
 
-WRAPIMPL_BEGIN( Tile )
+WRAPIMPL_CACHED_BEGIN( Tile )
+	WRAPIMPL_LAZY_BEGIN
+		WRAPIMPL_LAZY_SHARED( "x", Int, self->coord.x )
+		WRAPIMPL_LAZY_SHARED( "y", Int, self->coord.y )
+		WRAPIMPL_LAZY_SHARED( "is_water", Bool, self->is_water_tile )
+		WRAPIMPL_LAZY_SHARED( "is_land", Bool, !self->is_water_tile )
+		WRAPIMPL_LAZY_SHARED( "moisture", Int, self->moisture )
+		WRAPIMPL_LAZY_SHARED( "rockiness", Int, self->rockiness )
+		WRAPIMPL_LAZY_SHARED( "elevation", Int, *self->elevation.center )
+		WRAPIMPL_LAZY_SHARED( "is_rocky", Bool, self->rockiness == ROCKINESS_ROCKY )
+		WRAPIMPL_LAZY_SHARED( "has_fungus", Bool, self->features & FEATURE_XENOFUNGUS )
+		WRAPIMPL_LAZY_SHARED( "has_river", Bool, self->features & FEATURE_RIVER )
+	WRAPIMPL_LAZY_END
 	WRAPIMPL_PROPS
-		{
-			"x",
-			VALUE( gse::value::Int,, coord.x )
-		},
-		{
-			"y",
-			VALUE( gse::value::Int,, coord.y )
-		},
 		{
 			"is_locked",
 			NATIVE_CALL( this ) {
 				N_EXPECT_ARGS(0);
-				return VALUE( gse::value::Bool,, m_is_locked );
+				return VALUE_SHARED( gse::value::Bool,, m_is_locked );
 			} )
 		},
-		{
-			"is_water",
-			VALUE( gse::value::Bool,, is_water_tile )
-		},
-		{
-			"is_land",
-			VALUE( gse::value::Bool,, !is_water_tile )
-		},
-		{
-			"moisture",
-			VALUE( gse::value::Int,, moisture )
-		},
-		{
-			"rockiness",
-			VALUE( gse::value::Int,, rockiness )
-		},
-		{
-			"elevation",
-			VALUE( gse::value::Int,, *elevation.center )
-		},
-		{
-			"is_rocky",
-			VALUE( gse::value::Bool,, rockiness == ROCKINESS_ROCKY )
-		},
-		{
-			"has_fungus",
-			VALUE( gse::value::Bool,, features & FEATURE_XENOFUNGUS )
-		},
-		{
-			"has_river",
-			VALUE( gse::value::Bool,, features & FEATURE_RIVER )
-		},
 		GETN( W ),
 		GETN( NW ),
 		GETN( N ),
@@ -231,7 +284,7 @@ WRAPIMPL_BEGIN( Tile )
 			NATIVE_CALL( this ) {
 				N_EXPECT_ARGS( 1 );
 				N_GETVALUE_UNWRAP( other, 0, Tile );
-				return VALUE( gse::value::Bool,, IsAdjactentTo( other ) );
+				return VALUE_SHARED( gse::value::Bool,, IsAdjactentTo( other ) );
 			})
 		},
 		{
@@ -264,12 +317,12 @@ WRAPIMPL_BEGIN( Tile )
 					return base->Wrap( GSE_CALL );
 				}
 				else {
-					return VALUE( gse::value::Null );
+					return VALUE_SHARED( gse::value::Null );
 				}
 			} )
 		},
 	};
-WRAPIMPL_END_PTR()
+WRAPIMPL_CACHED_END_PTR()
 
 UNWRAPIMPL_PTR( Tile )
 
@@ -78,6 +78,10 @@ public:
 
 	yields_t yields = {};
 
+	// derived attributes that were invalidated and need to be recomputed
+	// there are no per-attribute versions, dirty mask is enough for map editor and frontend compares tile views anyway
+	attribute_t dirty = ATTRIBUTE_NONE;
+
 	// units (id -> unit)
 	std::map< size_t, unit::Unit* > units = {};
 
@@ -91,9 +95,19 @@ public:
 	// reset to empty state
 	void Clear();
 
+	// call after changing base attribute of tile
+	//   invalidates derived attributes of this tile and of tiles around it that depend on it
+	//   flags are changed feature or terraforming bits, because only some of them affect textures or sprites
+	//   tiles that became dirty are appended to dirty_tiles
+	void Touch( const attribute_t attribute, std::vector< Tile* >& dirty_tiles, const uint16_t flags = 0 );
+	void Invalidate( const attribute_t attributes, std::vector< Tile* >& dirty_tiles );
+
+	// clears attributes from dirty ones, call after they were recomputed
+	void Validate( const attribute_t attributes );
+
 	const bool IsAdjactentTo( const Tile* other ) const;
 
-	const types::Buffer Serialize() const;
+	void Serialize( types::Buffer& buf ) const;
 	void Deserialize( types::Buffer data );
 
 	const std::string ToString() const;
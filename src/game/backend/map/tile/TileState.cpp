@@ -50,9 +50,7 @@ const types::Vec3& TileState::GetCenterCoords( tile_layer_type_t layer ) const {
 	return layers[ layer ].coords.center;
 }
 
-const types::Buffer TileState::Serialize() const {
-	types::Buffer buf;
-
+void TileState::Serialize( types::Buffer& buf ) const {
 	buf.WriteVec2f( coord );
 	buf.WriteFloat( tex_coord.x );
 	buf.WriteFloat( tex_coord.y );
@@ -60,22 +58,22 @@ const types::Buffer TileState::Serialize() const {
 	buf.WriteFloat( tex_coord.y1 );
 	buf.WriteFloat( tex_coord.x2 );
 	buf.WriteFloat( tex_coord.y2 );
-	buf.WriteString( elevations.Serialize().ToString() );
+	buf.WriteNested( [ this ]( types::Buffer& b ) { elevations.Serialize( b ); } );
 	buf.WriteInt( LAYER_MAX );
 	for ( auto i = 0 ; i < LAYER_MAX ; i++ ) {
-		buf.WriteString( layers[ i ].Serialize().ToString() );
+		buf.WriteNested( [ this, i ]( types::Buffer& b ) { layers[ i ].Serialize( b ); } );
 	}
-	buf.WriteString( SerializeTileVertices( overdraw_column.coords ).ToString() );
-	buf.WriteString( overdraw_column.indices.Serialize().ToString() );
-	buf.WriteString( overdraw_column.surfaces.Serialize().ToString() );
-	buf.WriteString( SerializeTileVertices( data_mesh.coords ).ToString() );
-	buf.WriteString( data_mesh.indices.Serialize().ToString() );
+	buf.WriteNested( [ this ]( types::Buffer& b ) { SerializeTileVertices( b, overdraw_column.coords ); } );
+	buf.WriteNested( [ this ]( types::Buffer& b ) { overdraw_column.indices.Serialize( b ); } );
+	buf.WriteNested( [ this ]( types::Buffer& b ) { overdraw_column.surfaces.Serialize( b ); } );
+	buf.WriteNested( [ this ]( types::Buffer& b ) { SerializeTileVertices( b, data_mesh.coords ); } );
+	buf.WriteNested( [ this ]( types::Buffer& b ) { data_mesh.indices.Serialize( b ); } );
 	buf.WriteBool( has_water );
 	buf.WriteBool( is_coastline_corner );
-	buf.WriteString( moisture_original->Serialize().ToString() );
+	buf.WriteNested( *moisture_original );
 	if ( river_original ) {
 		buf.WriteBool( true );
-		buf.WriteString( river_original->Serialize().ToString() );
+		buf.WriteNested( *river_original );
 	}
 	else {
 		buf.WriteBool( false );
@@ -88,57 +86,39 @@ const types::Buffer TileState::Serialize() const {
 		buf.WriteString( a.name );
 		buf.WriteVec2u( a.tex_coords );
 	}
-
-	return buf;
 }
 
-const types::Buffer TileState::tile_elevations_t::Serialize() const {
-	types::Buffer buf;
-
+void TileState::tile_elevations_t::Serialize( types::Buffer& buf ) const {
 	buf.WriteInt( center );
 	buf.WriteInt( left );
 	buf.WriteInt( top );
 	buf.WriteInt( right );
 	buf.WriteInt( bottom );
-
-	return buf;
 }
 
-const types::Buffer TileState::tile_layer_t::Serialize() const {
-	types::Buffer buf;
-
-	buf.WriteString( SerializeTileVertices( coords ).ToString() );
-	buf.WriteString( indices.Serialize().ToString() );
-	buf.WriteString( surfaces.Serialize().ToString() );
-	buf.WriteString( SerializeTileTexCoords( tex_coords ).ToString() );
-	buf.WriteString( SerializeTileColors( colors ).ToString() );
+void TileState::tile_layer_t::Serialize( types::Buffer& buf ) const {
+	buf.WriteNested( [ this ]( types::Buffer& b ) { SerializeTileVertices( b, coords ); } );
+	buf.WriteNested( [ this ]( types::Buffer& b ) { indices.Serialize( b ); } );
+	buf.WriteNested( [ this ]( types::Buffer& b ) { surfaces.Serialize( b ); } );
+	buf.WriteNested( [ this ]( types::Buffer& b ) { SerializeTileTexCoords( b, tex_coords ); } );
+	buf.WriteNested( [ this ]( types::Buffer& b ) { SerializeTileColors( b, colors ); } );
 	buf.WriteVec2f( texture_stretch );
 	buf.WriteBool( texture_stretch_at_edges );
-
-	return buf;
 }
 
-const types::Buffer TileState::tile_indices_t::Serialize() const {
-	types::Buffer buf;
-
+void TileState::tile_indices_t::Serialize( types::Buffer& buf ) const {
 	buf.WriteInt( center );
 	buf.WriteInt( left );
 	buf.WriteInt( top );
 	buf.WriteInt( right );
 	buf.WriteInt( bottom );
-
-	return buf;
 }
 
-const types::Buffer TileState::tile_surfaces_t::Serialize() const {
-	types::Buffer buf;
-
+void TileState::tile_surfaces_t::Serialize( types::Buffer& buf ) const {
 	buf.WriteInt( left_top );
 	buf.WriteInt( top_right );
 	buf.WriteInt( right_bottom );
 	buf.WriteInt( bottom_left );
-
-	return buf;
 }
 
 void TileState::Deserialize( types::Buffer buf ) {
@@ -149,18 +129,18 @@ void TileState::Deserialize( types::Buffer buf ) {
 	tex_coord.y1 = buf.ReadFloat();
 	tex_coord.x2 = buf.ReadFloat();
 	tex_coord.y2 = buf.ReadFloat();
-	elevations.Deserialize( buf.ReadString() );
+	elevations.Deserialize( buf.ReadNested() );
 	if ( (tile_layer_type_t)buf.ReadInt() != LAYER_MAX ) {
 		THROW( "LAYER_MAX mismatch" );
 	}
 	for ( auto i = 0 ; i < LAYER_MAX ; i++ ) {
-		layers[ i ].Deserialize( buf.ReadString() );
+		layers[ i ].Deserialize( buf.ReadNested() );
 	}
-	overdraw_column.coords = DeserializeTileVertices( buf.ReadString() );
-	overdraw_column.indices.Deserialize( buf.ReadString() );
-	overdraw_column.surfaces.Deserialize( buf.ReadString() );
-	data_mesh.coords = DeserializeTileVertices( buf.ReadString() );
-	data_mesh.indices.Deserialize( buf.ReadString() );
+	overdraw_column.coords = DeserializeTileVertices( buf.ReadNested() );
+	overdraw_column.indices.Deserialize( buf.ReadNested() );
+	overdraw_column.surfaces.Deserialize( buf.ReadNested() );
+	data_mesh.coords = DeserializeTileVertices( buf.ReadNested() );
+	data_mesh.indices.Deserialize( buf.ReadNested() );
 	has_water = buf.ReadBool();
 	is_coastline_corner = buf.ReadBool();
 
@@ -168,11 +148,11 @@ void TileState::Deserialize( types::Buffer buf ) {
 	const auto h = s_consts.tc.texture_pcx.dimensions.y;
 
 	NEW( moisture_original, types::texture::Texture, "MoistureOriginal", w, h );
-	moisture_original->Deserialize( buf.ReadString() );
+	moisture_original->Deserialize( buf.ReadNested() );
 	const bool has_river_original = buf.ReadBool();
 	if ( has_river_original ) {
 		NEW( river_original, types::texture::Texture, "RiverOriginal", w, h );
-		river_original->Deserialize( buf.ReadString() );
+		river_original->Deserialize( buf.ReadNested() );
 	}
 
 	const size_t sprites_count = buf.ReadInt();
@@ -188,16 +168,12 @@ void TileState::Deserialize( types::Buffer buf ) {
 
 }
 
-const types::Buffer TileState::SerializeTileVertices( const tile_vertices_t& vertices ) {
-	types::Buffer buf;
-
+void TileState::SerializeTileVertices( types::Buffer& buf, const tile_vertices_t& vertices ) {
 	buf.WriteVec3( vertices.center );
 	buf.WriteVec3( vertices.left );
 	buf.WriteVec3( vertices.top );
 	buf.WriteVec3( vertices.right );
 	buf.WriteVec3( vertices.bottom );
-
-	return buf;
 }
 
 const tile_vertices_t TileState::DeserializeTileVertices( types::Buffer buf ) {
@@ -215,16 +191,12 @@ const tile_vertices_t TileState::DeserializeTileVertices( types::Buffer buf ) {
 	};
 }
 
-const types::Buffer TileState::SerializeTileTexCoords( const tile_tex_coords_t& tex_coords ) {
-	types::Buffer buf;
-
+void TileState::SerializeTileTexCoords( types::Buffer& buf, const tile_tex_coords_t& tex_coords ) {
 	buf.WriteVec2f( tex_coords.center );
 	buf.WriteVec2f( tex_coords.left );
 	buf.WriteVec2f( tex_coords.top );
 	buf.WriteVec2f( tex_coords.right );
 	buf.WriteVec2f( tex_coords.bottom );
-
-	return buf;
 }
 
 const tile_tex_coords_t TileState::DeserializeTileTexCoords( types::Buffer buf ) {
@@ -242,16 +214,12 @@ const tile_tex_coords_t TileState::DeserializeTileTexCoords( types::Buffer buf )
 	};
 }
 
-const types::Buffer TileState::SerializeTileColors( const tile_colors_t& colors ) {
-	types::Buffer buf;
-
+void TileState::SerializeTileColors( types::Buffer& buf, const tile_colors_t& colors ) {
 	buf.WriteColor( colors.center );
 	buf.WriteColor( colors.left );
 	buf.WriteColor( colors.top );
 	buf.WriteColor( colors.right );
 	buf.WriteColor( colors.bottom );
-
-	return buf;
 }
 
 void TileState::DeserializeTileColors( types::Buffer buf, tile_colors_t& colors ) {
@@ -271,11 +239,11 @@ void TileState::tile_elevations_t::Deserialize( types::Buffer buf ) {
 }
 
 void TileState::tile_layer_t::Deserialize( types::Buffer buf ) {
-	coords = DeserializeTileVertices( buf.ReadString() );
-	indices.Deserialize( buf.ReadString() );
-	surfaces.Deserialize( buf.ReadString() );
-	tex_coords = DeserializeTileTexCoords( buf.ReadString() );
-	DeserializeTileColors( buf.ReadString(), colors );
+	coords = DeserializeTileVertices( buf.ReadNested() );
+	indices.Deserialize( buf.ReadNested() );
+	surfaces.Deserialize( buf.ReadNested() );
+	tex_coords = DeserializeTileTexCoords( buf.ReadNested() );
+	DeserializeTileColors( buf.ReadNested(), colors );
 	texture_stretch = buf.ReadVec2f();
 	texture_stretch_at_edges = buf.ReadBool();
 }
@@ -291,19 +291,29 @@ const std::vector< Tile* > Tiles::GetVector( MT_CANCELABLE ) {
 
 const types::Buffer Tiles::Serialize() const {
 	types::Buffer buf;
+	Serialize( buf );
+	return buf;
+}
 
+void Tiles::Serialize( types::Buffer& buf ) const {
 	buf.WriteInt( m_width );
 	buf.WriteInt( m_height );
 
+	bool is_reserved = false;
 	for ( auto y = 0 ; y < m_height ; y++ ) {
 		for ( auto x = y & 1 ; x < m_width ; x += 2 ) {
-			buf.WriteString( AtConst( x, y ).Serialize().ToString() );
+			const auto* tile = &AtConst( x, y );
+			const auto tile_start = buf.lenw;
+			buf.WriteNested( [ tile ]( types::Buffer& b ) { tile->Serialize( b ); } );
+			if ( !is_reserved ) {
+				// tiles are similar in size, so first one gives good estimate
+				buf.Reserve( buf.lenw + ( buf.lenw - tile_start ) * ( m_width * m_height / 2 ) + 16 );
+				is_reserved = true;
+			}
 		}
 	}
 
 	buf.WriteBool( m_is_validated );
-
-	return buf;
 }
 
 void Tiles::Deserialize( types::Buffer buf ) {
@@ -316,7 +326,7 @@ void Tiles::Deserialize( types::Buffer buf ) {
 
 	for ( auto y = 0 ; y < m_height ; y++ ) {
 		for ( auto x = y & 1 ; x < m_width ; x += 2 ) {
-			At( x, y ).Deserialize( types::Buffer( buf.ReadString() ) );
+			At( x, y ).Deserialize( buf.ReadNested() );
 		}
 	}
 
@@ -45,6 +45,7 @@ CLASS( Tiles, types::Serializable )
 	const std::vector< Tile* > GetVector( MT_CANCELABLE );
 
 	const types::Buffer Serialize() const override;
+	void Serialize( types::Buffer& buf ) const override;
 	void Deserialize( types::Buffer buf ) override;
 
 private:
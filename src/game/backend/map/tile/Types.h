@@ -142,8 +142,35 @@ static constexpr terraforming_t TERRAFORMING_SENSOR = 1 << 10;
 static constexpr terraforming_t TERRAFORMING_BUNKER = 1 << 11;
 static constexpr terraforming_t TERRAFORMING_AIRBASE = 1 << 12;
 
+// features and terraforming that are drawn on terrain texture, blended ones also affect textures of neighbour tiles
+static constexpr feature_t FEATURES_TEXTURED = FEATURE_RIVER | FEATURE_XENOFUNGUS | FEATURE_JUNGLE | FEATURE_DUNES;
+static constexpr feature_t FEATURES_BLENDED = FEATURE_RIVER | FEATURE_XENOFUNGUS | FEATURE_JUNGLE;
+static constexpr terraforming_t TERRAFORMING_TEXTURED = TERRAFORMING_ROAD | TERRAFORMING_MAG_TUBE | TERRAFORMING_FOREST | TERRAFORMING_FARM | TERRAFORMING_SOIL_ENRICHER;
+static constexpr terraforming_t TERRAFORMING_BLENDED = TERRAFORMING_TEXTURED;
+
+// features and terraforming that have sprites
+static constexpr feature_t FEATURES_SPRITES = FEATURE_MONOLITH | FEATURE_URANIUM | FEATURE_GEOTHERMAL | FEATURE_UNITY_POD;
+static constexpr terraforming_t TERRAFORMING_SPRITES = TERRAFORMING_FARM | TERRAFORMING_SOIL_ENRICHER | TERRAFORMING_SOLAR | TERRAFORMING_MINE | TERRAFORMING_CONDENSER | TERRAFORMING_MIRROR | TERRAFORMING_BOREHOLE | TERRAFORMING_SENSOR | TERRAFORMING_BUNKER | TERRAFORMING_AIRBASE;
+
 typedef std::unordered_map< std::string, size_t > yields_t;
 
+// bitflags, attributes of tile that are tracked for changes ( see Tile::Touch )
+//   base attributes are edited directly
+//   derived attributes are computed from base attributes of tile and of tiles around it
+typedef uint16_t attribute_t;
+static constexpr attribute_t ATTRIBUTE_NONE = 0;
+static constexpr attribute_t ATTRIBUTE_ELEVATION = 1 << 0;
+static constexpr attribute_t ATTRIBUTE_MOISTURE = 1 << 1;
+static constexpr attribute_t ATTRIBUTE_ROCKINESS = 1 << 2;
+static constexpr attribute_t ATTRIBUTE_BONUS = 1 << 3;
+static constexpr attribute_t ATTRIBUTE_FEATURES = 1 << 4;
+static constexpr attribute_t ATTRIBUTE_TERRAFORMING = 1 << 5;
+static constexpr attribute_t ATTRIBUTE_YIELDS = 1 << 6;
+static constexpr attribute_t ATTRIBUTE_TEXTURES = 1 << 7; // terrain textures ( including texture variants ) and mesh
+static constexpr attribute_t ATTRIBUTE_SPRITES = 1 << 8;
+static constexpr attribute_t ATTRIBUTES_BASE = ATTRIBUTE_ELEVATION | ATTRIBUTE_MOISTURE | ATTRIBUTE_ROCKINESS | ATTRIBUTE_BONUS | ATTRIBUTE_FEATURES | ATTRIBUTE_TERRAFORMING;
+static constexpr attribute_t ATTRIBUTES_DERIVED = ATTRIBUTE_YIELDS | ATTRIBUTE_TEXTURES | ATTRIBUTE_SPRITES;
+
 }
 }
 }
@@ -0,0 +1,347 @@
+#include "View.h"
+
+#include <cstring>
+#include <algorithm>
+
+#include "Tile.h"
+#include "TileState.h"
+
+#include "common/Assert.h"
+
+namespace game {
+namespace backend {
+namespace map {
+namespace tile {
+
+// deltas never leave process, so values are stored in native byte order
+// integers are varints ( most of them are small ), floats are copied as is
+
+static void WriteVarint( std::vector< uint8_t >& out, uint64_t value ) {
+	while ( value >= 0x80 ) {
+		out.push_back( (uint8_t)( value | 0x80 ) );
+		value >>= 7;
+	}
+	out.push_back( (uint8_t)value );
+}
+
+static const uint64_t ReadVarint( const uint8_t*& ptr, const uint8_t* const end ) {
+	uint64_t value = 0;
+	for ( size_t shift = 0 ; shift < 64 ; shift += 7 ) {
+		if ( ptr >= end ) {
+			THROW( "tile delta ends prematurely" );
+		}
+		const uint8_t b = *( ptr++ );
+		value |= (uint64_t)( b & 0x7f ) << shift;
+		if ( !( b & 0x80 ) ) {
+			return value;
+		}
+	}
+	THROW( "invalid varint in tile delta" );
+}
+
+static void WriteSigned( std::vector< uint8_t >& out, const int64_t value ) {
+	WriteVarint( out, ( (uint64_t)value << 1 ) ^ (uint64_t)( value >> 63 ) );
+}
+
+static const int64_t ReadSigned( const uint8_t*& ptr, const uint8_t* const end ) {
+	const uint64_t value = ReadVarint( ptr, end );
+	return (int64_t)( value >> 1 ) ^ -(int64_t)( value & 1 );
+}
+
+static void WriteBytes( std::vector< uint8_t >& out, const void* data, const size_t size ) {
+	const auto* bytes = (const uint8_t*)data;
+	out.insert( out.end(), bytes, bytes + size );
+}
+
+static void ReadBytes( const uint8_t*& ptr, const uint8_t* const end, void* data, const size_t size ) {
+	if ( (size_t)( end - ptr ) < size ) {
+		THROW( "tile delta ends prematurely" );
+	}
+	memcpy( data, ptr, size );
+	ptr += size;
+}
+
+static void WriteString( std::vector< uint8_t >& out, const std::string& value ) {
+	WriteVarint( out, value.size() );
+	WriteBytes( out, value.data(), value.size() );
+}
+
+static const std::string ReadString( const uint8_t*& ptr, const uint8_t* const end ) {
+	const size_t size = ReadVarint( ptr, end );
+	if ( (size_t)( end - ptr ) < size ) {
+		THROW( "tile delta ends prematurely" );
+	}
+	const std::string value( (const char*)ptr, size );
+	ptr += size;
+	return value;
+}
+
+void View::Set( const Tile* tile, const TileState* ts ) {
+	is_water = tile->is_water_tile;
+	is_coastline_corner = ts->is_coastline_corner;
+	water_neighbours = 0;
+	if ( tile->W->is_water_tile ) {
+		water_neighbours |= WATER_W;
+	}
+	if ( tile->N->is_water_tile ) {
+		water_neighbours |= WATER_N;
+	}
+	if ( tile->E->is_water_tile ) {
+		water_neighbours |= WATER_E;
+	}
+	if ( tile->S->is_water_tile ) {
+		water_neighbours |= WATER_S;
+	}
+
+	elevations[ 0 ] = *tile->elevation.center;
+	elevations[ 1 ] = *tile->elevation.left;
+	elevations[ 2 ] = *tile->elevation.top;
+	elevations[ 3 ] = *tile->elevation.right;
+	elevations[ 4 ] = *tile->elevation.bottom;
+
+	moisture = tile->moisture;
+	rockiness = tile->rockiness;
+	bonus = tile->bonus;
+	features = tile->features;
+	terraforming = tile->terraforming;
+
+	for ( size_t lt = 0 ; lt < LAYER_MAX ; lt++ ) {
+		const auto& src = ts->layers[ lt ];
+		auto& dst = layers[ lt ];
+		size_t i = 0;
+#define x( _k ) \
+		dst.coords[ i * 3 ] = src.coords._k.x; \
+		dst.coords[ i * 3 + 1 ] = src.coords._k.y; \
+		dst.coords[ i * 3 + 2 ] = src.coords._k.z; \
+		dst.tex_coords[ i * 2 ] = src.tex_coords._k.x; \
+		dst.tex_coords[ i * 2 + 1 ] = src.tex_coords._k.y; \
+		dst.colors[ i * 4 ] = src.colors._k.value.red; \
+		dst.colors[ i * 4 + 1 ] = src.colors._k.value.green; \
+		dst.colors[ i * 4 + 2 ] = src.colors._k.value.blue; \
+		dst.colors[ i * 4 + 3 ] = src.colors._k.value.alpha; \
+		i++;
+		x( center )
+		x( left )
+		x( top )
+		x( right )
+		x( bottom )
+#undef x
+	}
+
+	sprites.clear();
+	sprites.reserve( ts->sprites.size() );
+	for ( const auto& s : ts->sprites ) {
+		sprites.push_back( s.actor );
+	}
+
+	yields = tile->yields;
+}
+
+const tile_vertices_t View::GetCoords( const tile_layer_type_t layer ) const {
+	const auto* c = layers[ layer ].coords;
+	return {
+		{ c[ 0 ],  c[ 1 ],  c[ 2 ] },
+		{ c[ 3 ],  c[ 4 ],  c[ 5 ] },
+		{ c[ 6 ],  c[ 7 ],  c[ 8 ] },
+		{ c[ 9 ],  c[ 10 ], c[ 11 ] },
+		{ c[ 12 ], c[ 13 ], c[ 14 ] },
+	};
+}
+
+const tile_tex_coords_t View::GetTexCoords( const tile_layer_type_t layer ) const {
+	const auto* c = layers[ layer ].tex_coords;
+	return {
+		{ c[ 0 ], c[ 1 ] },
+		{ c[ 2 ], c[ 3 ] },
+		{ c[ 4 ], c[ 5 ] },
+		{ c[ 6 ], c[ 7 ] },
+		{ c[ 8 ], c[ 9 ] },
+	};
+}
+
+void View::GetColors( const tile_layer_type_t layer, tile_colors_t& colors ) const {
+	const auto* c = layers[ layer ].colors;
+	colors.center.Set( c[ 0 ], c[ 1 ], c[ 2 ], c[ 3 ] );
+	colors.left.Set( c[ 4 ], c[ 5 ], c[ 6 ], c[ 7 ] );
+	colors.top.Set( c[ 8 ], c[ 9 ], c[ 10 ], c[ 11 ] );
+	colors.right.Set( c[ 12 ], c[ 13 ], c[ 14 ], c[ 15 ] );
+	colors.bottom.Set( c[ 16 ], c[ 17 ], c[ 18 ], c[ 19 ] );
+}
+
+const View::fields_t View::Compare( const View& other ) const {
+	fields_t fields = F_NONE;
+	if (
+		is_water != other.is_water ||
+			is_coastline_corner != other.is_coastline_corner ||
+			water_neighbours != other.water_neighbours
+		) {
+		fields |= F_FLAGS;
+	}
+	if ( memcmp( elevations, other.elevations, sizeof( elevations ) ) ) {
+		fields |= F_ELEVATIONS;
+	}
+	if ( moisture != other.moisture || rockiness != other.rockiness || bonus != other.bonus ) {
+		fields |= F_TERRAIN;
+	}
+	if ( features != other.features ) {
+		fields |= F_FEATURES;
+	}
+	if ( terraforming != other.terraforming ) {
+		fields |= F_TERRAFORMING;
+	}
+	for ( size_t lt = 0 ; lt < LAYER_MAX ; lt++ ) {
+		const auto& a = layers[ lt ];
+		const auto& b = other.layers[ lt ];
+		// bitwise, float rounding differences still need to reach frontend
+		if ( memcmp( a.coords, b.coords, sizeof( a.coords ) ) ) {
+			fields |= LayerField( (tile_layer_type_t)lt, F_LAYER_COORDS );
+		}
+		if ( memcmp( a.tex_coords, b.tex_coords, sizeof( a.tex_coords ) ) ) {
+			fields |= LayerField( (tile_layer_type_t)lt, F_LAYER_TEX_COORDS );
+		}
+		if ( memcmp( a.colors, b.colors, sizeof( a.colors ) ) ) {
+			fields |= LayerField( (tile_layer_type_t)lt, F_LAYER_COLORS );
+		}
+	}
+	if ( sprites != other.sprites ) {
+		fields |= F_SPRITES;
+	}
+	if ( yields != other.yields ) {
+		fields |= F_YIELDS;
+	}
+	return fields;
+}
+
+void View::WriteDelta( std::vector< uint8_t >& out, const coords_t& coords, const fields_t fields ) const {
+	WriteVarint( out, coords.x );
+	WriteVarint( out, coords.y );
+	WriteVarint( out, fields );
+	if ( fields & F_FLAGS ) {
+		out.push_back(
+			( is_water
+				? 1
+				: 0
+			) | ( is_coastline_corner
+				? 2
+				: 0
+			) | ( water_neighbours << 2 )
+		);
+	}
+	if ( fields & F_ELEVATIONS ) {
+		for ( const auto e : elevations ) {
+			WriteSigned( out, e );
+		}
+	}
+	if ( fields & F_TERRAIN ) {
+		out.push_back( moisture );
+		out.push_back( rockiness );
+		out.push_back( bonus );
+	}
+	if ( fields & F_FEATURES ) {
+		WriteVarint( out, features );
+	}
+	if ( fields & F_TERRAFORMING ) {
+		WriteVarint( out, terraforming );
+	}
+	if ( fields & F_SPRITES ) {
+		WriteVarint( out, sprites.size() );
+		for ( const auto& s : sprites ) {
+			WriteString( out, s );
+		}
+	}
+	if ( fields & F_YIELDS ) {
+		// sorted to keep deltas of same state identical
+		std::vector< std::pair< std::string, size_t > > sorted( yields.begin(), yields.end() );
+		std::sort( sorted.begin(), sorted.end() );
+		WriteVarint( out, sorted.size() );
+		for ( const auto& it : sorted ) {
+			WriteString( out, it.first );
+			WriteVarint( out, it.second );
+		}
+	}
+	for ( size_t lt = 0 ; lt < LAYER_MAX ; lt++ ) {
+		const auto& layer = layers[ lt ];
+		if ( fields & LayerField( (tile_layer_type_t)lt, F_LAYER_COORDS ) ) {
+			WriteBytes( out, layer.coords, sizeof( layer.coords ) );
+		}
+		if ( fields & LayerField( (tile_layer_type_t)lt, F_LAYER_TEX_COORDS ) ) {
+			WriteBytes( out, layer.tex_coords, sizeof( layer.tex_coords ) );
+		}
+		if ( fields & LayerField( (tile_layer_type_t)lt, F_LAYER_COLORS ) ) {
+			WriteBytes( out, layer.colors, sizeof( layer.colors ) );
+		}
+	}
+}
+
+const coords_t View::ReadDeltaCoords( const uint8_t*& ptr, const uint8_t* const end ) {
+	const size_t x = ReadVarint( ptr, end );
+	const size_t y = ReadVarint( ptr, end );
+	return {
+		x,
+		y
+	};
+}
+
+const View::fields_t View::ApplyDelta( const uint8_t*& ptr, const uint8_t* const end ) {
+	const uint64_t fields = ReadVarint( ptr, end );
+	if ( fields & ~(uint64_t)F_ALL ) {
+		THROW( "invalid fields in tile delta: " + std::to_string( fields ) );
+	}
+	if ( fields & F_FLAGS ) {
+		uint8_t flags;
+		ReadBytes( ptr, end, &flags, 1 );
+		is_water = flags & 1;
+		is_coastline_corner = flags & 2;
+		water_neighbours = flags >> 2;
+	}
+	if ( fields & F_ELEVATIONS ) {
+		for ( auto& e : elevations ) {
+			e = ReadSigned( ptr, end );
+		}
+	}
+	if ( fields & F_TERRAIN ) {
+		ReadBytes( ptr, end, &moisture, 1 );
+		ReadBytes( ptr, end, &rockiness, 1 );
+		ReadBytes( ptr, end, &bonus, 1 );
+	}
+	if ( fields & F_FEATURES ) {
+		features = ReadVarint( ptr, end );
+	}
+	if ( fields & F_TERRAFORMING ) {
+		terraforming = ReadVarint( ptr, end );
+	}
+	if ( fields & F_SPRITES ) {
+		const size_t count = ReadVarint( ptr, end );
+		sprites.clear();
+		sprites.reserve( count );
+		for ( size_t i = 0 ; i < count ; i++ ) {
+			sprites.push_back( ReadString( ptr, end ) );
+		}
+	}
+	if ( fields & F_YIELDS ) {
+		const size_t count = ReadVarint( ptr, end );
+		yields.clear();
+		for ( size_t i = 0 ; i < count ; i++ ) {
+			const auto key = ReadString( ptr, end );
+			yields[ key ] = ReadVarint( ptr, end );
+		}
+	}
+	for ( size_t lt = 0 ; lt < LAYER_MAX ; lt++ ) {
+		auto& layer = layers[ lt ];
+		if ( fields & LayerField( (tile_layer_type_t)lt, F_LAYER_COORDS ) ) {
+			ReadBytes( ptr, end, layer.coords, sizeof( layer.coords ) );
+		}
+		if ( fields & LayerField( (tile_layer_type_t)lt, F_LAYER_TEX_COORDS ) ) {
+			ReadBytes( ptr, end, layer.tex_coords, sizeof( layer.tex_coords ) );
+		}
+		if ( fields & LayerField( (tile_layer_type_t)lt, F_LAYER_COLORS ) ) {
+			ReadBytes( ptr, end, layer.colors, sizeof( layer.colors ) );
+		}
+	}
+	return (fields_t)fields;
+}
+
+}
+}
+}
+}
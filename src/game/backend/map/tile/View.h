@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <string>
+
+#include "Types.h"
+
+namespace game {
+namespace backend {
+namespace map {
+namespace tile {
+
+class Tile;
+class TileState;
+
+// everything frontend needs to know about tile, in compact form
+// backend keeps last view it sent for every tile and sends only fields that changed since then ( see WriteDelta )
+class View {
+public:
+
+	typedef uint32_t fields_t;
+	static constexpr fields_t F_NONE = 0;
+	static constexpr fields_t F_FLAGS = 1 << 0;
+	static constexpr fields_t F_ELEVATIONS = 1 << 1;
+	static constexpr fields_t F_TERRAIN = 1 << 2;
+	static constexpr fields_t F_FEATURES = 1 << 3;
+	static constexpr fields_t F_TERRAFORMING = 1 << 4;
+	static constexpr fields_t F_SPRITES = 1 << 5;
+	static constexpr fields_t F_YIELDS = 1 << 6;
+	// three bits per layer ( coords, tex coords, colors ), starting from this one
+	static constexpr fields_t F_LAYERS_SHIFT = 7;
+	static constexpr fields_t F_LAYER_COORDS = 1 << 0;
+	static constexpr fields_t F_LAYER_TEX_COORDS = 1 << 1;
+	static constexpr fields_t F_LAYER_COLORS = 1 << 2;
+	static constexpr fields_t F_LAYERS = ( ( 1 << ( LAYER_MAX * 3 ) ) - 1 ) << F_LAYERS_SHIFT;
+	static constexpr fields_t F_ALL = ( 1 << ( F_LAYERS_SHIFT + LAYER_MAX * 3 ) ) - 1;
+
+	static constexpr fields_t LayerField( const tile_layer_type_t layer, const fields_t field ) {
+		return field << ( F_LAYERS_SHIFT + layer * 3 );
+	}
+
+	static constexpr uint8_t WATER_W = 1 << 0;
+	static constexpr uint8_t WATER_N = 1 << 1;
+	static constexpr uint8_t WATER_E = 1 << 2;
+	static constexpr uint8_t WATER_S = 1 << 3;
+
+	// center, left, top, right, bottom
+	static constexpr size_t CORNERS = 5;
+
+	struct layer_t {
+		float coords[ CORNERS * 3 ];
+		float tex_coords[ CORNERS * 2 ];
+		float colors[ CORNERS * 4 ];
+	};
+
+	bool is_water = false;
+	bool is_coastline_corner = false;
+	uint8_t water_neighbours = 0;
+	elevation_t elevations[ CORNERS ] = {};
+	moisture_t moisture = 0;
+	rockiness_t rockiness = 0;
+	bonus_t bonus = 0;
+	feature_t features = 0;
+	terraforming_t terraforming = 0;
+	layer_t layers[ LAYER_MAX ] = {};
+	std::vector< std::string > sprites = {};
+	yields_t yields = {};
+
+	void Set( const Tile* tile, const TileState* ts );
+
+	const tile_vertices_t GetCoords( const tile_layer_type_t layer ) const;
+	const tile_tex_coords_t GetTexCoords( const tile_layer_type_t layer ) const;
+	void GetColors( const tile_layer_type_t layer, tile_colors_t& colors ) const;
+
+	// fields that differ between views
+	const fields_t Compare( const View& other ) const;
+
+	// appends coords, fields mask and values of given fields
+	void WriteDelta( std::vector< uint8_t >& out, const coords_t& coords, const fields_t fields ) const;
+
+	// delta starts with coords, read them first to find which view to apply it to
+	static const coords_t ReadDeltaCoords( const uint8_t*& ptr, const uint8_t* const end );
+	// applies rest of delta and returns fields that were changed
+	const fields_t ApplyDelta( const uint8_t*& ptr, const uint8_t* const end );
+
+};
+
+}
+}
+}
+}
@@ -81,13 +81,12 @@ const bool MapEditor::IsEnabled() const {
 const tiles_t MapEditor::Draw( map::tile::Tile* tile, const draw_mode_t mode ) {
 	if ( IsEnabled() && mode != DM_NONE && m_active_tool && m_active_brush ) {
 		Log( "Drawing at " + tile->coord.ToString() + " with brush " + std::to_string( GetActiveBrushType() ) + " tool " + std::to_string( GetActiveToolType() ) );
-		tiles_t tiles_to_reload = {};
+		tiles_t dirty_tiles = {}; // every tile is added only once, when it becomes dirty
 		const tiles_t tiles_to_draw = GetUniqueTiles( m_active_brush->Draw( tile ) );
 		for ( auto& t : tiles_to_draw ) {
-			const tiles_t tiles = m_active_tool->Draw( t, mode );
-			tiles_to_reload.insert( tiles_to_reload.end(), tiles.begin(), tiles.end() );
+			m_active_tool->Draw( t, mode, dirty_tiles );
 		}
-		return GetUniqueTiles( tiles_to_reload );
+		return dirty_tiles;
 	}
 	else {
 		return {};
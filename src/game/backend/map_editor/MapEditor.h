@@ -42,7 +42,7 @@ CLASS( MapEditor, common::Class )
 
 	const bool IsEnabled() const;
 
-	const tiles_t Draw( map::tile::Tile* tile, const draw_mode_t mode ); // returns tiles that need reload
+	const tiles_t Draw( map::tile::Tile* tile, const draw_mode_t mode ); // returns tiles with derived attributes to recompute
 
 private:
 	Game* m_game = nullptr;
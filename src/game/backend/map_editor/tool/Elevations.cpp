@@ -15,9 +15,7 @@ Elevations::Elevations( Game* game )
 	//
 }
 
-const tiles_t Elevations::Draw( map::tile::Tile* tile, const draw_mode_t mode ) {
-	tiles_t tiles_to_reload = {};
-
+void Elevations::Draw( map::tile::Tile* tile, const draw_mode_t mode, tiles_t& dirty_tiles ) {
 	if ( tile->coord.y > 1 && tile->coord.y < m_game->GetMap()->GetHeight() - 2 ) { // editing poles will screw things up
 
 		map::tile::elevation_t elevation, change;
@@ -48,6 +46,12 @@ const tiles_t Elevations::Draw( map::tile::Tile* tile, const draw_mode_t mode )
 				}
 			};
 
+		std::vector< map::tile::elevation_t > old_corners = {};
+		old_corners.reserve( tile->elevation.corners.size() );
+		for ( const auto& corner : tile->elevation.corners ) {
+			old_corners.push_back( *corner );
+		}
+
 		f_change_corner( tile->elevation.left );
 		f_change_corner( tile->elevation.top );
 		f_change_corner( tile->elevation.right );
@@ -63,43 +67,25 @@ const tiles_t Elevations::Draw( map::tile::Tile* tile, const draw_mode_t mode )
 		}
 		tile->Update();
 
+		bool is_changed = false;
+		for ( size_t i = 0 ; i < old_corners.size() ; i++ ) {
+			if ( *tile->elevation.corners[ i ] != old_corners[ i ] ) {
+				is_changed = true;
+				break;
+			}
+		}
+		if ( !is_changed ) {
+			return; // already at limit, nothing to reload
+		}
+
 		// update neighbour tiles because they share some corners
 		for ( auto& n : tile->neighbours ) {
 			n->Update();
 		}
 
-		// we need to reload quite a few tiles because coastlines 2 tiles away may need to be redrawn or removed
-		// TODO: reduce based on some conditions
-		tiles_to_reload = {
-			tile,
-			tile->W,
-			tile->W->SW,
-			tile->W->W,
-			tile->W->NW,
-			tile->NW,
-			tile->NW->NW,
-			tile->N,
-			tile->N->NW,
-			tile->N->N,
-			tile->N->NE,
-			tile->NE,
-			tile->NE->NE,
-			tile->E,
-			tile->E->NE,
-			tile->E->E,
-			tile->E->SE,
-			tile->SE,
-			tile->SE->SE,
-			tile->S,
-			tile->S->SE,
-			tile->S->S,
-			tile->S->SW,
-			tile->SW,
-			tile->SW->SW
-		};
+		// quite a few tiles will be reloaded because coastlines 2 tiles away may need to be redrawn or removed
+		tile->Touch( map::tile::ATTRIBUTE_ELEVATION, dirty_tiles );
 	}
-
-	return tiles_to_reload;
 }
 
 }
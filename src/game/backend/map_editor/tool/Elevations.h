@@ -16,7 +16,7 @@ CLASS( Elevations, Tool )
 
 	Elevations( Game* game );
 
-	const tiles_t Draw( map::tile::Tile* tile, const draw_mode_t mode ) override;
+	void Draw( map::tile::Tile* tile, const draw_mode_t mode, tiles_t& dirty_tiles ) override;
 
 };
 
@@ -13,37 +13,22 @@ Feature::Feature( Game* game, const tool_type_t type, const map::tile::feature_t
 	//
 }
 
-const tiles_t Feature::Draw( map::tile::Tile* tile, const draw_mode_t mode ) {
+void Feature::Draw( map::tile::Tile* tile, const draw_mode_t mode, tiles_t& dirty_tiles ) {
 	if ( mode == DM_DEC ) {
 		if ( !( tile->features & m_feature ) ) {
-			return {}; // already unset
+			return; // already unset
 		}
 		tile->features &= ~m_feature;
 	}
 	else if ( mode == DM_INC ) {
 		if ( tile->features & m_feature ) {
-			return {}; // already set
+			return; // already set
 		}
 		tile->features |= m_feature;
 	}
 
 	// some features will alter surrounding tiles, others won't
-	if ( m_feature & ( map::tile::FEATURE_JUNGLE | map::tile::FEATURE_RIVER | map::tile::FEATURE_XENOFUNGUS ) ) {
-		return {
-			tile,
-			tile->W,
-			tile->NW,
-			tile->N,
-			tile->NE,
-			tile->E,
-			tile->SE,
-			tile->S,
-			tile->SW,
-		};
-	}
-	else {
-		return { tile };
-	}
+	tile->Touch( map::tile::ATTRIBUTE_FEATURES, dirty_tiles, m_feature );
 }
 
 }
@@ -13,7 +13,7 @@ CLASS( Feature, Tool )
 
 	Feature( Game* game, const tool_type_t type, const map::tile::feature_t feature );
 
-	const tiles_t Draw( map::tile::Tile* tile, const draw_mode_t mode ) override;
+	void Draw( map::tile::Tile* tile, const draw_mode_t mode, tiles_t& dirty_tiles ) override;
 
 private:
 	const map::tile::feature_t m_feature = map::tile::FEATURE_NONE;
@@ -13,32 +13,22 @@ Moisture::Moisture( Game* game )
 	//
 }
 
-const tiles_t Moisture::Draw( map::tile::Tile* tile, const draw_mode_t mode ) {
+void Moisture::Draw( map::tile::Tile* tile, const draw_mode_t mode, tiles_t& dirty_tiles ) {
 	if ( mode == DM_DEC ) {
 		if ( tile->moisture <= map::tile::MOISTURE_ARID ) {
-			return {}; // can't decrease further
+			return; // can't decrease further
 		}
 		tile->moisture--;
 	}
 	else if ( mode == DM_INC ) {
 		if ( tile->moisture >= map::tile::MOISTURE_RAINY ) {
-			return {}; // can't increase further
+			return; // can't increase further
 		}
 		tile->moisture++;
 	}
 
-	// we need to reload surrounding tiles too because they need to blend correctly
-	return {
-		tile,
-		tile->W,
-		tile->NW,
-		tile->N,
-		tile->NE,
-		tile->E,
-		tile->SE,
-		tile->S,
-		tile->SW,
-	};
+	// surrounding tiles will be reloaded too because they need to blend correctly
+	tile->Touch( map::tile::ATTRIBUTE_MOISTURE, dirty_tiles );
 }
 
 }
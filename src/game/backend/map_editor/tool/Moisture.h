@@ -11,7 +11,7 @@ CLASS( Moisture, Tool )
 
 	Moisture( Game* game );
 
-	const tiles_t Draw( map::tile::Tile* tile, const draw_mode_t mode ) override;
+	void Draw( map::tile::Tile* tile, const draw_mode_t mode, tiles_t& dirty_tiles ) override;
 
 };
 
@@ -12,10 +12,10 @@ Resource::Resource( Game* game )
 	//
 }
 
-const tiles_t Resource::Draw( map::tile::Tile* tile, const draw_mode_t mode ) {
+void Resource::Draw( map::tile::Tile* tile, const draw_mode_t mode, tiles_t& dirty_tiles ) {
 	if ( mode == DM_DEC ) {
 		if ( tile->bonus == map::tile::BONUS_NONE ) {
-			return {}; // nothing to remove
+			return; // nothing to remove
 		}
 		tile->bonus = map::tile::BONUS_NONE;
 	}
@@ -29,7 +29,7 @@ const tiles_t Resource::Draw( map::tile::Tile* tile, const draw_mode_t mode ) {
 		}
 	}
 
-	return { tile };
+	tile->Touch( map::tile::ATTRIBUTE_BONUS, dirty_tiles );
 }
 
 }
@@ -12,32 +12,22 @@ Rockiness::Rockiness( Game* game )
 	//
 }
 
-const tiles_t Rockiness::Draw( map::tile::Tile* tile, const draw_mode_t mode ) {
+void Rockiness::Draw( map::tile::Tile* tile, const draw_mode_t mode, tiles_t& dirty_tiles ) {
 	if ( mode == DM_DEC ) {
 		if ( tile->rockiness <= map::tile::ROCKINESS_FLAT ) {
-			return {}; // can't decrease further
+			return; // can't decrease further
 		}
 		tile->rockiness--;
 	}
 	else if ( mode == DM_INC ) {
 		if ( tile->rockiness >= map::tile::ROCKINESS_ROCKY ) {
-			return {}; // can't increase further
+			return; // can't increase further
 		}
 		tile->rockiness++;
 	}
 
-	// we need to reload surrounding tiles too because they need to blend correctly
-	return {
-		tile,
-		tile->W,
-		tile->NW,
-		tile->N,
-		tile->NE,
-		tile->E,
-		tile->SE,
-		tile->S,
-		tile->SW,
-	};
+	// surrounding tiles will be reloaded too because they need to blend correctly
+	tile->Touch( map::tile::ATTRIBUTE_ROCKINESS, dirty_tiles );
 }
 
 }
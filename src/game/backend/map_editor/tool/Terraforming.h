@@ -13,7 +13,7 @@ CLASS( Terraforming, Tool )
 
 	Terraforming( Game* game, const tool_type_t type, const map::tile::terraforming_t terraforming );
 
-	const tiles_t Draw( map::tile::Tile* tile, const draw_mode_t mode ) override;
+	void Draw( map::tile::Tile* tile, const draw_mode_t mode, tiles_t& dirty_tiles ) override;
 
 private:
 	const map::tile::terraforming_t m_terraforming = map::tile::TERRAFORMING_NONE;
@@ -20,8 +20,8 @@ CLASS( Tool, common::Class )
 
 	const tool_type_t GetType() const;
 
-	// return tiles that were drawn on and need reload
-	virtual const tiles_t Draw( map::tile::Tile* tile, const draw_mode_t mode ) = 0;
+	// changes tile and appends tiles that need their derived attributes recomputed ( see map::tile::Tile::Touch )
+	virtual void Draw( map::tile::Tile* tile, const draw_mode_t mode, tiles_t& dirty_tiles ) = 0;
 
 protected:
 	const Game* m_game = nullptr;
@@ -3,9 +3,13 @@
 #include "Resource.h"
 
 #include "gse/callable/Native.h"
+#include "gse/value/Array.h"
+#include "gse/value/Bool.h"
+#include "gse/value/Shape.h"
 #include "game/backend/Game.h"
 #include "game/backend/State.h"
 #include "game/backend/slot/Slot.h"
+#include "game/backend/map/tile/Tile.h"
 #include "game/backend/Bindings.h"
 
 namespace game {
@@ -27,6 +31,7 @@ void ResourceManager::Clear() {
 		delete it.second;
 	}
 	m_resources.clear();
+	InvalidateYields();
 }
 
 void ResourceManager::DefineResource( resource::Resource* resource ) {
@@ -40,6 +45,7 @@ void ResourceManager::DefineResource( resource::Resource* resource ) {
 			resource
 		}
 	);
+	InvalidateYields();
 }
 
 void ResourceManager::UndefineResource( const std::string& id ) {
@@ -47,38 +53,236 @@ void ResourceManager::UndefineResource( const std::string& id ) {
 
 	ASSERT( m_resources.find( id ) != m_resources.end(), "resource does not exist" );
 	m_resources.erase( id );
+	InvalidateYields();
 }
 
 const map::tile::yields_t ResourceManager::GetYields( GSE_CALLABLE, map::tile::Tile* tile, slot::Slot* slot ) {
-	map::tile::yields_t yields = {};
-	for ( const auto& it : m_resources ) {
-		const auto result = m_game->GetState()->TriggerObject( this, "get_yield", ARGS_F( &tile, &slot, &it ) {
+	UpdateYields( GSE_CALL, { tile }, slot );
+	return tile->yields;
+}
+
+void ResourceManager::UpdateYields( GSE_CALLABLE, const std::vector< map::tile::Tile* >& tiles, slot::Slot* slot ) {
+
+	if ( !m_is_yields_cached ) {
+		const auto yields = ComputeYields( GSE_CALL, tiles, slot );
+		ASSERT( yields.size() == tiles.size(), "yields count mismatch" );
+		for ( size_t i = 0 ; i < tiles.size() ; i++ ) {
+			tiles[ i ]->yields = yields[ i ];
+		}
+		return;
+	}
+
+	// tiles that look same to handlers need to be computed only once
+	std::vector< map::tile::Tile* > uncached_tiles = {};
+	std::vector< yields_key_t > uncached_keys = {};
+	std::unordered_map< yields_key_t, size_t, yields_key_hash_t > uncached_indices = {};
+	std::vector< std::pair< map::tile::Tile*, size_t > > duplicate_tiles = {};
+
+	for ( auto* const tile : tiles ) {
+		const auto key = GetYieldsKey( tile, slot );
+		const auto it = m_yields_cache.find( key );
+		if ( it != m_yields_cache.end() ) {
+			tile->yields = it->second;
+			continue;
+		}
+		const auto it2 = uncached_indices.find( key );
+		if ( it2 != uncached_indices.end() ) {
+			duplicate_tiles.push_back(
+				{
+					tile,
+					it2->second
+				}
+			);
+			continue;
+		}
+		uncached_indices.insert(
+			{
+				key,
+				uncached_tiles.size()
+			}
+		);
+		uncached_tiles.push_back( tile );
+		uncached_keys.push_back( key );
+	}
+
+	if ( uncached_tiles.empty() ) {
+		return;
+	}
+
+	const auto yields = ComputeYields( GSE_CALL, uncached_tiles, slot );
+	ASSERT( yields.size() == uncached_tiles.size(), "yields count mismatch" );
+	for ( size_t i = 0 ; i < uncached_tiles.size() ; i++ ) {
+		uncached_tiles[ i ]->yields = yields[ i ];
+		m_yields_cache.insert_or_assign( uncached_keys[ i ], yields[ i ] );
+	}
+	for ( const auto& it : duplicate_tiles ) {
+		it.first->yields = yields[ it.second ];
+	}
+}
+
+void ResourceManager::InvalidateYields() {
+	m_yields_cache.clear();
+}
+
+void ResourceManager::SetYieldsCached( const bool is_cached ) {
+	Log( (std::string)( is_cached
+		? "Enabling"
+		: "Disabling"
+	) + " yields cache" );
+	m_is_yields_cached = is_cached;
+	InvalidateYields();
+}
+
+const ResourceManager::callback_id_t ResourceManager::On( GSE_CALLABLE, const std::string& event, gse::Value* const callback ) {
+	if ( IsYieldsEvent( event ) ) {
+		InvalidateYields();
+	}
+	return gse::GCWrappable::On( GSE_CALL, event, callback );
+}
+
+void ResourceManager::Off( GSE_CALLABLE, const std::string& event, const callback_id_t callback_id ) {
+	if ( IsYieldsEvent( event ) ) {
+		InvalidateYields();
+	}
+	gse::GCWrappable::Off( GSE_CALL, event, callback_id );
+}
+
+const bool ResourceManager::yields_key_t::operator==( const yields_key_t& other ) const {
+	return
+		slot_index == other.slot_index &&
+			is_water_tile == other.is_water_tile &&
+			moisture == other.moisture &&
+			rockiness == other.rockiness &&
+			bonus == other.bonus &&
+			features == other.features &&
+			terraforming == other.terraforming &&
+			elevation == other.elevation;
+}
+
+const size_t ResourceManager::yields_key_hash_t::operator()( const yields_key_t& key ) const {
+	size_t result = key.slot_index;
+	result = result * 31 + key.is_water_tile;
+	result = result * 31 + key.moisture;
+	result = result * 31 + key.rockiness;
+	result = result * 31 + key.bonus;
+	result = result * 31 + key.features;
+	result = result * 31 + key.terraforming;
+	result = result * 31 + (size_t)key.elevation;
+	return result;
+}
+
+const ResourceManager::yields_key_t ResourceManager::GetYieldsKey( const map::tile::Tile* tile, const slot::Slot* slot ) {
+	return {
+		slot->GetIndex(),
+		tile->is_water_tile,
+		tile->moisture,
+		tile->rockiness,
+		tile->bonus,
+		tile->features,
+		tile->terraforming,
+		*tile->elevation.center,
+	};
+}
+
+const std::vector< map::tile::yields_t > ResourceManager::ComputeYields( GSE_CALLABLE, const std::vector< map::tile::Tile* >& tiles, slot::Slot* slot ) {
+	std::vector< map::tile::yields_t > yields( tiles.size() );
+
+	// interned once, so that per-tile triggers don't look up event names
+	static const auto s_get_yield = gse::value::Shape::Intern( "get_yield" );
+	static const auto s_get_yields = gse::value::Shape::Intern( "get_yields" );
+
+	if ( GetHandlers( s_get_yields ) ) {
+		// one call for all tiles, handler returns array of values ( one per tile ) for every resource
+		// wrappers are cached, so tiles and strings are the only values created per batch
+		gse::value::array_elements_t tiles_wrapped = {};
+		tiles_wrapped.reserve( tiles.size() );
+		for ( auto* const tile : tiles ) {
+			tiles_wrapped.push_back( tile->Wrap( GSE_CALL ) );
+		}
+		gse::value::array_elements_t resources = {};
+		resources.reserve( m_resources.size() );
+		for ( const auto& it : m_resources ) {
+			resources.push_back( VALUE( gse::value::String,, it.first ) );
+		}
+		const auto result = m_game->GetState()->TriggerObject( this, s_get_yields, ARGS_F( &tiles_wrapped, &resources, &slot ) {
 			{
-				"tile",
-				tile->Wrap( GSE_CALL, gc_space )
+				"tiles",
+				VALUE( gse::value::Array,, tiles_wrapped )
 			},
 			{
-				"resource",
-				VALUE( gse::value::String,, it.first )
+				"resources",
+				VALUE( gse::value::Array,, resources )
 			},
 			{
 				"player",
-				slot->Wrap( GSE_CALL, gc_space )
+				slot->Wrap( GSE_CALL )
 			},
 		}; } );
-		if ( result->type != gse::Value::T_INT ) {
+		if ( result->type != gse::Value::T_OBJECT ) {
 			GSE_ERROR( gse::EC.INVALID_HANDLER, "unexpected return type: expected Object, got " + result->GetTypeString() );
 		}
-		yields.insert(
-			{
-				it.first,
-				( (gse::value::Int*)result )->value
+		auto* const result_obj = (gse::value::Object*)result;
+		for ( const auto& it : m_resources ) {
+			const auto* const values = result_obj->Get( it.first );
+			if ( values->type != gse::Value::T_ARRAY ) {
+				GSE_ERROR( gse::EC.INVALID_HANDLER, "unexpected type of '" + it.first + "' yields: expected Array, got " + values->GetTypeString() );
 			}
-		);
+			const auto& elements = ( (gse::value::Array*)values )->value;
+			if ( elements.size() != tiles.size() ) {
+				GSE_ERROR( gse::EC.INVALID_HANDLER, "unexpected count of '" + it.first + "' yields: expected " + std::to_string( tiles.size() ) + ", got " + std::to_string( elements.size() ) );
+			}
+			for ( size_t i = 0 ; i < tiles.size() ; i++ ) {
+				const auto* const element = elements[ i ];
+				if ( element->type != gse::Value::T_INT ) {
+					GSE_ERROR( gse::EC.INVALID_HANDLER, "unexpected type of '" + it.first + "' yield: expected Int, got " + element->GetTypeString() );
+				}
+				yields[ i ].insert(
+					{
+						it.first,
+						( (gse::value::Int*)element )->value
+					}
+				);
+			}
+		}
+	}
+	else {
+		for ( size_t i = 0 ; i < tiles.size() ; i++ ) {
+			auto* const tile = tiles[ i ];
+			for ( const auto& it : m_resources ) {
+				const auto result = m_game->GetState()->TriggerObject( this, s_get_yield, ARGS_F( &tile, &slot, &it ) {
+					{
+						"tile",
+						tile->Wrap( GSE_CALL )
+					},
+					{
+						"resource",
+						VALUE( gse::value::String,, it.first )
+					},
+					{
+						"player",
+						slot->Wrap( GSE_CALL )
+					},
+				}; } );
+				if ( result->type != gse::Value::T_INT ) {
+					GSE_ERROR( gse::EC.INVALID_HANDLER, "unexpected return type: expected Int, got " + result->GetTypeString() );
+				}
+				yields[ i ].insert(
+					{
+						it.first,
+						( (gse::value::Int*)result )->value
+					}
+				);
+			}
+		}
 	}
+
 	return yields;
 }
 
+const bool ResourceManager::IsYieldsEvent( const std::string& event ) const {
+	return event == "get_yield" || event == "get_yields" || event == "*";
+}
+
 WRAPIMPL_BEGIN( ResourceManager )
 	WRAPIMPL_PROPS
 	WRAPIMPL_TRIGGERS
@@ -139,13 +343,13 @@ WRAPIMPL_BEGIN( ResourceManager )
 						}
 					);
 					DefineResource( resource );
-					return VALUE( gse::value::Undefined );
+					return VALUE_SHARED( gse::value::Undefined );
 				}
 				else {
 					GSE_ERROR( gse::EC.GAME_ERROR, "Unsupported resource type: " + type );
 				}
 
-				return VALUE( gse::value::Undefined );
+				return VALUE_SHARED( gse::value::Undefined );
 			} )
 		},
 		{
@@ -163,7 +367,19 @@ WRAPIMPL_BEGIN( ResourceManager )
 
 				UndefineResource( id );
 
-				return VALUE( gse::value::Undefined );
+				return VALUE_SHARED( gse::value::Undefined );
+			} )
+		},
+		{
+			"set_yields_cached",
+			NATIVE_CALL( this ) {
+
+				N_EXPECT_ARGS( 1 );
+				N_GETVALUE( is_cached, 0, Bool );
+
+				SetYieldsCached( is_cached );
+
+				return VALUE_SHARED( gse::value::Undefined );
 			} )
 		}
 	};
@@ -177,7 +393,7 @@ void ResourceManager::Serialize( types::Buffer& buf ) const {
 	for ( const auto& it : m_resources ) {
 		const auto& res = it.second;
 		buf.WriteString( res->m_id );
-		buf.WriteString( resource::Resource::Serialize( res ).ToString() );
+		buf.WriteString( resource::Resource::Serialize( res ).ToStringView() );
 	}
 }
 
@@ -189,7 +405,7 @@ void ResourceManager::Deserialize( types::Buffer& buf ) {
 	m_resources.reserve( sz );
 	for ( size_t i = 0 ; i < sz ; i++ ) {
 		const auto name = buf.ReadString();
-		auto b = types::Buffer( buf.ReadString() );
+		auto b = buf.ReadNested();
 		DefineResource( resource::Resource::Deserialize( b ) );
 	}
 }
@@ -36,6 +36,15 @@ CLASS( ResourceManager, gse::GCWrappable )
 	void UndefineResource( const std::string& id );
 
 	const map::tile::yields_t GetYields( GSE_CALLABLE, map::tile::Tile* tile, slot::Slot* slot );
+	// computes and assigns yields of all given tiles, scripts are called once per batch if they handle 'get_yields'
+	void UpdateYields( GSE_CALLABLE, const std::vector< map::tile::Tile* >& tiles, slot::Slot* slot );
+	// yields are cached by tile attributes ( see yields_key_t ), cache must be reset if handlers may return something else for same tiles
+	void InvalidateYields();
+	// scripts whose handlers read anything besides keyed attributes ( neighbours, units, turn, ... ) must disable cache
+	void SetYieldsCached( const bool is_cached );
+
+	const callback_id_t On( GSE_CALLABLE, const std::string& event, gse::Value* const callback ) override;
+	void Off( GSE_CALLABLE, const std::string& event, const callback_id_t callback_id ) override;
 
 	WRAPDEFS_PTR( ResourceManager )
 
@@ -46,6 +55,30 @@ private:
 	Game* m_game;
 
 	std::unordered_map< std::string, resource::Resource* > m_resources = {};
+
+	bool m_is_yields_cached = true;
+
+	// attributes that yields usually depend on, handlers can see much more ( whole tile, its neighbours, player )
+	// so cache is only valid while get_yield(s) handlers are pure functions of these
+	struct yields_key_t {
+		size_t slot_index;
+		bool is_water_tile;
+		map::tile::moisture_t moisture;
+		map::tile::rockiness_t rockiness;
+		map::tile::bonus_t bonus;
+		map::tile::feature_t features;
+		map::tile::terraforming_t terraforming;
+		map::tile::elevation_t elevation;
+		const bool operator==( const yields_key_t& other ) const;
+	};
+	struct yields_key_hash_t {
+		const size_t operator()( const yields_key_t& key ) const;
+	};
+	std::unordered_map< yields_key_t, map::tile::yields_t, yields_key_hash_t > m_yields_cache = {};
+
+	static const yields_key_t GetYieldsKey( const map::tile::Tile* tile, const slot::Slot* slot );
+	const std::vector< map::tile::yields_t > ComputeYields( GSE_CALLABLE, const std::vector< map::tile::Tile* >& tiles, slot::Slot* slot );
+	const bool IsYieldsEvent( const std::string& event ) const;
 };
 
 }
@@ -30,7 +30,7 @@ const types::Buffer Rules::Serialize() const {
 /*	buf.WriteInt( m_difficulty_levels.size() );
 	for ( auto& it : m_difficulty_levels ) {
 		buf.WriteString( it.first );
-		buf.WriteString( it.second.Serialize().ToString() );
+		buf.WriteNested( it.second );
 	}*/
 
 	return buf;
@@ -44,7 +44,7 @@ void Rules::Deserialize( types::Buffer buf ) {
 	const size_t difficulty_levels_count = buf.ReadInt();
 	for ( size_t i = 0 ; i < difficulty_levels_count ; i++ ) {
 		const std::string difficulty_level_name = buf.ReadString();
-		m_difficulty_levels[ difficulty_level_name ].Deserialize( buf.ReadString() );
+		m_difficulty_levels[ difficulty_level_name ].Deserialize( buf.ReadNested() );
 	}*/
 
 	m_is_initialized = true;
@@ -80,8 +80,8 @@ WRAPIMPL_DYNAMIC_END()
 const types::Buffer GlobalSettings::Serialize() const {
 	types::Buffer buf;
 
-	buf.WriteString( map.Serialize().ToString() );
-	buf.WriteString( rules.Serialize().ToString() );
+	buf.WriteNested( map );
+	buf.WriteNested( rules );
 	buf.WriteInt( difficulty_level );
 	buf.WriteString( game_name );
 
@@ -89,8 +89,8 @@ const types::Buffer GlobalSettings::Serialize() const {
 }
 
 void GlobalSettings::Deserialize( types::Buffer buf ) {
-	map.Deserialize( buf.ReadString() );
-	rules.Deserialize( buf.ReadString() );
+	map.Deserialize( buf.ReadNested() );
+	rules.Deserialize( buf.ReadNested() );
 	difficulty_level = buf.ReadInt();
 	game_name = buf.ReadString();
 }
@@ -168,15 +168,15 @@ WRAPIMPL_END_PTR()
 const types::Buffer Settings::Serialize() const {
 	types::Buffer buf;
 
-	buf.WriteString( global.Serialize().ToString() );
-	buf.WriteString( local.Serialize().ToString() );
+	buf.WriteNested( global );
+	buf.WriteNested( local );
 
 	return buf;
 }
 
 void Settings::Deserialize( types::Buffer buf ) {
-	global.Deserialize( types::Buffer( buf.ReadString() ) );
-	local.Deserialize( types::Buffer( buf.ReadString() ) );
+	global.Deserialize( buf.ReadNested() );
+	local.Deserialize( buf.ReadNested() );
 }
 
 }
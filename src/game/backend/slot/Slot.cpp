@@ -146,7 +146,7 @@ const types::Buffer Slot::Serialize() const {
 
 	buf.WriteInt( m_slot_state );
 	if ( m_slot_state == SS_PLAYER ) {
-		buf.WriteString( m_player_data.player->Serialize().ToString() );
+		buf.WriteNested( *m_player_data.player );
 		// not sending cid
 		// not sending remote address
 		buf.WriteInt( m_player_data.flags );
@@ -164,7 +164,7 @@ void Slot::Deserialize( types::Buffer buf ) {
 			m_player_data.player->SetSlot( this );
 		}
 		else {
-			m_player_data.player->Deserialize( buf.ReadString() );
+			m_player_data.player->Deserialize( buf.ReadNested() );
 		}
 		m_player_data.flags = buf.ReadInt();
 	}
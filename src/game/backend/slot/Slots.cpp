@@ -44,7 +44,7 @@ const types::Buffer Slots::Serialize() const {
 	buf.WriteInt( m_slots.size() );
 
 	for ( auto& slot : m_slots ) {
-		buf.WriteString( slot.Serialize().ToString() );
+		buf.WriteNested( slot );
 	}
 
 	return buf;
@@ -55,7 +55,7 @@ void Slots::Deserialize( types::Buffer buf ) {
 	Resize( buf.ReadInt() );
 
 	for ( auto& slot : m_slots ) {
-		slot.Deserialize( buf.ReadString() );
+		slot.Deserialize( buf.ReadNested() );
 	}
 }
 
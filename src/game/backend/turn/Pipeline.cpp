@@ -0,0 +1,66 @@
+#include "Pipeline.h"
+
+#include <chrono>
+
+namespace game {
+namespace backend {
+namespace turn {
+
+void Pipeline::AddStage( const std::string& name, const stage_t& stage ) {
+	m_stages.push_back(
+		{
+			name,
+			stage
+		}
+	);
+}
+
+void Pipeline::Run() {
+	m_timings.clear();
+	m_timings.reserve( m_stages.size() );
+	m_total_us = 0;
+	for ( const auto& stage : m_stages ) {
+		const auto started_at = std::chrono::steady_clock::now();
+		stage.stage();
+		const uint64_t us = std::chrono::duration_cast< std::chrono::microseconds >( std::chrono::steady_clock::now() - started_at ).count();
+		m_timings.push_back(
+			{
+				stage.name,
+				us
+			}
+		);
+		m_total_us += us;
+	}
+}
+
+const Pipeline::timings_t& Pipeline::GetTimings() const {
+	return m_timings;
+}
+
+const uint64_t Pipeline::GetTime( const std::string& name ) const {
+	for ( const auto& timing : m_timings ) {
+		if ( timing.name == name ) {
+			return timing.us;
+		}
+	}
+	return 0;
+}
+
+const uint64_t Pipeline::GetTotalTime() const {
+	return m_total_us;
+}
+
+const std::string Pipeline::GetTimingsString() const {
+	std::string result = "";
+	for ( const auto& timing : m_timings ) {
+		if ( !result.empty() ) {
+			result += ", ";
+		}
+		result += timing.name + ": " + std::to_string( timing.us ) + "us";
+	}
+	return result;
+}
+
+}
+}
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <functional>
+#include <cstdint>
+
+namespace game {
+namespace backend {
+namespace turn {
+
+// turn processing as sequence of named stages, each stage is timed separately
+// stages run serially on calling thread, script hooks can touch any game object so they can't be split between threads
+class Pipeline {
+public:
+
+	typedef std::function< void() > stage_t;
+
+	struct timing_t {
+		std::string name;
+		uint64_t us;
+	};
+	typedef std::vector< timing_t > timings_t;
+
+	void AddStage( const std::string& name, const stage_t& stage );
+
+	void Run();
+
+	const timings_t& GetTimings() const;
+	// 0 if stage wasn't run
+	const uint64_t GetTime( const std::string& name ) const;
+	const uint64_t GetTotalTime() const;
+	const std::string GetTimingsString() const;
+
+private:
+
+	struct stage_info_t {
+		std::string name;
+		stage_t stage;
+	};
+
+	std::vector< stage_info_t > m_stages = {};
+	timings_t m_timings = {};
+	uint64_t m_total_us = 0;
+
+};
+
+}
+}
+}
@@ -18,15 +18,21 @@ const size_t Turn::GetId() const {
 
 void Turn::AdvanceTurn( const size_t turn_id ) {
 	m_id = turn_id;
+	m_checksum = 0;
 }
 
-const util::crc32::crc_t Turn::FinalizeAndChecksum() {
-	THROW( "TODO: FINALIZE_AND_CHECKSUM" );
-	//return util::crc32::CRC32::CalculateFromBuffer( event::Event::SerializeMultiple( m_events ) );
+const util::crc32::crc_t Turn::FinalizeAndChecksum( const types::Buffer& state ) {
+	m_checksum = util::crc32::CRC32::CalculateFromBuffer( state );
+	return m_checksum;
+}
+
+const util::crc32::crc_t Turn::GetChecksum() const {
+	return m_checksum;
 }
 
 void Turn::Reset() {
 	m_id = 0;
+	m_checksum = 0;
 }
 
 }
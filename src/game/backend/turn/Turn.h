@@ -17,12 +17,14 @@ public:
 	const size_t GetId() const;
 
 	void AdvanceTurn( const size_t turn_id );
-	const util::crc32::crc_t FinalizeAndChecksum();
+	const util::crc32::crc_t FinalizeAndChecksum( const types::Buffer& state );
+	const util::crc32::crc_t GetChecksum() const;
 
 	void Reset();
 
 private:
 	size_t m_id = 0;
+	util::crc32::crc_t m_checksum = 0;
 };
 
 }
@@ -0,0 +1,256 @@
+#include "Store.h"
+
+#include <algorithm>
+
+#include "common/Assert.h"
+
+namespace game {
+namespace backend {
+namespace unit {
+
+void Store::SetMapSize( const size_t width, const size_t height ) {
+	if ( width == m_map_width && height == m_map_height ) {
+		return;
+	}
+	m_map_width = width;
+	m_map_height = height;
+	m_chunks_width = std::max< size_t >( 1, ( width + CHUNK_SIZE - 1 ) / CHUNK_SIZE );
+	m_chunks_height = std::max< size_t >( 1, ( height + CHUNK_SIZE - 1 ) / CHUNK_SIZE );
+	m_chunks.clear();
+	m_chunks.resize( m_chunks_width * m_chunks_height );
+	for ( size_t index = 0 ; index < m_ids.size() ; index++ ) {
+		m_chunks[ GetChunk( m_xs[ index ], m_ys[ index ] ) ].push_back( index );
+	}
+}
+
+void Store::Clear() {
+	m_ids.clear();
+	m_units.clear();
+	m_xs.clear();
+	m_ys.clear();
+	m_owners.clear();
+	m_movements.clear();
+	m_healths.clear();
+	m_morales.clear();
+	m_indices.clear();
+	for ( auto& chunk : m_chunks ) {
+		chunk.clear();
+	}
+}
+
+void Store::Add( const size_t id, Unit* unit, const hot_t& hot ) {
+	ASSERT( m_indices.find( id ) == m_indices.end(), "unit id already in store" );
+	const size_t index = m_ids.size();
+	m_ids.push_back( id );
+	m_units.push_back( unit );
+	m_xs.push_back( hot.x );
+	m_ys.push_back( hot.y );
+	m_owners.push_back( hot.owner );
+	m_movements.push_back( hot.movement );
+	m_healths.push_back( hot.health );
+	m_morales.push_back( hot.morale );
+	m_indices.insert(
+		{
+			id,
+			index
+		}
+	);
+	m_chunks[ GetChunk( hot.x, hot.y ) ].push_back( index );
+}
+
+void Store::Update( const size_t id, const hot_t& hot ) {
+	const auto it = m_indices.find( id );
+	if ( it == m_indices.end() ) {
+		return;
+	}
+	const size_t index = it->second;
+	const size_t old_chunk = GetChunk( m_xs[ index ], m_ys[ index ] );
+	const size_t new_chunk = GetChunk( hot.x, hot.y );
+	if ( new_chunk != old_chunk ) {
+		ChunkRemove( old_chunk, index );
+		m_chunks[ new_chunk ].push_back( index );
+	}
+	m_xs[ index ] = hot.x;
+	m_ys[ index ] = hot.y;
+	m_owners[ index ] = hot.owner;
+	m_movements[ index ] = hot.movement;
+	m_healths[ index ] = hot.health;
+	m_morales[ index ] = hot.morale;
+}
+
+void Store::Remove( const size_t id ) {
+	const auto it = m_indices.find( id );
+	ASSERT( it != m_indices.end(), "unit id not in store" );
+	const size_t index = it->second;
+	const size_t last = m_ids.size() - 1;
+	m_indices.erase( it );
+	ChunkRemove( GetChunk( m_xs[ index ], m_ys[ index ] ), index );
+	if ( index != last ) {
+		ChunkReplace( GetChunk( m_xs[ last ], m_ys[ last ] ), last, index );
+		m_ids[ index ] = m_ids[ last ];
+		m_units[ index ] = m_units[ last ];
+		m_xs[ index ] = m_xs[ last ];
+		m_ys[ index ] = m_ys[ last ];
+		m_owners[ index ] = m_owners[ last ];
+		m_movements[ index ] = m_movements[ last ];
+		m_healths[ index ] = m_healths[ last ];
+		m_morales[ index ] = m_morales[ last ];
+		m_indices.at( m_ids[ index ] ) = index;
+	}
+	m_ids.pop_back();
+	m_units.pop_back();
+	m_xs.pop_back();
+	m_ys.pop_back();
+	m_owners.pop_back();
+	m_movements.pop_back();
+	m_healths.pop_back();
+	m_morales.pop_back();
+}
+
+const size_t Store::Size() const {
+	return m_ids.size();
+}
+
+Unit* Store::Get( const size_t id ) const {
+	const auto it = m_indices.find( id );
+	return it != m_indices.end()
+		? m_units[ it->second ]
+		: nullptr;
+}
+
+const bool Store::Has( const size_t id ) const {
+	return m_indices.find( id ) != m_indices.end();
+}
+
+const std::vector< size_t > Store::GetIds() const {
+	auto ids = m_ids;
+	std::sort( ids.begin(), ids.end() );
+	return ids;
+}
+
+void Store::FindInRadius( const size_t x, const size_t y, const size_t radius, const size_t owner, units_t& result ) const {
+	if ( m_ids.empty() ) {
+		return;
+	}
+
+	// every tile step changes x + y by 2
+	const size_t span = radius * 2;
+	const bool wraps = m_map_width > 0;
+
+	std::vector< bool > columns( m_chunks_width, false );
+	if ( !wraps || span * 2 + 1 >= m_map_width ) {
+		std::fill( columns.begin(), columns.end(), true );
+	}
+	else {
+		for ( size_t i = 0 ; i <= span * 2 ; i++ ) {
+			const size_t wx = ( x + m_map_width - span + i ) % m_map_width;
+			columns[ std::min( wx / CHUNK_SIZE, m_chunks_width - 1 ) ] = true;
+		}
+	}
+	const size_t row_from = std::min(
+		(
+			y > span
+				? y - span
+				: 0
+		) / CHUNK_SIZE, m_chunks_height - 1
+	);
+	const size_t row_to = std::min( ( y + span ) / CHUNK_SIZE, m_chunks_height - 1 );
+
+	std::vector< size_t > indices = {};
+	for ( size_t row = row_from ; row <= row_to ; row++ ) {
+		for ( size_t column = 0 ; column < m_chunks_width ; column++ ) {
+			if ( !columns[ column ] ) {
+				continue;
+			}
+			for ( const auto index : m_chunks[ row * m_chunks_width + column ] ) {
+				if ( owner != ANY_OWNER && m_owners[ index ] != owner ) {
+					continue;
+				}
+				size_t dx = m_xs[ index ] > x
+					? m_xs[ index ] - x
+					: x - m_xs[ index ];
+				if ( wraps && dx < m_map_width ) {
+					dx = std::min( dx, m_map_width - dx );
+				}
+				const size_t dy = m_ys[ index ] > y
+					? m_ys[ index ] - y
+					: y - m_ys[ index ];
+				if ( dx + dy <= span ) {
+					indices.push_back( index );
+				}
+			}
+		}
+	}
+	AppendSorted( indices, result );
+}
+
+void Store::FindInRect( const size_t x1, const size_t y1, const size_t x2, const size_t y2, const size_t owner, units_t& result ) const {
+	ASSERT( x1 <= x2 && y1 <= y2, "invalid rectangle" );
+	if ( m_ids.empty() ) {
+		return;
+	}
+	const size_t column_from = std::min( x1 / CHUNK_SIZE, m_chunks_width - 1 );
+	const size_t column_to = std::min( x2 / CHUNK_SIZE, m_chunks_width - 1 );
+	const size_t row_from = std::min( y1 / CHUNK_SIZE, m_chunks_height - 1 );
+	const size_t row_to = std::min( y2 / CHUNK_SIZE, m_chunks_height - 1 );
+
+	std::vector< size_t > indices = {};
+	for ( size_t row = row_from ; row <= row_to ; row++ ) {
+		for ( size_t column = column_from ; column <= column_to ; column++ ) {
+			for ( const auto index : m_chunks[ row * m_chunks_width + column ] ) {
+				if (
+					( owner == ANY_OWNER || m_owners[ index ] == owner ) &&
+						m_xs[ index ] >= x1 && m_xs[ index ] <= x2 &&
+						m_ys[ index ] >= y1 && m_ys[ index ] <= y2
+					) {
+					indices.push_back( index );
+				}
+			}
+		}
+	}
+	AppendSorted( indices, result );
+}
+
+const bool Store::HasMovesLeft( const size_t owner, const movement_t minimum_movement ) const {
+	for ( size_t index = 0 ; index < m_owners.size() ; index++ ) {
+		if ( m_owners[ index ] == owner && m_movements[ index ] >= minimum_movement ) {
+			return true;
+		}
+	}
+	return false;
+}
+
+const size_t Store::GetChunk( const size_t x, const size_t y ) const {
+	return std::min( y / CHUNK_SIZE, m_chunks_height - 1 ) * m_chunks_width + std::min( x / CHUNK_SIZE, m_chunks_width - 1 );
+}
+
+void Store::ChunkRemove( const size_t chunk, const size_t index ) {
+	auto& indices = m_chunks[ chunk ];
+	const auto it = std::find( indices.begin(), indices.end(), index );
+	ASSERT( it != indices.end(), "unit index not in chunk" );
+	*it = indices.back();
+	indices.pop_back();
+}
+
+void Store::ChunkReplace( const size_t chunk, const size_t index, const size_t new_index ) {
+	auto& indices = m_chunks[ chunk ];
+	const auto it = std::find( indices.begin(), indices.end(), index );
+	ASSERT( it != indices.end(), "unit index not in chunk" );
+	*it = new_index;
+}
+
+void Store::AppendSorted( std::vector< size_t >& indices, units_t& result ) const {
+	std::sort(
+		indices.begin(), indices.end(), [ this ]( const size_t a, const size_t b ) {
+			return m_ids[ a ] < m_ids[ b ];
+		}
+	);
+	result.reserve( result.size() + indices.size() );
+	for ( const auto index : indices ) {
+		result.push_back( m_units[ index ] );
+	}
+}
+
+}
+}
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+#include "Types.h"
+
+namespace game {
+namespace backend {
+namespace unit {
+
+class Unit;
+
+// dense storage of spawned units, fields needed by per-turn sweeps and area queries are kept in contiguous arrays
+// ids are stable, indices are not ( last unit is moved into place of removed one )
+// units are also indexed by map chunks so that area queries don't need to check every unit
+class Store {
+public:
+
+	static const size_t ANY_OWNER = (size_t)-1;
+
+	// side length of spatial index chunk, in tiles
+	static const size_t CHUNK_SIZE = 8;
+
+	// copy of unit fields that are kept in arrays, must be updated after unit changes
+	struct hot_t {
+		size_t x;
+		size_t y;
+		size_t owner;
+		movement_t movement;
+		health_t health;
+		morale_t morale;
+	};
+
+	typedef std::vector< Unit* > units_t;
+
+	// rebuilds spatial index if size changed
+	void SetMapSize( const size_t width, const size_t height );
+
+	void Clear();
+	void Add( const size_t id, Unit* unit, const hot_t& hot );
+	// does nothing if unit is not stored ( i.e. not spawned yet )
+	void Update( const size_t id, const hot_t& hot );
+	void Remove( const size_t id );
+
+	const size_t Size() const;
+	Unit* Get( const size_t id ) const;
+	const bool Has( const size_t id ) const;
+
+	// ordered by id
+	const std::vector< size_t > GetIds() const;
+
+	// results are ordered by id, distance is in tile steps ( diagonal steps included ), map wraps horizontally
+	void FindInRadius( const size_t x, const size_t y, const size_t radius, const size_t owner, units_t& result ) const;
+	// rectangle is inclusive, no wrapping
+	void FindInRect( const size_t x1, const size_t y1, const size_t x2, const size_t y2, const size_t owner, units_t& result ) const;
+
+	const bool HasMovesLeft( const size_t owner, const movement_t minimum_movement ) const;
+
+private:
+
+	// same index in every array
+	std::vector< size_t > m_ids = {};
+	std::vector< Unit* > m_units = {};
+	std::vector< size_t > m_xs = {};
+	std::vector< size_t > m_ys = {};
+	std::vector< size_t > m_owners = {};
+	std::vector< movement_t > m_movements = {};
+	std::vector< health_t > m_healths = {};
+	std::vector< morale_t > m_morales = {};
+	std::unordered_map< size_t, size_t > m_indices = {};
+
+	// unit indices per chunk, row by row
+	size_t m_map_width = 0;
+	size_t m_map_height = 0;
+	size_t m_chunks_width = 1;
+	size_t m_chunks_height = 1;
+	std::vector< std::vector< size_t > > m_chunks = { {} };
+
+	const size_t GetChunk( const size_t x, const size_t y ) const;
+	void ChunkRemove( const size_t chunk, const size_t index );
+	void ChunkReplace( const size_t chunk, const size_t index, const size_t new_index );
+	void AppendSorted( std::vector< size_t >& indices, units_t& result ) const;
+
+};
+
+}
+}
+}
@@ -79,12 +79,13 @@ void Unit::SetTile( GSE_CALLABLE, map::tile::Tile* tile ) {
 		}
 	);
 	m_tile = tile;
+	m_um->UpdateStore( this );
 }
 
 const types::Buffer Unit::Serialize( const Unit* unit ) {
 	types::Buffer buf;
 	buf.WriteInt( unit->m_id );
-	buf.WriteString( Def::Serialize( unit->m_def ).ToString() );
+	buf.WriteString( Def::Serialize( unit->m_def ).ToStringView() );
 	buf.WriteInt( unit->m_owner->GetIndex() );
 	buf.WriteInt( unit->m_tile->coord.x );
 	buf.WriteInt( unit->m_tile->coord.y );
@@ -98,7 +99,7 @@ const types::Buffer Unit::Serialize( const Unit* unit ) {
 Unit* Unit::Deserialize( GSE_CALLABLE, types::Buffer& buf, UnitManager* um ) {
 	ASSERT( um, "um is null" );
 	const auto id = buf.ReadInt();
-	auto defbuf = types::Buffer( buf.ReadString() );
+	auto defbuf = buf.ReadNested();
 	auto* def = Def::Deserialize( defbuf );
 	auto* slot = um->GetSlot( buf.ReadInt() );
 	const auto pos_x = buf.ReadInt();
@@ -122,22 +123,22 @@ WRAPIMPL_DESERIALIZE( Unit )
 	return unit->Wrap( GSE_CALL, true );
 }
 
-WRAPIMPL_DYNAMIC_GETTERS( Unit )
-	WRAPIMPL_GET_CUSTOM( "id", Int, m_id )
-	WRAPIMPL_GET_CUSTOM( "def", String, m_def->m_id )
-	WRAPIMPL_GET_CUSTOM( "owner", Int, m_owner->GetIndex() )
-	WRAPIMPL_GET_CUSTOM( "tile", Object, GSE_CALL_NOGC, {
-		{ "x", VALUE( gse::value::Int,, m_tile->coord.x ) },
-		{ "y", VALUE( gse::value::Int,, m_tile->coord.y ) },
-	} )
-	WRAPIMPL_GET_CUSTOM( "movement", Float, m_movement )
-	WRAPIMPL_GET_CUSTOM( "morale", Int, m_morale )
-	WRAPIMPL_GET_CUSTOM( "health", Float, m_health )
-	WRAPIMPL_GET_CUSTOM( "moved_this_turn", Bool, m_moved_this_turn )
-	WRAPIMPL_GET_CUSTOM( "is_immovable", Bool, m_def->GetMovementType() == MT_IMMOVABLE )
-	WRAPIMPL_GET_CUSTOM( "is_land", Bool, m_def->GetMovementType() == MT_LAND )
-	WRAPIMPL_GET_CUSTOM( "is_water", Bool, m_def->GetMovementType() == MT_WATER )
-	WRAPIMPL_GET_CUSTOM( "is_air", Bool, m_def->GetMovementType() == MT_AIR )
+WRAPIMPL_CACHED_BEGIN( Unit )
+	WRAPIMPL_LAZY_BEGIN
+		WRAPIMPL_LAZY_SHARED( "id", Int, self->m_id )
+		WRAPIMPL_LAZY( "def", String, self->m_def->m_id )
+		WRAPIMPL_LAZY_SHARED( "owner", Int, self->m_owner->GetIndex() )
+		WRAPIMPL_LAZY_WRAPPED( "tile", m_tile )
+		WRAPIMPL_LAZY( "movement", Float, self->m_movement )
+		WRAPIMPL_LAZY_SHARED( "morale", Int, self->m_morale )
+		WRAPIMPL_LAZY( "health", Float, self->m_health )
+		WRAPIMPL_LAZY_SHARED( "moved_this_turn", Bool, self->m_moved_this_turn )
+		WRAPIMPL_LAZY_SHARED( "is_immovable", Bool, self->m_def->GetMovementType() == MT_IMMOVABLE )
+		WRAPIMPL_LAZY_SHARED( "is_land", Bool, self->m_def->GetMovementType() == MT_LAND )
+		WRAPIMPL_LAZY_SHARED( "is_water", Bool, self->m_def->GetMovementType() == MT_WATER )
+		WRAPIMPL_LAZY_SHARED( "is_air", Bool, self->m_def->GetMovementType() == MT_AIR )
+	WRAPIMPL_LAZY_END
+	WRAPIMPL_PROPS
 	WRAPIMPL_LINK( "get_def", m_def )
 	WRAPIMPL_LINK( "get_owner", m_owner )
 	WRAPIMPL_LINK( "get_tile", m_tile )
@@ -161,10 +162,10 @@ WRAPIMPL_DYNAMIC_GETTERS( Unit )
 				m_um->Unpersist( on_complete );
 				delete errmsg;
 			}
-			return VALUE( gse::value::Undefined );
+			return VALUE_SHARED( gse::value::Undefined );
 		} )
 	},
-WRAPIMPL_DYNAMIC_SETTERS( Unit )
+WRAPIMPL_CACHED_DYNAMIC_SETTERS( Unit )
 	WRAPIMPL_SET_CUSTOM( "movement", Float, m_movement )
 	WRAPIMPL_SET_CUSTOM( "health", Float, m_health )
 	WRAPIMPL_SET_CUSTOM( "moved_this_turn", Bool, m_moved_this_turn )
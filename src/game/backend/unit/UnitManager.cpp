@@ -18,12 +18,25 @@
 #include "gse/value/Bool.h"
 #include "gse/value/Float.h"
 #include "gse/value/Array.h"
+#include "game/backend/map/Map.h"
 #include "game/backend/map/tile/TileManager.h"
 
 namespace game {
 namespace backend {
 namespace unit {
 
+static const Store::hot_t GetHot( const Unit* unit ) {
+	const auto* tile = unit->GetTile();
+	return {
+		tile->coord.x,
+		tile->coord.y,
+		unit->m_owner->GetIndex(),
+		unit->m_movement,
+		unit->m_health,
+		unit->m_morale,
+	};
+}
+
 UnitManager::UnitManager( Game* game )
 	: gse::GCWrappable( game->GetGCSpace() )
 	, m_game( game ) {
@@ -40,10 +53,10 @@ void UnitManager::Clear() {
 	}
 	m_unprocessed_units.clear();
 
-	for ( auto& it : m_units ) {
-		delete it.second;
+	for ( const auto id : m_units.GetIds() ) {
+		delete m_units.Get( id );
 	}
-	m_units.clear();
+	m_units.Clear();
 
 	for ( auto& it : m_unit_moralesets ) {
 		delete it.second;
@@ -116,10 +129,12 @@ void UnitManager::SpawnUnit( GSE_CALLABLE, Unit* unit ) {
 
 	auto* tile = unit->GetTile();
 
-	Log( "Spawning unit #" + std::to_string( unit->m_id ) + " ( " + unit->m_def->m_id + " ) at " + tile->ToString() );
+	LOG_AT( logger::LL_DEBUG, "Spawning unit #" + std::to_string( unit->m_id ) + " ( " + unit->m_def->m_id + " ) at " + tile->ToString() );
 
-	ASSERT( m_units.find( unit->m_id ) == m_units.end(), "duplicate unit id" );
-	m_units.insert_or_assign( unit->m_id, unit );
+	ASSERT( !m_units.Has( unit->m_id ), "duplicate unit id" );
+	const auto* map = GetMap();
+	m_units.SetMapSize( map->GetWidth(), map->GetHeight() );
+	m_units.Add( unit->m_id, unit, GetHot( unit ) );
 
 	QueueUnitUpdate( unit, UUO_SPAWN );
 
@@ -136,14 +151,12 @@ void UnitManager::SpawnUnit( GSE_CALLABLE, Unit* unit ) {
 
 void UnitManager::DespawnUnit( GSE_CALLABLE, const size_t unit_id ) {
 
-	const auto& it = m_units.find( unit_id );
-	if ( it == m_units.end() ) {
+	auto* unit = m_units.Get( unit_id );
+	if ( !unit ) {
 		GSE_ERROR( gse::EC.GAME_ERROR, "Unit id " + std::to_string( unit_id ) + " not found" );
 	}
 
-	auto* unit = it->second;
-
-	Log( "Despawning unit #" + std::to_string( unit->m_id ) + " (" + unit->m_def->m_id + ") at " + unit->GetTile()->ToString() );
+	LOG_AT( logger::LL_DEBUG, "Despawning unit #" + std::to_string( unit->m_id ) + " (" + unit->m_def->m_id + ") at " + unit->GetTile()->ToString() );
 
 	QueueUnitUpdate( unit, UUO_DESPAWN );
 
@@ -153,7 +166,7 @@ void UnitManager::DespawnUnit( GSE_CALLABLE, const size_t unit_id ) {
 	ASSERT( tile_it != tile->units.end(), "unit id not found in tile" );
 	tile->units.erase( tile_it );
 
-	m_units.erase( it );
+	m_units.Remove( unit_id );
 
 	auto* state = m_game->GetState();
 	if ( state->IsMaster() ) {
@@ -177,11 +190,7 @@ MoraleSet* UnitManager::GetMoraleSet( const std::string& name ) const {
 }
 
 Unit* UnitManager::GetUnit( const size_t id ) const {
-	const auto& it = m_units.find( id );
-	if ( it != m_units.end() ) {
-		return it->second;
-	}
-	return nullptr;
+	return m_units.Get( id );
 }
 
 Def* UnitManager::GetUnitDef( const std::string& name ) const {
@@ -194,8 +203,12 @@ Def* UnitManager::GetUnitDef( const std::string& name ) const {
 	}
 }
 
-const std::map< size_t, Unit* >& UnitManager::GetUnits() const {
-	return m_units;
+const std::vector< size_t > UnitManager::GetUnitIds() const {
+	return m_units.GetIds();
+}
+
+const bool UnitManager::HasUnitsWithMovesLeft( const slot::Slot* owner ) const {
+	return m_units.HasMovesLeft( owner->GetIndex(), Unit::MINIMUM_MOVEMENT_TO_KEEP );
 }
 
 void UnitManager::ProcessUnprocessed( GSE_CALLABLE ) {
@@ -297,7 +310,7 @@ WRAPIMPL_BEGIN( UnitManager )
 
 				DefineMoraleSet( new unit::MoraleSet( id, values ) );
 
-				return VALUE( gse::value::Undefined );
+				return VALUE_SHARED( gse::value::Undefined );
 			} )
 		},
 		{
@@ -315,7 +328,7 @@ WRAPIMPL_BEGIN( UnitManager )
 
 				UndefineMoraleSet( id );
 
-				return VALUE( gse::value::Undefined );
+				return VALUE_SHARED( gse::value::Undefined );
 			} )
 		},
 		{
@@ -389,7 +402,7 @@ WRAPIMPL_BEGIN( UnitManager )
 
 						DefineUnit( def );
 
-						return VALUE( gse::value::Undefined );
+						return VALUE_SHARED( gse::value::Undefined );
 					}
 					else {
 						GSE_ERROR( gse::EC.GAME_ERROR, "Unsupported render type: " + render_type );
@@ -415,7 +428,7 @@ WRAPIMPL_BEGIN( UnitManager )
 
 				UndefineUnit( id );
 
-				return VALUE( gse::value::Undefined );
+				return VALUE_SHARED( gse::value::Undefined );
 			} )
 		},
 		{
@@ -423,7 +436,7 @@ WRAPIMPL_BEGIN( UnitManager )
 			NATIVE_CALL( this ) {
 				N_EXPECT_ARGS( 1 );
 				N_GETVALUE( unit_id, 0, Int );
-				return VALUE( gse::value::Bool,, m_units.find( unit_id ) != m_units.end() );
+				return VALUE_SHARED( gse::value::Bool,, m_units.Has( unit_id ) );
 			} )
 		},
 		{
@@ -431,15 +444,67 @@ WRAPIMPL_BEGIN( UnitManager )
 			NATIVE_CALL( this ) {
 				N_EXPECT_ARGS( 1 );
 				N_GETVALUE( unit_id, 0, Int );
-				const auto& it = m_units.find( unit_id );
-				if ( it != m_units.end() ) {
-					return it->second->Wrap( GSE_CALL, true );
+				auto* unit = m_units.Get( unit_id );
+				if ( unit ) {
+					return unit->Wrap( GSE_CALL, true );
 				}
 				else {
 					GSE_ERROR( gse::EC.GAME_ERROR, "Unit id " + std::to_string( unit_id ) + " not found" );
 				}
 			} )
 		},
+		{
+			"get_units_in_radius",
+			NATIVE_CALL( this ) {
+				N_EXPECT_ARGS_MIN_MAX( 2, 3 );
+				N_GETVALUE_UNWRAP( tile, 0, map::tile::Tile );
+				N_GETVALUE( radius, 1, Int );
+				if ( radius < 0 ) {
+					GSE_ERROR( gse::EC.INVALID_CALL, "Radius can't be negative: " + std::to_string( radius ) );
+				}
+				size_t owner = Store::ANY_OWNER;
+				if ( arguments.size() == 3 ) {
+					N_GETVALUE_UNWRAP( player, 2, Player );
+					owner = player->GetSlot()->GetIndex();
+				}
+				Store::units_t units = {};
+				m_units.FindInRadius( tile->coord.x, tile->coord.y, radius, owner, units );
+				gse::value::array_elements_t result = {};
+				result.reserve( units.size() );
+				for ( const auto& unit : units ) {
+					result.push_back( unit->Wrap( GSE_CALL, true ) );
+				}
+				return VALUE( gse::value::Array,, result );
+			} )
+		},
+		{
+			"get_units_in_rect",
+			NATIVE_CALL( this ) {
+				N_EXPECT_ARGS_MIN_MAX( 2, 3 );
+				N_GETVALUE_UNWRAP( corner1, 0, map::tile::Tile );
+				N_GETVALUE_UNWRAP( corner2, 1, map::tile::Tile );
+				size_t owner = Store::ANY_OWNER;
+				if ( arguments.size() == 3 ) {
+					N_GETVALUE_UNWRAP( player, 2, Player );
+					owner = player->GetSlot()->GetIndex();
+				}
+				Store::units_t units = {};
+				m_units.FindInRect(
+					std::min( corner1->coord.x, corner2->coord.x ),
+					std::min( corner1->coord.y, corner2->coord.y ),
+					std::max( corner1->coord.x, corner2->coord.x ),
+					std::max( corner1->coord.y, corner2->coord.y ),
+					owner,
+					units
+				);
+				gse::value::array_elements_t result = {};
+				result.reserve( units.size() );
+				for ( const auto& unit : units ) {
+					result.push_back( unit->Wrap( GSE_CALL, true ) );
+				}
+				return VALUE( gse::value::Array,, result );
+			} )
+		},
 		{
 			"spawn_unit",
 			NATIVE_CALL( this ) {
@@ -493,7 +558,7 @@ WRAPIMPL_BEGIN( UnitManager )
 					N_GETVALUE_UNWRAP( unit, 0, Unit );
 					DespawnUnit( GSE_CALL, unit->m_id );
 				}
-				return VALUE( gse::value::Undefined );
+				return VALUE_SHARED( gse::value::Undefined );
 			})
 		},
 	};
@@ -507,20 +572,20 @@ void UnitManager::Serialize( types::Buffer& buf ) const {
 	buf.WriteInt( m_unit_moralesets.size() );
 	for ( const auto& it : m_unit_moralesets ) {
 		buf.WriteString( it.first );
-		buf.WriteString( MoraleSet::Serialize( it.second ).ToString() );
+		buf.WriteString( MoraleSet::Serialize( it.second ).ToStringView() );
 	}
 
 	Log( "Serializing " + std::to_string( m_unit_defs.size() ) + " unit defs" );
 	buf.WriteInt( m_unit_defs.size() );
 	for ( const auto& it : m_unit_defs ) {
 		buf.WriteString( it.first );
-		buf.WriteString( Def::Serialize( it.second ).ToString() );
+		buf.WriteString( Def::Serialize( it.second ).ToStringView() );
 	}
 
-	Log( "Serializing " + std::to_string( m_units.size() ) + " units" );
-	buf.WriteInt( m_units.size() );
-	for ( const auto& it : m_units ) {
-		buf.WriteString( Unit::Serialize( it.second ).ToString() );
+	Log( "Serializing " + std::to_string( m_units.Size() ) + " units" );
+	buf.WriteInt( m_units.Size() );
+	for ( const auto id : m_units.GetIds() ) {
+		buf.WriteString( Unit::Serialize( m_units.Get( id ) ).ToStringView() );
 	}
 	buf.WriteInt( Unit::GetNextId() );
 
@@ -530,7 +595,7 @@ void UnitManager::Serialize( types::Buffer& buf ) const {
 void UnitManager::Deserialize( GSE_CALLABLE, types::Buffer& buf ) {
 	ASSERT( m_unit_moralesets.empty(), "unit moralesets not empty" );
 	ASSERT( m_unit_defs.empty(), "unit defs not empty" );
-	ASSERT( m_units.empty(), "units not empty" );
+	ASSERT( !m_units.Size(), "units not empty" );
 	ASSERT( m_unprocessed_units.empty(), "unprocessed units not empty" );
 
 	size_t sz = buf.ReadInt();
@@ -538,7 +603,7 @@ void UnitManager::Deserialize( GSE_CALLABLE, types::Buffer& buf ) {
 	m_unit_moralesets.reserve( sz );
 	for ( size_t i = 0 ; i < sz ; i++ ) {
 		const auto name = buf.ReadString();
-		auto b = types::Buffer( buf.ReadString() );
+		auto b = buf.ReadNested();
 		DefineMoraleSet( MoraleSet::Deserialize( b ) );
 	}
 
@@ -547,7 +612,7 @@ void UnitManager::Deserialize( GSE_CALLABLE, types::Buffer& buf ) {
 	m_unit_defs.reserve( sz );
 	for ( size_t i = 0 ; i < sz ; i++ ) {
 		const auto name = buf.ReadString();
-		auto b = types::Buffer( buf.ReadString() );
+		auto b = buf.ReadNested();
 		DefineUnit( Def::Deserialize( b ) );
 	}
 
@@ -557,7 +622,7 @@ void UnitManager::Deserialize( GSE_CALLABLE, types::Buffer& buf ) {
 		m_unprocessed_units.reserve( sz );
 	}
 	for ( size_t i = 0 ; i < sz ; i++ ) {
-		auto b = types::Buffer( buf.ReadString() );
+		auto b = buf.ReadNested();
 		SpawnUnit( GSE_CALL, Unit::Deserialize( GSE_CALL, b, this ) );
 	}
 
@@ -726,6 +791,7 @@ void UnitManager::AttackUnitApply( GSE_CALLABLE, Unit* attacker, Unit* defender,
 }
 
 void UnitManager::RefreshUnit( GSE_CALLABLE, const Unit* unit ) {
+	UpdateStore( unit );
 	QueueUnitUpdate( unit, UUO_REFRESH );
 }
 
@@ -737,6 +803,12 @@ slot::Slot* UnitManager::GetSlot( const size_t slot_num ) const {
 	return &m_game->GetState()->m_slots->GetSlot( slot_num );
 }
 
+void UnitManager::UpdateStore( const Unit* unit ) {
+	if ( m_units.Get( unit->m_id ) == unit ) {
+		m_units.Update( unit->m_id, GetHot( unit ) );
+	}
+}
+
 }
 }
 }
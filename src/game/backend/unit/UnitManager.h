@@ -5,6 +5,7 @@
 #include "gse/value/Object.h"
 
 #include "Types.h"
+#include "Store.h"
 
 namespace game {
 namespace backend {
@@ -44,7 +45,9 @@ public:
 	MoraleSet* GetMoraleSet( const std::string& name ) const;
 	Unit* GetUnit( const size_t id ) const;
 	Def* GetUnitDef( const std::string& name ) const;
-	const std::map< size_t, Unit* >& GetUnits() const;
+	// ordered by id
+	const std::vector< size_t > GetUnitIds() const;
+	const bool HasUnitsWithMovesLeft( const slot::Slot* owner ) const;
 
 	void ProcessUnprocessed( GSE_CALLABLE );
 	void PushUpdates();
@@ -68,7 +71,7 @@ private:
 
 	std::unordered_map< std::string, MoraleSet* > m_unit_moralesets = {};
 	std::unordered_map< std::string, Def* > m_unit_defs = {};
-	std::map< size_t, Unit* > m_units = {};
+	Store m_units = {};
 	std::vector< Unit* > m_unprocessed_units = {};
 
 	enum unit_update_op_t : uint8_t {
@@ -91,6 +94,7 @@ private:
 	friend class Unit;
 	map::Map* GetMap() const;
 	slot::Slot* GetSlot( const size_t slot_num ) const;
+	void UpdateStore( const Unit* unit );
 };
 
 }
@@ -1046,17 +1046,15 @@ void Game::ProcessRequest( const FrontendRequest* request ) {
 			break;
 		}
 		case FrontendRequest::FR_UPDATE_TILES: {
-			const auto& tiles_data = *request->data.update_tiles.tile_updates;
-			for ( const auto& tile_data : tiles_data ) {
-				const auto& t = tile_data.first;
-				ASSERT( t, "tile not found" );
-				const auto& ts = tile_data.second;
-				ASSERT( ts, "tile state not found" );
-				auto* tile = m_tm->GetTile( t->coord.x, t->coord.y );
+			const auto& tile_deltas = *request->data.update_tiles.tile_deltas;
+			LOG_AT( logger::LL_DEBUG, "Updating " + std::to_string( request->data.update_tiles.count ) + " tiles ( " + std::to_string( tile_deltas.size() ) + " bytes )" );
+			const uint8_t* ptr = tile_deltas.data();
+			const uint8_t* const end = ptr + tile_deltas.size();
+			while ( ptr < end ) {
+				const auto coords = backend::map::tile::View::ReadDeltaCoords( ptr, end );
+				auto* tile = m_tm->GetTile( coords.x, coords.y );
 				ASSERT( tile, "matching tile not found" );
-
-				Log( "Updating tile: " + tile->GetCoords().ToString() );
-				tile->Update( *t, *ts );
+				tile->ApplyDelta( ptr, end );
 			}
 			break;
 		}
@@ -48,7 +48,7 @@ InstancedSprite* InstancedSpriteManager::GetInstancedSprite(
 	auto it = m_instanced_sprites.find( key );
 	if ( it == m_instanced_sprites.end() ) {
 
-		Log( "Creating instanced sprite: " + key );
+		LOG_AT( logger::LL_DEBUG, "Creating instanced sprite: " + key );
 
 		const auto tw = texture->GetWidth();
 		const auto th = texture->GetHeight();
@@ -109,7 +109,7 @@ InstancedSprite* InstancedSpriteManager::GetRepaintedInstancedSprite( const std:
 	auto it = m_repainted_instanced_sprites.find( key );
 	if ( it == m_repainted_instanced_sprites.end() ) {
 
-		Log( "Creating repainted instanced sprite: " + key );
+		LOG_AT( logger::LL_DEBUG, "Creating repainted instanced sprite: " + key );
 
 		const auto* original_sprite = original->actor->GetSpriteActor();
 		auto* texture = GetRepaintedSourceTexture( name, original_sprite->GetTexture(), rules );
@@ -147,7 +147,7 @@ InstancedSprite* InstancedSpriteManager::GetRepaintedInstancedSprite( const std:
 void InstancedSpriteManager::RemoveInstancedSpriteByKey( const std::string& key ) {
 	const auto& it = m_instanced_sprites.find( key );
 	ASSERT( it != m_instanced_sprites.end(), "instanced sprite not found: " + key );
-	Log( "Removing instanced sprite: " + key );
+	LOG_AT( logger::LL_DEBUG, "Removing instanced sprite: " + key );
 	const auto& sprite = it->second;
 	m_scene->RemoveActor( sprite.actor );
 	DELETE( sprite.actor );
@@ -157,7 +157,7 @@ void InstancedSpriteManager::RemoveInstancedSpriteByKey( const std::string& key
 void InstancedSpriteManager::RemoveRepaintedInstancedSpriteByKey( const std::string& key ) {
 	const auto& it = m_repainted_instanced_sprites.find( key );
 	ASSERT( it != m_repainted_instanced_sprites.end(), "instanced sprite not found: " + key );
-	Log( "Removing instanced sprite: " + key );
+	LOG_AT( logger::LL_DEBUG, "Removing instanced sprite: " + key );
 	const auto& sprite = it->second;
 	m_scene->RemoveActor( sprite.actor );
 	DELETE( sprite.actor );
@@ -42,7 +42,7 @@ InstancedText* InstancedTextManager::CreateInstancedText(
 	const types::Color& color,
 	const types::Color& shadow_color
 ) {
-	Log( "Creating instanced text: '" + text + "', " + font->GetFontName() + ", " + color.ToString() + "-" + shadow_color.ToString() );
+	LOG_AT( logger::LL_DEBUG, "Creating instanced text: '" + text + "', " + font->GetFontName() + ", " + color.ToString() + "-" + shadow_color.ToString() );
 	return new InstancedText( text, font, color, shadow_color );
 }
 
@@ -1,5 +1,7 @@
 #include "Tile.h"
 
+#include <algorithm>
+
 #include "game/frontend/unit/Unit.h"
 #include "game/frontend/base/Base.h"
 #include "game/backend/map/tile/Tile.h"
@@ -11,20 +13,17 @@ namespace frontend {
 namespace tile {
 
 std::vector< size_t > Tile::GetUnitsOrder( const std::unordered_map< size_t, unit::Unit* >& units ) {
-	std::map< size_t, std::vector< size_t > > weights; // { weight, units }
-
-	for ( auto& it : units ) {
-		const auto unit_id = it.first;
-		const auto* unit = it.second;
-		size_t weight = unit->GetSelectionWeight();
-		weights[ -weight ].push_back( unit_id ); // negative because we need reverse order
+	std::vector< unit::Unit* > ordered_units = {};
+	ordered_units.reserve( units.size() );
+	for ( const auto& it : units ) {
+		ordered_units.push_back( it.second );
 	}
+	std::sort( ordered_units.begin(), ordered_units.end(), IsUnitOrderedBefore );
 
 	std::vector< size_t > result = {};
-	for ( const auto& it : weights ) {
-		for ( const auto& unit_id : it.second ) {
-			result.push_back( unit_id );
-		}
+	result.reserve( ordered_units.size() );
+	for ( const auto& unit : ordered_units ) {
+		result.push_back( unit->GetId() );
 	}
 
 	return result;
@@ -40,7 +39,7 @@ Tile::~Tile() {
 }
 
 const bool Tile::IsWater() const {
-	return m_is_water;
+	return m_view.is_water;
 }
 
 const types::Vec2< size_t >& Tile::GetCoords() const {
@@ -57,7 +56,7 @@ void Tile::AddUnit( unit::Unit* unit ) {
 			unit
 		}
 	);
-	m_is_units_reorder_needed = true;
+	m_ordered_units.insert( std::lower_bound( m_ordered_units.begin(), m_ordered_units.end(), unit, IsUnitOrderedBefore ), unit );
 	m_is_objects_reorder_needed = true;
 	if ( m_base ) {
 		m_base->Update();
@@ -73,7 +72,9 @@ void Tile::RemoveUnit( unit::Unit* unit ) {
 		SetActiveUnit( nullptr );
 	}
 	m_units.erase( unit->GetId() );
-	m_is_units_reorder_needed = true;
+	const auto it = std::find( m_ordered_units.begin(), m_ordered_units.end(), unit );
+	ASSERT( it != m_ordered_units.end(), "unit not in ordered units" );
+	m_ordered_units.erase( it );
 	m_is_objects_reorder_needed = true;
 	if ( m_base ) {
 		m_base->Update();
@@ -88,6 +89,24 @@ void Tile::SetActiveUnit( unit::Unit* unit ) {
 	}
 }
 
+void Tile::RefreshUnitOrder( unit::Unit* unit ) {
+	const auto it = std::find( m_ordered_units.begin(), m_ordered_units.end(), unit );
+	ASSERT( it != m_ordered_units.end(), "unit not in ordered units" );
+	// other units keep their order, so it's enough to move this one to its new place
+	const auto it_before = std::lower_bound( m_ordered_units.begin(), it, unit, IsUnitOrderedBefore );
+	if ( it_before != it ) {
+		std::rotate( it_before, it, it + 1 );
+	}
+	else {
+		const auto it_after = std::lower_bound( it + 1, m_ordered_units.end(), unit, IsUnitOrderedBefore );
+		if ( it_after == it + 1 ) {
+			return; // still in place
+		}
+		std::rotate( it, it + 1, it_after );
+	}
+	m_is_objects_reorder_needed = true;
+}
+
 void Tile::SetBase( base::Base* base ) {
 	ASSERT( !m_base, "base already set" );
 	m_base = base;
@@ -108,13 +127,6 @@ void Tile::Render( size_t selected_unit_id ) {
 		m_base->Hide();
 	}
 
-	SetActiveUnit( nullptr );
-
-	for ( const auto& unit : m_render.currently_rendered_fake_badges ) {
-		unit->HideFakeBadge();
-	}
-	m_render.currently_rendered_fake_badges.clear();
-
 	bool should_show_units = !m_units.empty();
 	if ( m_base ) {
 		m_base->Show();
@@ -126,52 +138,69 @@ void Tile::Render( size_t selected_unit_id ) {
 			}
 		}
 	}
+
+	// only units that are rendered or have fake badges are touched, so large stacks are cheap to rerender
+	auto& fake_badges = m_render.next_fake_badges;
+	fake_badges.clear();
+	unit::Unit* rendered_unit = nullptr;
+	unit::Unit* most_important_unit = nullptr;
 	if ( should_show_units ) {
-		const auto units_order = GetUnitsOrder( m_units );
-		ASSERT( !units_order.empty(), "units order is empty" );
+		ASSERT( !m_ordered_units.empty(), "units order is empty" );
 
-		const auto most_important_unit_id = units_order.front();
+		most_important_unit = m_ordered_units.front();
 
 		// also display badges from stacked units that are not visible themselves
-		// TODO: refactor
-		ASSERT( m_render.currently_rendered_fake_badges.empty(), "orphan badges already rendered" );
 		size_t fake_badge_idx = 1;
-		for ( const auto& unit_id : units_order ) {
-			const auto& unit = m_units.at( unit_id );
-			if ( !m_render.currently_rendered_unit && unit_id == most_important_unit_id ) {
+		for ( const auto& unit : m_ordered_units ) {
+			if ( !rendered_unit && unit == most_important_unit ) {
 				// choose first by default
-				m_render.currently_rendered_unit = unit;
+				rendered_unit = unit;
 			}
-			else if ( unit_id == selected_unit_id ) {
+			else if ( unit->GetId() == selected_unit_id ) {
 				// override default is found
-				if ( m_render.currently_rendered_unit ) {
-					m_render.currently_rendered_fake_badges.push_back( m_render.currently_rendered_unit );
+				if ( rendered_unit ) {
+					fake_badges.push_back( rendered_unit );
 				}
-				m_render.currently_rendered_unit = unit;
+				rendered_unit = unit;
 			}
 			else {
 				// render fake badge
-				m_render.currently_rendered_fake_badges.push_back( unit );
+				fake_badges.push_back( unit );
 				if ( fake_badge_idx++ > 10 ) {
 					break;
 				}
 			}
 		}
-		if ( m_render.currently_rendered_unit ) {
-			const auto id = m_render.currently_rendered_unit->GetId();
-			m_render.currently_rendered_unit->Show();
-			if ( id == most_important_unit_id ) {
-				m_render.currently_rendered_unit->ShowBadge();
+	}
+
+	if ( m_render.currently_rendered_unit != rendered_unit ) {
+		SetActiveUnit( nullptr );
+		m_render.currently_rendered_unit = rendered_unit;
+	}
+	for ( const auto& unit : m_render.currently_rendered_fake_badges ) {
+		if ( std::find( fake_badges.begin(), fake_badges.end(), unit ) == fake_badges.end() ) {
+			unit->HideFakeBadge();
+		}
+	}
+	std::swap( m_render.currently_rendered_fake_badges, fake_badges );
+
+	if ( should_show_units ) {
+		if ( rendered_unit ) {
+			const auto id = rendered_unit->GetId();
+			rendered_unit->StopBadgeBlink( true );
+			rendered_unit->Show();
+			if ( rendered_unit == most_important_unit ) {
+				rendered_unit->ShowBadge();
 			}
-			if ( id == selected_unit_id && m_render.currently_rendered_unit->IsActive() ) {
-				m_render.currently_rendered_unit->StartBadgeBlink();
+			if ( id == selected_unit_id && rendered_unit->IsActive() ) {
+				rendered_unit->StartBadgeBlink();
 			}
 		}
 		size_t idx;
-		const auto& fake_badges = m_render.currently_rendered_fake_badges;
-		for ( size_t i = 0 ; i < fake_badges.size() ; i++ ) { // order is important
-			idx = fake_badges.size() - i - 1;
-			fake_badges.at( idx )->ShowFakeBadge( i );
+		const auto& rendered_fake_badges = m_render.currently_rendered_fake_badges;
+		for ( size_t i = 0 ; i < rendered_fake_badges.size() ; i++ ) { // order is important
+			idx = rendered_fake_badges.size() - i - 1;
+			rendered_fake_badges.at( idx )->ShowFakeBadge( i ); // does nothing if already shown at same offset
 		}
 	}
 	else {
@@ -188,16 +217,7 @@ const std::unordered_map< size_t, unit::Unit* >& Tile::GetUnits() const {
 	return m_units;
 }
 
-const std::vector< unit::Unit* >& Tile::GetOrderedUnits() {
-	if ( m_is_units_reorder_needed ) {
-		m_ordered_units.clear();
-		m_ordered_units.reserve( m_units.size() );
-		const auto order = GetUnitsOrder( m_units );
-		for ( const auto& it : order ) {
-			m_ordered_units.push_back( m_units.at( it ) );
-		}
-		m_is_units_reorder_needed = false;
-	}
+const std::vector< unit::Unit* >& Tile::GetOrderedUnits() const {
 	return m_ordered_units;
 }
 
@@ -227,7 +247,7 @@ unit::Unit* Tile::GetMostImportantUnit() {
 		return nullptr;
 	}
 	else {
-		return GetOrderedUnits().front();
+		return m_ordered_units.front();
 	}
 }
 
@@ -244,6 +264,15 @@ base::Base* Tile::GetBase() const {
 	return m_base;
 }
 
+const bool Tile::IsUnitOrderedBefore( const unit::Unit* a, const unit::Unit* b ) {
+	const auto weight_a = a->GetSelectionWeight();
+	const auto weight_b = b->GetSelectionWeight();
+	if ( weight_a != weight_b ) {
+		return weight_a > weight_b;
+	}
+	return a->GetId() < b->GetId();
+}
+
 Tile* Tile::GetNeighbour( const backend::map::tile::direction_t direction ) {
 	switch ( direction ) {
 		case backend::map::tile::D_NONE:
@@ -274,18 +303,55 @@ const Tile::render_data_t& Tile::GetRenderData() const {
 }
 
 const backend::map::tile::yields_t& Tile::GetYields() const {
-	return m_yields;
+	return m_view.yields;
 }
 
 void Tile::Update( const backend::map::tile::Tile& tile, const backend::map::tile::TileState& ts ) {
+	m_view.Set( &tile, &ts );
+	Refresh( backend::map::tile::View::F_ALL );
+}
+
+void Tile::ApplyDelta( const uint8_t*& ptr, const uint8_t* const end ) {
+	Refresh( m_view.ApplyDelta( ptr, end ) );
+}
 
-	m_is_water = tile.is_water_tile;
+void Tile::Refresh( const backend::map::tile::View::fields_t fields ) {
+	typedef backend::map::tile::View View;
 
-	backend::map::tile::tile_layer_type_t lt = ( tile.is_water_tile
+	const bool geometry_changed = fields & ( View::F_FLAGS | View::F_LAYERS );
+	const bool info_changed = fields & ( View::F_FLAGS | View::F_ELEVATIONS | View::F_TERRAIN | View::F_FEATURES | View::F_TERRAFORMING );
+
+	if ( geometry_changed ) {
+		RefreshGeometry();
+	}
+
+	if ( fields & View::F_SPRITES ) {
+		m_render_data.sprites = m_view.sprites;
+	}
+
+	if ( info_changed ) {
+		RefreshInfo();
+	}
+
+	if ( geometry_changed ) {
+		for ( const auto& it : m_units ) {
+			it.second->UpdateFromTile();
+		}
+		if ( m_base ) {
+			m_base->UpdateFromTile();
+		}
+	}
+}
+
+void Tile::RefreshGeometry() {
+	const bool is_water = m_view.is_water;
+
+	backend::map::tile::tile_layer_type_t lt = ( is_water
 		? backend::map::tile::LAYER_WATER
 		: backend::map::tile::LAYER_LAND
 	);
-	const auto& layer = ts.layers[ lt ];
+	const auto layer_coords = m_view.GetCoords( lt );
+	const auto water_coords = m_view.GetCoords( backend::map::tile::LAYER_WATER );
 
 	backend::map::tile::tile_vertices_t selection_coords = {};
 	backend::map::tile::tile_vertices_t preview_coords = {
@@ -316,7 +382,7 @@ void Tile::Update( const backend::map::tile::Tile& tile, const backend::map::til
 		}
 	};
 
-#define x( _k ) selection_coords._k = layer.coords._k
+#define x( _k ) selection_coords._k = layer_coords._k
 	x( center );
 	x( left );
 	x( top );
@@ -324,18 +390,18 @@ void Tile::Update( const backend::map::tile::Tile& tile, const backend::map::til
 	x( bottom );
 #undef x
 
-	if ( !tile.is_water_tile && ts.is_coastline_corner ) {
-		if ( tile.W->is_water_tile ) {
-			selection_coords.left = ts.layers[ backend::map::tile::LAYER_WATER ].coords.left;
+	if ( !is_water && m_view.is_coastline_corner ) {
+		if ( m_view.water_neighbours & backend::map::tile::View::WATER_W ) {
+			selection_coords.left = water_coords.left;
 		}
-		if ( tile.N->is_water_tile ) {
-			selection_coords.top = ts.layers[ backend::map::tile::LAYER_WATER ].coords.top;
+		if ( m_view.water_neighbours & backend::map::tile::View::WATER_N ) {
+			selection_coords.top = water_coords.top;
 		}
-		if ( tile.E->is_water_tile ) {
-			selection_coords.right = ts.layers[ backend::map::tile::LAYER_WATER ].coords.right;
+		if ( m_view.water_neighbours & backend::map::tile::View::WATER_E ) {
+			selection_coords.right = water_coords.right;
 		}
-		if ( tile.S->is_water_tile ) {
-			selection_coords.bottom = ts.layers[ backend::map::tile::LAYER_WATER ].coords.bottom;
+		if ( m_view.water_neighbours & backend::map::tile::View::WATER_S ) {
+			selection_coords.bottom = water_coords.bottom;
 		}
 	}
 
@@ -353,14 +419,14 @@ void Tile::Update( const backend::map::tile::Tile& tile, const backend::map::til
 	};
 
 	std::vector< backend::map::tile::tile_layer_type_t > layers = {};
-	if ( tile.is_water_tile ) {
+	if ( is_water ) {
 		layers.push_back( backend::map::tile::LAYER_LAND );
 		layers.push_back( backend::map::tile::LAYER_WATER_SURFACE );
 		layers.push_back( backend::map::tile::LAYER_WATER_SURFACE_EXTRA ); // TODO: only near coastlines?
 		layers.push_back( backend::map::tile::LAYER_WATER );
 	}
 	else {
-		if ( ts.is_coastline_corner ) {
+		if ( m_view.is_coastline_corner ) {
 			layers.push_back( backend::map::tile::LAYER_WATER_SURFACE );
 			layers.push_back( backend::map::tile::LAYER_WATER_SURFACE_EXTRA );
 			layers.push_back( backend::map::tile::LAYER_WATER );
@@ -381,13 +447,13 @@ void Tile::Update( const backend::map::tile::Tile& tile, const backend::map::til
 
 		NEWV( mesh, types::mesh::Render, 5, 4 );
 
-		const auto& l = ts.layers[ lt ];
-
-		auto tint = l.colors;
+		const auto tex_coords = m_view.GetTexCoords( lt );
+		backend::map::tile::tile_colors_t tint;
+		m_view.GetColors( lt, tint );
 
 		std::string c = "Coords = " + preview_coords.center.ToString() + " " + preview_coords.left.ToString() + " " + preview_coords.top.ToString() + " " + preview_coords.right.ToString() + " " + preview_coords.bottom.ToString();
 
-#define x( _k ) auto _k = mesh->AddVertex( { preview_coords._k.x, preview_coords._k.y, preview_coords._k.z }, l.tex_coords._k, tint._k * tint_modifier )
+#define x( _k ) auto _k = mesh->AddVertex( { preview_coords._k.x, preview_coords._k.y, preview_coords._k.z }, tex_coords._k, tint._k * tint_modifier )
 		x( center );
 		x( left );
 		x( top );
@@ -407,15 +473,23 @@ void Tile::Update( const backend::map::tile::Tile& tile, const backend::map::til
 		preview_meshes.push_back( mesh );
 	}
 
-	std::vector< std::string > sprites = {};
-	for ( auto& s : ts.sprites ) {
-		sprites.push_back( s.actor );
+	// previews copy meshes they show, so old ones aren't used anywhere
+	for ( const auto& mesh : m_render_data.preview_meshes ) {
+		DELETE( mesh );
 	}
 
+	m_render_data.coords = layer_coords.center;
+	m_render_data.selection_coords = selection_coords;
+	m_render_data.preview_meshes = preview_meshes;
+}
+
+void Tile::RefreshInfo() {
+	const bool is_water = m_view.is_water;
+
 	std::vector< std::string > info_lines = {};
 
-	auto e = *tile.elevation.center;
-	if ( tile.is_water_tile ) {
+	auto e = m_view.elevations[ 0 ];
+	if ( is_water ) {
 		if ( e < backend::map::tile::ELEVATION_LEVEL_TRENCH ) {
 			info_lines.push_back( "Ocean Trench" );
 		}
@@ -430,7 +504,7 @@ void Tile::Update( const backend::map::tile::Tile& tile, const backend::map::til
 	else {
 		info_lines.push_back( "Elev: " + std::to_string( e ) + "m" );
 		std::string tilestr = "";
-		switch ( tile.rockiness ) {
+		switch ( m_view.rockiness ) {
 			case backend::map::tile::ROCKINESS_FLAT: {
 				tilestr += "Flat";
 				break;
@@ -445,7 +519,7 @@ void Tile::Update( const backend::map::tile::Tile& tile, const backend::map::til
 			}
 		}
 		tilestr += " & ";
-		switch ( tile.moisture ) {
+		switch ( m_view.moisture ) {
 			case backend::map::tile::MOISTURE_ARID: {
 				tilestr += "Arid";
 				break;
@@ -463,18 +537,18 @@ void Tile::Update( const backend::map::tile::Tile& tile, const backend::map::til
 	}
 
 #define FEATURE( _feature, _line ) \
-            if ( tile.features & backend::map::tile::_feature ) { \
+            if ( m_view.features & backend::map::tile::_feature ) { \
                 info_lines.push_back( _line ); \
             }
 
-	if ( tile.is_water_tile ) {
+	if ( is_water ) {
 		FEATURE( FEATURE_XENOFUNGUS, "Sea Fungus" )
 	}
 	else {
 		FEATURE( FEATURE_XENOFUNGUS, "Xenofungus" )
 	}
 
-	switch ( tile.bonus ) {
+	switch ( m_view.bonus ) {
 		case backend::map::tile::BONUS_NUTRIENT: {
 			info_lines.push_back( "Nutrient bonus" );
 			break;
@@ -492,7 +566,7 @@ void Tile::Update( const backend::map::tile::Tile& tile, const backend::map::til
 		}
 	}
 
-	if ( tile.is_water_tile ) {
+	if ( is_water ) {
 		FEATURE( FEATURE_GEOTHERMAL, "Geothermal" )
 	}
 	else {
@@ -506,11 +580,11 @@ void Tile::Update( const backend::map::tile::Tile& tile, const backend::map::til
 #undef FEATURE
 
 #define TERRAFORMING( _terraforming, _line ) \
-            if ( tile.terraforming & backend::map::tile::_terraforming ) { \
+            if ( m_view.terraforming & backend::map::tile::_terraforming ) { \
                 info_lines.push_back( _line ); \
             }
 
-	if ( tile.is_water_tile ) {
+	if ( is_water ) {
 		TERRAFORMING( TERRAFORMING_FARM, "Kelp Farm" );
 		TERRAFORMING( TERRAFORMING_SOLAR, "Tidal Harness" );
 		TERRAFORMING( TERRAFORMING_MINE, "Mining Platform" );
@@ -561,21 +635,7 @@ void Tile::Update( const backend::map::tile::Tile& tile, const backend::map::til
 		preview_lines.push_back( info_line );
 	}
 
-	m_render_data.coords = layer.coords.center;
-	m_render_data.selection_coords = selection_coords;
-	m_render_data.preview_meshes = preview_meshes;
 	m_render_data.preview_lines = preview_lines;
-	m_render_data.sprites = sprites;
-
-	for ( const auto& it : m_units ) {
-		it.second->UpdateFromTile();
-	}
-	if ( m_base ) {
-		m_base->UpdateFromTile();
-	}
-
-	m_yields = tile.yields;
-
 }
 
 }
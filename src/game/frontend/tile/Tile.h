@@ -1,10 +1,12 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <vector>
 #include <unordered_map>
 
 #include "game/backend/map/tile/Types.h"
+#include "game/backend/map/tile/View.h"
 
 #include "types/Vec2.h"
 #include "types/Vec3.h"
@@ -48,6 +50,8 @@ public:
 	void AddUnit( unit::Unit* unit );
 	void RemoveUnit( unit::Unit* unit );
 	void SetActiveUnit( unit::Unit* unit );
+	// call after selection weight of unit on this tile has changed
+	void RefreshUnitOrder( unit::Unit* unit );
 
 	void SetBase( base::Base* base );
 	void UnsetBase( base::Base* base );
@@ -55,7 +59,7 @@ public:
 	void Render( size_t selected_unit_id = 0 );
 
 	const std::unordered_map< size_t, unit::Unit* >& GetUnits() const;
-	const std::vector< unit::Unit* >& GetOrderedUnits();
+	const std::vector< unit::Unit* >& GetOrderedUnits() const;
 	const std::vector< TileObject* >& GetOrderedObjects();
 	unit::Unit* GetMostImportantUnit();
 	TileObject* GetMostImportantObject();
@@ -85,29 +89,35 @@ public:
 	const render_data_t& GetRenderData() const;
 	const backend::map::tile::yields_t& GetYields() const;
 
+	// full update, used on map load
 	void Update( const backend::map::tile::Tile& tile, const backend::map::tile::TileState& ts );
+	// applies one tile delta ( after its coords ) and recalculates only things that depend on changed fields
+	void ApplyDelta( const uint8_t*& ptr, const uint8_t* const end );
 
 private:
 
 	struct {
 		unit::Unit* currently_rendered_unit = nullptr;
 		std::vector< unit::Unit* > currently_rendered_fake_badges = {};
+		std::vector< unit::Unit* > next_fake_badges = {}; // reused between renders to avoid allocations
 	} m_render;
 	std::unordered_map< size_t, unit::Unit* > m_units = {};
 
+	// always sorted, by selection weight ( descending ) and then by id
 	std::vector< unit::Unit* > m_ordered_units = {};
-	bool m_is_units_reorder_needed = true;
+	static const bool IsUnitOrderedBefore( const unit::Unit* a, const unit::Unit* b );
 
 	std::vector< TileObject* > m_ordered_objects = {};
 	bool m_is_objects_reorder_needed = true;
 
-	bool m_is_water = false;
-
 	base::Base* m_base = nullptr;
 
 	render_data_t m_render_data = {};
 
-	backend::map::tile::yields_t m_yields = {};
+	backend::map::tile::View m_view = {};
+	void Refresh( const backend::map::tile::View::fields_t fields );
+	void RefreshGeometry();
+	void RefreshInfo();
 
 };
 
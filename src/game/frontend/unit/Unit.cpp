@@ -58,6 +58,7 @@ Unit::Unit(
 	, m_morale_string( morale_string )
 	, m_health( health ) {
 	m_is_active = ShouldBeActive();
+	m_selection_weight = CalculateSelectionWeight();
 	m_render.badge.def = m_slot_badges->GetUnitBadgeSprite( m_morale, m_is_active );
 	m_render.badge.healthbar.def = m_badge_defs->GetBadgeHealthbarSprite( m_health );
 	UpdateMeshTex( m_render_data.unit, GetSprite()->instanced_sprite );
@@ -97,6 +98,10 @@ tile::Tile* Unit::GetTile() const {
 }
 
 const size_t Unit::GetSelectionWeight() const {
+	return m_selection_weight;
+}
+
+const size_t Unit::CalculateSelectionWeight() const {
 	size_t weight = 0;
 
 	// active units have priority
@@ -223,7 +228,7 @@ void Unit::HideBadge() {
 void Unit::ShowFakeBadge( const uint8_t offset ) {
 	if ( !m_render.fake_badge.instance_id || m_fake_badge_offset != offset ) {
 		if ( m_render.fake_badge.instance_id ) {
-			m_slot_badges->HideFakeBadge( !m_render.fake_badge.instance_id );
+			m_slot_badges->HideFakeBadge( m_render.fake_badge.instance_id );
 		}
 		m_render.fake_badge.instance_id = m_slot_badges->ShowFakeBadge( m_render.coords, offset );
 		m_fake_badge_offset = offset;
@@ -297,6 +302,11 @@ void Unit::Refresh() {
 		if ( is_badge_visible ) {
 			ShowBadge();
 		}
+		const auto selection_weight = CalculateSelectionWeight();
+		if ( selection_weight != m_selection_weight ) {
+			m_selection_weight = selection_weight;
+			m_tile->RefreshUnitOrder( this );
+		}
 	}
 }
 
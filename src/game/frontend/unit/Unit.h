@@ -165,6 +165,10 @@ private:
 	bool m_need_refresh = true;
 	uint8_t m_fake_badge_offset = 0;
 
+	// cached because tile keeps its units sorted by it, changes only on refresh
+	size_t m_selection_weight = 0;
+	const size_t CalculateSelectionWeight() const;
+
 	const bool ShouldBeActive() const;
 
 	render_data_t m_render_data = {};
@@ -0,0 +1,130 @@
+#include "Arena.h"
+
+#include <new>
+
+namespace gc {
+
+// arena locked by BulkLock in current thread
+static thread_local Arena* s_locked_arena = nullptr;
+
+Arena::Arena() {
+	//
+}
+
+Arena::~Arena() {
+	if ( m_allocated_count ) {
+		// something is still alive and may be accessed, better leak than crash
+		Log( "WARNING: arena destroyed with " + std::to_string( m_allocated_count ) + " blocks still allocated, leaking " + std::to_string( m_slabs.size() ) + " slabs" );
+		return;
+	}
+	for ( const auto& slab : m_slabs ) {
+		::operator delete( slab );
+	}
+}
+
+void* Arena::Allocate( Arena* const arena, const size_t size ) {
+	const size_t size_class = ( size + SIZE_STEP - 1 ) / SIZE_STEP;
+	header_t* header;
+	if ( arena && size_class <= SIZE_CLASSES_COUNT ) {
+		header = (header_t*)arena->AllocateBlock( size_class );
+		header->arena = arena;
+	}
+	else {
+		header = (header_t*)::operator new( HEADER_SIZE + size );
+		header->arena = nullptr;
+	}
+	header->size_class = size_class;
+	return (uint8_t*)header + HEADER_SIZE;
+}
+
+void Arena::Free( void* const ptr ) {
+	if ( !ptr ) {
+		return;
+	}
+	auto* header = (header_t*)( (uint8_t*)ptr - HEADER_SIZE );
+	if ( header->arena ) {
+		header->arena->FreeBlock( header );
+	}
+	else {
+		::operator delete( header );
+	}
+}
+
+const size_t Arena::GetAllocatedCount() {
+	Lock();
+	const auto result = m_allocated_count;
+	Unlock();
+	return result;
+}
+
+Arena::BulkLock::BulkLock( Arena* const arena )
+	: m_arena( arena )
+	, m_previous( s_locked_arena ) {
+	if ( m_previous != m_arena ) {
+		m_arena->m_mutex.lock();
+		s_locked_arena = m_arena;
+	}
+}
+
+Arena::BulkLock::~BulkLock() {
+	if ( m_previous != m_arena ) {
+		s_locked_arena = m_previous;
+		m_arena->m_mutex.unlock();
+	}
+}
+
+void* Arena::AllocateBlock( const size_t size_class ) {
+	void* result;
+	Lock();
+	auto*& free_list = m_free_lists[ size_class ];
+	if ( free_list ) {
+		result = free_list;
+		free_list = free_list->next;
+	}
+	else {
+		const size_t block_size = HEADER_SIZE + size_class * SIZE_STEP;
+		if ( m_slab_ptr + block_size > m_slab_end ) {
+			// rest of previous slab is wasted, it's smaller than one block anyway
+			uint8_t* slab;
+			try {
+				slab = (uint8_t*)::operator new( SLAB_SIZE );
+				m_slabs.push_back( slab );
+			}
+			catch ( ... ) {
+				Unlock();
+				throw;
+			}
+			m_slab_ptr = slab;
+			m_slab_end = slab + SLAB_SIZE;
+		}
+		result = m_slab_ptr;
+		m_slab_ptr += block_size;
+	}
+	m_allocated_count++;
+	Unlock();
+	return result;
+}
+
+void Arena::FreeBlock( header_t* const header ) {
+	auto* const block = (free_block_t*)header;
+	Lock();
+	auto*& free_list = m_free_lists[ header->size_class ];
+	block->next = free_list;
+	free_list = block;
+	m_allocated_count--;
+	Unlock();
+}
+
+void Arena::Lock() {
+	if ( s_locked_arena != this ) {
+		m_mutex.lock();
+	}
+}
+
+void Arena::Unlock() {
+	if ( s_locked_arena != this ) {
+		m_mutex.unlock();
+	}
+}
+
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <mutex>
+
+#include "common/Common.h"
+
+namespace gc {
+
+/**
+ * Memory for gc objects of one space.
+ *   small blocks are carved from big slabs and recycled through per-size free lists
+ *   big blocks, and objects created without space, fall back to global operator new
+ *   every block is prefixed with header that tells where it came from, so it can be freed without knowing its arena
+ */
+CLASS( Arena, common::Class )
+
+	// granularity of size classes, also alignment of returned memory
+	static constexpr size_t SIZE_STEP = 16;
+	// anything bigger is allocated from heap
+	static constexpr size_t MAX_POOLED_SIZE = 512;
+	static constexpr size_t SIZE_CLASSES_COUNT = MAX_POOLED_SIZE / SIZE_STEP;
+	static constexpr size_t SLAB_SIZE = 64 * 1024;
+
+	Arena();
+	~Arena();
+
+	// arena may be null
+	static void* Allocate( Arena* const arena, const size_t size );
+	static void Free( void* const ptr );
+
+	const size_t GetAllocatedCount();
+
+	// holds arena lock for its lifetime, frees and allocations from same thread skip locking meanwhile
+	// used by sweep to return many blocks at once
+	class BulkLock {
+	public:
+		BulkLock( Arena* const arena );
+		~BulkLock();
+	private:
+		Arena* const m_arena;
+		Arena* const m_previous;
+	};
+
+private:
+
+	struct header_t {
+		Arena* arena;
+		size_t size_class;
+	};
+	static constexpr size_t HEADER_SIZE = ( sizeof( header_t ) + SIZE_STEP - 1 ) / SIZE_STEP * SIZE_STEP;
+
+	struct free_block_t {
+		free_block_t* next;
+	};
+
+	std::mutex m_mutex;
+	free_block_t* m_free_lists[ SIZE_CLASSES_COUNT + 1 ] = {};
+	std::vector< void* > m_slabs = {};
+	// unused tail of last slab
+	uint8_t* m_slab_ptr = nullptr;
+	uint8_t* m_slab_end = nullptr;
+	size_t m_allocated_count = 0;
+
+	void* AllocateBlock( const size_t size_class );
+	void FreeBlock( header_t* const header );
+
+	void Lock();
+	void Unlock();
+
+};
+
+}
@@ -2,16 +2,17 @@
 
 #include "Space.h"
 
-#if defined( DEBUG ) || defined( FASTDEBUG )
-#include "util/LogHelper.h"
 #include "engine/Engine.h"
 #include "config/Config.h"
+
+#if defined( DEBUG ) || defined( FASTDEBUG )
+#include "util/LogHelper.h"
 #endif
 
 namespace gc {
 
 void GC::Start() {
-
+	m_sweep_budget = std::chrono::milliseconds( g_engine->GetConfig()->GetGCSliceMs() );
 }
 
 void GC::Stop() {
@@ -28,7 +29,7 @@ void GC::Iterate() {
 #endif
 	std::lock_guard guard( m_spaces_mutex );
 	for ( const auto& gc_space : m_spaces ) {
-		gc_space->Collect();
+		gc_space->Collect( m_sweep_budget );
 	}
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <mutex>
+#include <chrono>
 #include <unordered_set>
 
 #include "common/Module.h"
@@ -20,12 +21,10 @@ class Object;
 
 CLASS( GC, common::Module )
 
+	// how often new collection cycle (mark) is started
 	static constexpr uint16_t COLLECTS_PER_SECOND = 1;
-
-	// new objects won't be removed until they are older than this
-	// this is important so that temporary variables such as those returned by function are not destroyed in the middle of processing
-	// TODO: improve
-	static constexpr uint16_t NEW_OBJECT_PROTECTION_TIME_MS = 200;
+	// how often gc thread wakes up to continue ongoing cycle (sweep slices)
+	static constexpr uint16_t ITERATIONS_PER_SECOND = 50;
 
 	void Start() override;
 	void Stop() override;
@@ -41,6 +40,10 @@ CLASS( GC, common::Module )
 #endif
 
 private:
+	// each sweep slice stops when this is exceeded
+	// mark is not sliced, it always runs whole reachable graph in one pause ( it would need write barrier on every reference store )
+	std::chrono::microseconds m_sweep_budget = {};
+
 	std::mutex m_spaces_mutex;
 	std::unordered_set< Space* > m_spaces = {};
 
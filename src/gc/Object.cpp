@@ -1,25 +1,57 @@
 #include "Object.h"
 
+#include <atomic>
+
 #include "Space.h"
+#include "Arena.h"
 
 namespace gc {
 
+// shared by all spaces so that marks from different spaces never look alike
+static std::atomic< uint32_t > s_mark_epoch = 0;
+
 Object::Object( gc::Space* const gc_space ) {
 	if ( gc_space ) {
 		gc_space->Add( this );
 	}
 }
 
-void Object::GetReachableObjects( std::unordered_set< Object* >& reachable_objects ) {
+Object::~Object() {
+	if ( m_persisted_objects ) {
+		delete m_persisted_objects;
+	}
+}
+
+void* Object::operator new( const size_t size ) {
+	return Arena::Allocate( nullptr, size );
+}
+
+void* Object::operator new( const size_t size, gc::Space* const gc_space ) {
+	return Arena::Allocate( gc_space ? &gc_space->m_arena : nullptr, size );
+}
+
+void Object::operator delete( void* const ptr ) {
+	Arena::Free( ptr );
+}
+
+void Object::operator delete( void* const ptr, gc::Space* const gc_space ) {
+	Arena::Free( ptr );
+}
+
+void Object::GetReachableObjects( MarkStack& reachable_objects ) {
 	GC_DEBUG_BEGIN( "gc::Object" );
 
 	GC_DEBUG( "this", this );
-	reachable_objects.insert( this );
+	if ( m_mark_epoch != reachable_objects.m_epoch ) {
+		// scanned directly ( i.e. root ), not through mark stack
+		m_mark_epoch = reachable_objects.m_epoch;
+		reachable_objects.m_marked_count++;
+	}
 
 	{
-		if ( !m_persisted_objects.empty() ) {
+		if ( m_persisted_objects ) {
 			GC_DEBUG_BEGIN( "persisted_objects" );
-			for ( const auto& obj : m_persisted_objects ) {
+			for ( const auto& obj : *m_persisted_objects ) {
 				GC_REACHABLE( obj );
 			}
 			GC_DEBUG_END();
@@ -30,17 +62,65 @@ void Object::GetReachableObjects( std::unordered_set< Object* >& reachable_objec
 }
 
 void Object::Persist( Object* const obj ) {
-	ASSERT( m_persisted_objects.find( obj ) == m_persisted_objects.end(), "object already persisted" );
-	m_persisted_objects.insert( obj );
+	if ( !m_persisted_objects ) {
+		m_persisted_objects = new std::unordered_set< Object* >();
+	}
+	ASSERT( m_persisted_objects->find( obj ) == m_persisted_objects->end(), "object already persisted" );
+	m_persisted_objects->insert( obj );
 }
 
 void Object::Unpersist( Object* const obj ) {
-	ASSERT( m_persisted_objects.find( obj ) != m_persisted_objects.end(), "object not persisted" );
-	m_persisted_objects.erase( obj );
+	ASSERT( m_persisted_objects && m_persisted_objects->find( obj ) != m_persisted_objects->end(), "object not persisted" );
+	m_persisted_objects->erase( obj );
+	if ( m_persisted_objects->empty() ) {
+		delete m_persisted_objects;
+		m_persisted_objects = nullptr;
+	}
 }
 
 const bool Object::IsPersisted( Object* const obj ) const {
-	return m_persisted_objects.find( obj ) != m_persisted_objects.end();
+	return m_persisted_objects && m_persisted_objects->find( obj ) != m_persisted_objects->end();
+}
+
+const bool Object::IsUnreachable() const {
+	return m_is_unreachable.load( std::memory_order_acquire );
+}
+
+const bool MarkStack::Mark( Object* const object ) {
+	ASSERT( m_epoch, "mark cycle not started" );
+	if ( object->m_mark_epoch == m_epoch ) {
+		return false;
+	}
+	object->m_mark_epoch = m_epoch;
+	m_marked_count++;
+	m_stack.push_back( object );
+	return true;
+}
+
+const bool MarkStack::IsMarked( const Object* const object ) const {
+	return object->m_mark_epoch == m_epoch;
+}
+
+const size_t MarkStack::GetMarkedCount() const {
+	return m_marked_count;
+}
+
+void MarkStack::Begin() {
+	ASSERT( m_stack.empty(), "mark stack not empty" );
+	m_epoch = ++s_mark_epoch;
+	if ( !m_epoch ) {
+		// 0 is reserved for never marked objects
+		m_epoch = ++s_mark_epoch;
+	}
+	m_marked_count = 0;
+}
+
+void MarkStack::Drain() {
+	while ( !m_stack.empty() ) {
+		auto* const object = m_stack.back();
+		m_stack.pop_back();
+		object->GetReachableObjects( *this );
+	}
 }
 
 }
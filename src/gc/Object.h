@@ -1,16 +1,16 @@
 #pragma once
 
 #include <unordered_set>
+#include <vector>
 #include <mutex>
 #include <string>
+#include <cstdint>
+#include <atomic>
 
 #include "common/Common.h"
 
 #define GC_REACHABLE( _var ) \
-    if ( reachable_objects.find( _var ) == reachable_objects.end() ) { \
-        (_var)->GetReachableObjects( reachable_objects ); \
-    } \
-    else { \
+    if ( !reachable_objects.Mark( _var ) ) { \
         GC_DEBUG( "ref", _var ); \
 }
 
@@ -37,13 +37,25 @@
 namespace gc {
 
 class Space;
+class MarkStack;
 
 CLASS( Object, common::Class )
 
 	Object( gc::Space* const gc_space );
-	virtual ~Object() = default;
+	virtual ~Object();
 
-	virtual void GetReachableObjects( std::unordered_set< Object* >& reachable_objects );
+	// objects created for space ( see VALUE() ) are allocated from its arena, others from heap
+	static void* operator new( const size_t size );
+	static void* operator new( const size_t size, gc::Space* const gc_space );
+	static void operator delete( void* const ptr );
+	static void operator delete( void* const ptr, gc::Space* const gc_space );
+
+	// marks directly referenced objects with GC_REACHABLE, they are scanned later from mark stack
+	virtual void GetReachableObjects( MarkStack& reachable_objects );
+
+	// true if last mark found object unreachable, it will be deleted by one of next sweeps
+	// caches that hold objects without keeping them reachable must not hand out such objects
+	const bool IsUnreachable() const;
 
 protected:
 	void Persist( Object* const obj );
@@ -51,7 +63,42 @@ protected:
 	const bool IsPersisted( Object* const obj ) const;
 
 private:
-	std::unordered_set< Object* > m_persisted_objects = {};
+	friend class MarkStack;
+	friend class Space;
+
+	// rarely used, allocated on first Persist() to keep small objects ( i.e. values ) small
+	std::unordered_set< Object* >* m_persisted_objects = nullptr;
+
+	// epoch of last mark that reached this object
+	uint32_t m_mark_epoch = 0;
+
+	// set by gc thread during mark, read by other threads ( see IsUnreachable )
+	std::atomic< bool > m_is_unreachable = false;
+
+};
+
+// marking state of one collection cycle
+// objects are marked by setting their epoch to the current one, so nothing needs to be cleared between cycles
+// scanning is iterative, so deep object graphs can't overflow the stack
+class MarkStack {
+public:
+	// returns false if object was already marked in this cycle
+	const bool Mark( Object* const object );
+	const bool IsMarked( const Object* const object ) const;
+	const size_t GetMarkedCount() const;
+
+private:
+	friend class Object;
+	friend class Space;
+
+	uint32_t m_epoch = 0;
+	size_t m_marked_count = 0;
+	std::vector< Object* > m_stack = {};
+
+	// starts new cycle, all objects become unmarked
+	void Begin();
+	// scans queued objects until none are left
+	void Drain();
 
 };
 
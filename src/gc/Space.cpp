@@ -17,6 +17,9 @@
 
 namespace gc {
 
+// mark epochs are shared, so marks of different spaces must not interleave
+static std::mutex s_mark_mutex;
+
 Space::Space( Object* const root_object )
 	: m_root_object( root_object ) {
 	ASSERT( root_object, "root object is null" );
@@ -40,6 +43,9 @@ Space::~Space() {
 	m_is_destroying = true;
 	m_collect_mutex.unlock();
 
+	// finish sweep that may be in progress
+	Sweep( std::chrono::microseconds::zero() );
+
 	// collect until there's nothing to collect
 	GC_LOG( "Destroying remaining objects" );
 	{
@@ -54,7 +60,7 @@ Space::~Space() {
 					Log( "WARNING: space is destroying but still accumulating in " + std::to_string( m_accumulations.size() ) + " thread(s)" );
 				}
 			}
-			while ( Collect() ) {}
+			while ( Collect( std::chrono::microseconds::zero(), true ) ) {}
 			m_objects_mutex.lock();
 			if ( !m_objects.empty() ) {
 				Log( "WARNING: collect finished but objects still not empty" );
@@ -72,8 +78,7 @@ void Space::Add( Object* object ) {
 	ASSERT( !m_is_destroying, "space is destroying" );
 	ASSERT( IsAccumulating(), "GC not in accumulation mode" );
 	//GC_LOG( "Adding object: " + std::to_string( (unsigned long long)object ) );
-	ASSERT( m_accumulated_objects.find( object ) == m_accumulated_objects.end(), "object " + std::to_string( (unsigned long long)object ) + " already exists" );
-	m_accumulated_objects.insert( object );
+	m_accumulated_objects.push_back( object );
 }
 
 void Space::Accumulate( gc::Object* const owner, const f_accum_t& f, const f_accum_t& f_cleanup ) {
@@ -137,7 +142,7 @@ void Space::AccumulateImpl( const f_accum_t& f ) {
 			if ( !m_accumulated_objects.empty() ) {
 				std::lock_guard guard( m_objects_mutex );
 				GC_LOG( "Accumulated " + std::to_string( m_accumulated_objects.size() ) + " objects" );
-				m_objects.insert( m_accumulated_objects.begin(), m_accumulated_objects.end() );
+				m_objects.insert( m_objects.end(), m_accumulated_objects.begin(), m_accumulated_objects.end() );
 				m_accumulated_objects.clear();
 			}
 		};
@@ -158,15 +163,39 @@ void Space::AccumulateImpl( const f_accum_t& f ) {
 	}
 }
 
-const bool Space::Collect() {
+const bool Space::Collect( const std::chrono::microseconds sweep_budget, const bool is_forced ) {
+	if ( m_objects_to_sweep.empty() ) {
+		const auto now = std::chrono::steady_clock::now();
+		if ( !is_forced && now < m_next_mark_time ) {
+			return false;
+		}
+		m_next_mark_time = now + std::chrono::milliseconds( 1000 / GC::COLLECTS_PER_SECOND );
+		if ( !Mark() ) {
+			return false;
+		}
+		// mark was already a ( not bounded ) pause, continue with sweep on next iteration
+		if ( !is_forced ) {
+			return true;
+		}
+	}
+	return Sweep( sweep_budget );
+}
+
+const bool Space::Mark() {
 	std::lock_guard guard2( m_pending_accumulations_mutex );
 	std::lock_guard guard( m_collect_mutex ); // allow only one collection at same space at same time
+	std::lock_guard mark_guard( s_mark_mutex );
+
+	ASSERT( m_objects_to_sweep.empty(), "previous sweep not finished" );
+
+	const auto started_at = std::chrono::steady_clock::now();
 
-	ASSERT( m_reachable_objects_tmp.empty(), "reachable objects tmp not empty" );
+	m_mark_stack.Begin();
 
 	GC_DEBUG_LOCK();
 	GC_DEBUG_BEGIN( "Root" );
-	m_root_object->GetReachableObjects( m_reachable_objects_tmp );
+	m_root_object->GetReachableObjects( m_mark_stack );
+	m_mark_stack.Drain();
 	GC_DEBUG_END();
 	GC_DEBUG_UNLOCK();
 
@@ -174,49 +203,116 @@ const bool Space::Collect() {
 		GC_DEBUG_BEGIN( "pending accumulations owners" );
 		for ( const auto& it : m_pending_accumulations ) {
 			if ( it.second.owner ) {
-				it.second.owner->GetReachableObjects( m_reachable_objects_tmp );
+				m_mark_stack.Mark( it.second.owner );
 			}
 		}
+		m_mark_stack.Drain();
 		GC_DEBUG_END();
 	}
 
-	std::unordered_set< Object* > removed_objects = {};
+	size_t objects_total;
 	{
 		std::lock_guard guard3( m_accumulations_mutex ); // prevent collection during accumulation // TODO: improve
+		std::lock_guard guard4( m_objects_mutex );
+		objects_total = m_objects.size();
+		// compact reachable objects in place, move unreachable ones to sweep list
+		size_t kept_count = 0;
+		for ( auto* const object : m_objects ) {
+			if ( m_mark_stack.IsMarked( object ) ) {
+				m_objects[ kept_count++ ] = object;
+			}
+			else {
+				object->m_is_unreachable.store( true, std::memory_order_release );
+				m_objects_to_sweep.push_back( object );
+			}
+		}
+		m_objects.resize( kept_count );
+		GC_LOG( "Kept " + std::to_string( kept_count ) + " reachable objects, found " + std::to_string( m_objects_to_sweep.size() ) + " unreachable" );
+	}
 
-		g_engine->GetGraphics()->NoRender( // tmp: prevent race conditions with render thread
-			[ this, &removed_objects ]() {
-				std::lock_guard guard2( m_objects_mutex );
-				for ( const auto& object : m_objects ) {
-					const auto& it = m_reachable_objects_tmp.find( object );
-					if ( it == m_reachable_objects_tmp.end() ) {
-						ASSERT( removed_objects.find( object ) == removed_objects.end(), "object " + std::to_string( (unsigned long long)object ) + " was already removed" );
-#if defined( DEBUG ) || defined( FASTDEBUG )
-						GC_LOG( "Destroying unreachable object: " + util::String::ToHexString( (unsigned long long)object ) /* TODO + "[ " + object->ToString() + " ]"*/ );
-#endif
+	const auto mark_us = std::chrono::duration_cast< std::chrono::microseconds >( std::chrono::steady_clock::now() - started_at ).count();
+	{
+		std::lock_guard guard5( m_stats_mutex );
+		m_stats.cycles++;
+		m_stats.objects_total = objects_total;
+		m_stats.objects_marked = m_mark_stack.GetMarkedCount();
+		m_stats.mark_us = mark_us;
+		m_stats.objects_swept = 0;
+		m_stats.sweep_us = 0;
+		m_stats.is_cycle_finished = m_objects_to_sweep.empty();
+	}
+
+	DEBUG_STAT_INC( gc_cycles );
+	DEBUG_STAT_MAX( gc_max_mark_us, mark_us );
+	ReportPause( started_at );
+
+	return !m_objects_to_sweep.empty();
+}
+
+const bool Space::Sweep( const std::chrono::microseconds sweep_budget ) {
+	if ( m_objects_to_sweep.empty() ) {
+		return false;
+	}
+
+	std::lock_guard guard( m_collect_mutex );
+	std::lock_guard guard2( m_accumulations_mutex );
+
+	const auto started_at = std::chrono::steady_clock::now();
+	const auto deadline = started_at + sweep_budget;
+
+	// checking clock is not free, so do it once per this many objects
+	const size_t check_time_every = 32;
+
+	size_t removed_count = 0;
+	g_engine->GetGraphics()->NoRender( // tmp: prevent race conditions with render thread
+		[ this, &sweep_budget, &deadline, &check_time_every, &removed_count ]() {
+			// freed blocks go back to arena without locking it for each one
+			Arena::BulkLock arena_lock( &m_arena );
+			while ( !m_objects_to_sweep.empty() ) {
+				auto* const object = m_objects_to_sweep.back();
+				m_objects_to_sweep.pop_back();
 #if defined( DEBUG ) || defined( FASTDEBUG )
-						debug::g_memory_watcher->MaybeDelete( object );
+				GC_LOG( "Destroying unreachable object: " + util::String::ToHexString( (unsigned long long)object ) /* TODO + "[ " + object->ToString() + " ]"*/ );
+				debug::g_memory_watcher->MaybeDelete( object );
 #endif
-						removed_objects.insert( object );
-						delete object;
-					}
+				delete object;
+				removed_count++;
+				if (
+					sweep_budget.count() &&
+						!( removed_count % check_time_every ) &&
+						std::chrono::steady_clock::now() >= deadline
+					) {
+					break;
 				}
-				GC_LOG( "Kept " + std::to_string( m_reachable_objects_tmp.size() ) + " reachable objects, removed " + std::to_string( removed_objects.size() ) + " unreachable" );
-			}
-		);
-
-		m_reachable_objects_tmp.clear();
-
-		{
-			std::lock_guard guard2( m_objects_mutex );
-			for ( const auto& object : removed_objects ) {
-				ASSERT( m_objects.find( object ) != m_objects.end(), "object to be removed not found" );
-				m_objects.erase( object );
 			}
 		}
+	);
+
+	GC_LOG( "Removed " + std::to_string( removed_count ) + " unreachable objects, " + std::to_string( m_objects_to_sweep.size() ) + " left to remove" );
+	DEBUG_STAT_CHANGE_BY( gc_objects_freed, removed_count );
+	{
+		std::lock_guard guard3( m_stats_mutex );
+		m_stats.objects_swept += removed_count;
+		m_stats.sweep_us += std::chrono::duration_cast< std::chrono::microseconds >( std::chrono::steady_clock::now() - started_at ).count();
+		m_stats.is_cycle_finished = m_objects_to_sweep.empty();
 	}
+	ReportPause( started_at );
 
-	return !removed_objects.empty();
+	return removed_count > 0;
+}
+
+const Space::stats_t Space::GetStats() {
+	std::lock_guard guard( m_stats_mutex );
+	return m_stats;
+}
+
+void Space::ReportPause( const std::chrono::steady_clock::time_point& started_at ) {
+#ifdef DEBUG
+	const ssize_t pause_us = std::chrono::duration_cast< std::chrono::microseconds >( std::chrono::steady_clock::now() - started_at ).count();
+	DEBUG_STAT_INC( gc_pauses );
+	DEBUG_STAT_CHANGE_BY( gc_pause_us, pause_us );
+	DEBUG_STAT_MAX( gc_max_pause_us, pause_us );
+#endif
 }
 
 }
@@ -12,6 +12,9 @@
 
 #include "common/Common.h"
 
+#include "Object.h"
+#include "Arena.h"
+
 #if defined( DEBUG ) || defined( FASTDEBUG )
 namespace gse::runner {
 class Interpreter;
@@ -24,7 +27,6 @@ class Interpreter;
 namespace gc {
 
 class GC;
-class Object;
 
 CLASS( Space, common::Class )
 	
@@ -33,6 +35,19 @@ CLASS( Space, common::Class )
 	
 	typedef std::function< void() > f_accum_t;
 	
+	// last collection cycle, sweep values grow while sweep slices are running
+	struct stats_t {
+		size_t cycles = 0;
+		size_t objects_total = 0;
+		size_t objects_marked = 0;
+		size_t mark_us = 0;
+		size_t objects_swept = 0;
+		size_t sweep_us = 0;
+		// true once last cycle ( counted in cycles ) swept all its unreachable objects
+		bool is_cycle_finished = true;
+	};
+	const stats_t GetStats();
+	
 	void Accumulate( gc::Object* const owner, const f_accum_t& f, const f_accum_t& f_cleanup = nullptr );
 	const bool IsAccumulating();
 	
@@ -43,7 +58,10 @@ private:
 	// if true - it means space is about to be destroyed and doing final cleanups/collects
 	std::atomic< bool > m_is_destroying = false;
 	
-	// object that is queried for reachability (recursive), not collectable and must be deleted manually after space
+	// memory of objects created for this space, must outlive them
+	Arena m_arena;
+	
+	// object that is queried for reachability, not collectable and must be deleted manually after space
 	Object* const m_root_object = {};
 	
 	// to track accumulating threads
@@ -52,17 +70,25 @@ private:
 	
 	// objects that have been accumulated but won't be collected until accumulator function finishes (that allows for temp values to move and assign where needed)
 	std::mutex m_accumulation_mutex;
-	std::unordered_set< Object* > m_accumulated_objects = {};
+	std::vector< Object* > m_accumulated_objects = {};
 	
-	// objects that are already collectable
+	// objects that are already collectable, contiguous so that sweep could walk it quickly
 	std::mutex m_objects_mutex;
-	std::unordered_set< Object* > m_objects = {};
+	std::vector< Object* > m_objects = {};
 	
 	// thread-safety of collection logic, to make sure only one thread can run collection of this space at any given time
 	std::mutex m_collect_mutex;
 	
-	// to avoid reallocations
-	std::unordered_set< Object* > m_reachable_objects_tmp = {};
+	// kept between cycles to avoid reallocations
+	MarkStack m_mark_stack = {};
+	
+	// objects found unreachable by last mark, destroyed in slices
+	// unreachable objects can't become reachable again, so they are safe to keep around between slices
+	std::vector< Object* > m_objects_to_sweep = {};
+	std::chrono::steady_clock::time_point m_next_mark_time = {};
+	
+	std::mutex m_stats_mutex;
+	stats_t m_stats = {};
 	
 	// for now let's isolate all script stuff to one thread
 	std::optional< std::thread::id > m_thread_id = {}; // callbacks from same thread will be executed immediately
@@ -79,7 +105,13 @@ private:
 #if defined( DEBUG ) || defined( FASTDEBUG )
 	friend class gse::runner::Interpreter;
 #endif
-	const bool Collect(); // true if anything was gced, false otherwise
+	// runs next step of collection cycle: mark (if it's time for new cycle) or slice of sweep
+	// only sweep is bounded by sweep_budget ( 0 means no limit ), mark always runs to the end, is_forced starts new cycle immediately
+	// true if anything was gced, false otherwise
+	const bool Collect( const std::chrono::microseconds sweep_budget, const bool is_forced = false );
+	const bool Mark();
+	const bool Sweep( const std::chrono::microseconds sweep_budget );
+	void ReportPause( const std::chrono::steady_clock::time_point& started_at );
 
 private:
 	friend class Object;
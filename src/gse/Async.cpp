@@ -103,7 +103,7 @@ void Async::ProcessAndExit( ExecutionPointer& ep ) {
 	}
 }
 
-void Async::GetReachableObjects( std::unordered_set< gc::Object* >& reachable_objects ) {
+void Async::GetReachableObjects( gc::MarkStack& reachable_objects ) {
 	gc::Object::GetReachableObjects( reachable_objects );
 	
 	GC_DEBUG_BEGIN( "Async" );
@@ -113,7 +113,8 @@ void Async::GetReachableObjects( std::unordered_set< gc::Object* >& reachable_ob
 	for ( const auto& timers : m_timers ) {
 		for ( const auto& timer : timers.second ) {
 			GC_REACHABLE( timer.second.callable );
-			ASSERT( reachable_objects.find( timer.second.ctx ) != reachable_objects.end(), "callable context not reachable" );
+			// normally reachable through callable, but it's scanned later so can't be checked here
+			GC_REACHABLE( timer.second.ctx );
 		}
 	}
 	GC_DEBUG_END();
@@ -29,7 +29,7 @@ CLASS( Async, gc::Object )
 
 	void ProcessAndExit( ExecutionPointer& ep );
 
-	void GetReachableObjects( std::unordered_set< gc::Object* >& reachable_objects ) override;
+	void GetReachableObjects( gc::MarkStack& reachable_objects ) override;
 
 private:
 
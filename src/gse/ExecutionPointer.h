@@ -1,7 +1,6 @@
 #pragma once
 
 #include <vector>
-#include <functional>
 
 #include "Types.h"
 
@@ -10,12 +9,25 @@ namespace gse {
 class ExecutionPointer {
 public:
 
-	void WithSI( const si_t& si, const std::function< void() >& f );
+	// si must stay valid while f runs ( only pointer is kept, to not copy file names on every call )
+	template< typename F >
+	void WithSI( const si_t& si, const F& f ) {
+		m_stacktrace.push_back( &si );
+		try {
+			f();
+		}
+		catch ( ... ) {
+			m_stacktrace.pop_back();
+			throw;
+		}
+		m_stacktrace.pop_back();
+	}
+
 	const std::vector< si_t > GetStackTrace() const;
 
 private:
 
-	std::vector< si_t > m_stacktrace = {};
+	std::vector< const si_t* > m_stacktrace = {};
 
 };
 
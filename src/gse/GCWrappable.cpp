@@ -16,18 +16,18 @@ const GCWrappable::callback_id_t GCWrappable::On( GSE_CALLABLE, const std::strin
 }
 
 void GCWrappable::Off( GSE_CALLABLE, const std::string& event, const callback_id_t callback_id ) {
-	const auto& it1 = m_callbacks.find( event );
-	if ( it1 != m_callbacks.end() ) {
+	const auto handlers = GetHandlers( event );
+	if ( handlers ) {
 		if ( callback_id ) {
 			// delete one handler
-			const auto& it2 = it1->second.find( callback_id );
-			if ( it2 != it1->second.end() ) {
+			const auto& it2 = handlers->find( callback_id );
+			if ( it2 != handlers->end() ) {
 				Unpersist( it2->second.callable );
 			}
 		}
 		else {
 			// delete all handlers
-			for ( const auto& it2 : it1->second ) {
+			for ( const auto& it2 : *handlers ) {
 				Unpersist( it2.second.callable );
 			}
 		}
@@ -39,7 +39,7 @@ const bool GCWrappable::HasHandlers( const std::string& event ) {
 	return Wrappable::HasHandlers( event );
 }
 
-void GCWrappable::GetReachableObjects( std::unordered_set< Object* >& reachable_objects ) {
+void GCWrappable::GetReachableObjects( gc::MarkStack& reachable_objects ) {
 	gc::Object::GetReachableObjects( reachable_objects );
 	gse::Wrappable::GetReachableObjects( reachable_objects );
 }
@@ -36,8 +36,9 @@ public:
 	const callback_id_t On( GSE_CALLABLE, const std::string& event, Value* const callback ) override;
 	void Off( GSE_CALLABLE, const std::string& event, const callback_id_t callback_id ) override;
 	const bool HasHandlers( const std::string& event ) override;
+	using Wrappable::HasHandlers;
 	
-	virtual void GetReachableObjects( std::unordered_set< Object* >& reachable_objects ) override;
+	virtual void GetReachableObjects( gc::MarkStack& reachable_objects ) override;
 	
 };
 
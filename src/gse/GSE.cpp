@@ -2,6 +2,7 @@
 
 #include "parser/JS.h"
 #include "runner/Interpreter.h"
+#include "runner/VM.h"
 #include "gse/context/GlobalContext.h"
 #include "Exception.h"
 #include "value/Undefined.h"
@@ -10,6 +11,8 @@
 #include "gc/Space.h"
 #include "Async.h"
 #include "ExecutionPointer.h"
+#include "engine/Engine.h"
+#include "config/Config.h"
 
 namespace gse {
 
@@ -21,6 +24,9 @@ GSE::GSE()
 	m_gc_space = new gc::Space( this );
 	m_gc_space->SetThreadId( std::this_thread::get_id() );
 	m_bindings.push_back( &m_builtins );
+	if ( g_engine ) {
+		m_runner_type = g_engine->GetConfig()->GetGSERunner();
+	}
 	m_gc_space->Accumulate(
 		this,
 		[ this ]() {
@@ -103,13 +109,25 @@ runner::Runner* GSE::GetRunner() {
 		m_gc_space->Accumulate(
 			this,
 			[ this ]() {
-				m_runner = new runner::Interpreter( m_gc_space );
+				switch ( m_runner_type ) {
+					case config::GR_VM: {
+						m_runner = new runner::VM( m_gc_space );
+						break;
+					}
+					default:
+						m_runner = new runner::Interpreter( m_gc_space );
+				}
 			}
 		);
 	}
 	return m_runner;
 }
 
+void GSE::SetRunnerType( const config::gse_runner_t runner_type ) {
+	ASSERT( !m_runner, "runner already created" );
+	m_runner_type = runner_type;
+}
+
 void GSE::AddBindings( Bindings* bindings ) {
 	m_bindings.push_back( bindings );
 }
@@ -245,7 +263,7 @@ Value* const GSE::GetGlobal( const std::string& identifier ) {
 		return it->second;
 	}
 	else {
-		return VALUEEXT( value::Undefined, m_gc_space );
+		return value::Undefined::Shared( m_gc_space );
 	}
 }
 
@@ -276,7 +294,7 @@ gc::Space* const GSE::GetGCSpace() const {
 	return m_gc_space;
 }
 
-void GSE::GetReachableObjects( std::unordered_set< Object* >& reachable_objects ) {
+void GSE::GetReachableObjects( gc::MarkStack& reachable_objects ) {
 	
 	GC_DEBUG_BEGIN( "runner" );
 	if ( m_runner ) {
@@ -12,6 +12,7 @@
 
 #include "Value.h"
 #include "builtins/Builtins.h"
+#include "config/Types.h"
 
 namespace gc {
 class Space;
@@ -55,6 +56,8 @@ CLASS( GSE, gc::Object )
 	parser::Parser* CreateParser( const std::string& filename, const std::string& source, const size_t initial_line_num = 1 );
 	parser::Parser* GetParser( const std::string& filename, const std::string& source, const size_t initial_line_num = 1 );
 	runner::Runner* GetRunner();
+	// must be called before GetRunner(), default comes from config
+	void SetRunnerType( const config::gse_runner_t runner_type );
 
 	void AddBindings( Bindings* bindings );
 
@@ -75,7 +78,7 @@ CLASS( GSE, gc::Object )
 	Async* GetAsync();
 	gc::Space* const GetGCSpace() const;
 
-	void GetReachableObjects( std::unordered_set< Object* >& reachable_objects ) override;
+	void GetReachableObjects( gc::MarkStack& reachable_objects ) override;
 
 #if defined ( DEBUG ) || defined( FASTDEBUG )
 
@@ -90,6 +93,7 @@ private:
 	std::unordered_set< context::GlobalContext* > m_global_contexts = {};
 	std::unordered_map< std::string, parser::Parser* > m_parsers = {}; // extension, parser
 	runner::Runner* m_runner = nullptr;
+	config::gse_runner_t m_runner_type = config::GR_INTERPRETER;
 
 	const std::unordered_set< std::string > m_supported_extensions = {
 		".gls.js",
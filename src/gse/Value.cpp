@@ -171,7 +171,10 @@ const std::string Value::ToString() const {
 		}
 		case T_OBJECTREF: {
 			const auto* that = (value::ObjectRef*)this;
-			return that->object->Get( that->key )->ToString();
+			return ( that->atom
+				? that->object->Get( that->atom )
+				: that->object->Get( that->key )
+			)->ToString();
 		}
 		case T_VALUEREF: {
 			const auto* that = (value::ValueRef*)this;
@@ -301,6 +304,9 @@ const std::string Value::Dump() const {
 }
 
 Value* const Value::Deref() {
+	if ( IsShared() ) {
+		return this;
+	}
 	CHECKACCUM( m_gc_space );
 	switch ( type ) {
 		case T_ARRAYREF: {
@@ -312,7 +318,9 @@ Value* const Value::Deref() {
 		}
 		case T_OBJECTREF: {
 			const auto* that = (value::ObjectRef*)this;
-			return that->object->Get( that->key );
+			return that->atom
+				? that->object->Get( that->atom )
+				: that->object->Get( that->key );
 		}
 		case T_VALUEREF: {
 			const auto* that = (value::ValueRef*)this;
@@ -324,10 +332,18 @@ Value* const Value::Deref() {
 }
 
 Value* const Value::Clone() {
+	if ( IsShared() ) {
+		// immutable, no need for copy
+		return this;
+	}
 	CHECKACCUM( m_gc_space );
 	return New( this );
 }
 
+const bool Value::IsShared() const {
+	return !m_gc_space;
+}
+
 #define DEFAULT_COMPARE( _op ) \
           case T_BOOL: \
                 return ( (value::Bool*)this )->value _op ( (value::Bool*)&other )->value; \
@@ -389,7 +405,7 @@ const bool Value::operator==( const Value& other ) const {
 			if ( a.size() != b.size() ) {
 				return false;
 			}
-			value::object_properties_t::const_iterator it_b;
+			value::Object::properties_t::const_iterator it_b;
 			for ( const auto& it : a ) {
 				if (
 					( it_b = b.find( it.first ) ) == b.end() ||
@@ -438,13 +454,13 @@ Value* const Value::New( const Value* value ) {
 	CHECKACCUM( gc_space );
 	switch ( type ) {
 		case T_UNDEFINED:
-			return VALUE( value::Undefined );
+			return VALUE_SHARED( value::Undefined );
 		case T_NULL:
-			return VALUE( value::Null );
+			return VALUE_SHARED( value::Null );
 		case T_BOOL:
-			return VALUE( value::Bool, , ( (value::Bool*)value )->value );
+			return VALUE_SHARED( value::Bool, , ( (value::Bool*)value )->value );
 		case T_INT:
-			return VALUE( value::Int, , ( (value::Int*)value )->value );
+			return VALUE_SHARED( value::Int, , ( (value::Int*)value )->value );
 		case T_FLOAT:
 			return VALUE( value::Float, , ( (value::Float*)value )->value );
 		case T_STRING:
@@ -554,11 +570,11 @@ Value* Value::Deserialize( GSE_CALLABLE, types::Buffer* buf, game::backend::Game
 		case T_NULLPTR:
 			return nullptr;
 		case T_UNDEFINED:
-			return VALUE( value::Undefined );
+			return VALUE_SHARED( value::Undefined );
 		case T_NULL:
-			return VALUE( value::Null );
+			return VALUE_SHARED( value::Null );
 		case T_BOOL:
-			return VALUE( value::Bool, , buf->ReadBool() );
+			return VALUE_SHARED( value::Bool, , buf->ReadBool() );
 		case T_INT:
 			return VALUE( value::Int, , buf->ReadInt() );
 		case T_FLOAT:
@@ -35,8 +35,14 @@ class Context;
 #define GSE_CALL_NOGC ctx, si, ep
 #define GSE_CALL gc_space, GSE_CALL_NOGC
 
-#define VALUE( _type, ... ) ( new _type( gc_space __VA_ARGS__ ) )
-#define VALUEEXT( _type, ... ) ( new _type( __VA_ARGS__ ) )
+// values are allocated from arena of their gc space ( first constructor argument )
+#define VALUE( _type, ... ) ( new ( gc_space ) _type( gc_space __VA_ARGS__ ) )
+#define VALUEEXT( _type, ... ) ( new ( VALUE_GC_SPACE_( __VA_ARGS__, ) ) _type( __VA_ARGS__ ) )
+#define VALUE_GC_SPACE_( ... ) VALUE_GC_SPACE__( __VA_ARGS__ )
+#define VALUE_GC_SPACE__( _gc_space, ... ) _gc_space
+// immutable values that are shared instead of allocated where possible ( undefined, null, bools, small ints ), see _type::Shared()
+// must not be modified, use VALUE() for values that need VALUE_SET()
+#define VALUE_SHARED( _type, ... ) ( _type::Shared( gc_space __VA_ARGS__ ) )
 #ifdef DEBUG
 #define VALUE_DATA( _type, _var ) ( _var->type == _type::GetType() ? ((_type*)_var) : THROW( "invalid GSE value type (expected " + Value::GetTypeStringStatic( _type::GetType() ) + ", got " + _var->GetTypeString() + ")" ) )
 #else
@@ -81,6 +87,37 @@ class Context;
     WRAPIMPL_DYNAMIC_BEGIN( _type ) \
     const gse::value::object_properties_t properties = {
 #define WRAPIMPL_PROPS gse::value::object_properties_t properties = {
+// wrapper is created once per space and reused while it exists, scalar properties are read from object on access ( see WRAPIMPL_LAZY )
+#define WRAPIMPL_CACHED_BEGIN( _type ) \
+    WRAPIMPL_BEGIN( _type ) \
+    typedef _type wrap_t; \
+    { \
+        auto* const cached = GetCachedWrapper( gc_space, dynamic ); \
+        if ( cached ) { \
+            return cached; \
+        } \
+    }
+#define WRAPIMPL_LAZY_BEGIN static const gse::value::Object::wrapgetters_t s_wrapgetters = {
+#define WRAPIMPL_LAZY_GETTER( _key, ... ) \
+    { \
+        gse::value::Shape::Intern( _key ), \
+        []( gse::Wrappable* const wrapobj, gse::Value* const previous, GSE_CALLABLE ) -> gse::Value* { \
+            [[maybe_unused]] const auto* const self = (const wrap_t*)wrapobj; /* constant getters don't need it */ \
+            __VA_ARGS__ \
+        } \
+    },
+#define WRAPIMPL_LAZY_VALUE_( _key, _type, _new, ... ) \
+    WRAPIMPL_LAZY_GETTER( _key, \
+        const decltype( gse::value::_type::value ) v = __VA_ARGS__; \
+        if ( previous && previous->type == gse::value::_type::GetType() && ( (gse::value::_type*)previous )->value == v ) { \
+            return previous; \
+        } \
+        return _new( gse::value::_type,, v ); \
+    )
+#define WRAPIMPL_LAZY( _key, _type, ... ) WRAPIMPL_LAZY_VALUE_( _key, _type, VALUE, __VA_ARGS__ )
+#define WRAPIMPL_LAZY_SHARED( _key, _type, ... ) WRAPIMPL_LAZY_VALUE_( _key, _type, VALUE_SHARED, __VA_ARGS__ )
+#define WRAPIMPL_LAZY_WRAPPED( _key, _property ) WRAPIMPL_LAZY_GETTER( _key, return self->_property->Wrap( GSE_CALL ); )
+#define WRAPIMPL_LAZY_END };
 #define WRAPIMPL_TRIGGERS \
     { \
         "on", \
@@ -103,7 +140,7 @@ class Context;
             else { \
                 Off( GSE_CALL, event, 0 ); \
             } \
-            return VALUE( gse::value::Undefined ); \
+            return VALUE_SHARED( gse::value::Undefined ); \
         } ) \
     }, \
     { \
@@ -123,8 +160,9 @@ class Context;
 
 #define WRAPIMPL_PROPS_EXTEND( _parent ) \
     const auto wrapped_parent = _parent::Wrap( GSE_CALL ); \
-    const auto& wrapped_parent_props = ( (gse::value::Object*)wrapped_parent )->value; \
-    properties.insert( wrapped_parent_props.begin(), wrapped_parent_props.end() );
+    for ( const auto& it : ( (gse::value::Object*)wrapped_parent )->value ) { \
+        properties.insert( { it.first, it.second } ); \
+    }
 #define WRAPIMPL_END_PTR() \
     return VALUEEXT( gse::value::Object, GSE_CALL, properties, WRAP_CLASS, this ); \
 }
@@ -132,6 +170,20 @@ class Context;
     }; \
     return VALUEEXT( gse::value::Object, GSE_CALL, properties, WRAP_CLASS, this, dynamic ? &_type::WrapSet : nullptr ); \
 } \
+void _type::WrapSet( gse::Wrappable* wrapobj, const std::string& key, gse::Value* const value, GSE_CALLABLE ) { \
+    auto* obj = (_type*)wrapobj; \
+    if ( !obj ) { return; }
+#define WRAPIMPL_CACHED_END_PTR() \
+    auto* const wrapped = VALUEEXT( gse::value::Object, GSE_CALL, properties, WRAP_CLASS, this, nullptr, &s_wrapgetters ); \
+    SetCachedWrapper( gc_space, dynamic, wrapped ); \
+    return wrapped; \
+}
+#define WRAPIMPL_CACHED_DYNAMIC_SETTERS( _type ) \
+    }; \
+    auto* const wrapped = VALUEEXT( gse::value::Object, GSE_CALL, properties, WRAP_CLASS, this, dynamic ? &_type::WrapSet : nullptr, &s_wrapgetters ); \
+    SetCachedWrapper( gc_space, dynamic, wrapped ); \
+    return wrapped; \
+} \
 void _type::WrapSet( gse::Wrappable* wrapobj, const std::string& key, gse::Value* const value, GSE_CALLABLE ) { \
     auto* obj = (_type*)wrapobj; \
     if ( !obj ) { return; }
@@ -254,6 +306,9 @@ public:
 	Value* const Deref();
 	Value* const Clone();
 
+	// shared values ( see VALUE_SHARED ) don't belong to any space and are never collected
+	const bool IsShared() const;
+
 #define OP( _op ) const bool operator _op( const Value& other ) const;
 	OP( == )
 	OP( != )
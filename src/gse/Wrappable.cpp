@@ -8,6 +8,8 @@
 
 namespace gse {
 
+std::atomic< size_t > Wrappable::s_wrappers_created = 0;
+
 Wrappable::Wrappable( const Wrappable& other ) {
 	// not copying callbacks
 }
@@ -26,29 +28,69 @@ Wrappable::~Wrappable() {
 void Wrappable::Link( value::Object* wrapobj ) {
 	ASSERT( m_wrapobjs.find( wrapobj ) == m_wrapobjs.end(), "wrapobj already linked" );
 	m_wrapobjs.insert( wrapobj );
+	s_wrappers_created.fetch_add( 1, std::memory_order_relaxed );
 }
 
 void Wrappable::Unlink( value::Object* wrapobj ) {
 	ASSERT( m_wrapobjs.find( wrapobj ) != m_wrapobjs.end(), "wrapobj not linked" );
 	m_wrapobjs.erase( wrapobj );
+	for ( auto it = m_cached_wrappers.begin() ; it != m_cached_wrappers.end() ; it++ ) {
+		if ( it->wrapobj == wrapobj ) {
+			m_cached_wrappers.erase( it );
+			break;
+		}
+	}
+}
+
+value::Object* const Wrappable::GetCachedWrapper( gc::Space* const gc_space, const bool dynamic ) const {
+	for ( const auto& it : m_cached_wrappers ) {
+		if ( it.gc_space == gc_space && it.dynamic == dynamic ) {
+			// unreachable wrapper will be deleted by sweep even if someone gets reference to it now
+			return it.wrapobj->IsUnreachable()
+				? nullptr
+				: it.wrapobj;
+		}
+	}
+	return nullptr;
+}
+
+void Wrappable::SetCachedWrapper( gc::Space* const gc_space, const bool dynamic, value::Object* const wrapobj ) {
+	ASSERT( m_wrapobjs.find( wrapobj ) != m_wrapobjs.end(), "cached wrapobj not linked" );
+	for ( auto& it : m_cached_wrappers ) {
+		if ( it.gc_space == gc_space && it.dynamic == dynamic ) {
+			it.wrapobj = wrapobj;
+			return;
+		}
+	}
+	m_cached_wrappers.push_back(
+		{
+			gc_space,
+			dynamic,
+			wrapobj
+		}
+	);
+}
+
+const size_t Wrappable::GetWrappersCreated() {
+	return s_wrappers_created.load( std::memory_order_relaxed );
+}
+
+void Wrappable::ResetWrappersCreated() {
+	s_wrappers_created.store( 0, std::memory_order_relaxed );
 }
 
 const Wrappable::callback_id_t Wrappable::On( GSE_CALLABLE, const std::string& event, gse::Value* const callback ) {
+	ASSERT( callback->type == Value::T_CALLABLE, "callback not callable" );
+	const auto atom = value::Shape::Intern( event );
 	std::lock_guard guard( m_callbacks_mutex );
-	if ( event == "*" ) {
+	if ( atom == GetCatchallAtom() ) {
 		m_catchall = true;
 	}
-	ASSERT( callback->type == Value::T_CALLABLE, "callback not callable" );
-	auto it = m_callbacks.find( event );
-	if ( it == m_callbacks.end() ) {
-		it = m_callbacks.insert(
-			{
-				event,
-				{}
-			}
-		).first;
-	}
-	return it->second.insert(
+	auto it = m_callbacks.find( atom );
+	auto handlers = it != m_callbacks.end()
+		? std::make_shared< handlers_t >( *it->second )
+		: std::make_shared< handlers_t >();
+	const auto callback_id = handlers->insert(
 		{
 			++m_next_callback_id,
 			{
@@ -58,116 +100,173 @@ const Wrappable::callback_id_t Wrappable::On( GSE_CALLABLE, const std::string& e
 			}
 		}
 	).first->first;
+	m_callbacks.insert_or_assign( atom, std::move( handlers ) );
+	m_has_callbacks.store( true, std::memory_order_release );
+	return callback_id;
 }
 
 void Wrappable::Off( GSE_CALLABLE, const std::string& event, const callback_id_t callback_id ) {
+	const auto atom = value::Shape::FindAtom( event );
+	if ( !atom ) {
+		return;
+	}
 	std::lock_guard guard( m_callbacks_mutex );
-	const auto& it = m_callbacks.find( event );
+	const auto& it = m_callbacks.find( atom );
 	if ( it != m_callbacks.end() ) {
 		if ( callback_id ) {
 			// delete one handler
-			const auto& it2 = it->second.find( callback_id );
-			if ( it2 != it->second.end() ) {
-				it->second.erase( it2 );
+			if ( it->second->find( callback_id ) == it->second->end() ) {
+				GSE_ERROR( gse::EC.INVALID_CALL, "Callback [" + event + "/" + std::to_string( callback_id ) + "] not found" );
+			}
+			if ( it->second->size() > 1 ) {
+				auto handlers = std::make_shared< handlers_t >( *it->second );
+				handlers->erase( callback_id );
+				it->second = std::move( handlers );
 			}
 			else {
-				GSE_ERROR( gse::EC.INVALID_CALL, "Callback [" + event + "/" + std::to_string( callback_id ) + "] not found" );
+				m_callbacks.erase( it );
 			}
 		}
 		else {
 			// delete all handlers
 			m_callbacks.erase( it );
 		}
+		if ( atom == GetCatchallAtom() ) {
+			m_catchall = m_callbacks.find( atom ) != m_callbacks.end();
+		}
+		m_has_callbacks.store( !m_callbacks.empty(), std::memory_order_release );
 	}
 }
 
 const bool Wrappable::HasHandlers( const std::string& event ) {
+	if ( !m_has_callbacks.load( std::memory_order_acquire ) ) {
+		return false;
+	}
+	return HasHandlers( value::Shape::FindAtom( event ) );
+}
+
+const bool Wrappable::HasHandlers( const value::atom_t event ) {
+	if ( !m_has_callbacks.load( std::memory_order_acquire ) ) {
+		return false;
+	}
 	std::lock_guard guard( m_callbacks_mutex );
-	return m_callbacks.find( event ) != m_callbacks.end() || m_callbacks.find( "*" ) != m_callbacks.end();
+	return ( event && m_callbacks.find( event ) != m_callbacks.end() ) || m_catchall;
 }
 
 Value* const Wrappable::Trigger( GSE_CALLABLE, const std::string& event, const f_args_t& f_args, const std::optional< Value::type_t > expected_return_type ) {
-	bool has_handler = false;
+	if ( !m_has_callbacks.load( std::memory_order_acquire ) ) {
+		// nobody listens, arguments aren't needed
+		return VALUE_SHARED( gse::value::Bool, , false );
+	}
+	return Trigger( GSE_CALL, value::Shape::FindAtom( event ), f_args, expected_return_type );
+}
+
+Value* const Wrappable::Trigger( GSE_CALLABLE, const value::atom_t atom, const f_args_t& f_args, const std::optional< Value::type_t > expected_return_type ) {
+	if ( !m_has_callbacks.load( std::memory_order_acquire ) ) {
+		// nobody listens, arguments aren't needed
+		return VALUE_SHARED( gse::value::Bool, , false );
+	}
+	handlers_ptr_t handlers = nullptr;
 	{
 		std::lock_guard guard( m_callbacks_mutex );
-		has_handler = m_callbacks.find( event ) != m_callbacks.end();
-	}
-	if ( has_handler ) {
-		Value* result = nullptr;
-		value::object_properties_t args = {};
-		if ( f_args ) {
-			f_args( GSE_CALL, args );
+		if ( atom ) {
+			const auto it = m_callbacks.find( atom );
+			if ( it != m_callbacks.end() ) {
+				handlers = it->second;
+			}
 		}
-		auto* args_obj = VALUEEXT( gse::value::Object, GSE_CALL, args );
-		result = Trigger( GSE_CALL, event, args_obj, expected_return_type );
-		if ( result ) {
-			return result;
+		if ( !handlers && m_catchall ) {
+			// catch-all handlers only run if event has no own handlers
+			const auto it = m_callbacks.find( GetCatchallAtom() );
+			if ( it != m_callbacks.end() ) {
+				handlers = it->second;
+			}
 		}
 	}
-	if ( m_catchall && event != "*" ) {
-		return Trigger( GSE_CALL, "*", f_args, expected_return_type );
+	if ( !handlers ) {
+		return VALUE_SHARED( gse::value::Bool, , false );
 	}
-	return VALUE( gse::value::Bool, , false );
+	value::object_properties_t args = {};
+	if ( f_args ) {
+		f_args( GSE_CALL, args );
+	}
+	auto* args_obj = VALUEEXT( gse::value::Object, GSE_CALL, args );
+	return RunHandlers( GSE_CALL, *handlers, args_obj, expected_return_type );
 }
 
 Value* const Wrappable::Trigger( GSE_CALLABLE, const std::string& event, gse::value::Object* const args_obj, const std::optional< Value::type_t > expected_return_type ) {
-	std::lock_guard guard( m_callbacks_mutex );
 	ASSERT( args_obj, "args_obj is null" );
-	Value* result = nullptr;
-	const auto& it = m_callbacks.find( event );
-	if ( it != m_callbacks.end() ) {
-		const auto callbacks = it->second; // copy because callbacks may be changed during trigger
-		for ( const auto& it2 : callbacks ) {
-			const auto& cb = it2.second.callable;
-			if ( cb->type != Value::T_CALLABLE ) {
-				ASSERT( cb->type == Value::T_CALLABLE, "callback not callable" );
-			}
-			m_callbacks_mutex.unlock(); // TODO: improve?
-			try {
-				result = ( (value::Callable*)cb )->Run( gc_space, it2.second.ctx, it2.second.si, ep, { args_obj } );
-			}
-			catch ( const gse::Exception& e ) {
-				m_callbacks_mutex.lock(); // to prevent error when guard exits
-				throw e;
-			}
-			catch ( const std::runtime_error& e ) {
-				m_callbacks_mutex.lock(); // to prevent error when guard exits
-				throw e;
-			}
-			m_callbacks_mutex.lock();
-			if ( expected_return_type.has_value() ) {
-				if ( !result || result->type != expected_return_type.value() ) {
-					throw gse::Exception( gse::EC.INVALID_HANDLER, "Event handler is expected to return " + Value::GetTypeStringStatic( expected_return_type.value() ) + ", got " + result->GetTypeString() + ": " + result->ToString(), it2.second.ctx, it2.second.si, ep );
-				}
-			}
-			if ( result && result->type != Value::T_UNDEFINED ) {
-				// TODO: resolve result conflicts somehow
-			}
-		}
+	const auto handlers = GetHandlers( event );
+	if ( !handlers ) {
+		return VALUE_SHARED( gse::value::Bool, , false );
 	}
-	return result
-		? result
-		: VALUE( gse::value::Bool, , false );
+	return RunHandlers( GSE_CALL, *handlers, args_obj, expected_return_type );
 }
 
 void Wrappable::ClearHandlers() {
 	std::lock_guard guard( m_callbacks_mutex );
 /*#if defined( DEBUG ) || defined( FASTDEBUG )
 	for ( const auto& it : m_callbacks ) {
-		g_engine->Log( "Removing " + std::to_string( it.second.size() ) + " handler(s) for \"" + it.first + "\"" );
+		g_engine->Log( "Removing " + std::to_string( it.second->size() ) + " handler(s) for \"" + *it.first + "\"" );
 	}
 #endif*/
 	m_callbacks.clear();
+	m_catchall = false;
+	m_has_callbacks.store( false, std::memory_order_release );
+}
+
+const Wrappable::handlers_ptr_t Wrappable::GetHandlers( const std::string& event ) {
+	if ( !m_has_callbacks.load( std::memory_order_acquire ) ) {
+		return nullptr;
+	}
+	return GetHandlers( value::Shape::FindAtom( event ) );
+}
+
+const Wrappable::handlers_ptr_t Wrappable::GetHandlers( const value::atom_t event ) {
+	if ( !event || !m_has_callbacks.load( std::memory_order_acquire ) ) {
+		return nullptr;
+	}
+	std::lock_guard guard( m_callbacks_mutex );
+	const auto it = m_callbacks.find( event );
+	return it != m_callbacks.end()
+		? it->second
+		: nullptr;
+}
+
+const value::atom_t Wrappable::GetCatchallAtom() {
+	static const auto s_catchall_atom = value::Shape::Intern( "*" );
+	return s_catchall_atom;
+}
+
+Value* const Wrappable::RunHandlers( GSE_CALLABLE, const handlers_t& handlers, gse::value::Object* const args_obj, const std::optional< Value::type_t >& expected_return_type ) {
+	// list is immutable and kept alive by caller, so handlers can add or remove handlers freely
+	Value* result = nullptr;
+	for ( const auto& it : handlers ) {
+		const auto& cb = it.second.callable;
+		ASSERT( cb->type == Value::T_CALLABLE, "callback not callable" );
+		result = ( (value::Callable*)cb )->Run( gc_space, it.second.ctx, it.second.si, ep, { args_obj } );
+		if ( expected_return_type.has_value() ) {
+			if ( !result || result->type != expected_return_type.value() ) {
+				throw gse::Exception( gse::EC.INVALID_HANDLER, "Event handler is expected to return " + Value::GetTypeStringStatic( expected_return_type.value() ) + ", got " + result->GetTypeString() + ": " + result->ToString(), it.second.ctx, it.second.si, ep );
+			}
+		}
+		if ( result && result->type != Value::T_UNDEFINED ) {
+			// TODO: resolve result conflicts somehow
+		}
+	}
+	return result
+		? result
+		: VALUE_SHARED( gse::value::Bool, , false );
 }
 
-void Wrappable::GetReachableObjects( std::unordered_set< gc::Object* >& reachable_objects ) {
+void Wrappable::GetReachableObjects( gc::MarkStack& reachable_objects ) {
 	GC_DEBUG_BEGIN( "GCWrappable" );
 
 	GC_DEBUG_BEGIN( "callbacks" );
 	{
 		std::lock_guard guard( m_callbacks_mutex );
 		for ( const auto& it1 : m_callbacks ) {
-			for ( const auto& it2 : it1.second ) {
+			for ( const auto& it2 : *it1.second ) {
 				GC_REACHABLE( it2.second.callable );
 			}
 		}
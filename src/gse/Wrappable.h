@@ -6,6 +6,9 @@
 #include <optional>
 #include <functional>
 #include <mutex>
+#include <vector>
+#include <atomic>
+#include <memory>
 
 #include "value/Types.h"
 #include "value/Int.h"
@@ -90,6 +93,15 @@ public:
 	void Link( value::Object* wrapobj );
 	void Unlink( value::Object* wrapobj );
 
+	// wrapper that was created by Wrap() for this space before, if it still exists and isn't about to be collected
+	// cache doesn't keep wrapper reachable, it's forgotten when wrapper or this object is destroyed
+	value::Object* const GetCachedWrapper( gc::Space* const gc_space, const bool dynamic ) const;
+	void SetCachedWrapper( gc::Space* const gc_space, const bool dynamic, value::Object* const wrapobj );
+
+	// number of wrapper objects linked since last reset ( for stats )
+	static const size_t GetWrappersCreated();
+	static void ResetWrappersCreated();
+
 	typedef uint16_t callback_id_t;
 	typedef std::function< void( GSE_CALLABLE, value::object_properties_t& args ) > f_args_t;
 	typedef std::function< void() > f_cleanup_t;
@@ -98,26 +110,55 @@ public:
 	virtual const bool HasHandlers( const std::string& event );
 	virtual Value* const Trigger( GSE_CALLABLE, const std::string& event, const f_args_t& f_args = nullptr, const std::optional< Value::type_t > expected_return_type = {} );
 	virtual Value* const Trigger( GSE_CALLABLE, const std::string& event, gse::value::Object* args_obj, const std::optional< Value::type_t > expected_return_type = {} );
+	// same but with event name interned beforehand ( see value::Shape::Intern ), for hot paths, skips global atoms lookup
+	const bool HasHandlers( const value::atom_t event );
+	Value* const Trigger( GSE_CALLABLE, const value::atom_t event, const f_args_t& f_args = nullptr, const std::optional< Value::type_t > expected_return_type = {} );
 	virtual void ClearHandlers();
 
-	void GetReachableObjects( std::unordered_set< gc::Object* >& reachable_objects );
+	void GetReachableObjects( gc::MarkStack& reachable_objects );
 
 protected:
 	// TODO: wrapobjs mutex
 	std::unordered_set< value::Object* > m_wrapobjs = {};
 
+private:
+	struct cached_wrapper_t {
+		gc::Space* gc_space;
+		bool dynamic;
+		value::Object* wrapobj;
+	};
+	std::vector< cached_wrapper_t > m_cached_wrappers = {}; // usually one or two
+
+	static std::atomic< size_t > s_wrappers_created;
+
 protected:
 	struct callback_t {
 		Value* callable;
 		context::Context* ctx;
 		si_t si;
 	};
-	typedef std::unordered_map< std::string, std::map< uint16_t, callback_t > > callbacks_t;
+	// handler lists are never modified after creation, On() and Off() replace them with modified copies
+	// so that Trigger() can run handlers without copying or holding lock
+	typedef std::map< callback_id_t, callback_t > handlers_t;
+	typedef std::shared_ptr< const handlers_t > handlers_ptr_t;
+	// event names are interned like property names ( see value::Shape ), lists are never empty
+	typedef std::unordered_map< value::atom_t, handlers_ptr_t > callbacks_t;
 	callbacks_t m_callbacks = {};
 	callback_id_t m_next_callback_id = 0;
 	std::mutex m_callbacks_mutex = {};
 
 	bool m_catchall = false;
+
+	// nullptr if there are no handlers for event
+	const handlers_ptr_t GetHandlers( const std::string& event );
+	const handlers_ptr_t GetHandlers( const value::atom_t event );
+
+private:
+	// checked without lock, so that events nobody listens to are skipped quickly
+	std::atomic< bool > m_has_callbacks = false;
+
+	static const value::atom_t GetCatchallAtom();
+	Value* const RunHandlers( GSE_CALLABLE, const handlers_t& handlers, gse::value::Object* const args_obj, const std::optional< Value::type_t >& expected_return_type );
 };
 
 }
@@ -28,7 +28,7 @@ void Async::AddToContext( gc::Space* const gc_space, context::Context* ctx, Exec
 					if ( !ctx->GetGSE()->GetAsync()->StopTimer( timer_id ) ) {
 						GSE_ERROR( EC.OPERATION_FAILED, "Timer is already stopped" );
 					}
-					return VALUE( value::Undefined );
+					return VALUE_SHARED( value::Undefined );
 				} ),
 			}
 		};
@@ -28,7 +28,7 @@ void Common::AddToContext( gc::Space* const gc_space, context::Context* ctx, Exe
 		if ( v && v->type == Value::T_OBJECT ) {
 			return VALUE( value::String,, ( ( value::Object*)v )->object_class );
 		}
-		return VALUE( value::Undefined );
+		return VALUE_SHARED( value::Undefined );
 	} ), ep );
 
 	ctx->CreateBuiltin( "sizeof", NATIVE_CALL() {
@@ -53,13 +53,13 @@ void Common::AddToContext( gc::Space* const gc_space, context::Context* ctx, Exe
 		N_EXPECT_ARGS( 1 );
 		N_GETPTR( v, 0 );
 		if ( !v ) {
-			return VALUE( gse::value::Bool,, false );
+			return VALUE_SHARED( gse::value::Bool,, false );
 		}
 		switch ( v->type ) {
 			case Value::T_UNDEFINED:
-				return VALUE( gse::value::Bool,, false );
+				return VALUE_SHARED( gse::value::Bool,, false );
 			default:
-				return VALUE( gse::value::Bool,, true );
+				return VALUE_SHARED( gse::value::Bool,, true );
 		}
 	} ), ep );
 
@@ -85,7 +85,7 @@ void Common::AddToContext( gc::Space* const gc_space, context::Context* ctx, Exe
 					GSE_ERROR( EC.OPERATION_NOT_SUPPORTED, "Could not get size of " + v->GetTypeString() + ": " + v->ToString() );
 			}
 		}
-		return VALUE( value::Bool,, is_empty );
+		return VALUE_SHARED( value::Bool,, is_empty );
 	} ), ep );
 
 	ctx->CreateBuiltin( "clone", NATIVE_CALL()
@@ -101,7 +101,7 @@ void Common::AddToContext( gc::Space* const gc_space, context::Context* ctx, Exe
 		}
 	} ), ep );
 
-	ctx->CreateBuiltin( "undefined", VALUE( value::Undefined ), ep );
+	ctx->CreateBuiltin( "undefined", VALUE_SHARED( value::Undefined ), ep );
 }
 
 }
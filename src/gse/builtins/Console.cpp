@@ -41,19 +41,19 @@ void Console::AddToContext( gc::Space* const gc_space, context::Context* ctx, Ex
 		}
 #endif
 		util::LogHelper::Println( "    " + si.ToString() + " " + line );
-		return VALUE( value::Undefined );
+		return VALUE_SHARED( value::Undefined );
 	} ), ep );
 
 #if defined( DEBUG ) || defined( FASTDEBUG )
 
 	ctx->CreateBuiltin( "global_mute", NATIVE_CALL() {
 		logger::g_is_muted = true;
-		return VALUE( value::Undefined );
+		return VALUE_SHARED( value::Undefined );
 	} ), ep );
 
 	ctx->CreateBuiltin( "global_unmute", NATIVE_CALL() {
 		logger::g_is_muted = false;
-		return VALUE( value::Undefined );
+		return VALUE_SHARED( value::Undefined );
 	} ), ep );
 
 #endif
@@ -115,7 +115,7 @@ void Conversions::AddToContext( gc::Space* const gc_space, context::Context* ctx
 			default:
 				f_err();
 		}
-		return VALUE( value::Undefined );
+		return VALUE_SHARED( value::Undefined );
 	} ), ep );
 
 #undef CONVERT_COLOR
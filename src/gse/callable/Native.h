@@ -4,6 +4,7 @@
 
 #include "gse/value/Callable.h"
 #include "gse/value/Types.h"
+#include "gse/value/Object.h"
 
 #include "gse/Value.h"
 
@@ -15,7 +16,7 @@ namespace callable {
 // TODO: refactor these
 #define N_ARGS \
     const gse::Value* arg; \
-    gse::value::object_properties_t::const_iterator obj_it; \
+    gse::value::Object::properties_t::const_iterator obj_it; \
     gse::Value* getprop_val = nullptr; \
     gse::Value* obj_val = nullptr; \
     gse::Value* callable_val = nullptr;
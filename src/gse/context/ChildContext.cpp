@@ -1,17 +1,23 @@
 #include "ChildContext.h"
 
 #include "gse/Exception.h"
+#include "gse/program/Frame.h"
 
 namespace gse {
 namespace context {
 
-ChildContext::ChildContext( GSE* gse, Context* parent_context, const si_t& si, const bool is_traceable )
+ChildContext::ChildContext( GSE* gse, Context* parent_context, const si_t& si, const bool is_traceable, const program::Frame* frame )
 	: Context( gse )
-	, m_parent_context( parent_context )
 	, m_si( si )
 	, m_is_traceable( is_traceable ) {
-	ASSERT( m_parent_context, "parent context not set" );
-	ASSERT( m_parent_context->GetParentContext() != this, "circular context dependency" );
+	ASSERT( parent_context, "parent context not set" );
+	ASSERT( parent_context->GetParentContext() != this, "circular context dependency" );
+	m_parent_context = parent_context;
+	m_parent_decl_limit = parent_context->m_decl_count;
+	if ( frame && frame->GetSize() ) {
+		m_frame = frame;
+		m_slots.resize( frame->GetSize(), { nullptr, false } );
+	}
 	m_parent_context->AddChildContext( this );
 }
 
@@ -21,10 +27,6 @@ ChildContext::~ChildContext() {
 	}
 }
 
-Context* ChildContext::GetParentContext() const {
-	return m_parent_context;
-}
-
 const si_t& ChildContext::GetSI() const {
 	return m_si;
 }
@@ -70,7 +72,7 @@ void ChildContext::JoinContext() {
 	}*/
 }
 
-void ChildContext::GetReachableObjects( std::unordered_set< Object* >& reachable_objects ) {
+void ChildContext::GetReachableObjects( gc::MarkStack& reachable_objects ) {
 	Context::GetReachableObjects( reachable_objects );
 
 	GC_DEBUG_BEGIN( "ChildContext" );
@@ -6,6 +6,8 @@
 #include "common/Common.h"
 #include "gse/value/Callable.h"
 #include "gse/value/Undefined.h"
+#include "gse/program/Frame.h"
+#include "gse/program/Variable.h"
 #include "gc/Space.h"
 #include "util/LogHelper.h"
 
@@ -17,8 +19,13 @@ Context::Context( gse::GSE* gse )
 	, m_gse( gse ) {}
 
 Context::~Context() {
-	for ( const auto& child_context : m_child_contexts ) {
-		child_context->Detach();
+	auto* child = m_first_child_context;
+	while ( child ) {
+		auto* const next = child->m_next_sibling_context;
+		child->m_prev_sibling_context = nullptr;
+		child->m_next_sibling_context = nullptr;
+		child->Detach();
+		child = next;
 	}
 }
 
@@ -26,29 +33,19 @@ GSE* Context::GetGSE() const {
 	return m_gse;
 }
 
+Context* Context::GetParentContext() const {
+	return m_parent_context;
+}
+
 const bool Context::HasVariable( const std::string& name ) {
-	const auto it = m_variables.find( name );
-	if ( it != m_variables.end() ) {
-		return true;
-	}
-	const auto ref_it = m_ref_contexts.find( name );
-	if ( ref_it != m_ref_contexts.end() ) {
-		return true;
-	}
-	return false;
+	return FindVariable( name, NOT_DECLARED, nullptr ) != nullptr;
 }
 
 Value* const Context::GetVariable( const std::string& name, const si_t& si, gse::ExecutionPointer& ep ) {
 	CHECKACCUM( m_gse->GetGCSpace() );
-	const auto it = m_variables.find( name );
-	if ( it != m_variables.end() ) {
-		return it->second.value;
-	}
-	const auto ref_it = m_ref_contexts.find( name );
-	if ( ref_it != m_ref_contexts.end() ) {
-		const auto ref = ref_it->second;
-		ASSERT( ref != this, "unexpected ref context recursion (was this context freed while in use?)" );
-		return ref->GetVariable( name, si, ep );
+	const auto* var = FindVariable( name, NOT_DECLARED, nullptr );
+	if ( var ) {
+		return var->value;
 	}
 	throw Exception( EC.REFERENCE_ERROR, "Variable '" + name + "' is not defined", CONTEXT_GSE_CALL );
 }
@@ -59,56 +56,101 @@ void Context::SetVariable( const std::string& name, const var_info_t& var_info )
 }
 
 void Context::CreateVariable( const std::string& name, Value* const value, CONTEXT_GSE_CALLABLE ) {
-	ASSERT( value, "value is null" );
-	if ( m_variables.find( name ) != m_variables.end() ) {
-		throw Exception( EC.INVALID_ASSIGNMENT, "Variable '" + name + "' already exists", CONTEXT_GSE_CALL );
-	}
-	m_variables.insert_or_assign(
-		name, var_info_t{
-			value,
-			false,
-		}
-	);
+	Declare( GetOwnVariable( name ), name, value, false, si, ep );
 }
 
 void Context::CreateConst( const std::string& name, Value* const value, CONTEXT_GSE_CALLABLE ) {
-	ASSERT( value, "value is null" );
-	if ( m_variables.find( name ) != m_variables.end() ) {
-		throw Exception( EC.INVALID_ASSIGNMENT, "Variable '" + name + "' already exists", CONTEXT_GSE_CALL );
-	}
-	m_variables.insert_or_assign(
-		name, var_info_t{
-			value,
-			true
-		}
-	);
+	Declare( GetOwnVariable( name ), name, value, true, si, ep );
 }
 
 void Context::UpdateVariable( const std::string& name, Value* const value, CONTEXT_GSE_CALLABLE ) {
-	ASSERT( value, "value is null" );
-	const auto it = m_variables.find( name );
-	if ( it != m_variables.end() ) {
-		if ( it->second.is_const ) {
-			throw Exception( EC.INVALID_ASSIGNMENT, "Can't change value of const '" + name + "'", CONTEXT_GSE_CALL );
-		}
-		it->second.value = value;
-		return;
-	}
-	const auto ref_it = m_ref_contexts.find( name );
-	if ( ref_it != m_ref_contexts.end() ) {
-		ref_it->second->UpdateVariable( name, value, si, ep );
+	Context* owner = nullptr;
+	Update( FindVariable( name, NOT_DECLARED, &owner ), owner, name, value, si, ep );
+}
+
+void Context::DestroyVariable( const std::string& name, CONTEXT_GSE_CALLABLE ) {
+	auto* var = GetOwnVariable( name );
+	if ( var && var->value ) {
+		// entry stays so that its declaration order is kept
+		var->value = nullptr;
 		return;
 	}
 	throw Exception( EC.REFERENCE_ERROR, "Variable '" + name + "' is not defined", CONTEXT_GSE_CALL );
 }
 
-void Context::DestroyVariable( const std::string& name, CONTEXT_GSE_CALLABLE ) {
-	const auto it = m_variables.find( name );
-	if ( it != m_variables.end() ) {
-		m_variables.erase( it );
+Value* const Context::GetVariable( const program::Variable* variable, CONTEXT_GSE_CALLABLE ) {
+	return GetVariable( variable, variable->location, si, ep );
+}
+
+Value* const Context::GetVariable( const program::Variable* variable, const program::variable_location_t& location, CONTEXT_GSE_CALLABLE ) {
+	CHECKACCUM( m_gse->GetGCSpace() );
+	const auto* var = FindVariable( variable, location, nullptr );
+#ifdef DEBUG
+	// hidden slots can't be found by name
+	ASSERT( location.frame != variable->location.frame || var == FindVariable( variable->name, NOT_DECLARED, nullptr ), "variable location mismatch for " + variable->name );
+#endif
+	if ( var ) {
+		return var->value;
+	}
+	throw Exception( EC.REFERENCE_ERROR, "Variable '" + variable->name + "' is not defined", CONTEXT_GSE_CALL );
+}
+
+void Context::CreateVariable( const program::Variable* variable, Value* const value, CONTEXT_GSE_CALLABLE ) {
+	CreateVariable( variable, variable->location, value, si, ep );
+}
+
+void Context::CreateConst( const program::Variable* variable, Value* const value, CONTEXT_GSE_CALLABLE ) {
+	CreateConst( variable, variable->location, value, si, ep );
+}
+
+void Context::CreateVariable( const program::Variable* variable, const program::variable_location_t& location, Value* const value, CONTEXT_GSE_CALLABLE ) {
+	Declare( GetOwnVariable( variable, location ), variable->name, value, false, si, ep );
+}
+
+void Context::CreateConst( const program::Variable* variable, const program::variable_location_t& location, Value* const value, CONTEXT_GSE_CALLABLE ) {
+	Declare( GetOwnVariable( variable, location ), variable->name, value, true, si, ep );
+}
+
+void Context::UpdateVariable( const program::Variable* variable, Value* const value, CONTEXT_GSE_CALLABLE ) {
+	UpdateVariable( variable, variable->location, value, si, ep );
+}
+
+void Context::UpdateVariable( const program::Variable* variable, const program::variable_location_t& location, Value* const value, CONTEXT_GSE_CALLABLE ) {
+	Context* owner = nullptr;
+	auto* var = FindVariable( variable, location, &owner );
+#ifdef DEBUG
+	ASSERT( location.frame != variable->location.frame || var == FindVariable( variable->name, NOT_DECLARED, nullptr ), "variable location mismatch for " + variable->name );
+#endif
+	Update( var, owner, variable->name, value, si, ep );
+}
+
+void Context::AddHiddenSlots( const program::Frame* frame, const size_t count ) {
+	ASSERT( !m_frame || m_frame == frame, "context frame mismatch" );
+	m_frame = frame;
+	m_slots.resize(
+		frame->GetSize() + count, {
+			nullptr,
+			false
+		}
+	);
+}
+
+void Context::ResetSlots( const size_t first, const size_t count ) {
+	ASSERT( first + count <= m_slots.size(), "slots out of range" );
+	for ( size_t i = first ; i < first + count ; i++ ) {
+		// declaration order stays, it's same scope every time
+		m_slots[ i ].value = nullptr;
+		m_slots[ i ].is_const = false;
+	}
+}
+
+void Context::DestroyVariable( const program::Variable* variable, CONTEXT_GSE_CALLABLE ) {
+	auto* var = GetOwnVariable( variable, variable->location );
+	if ( var && var->value ) {
+		var->value = nullptr;
 		return;
 	}
-	throw Exception( EC.REFERENCE_ERROR, "Variable '" + name + "' is not defined", CONTEXT_GSE_CALL );
+	throw Exception( EC.REFERENCE_ERROR, "Variable '" + variable->name + "' is not defined", CONTEXT_GSE_CALL );
 }
 
 void Context::CreateBuiltin( const std::string& name, Value* const value, gse::ExecutionPointer& ep ) {
@@ -123,58 +165,60 @@ ChildContext* const Context::ForkAndExecute(
 	GSE_CALLABLE,
 	const bool is_traceable,
 	const std::function< void( ChildContext* const subctx ) >& f
+) {
+	return ForkAndExecute( GSE_CALL, is_traceable, nullptr, f );
+}
+
+ChildContext* const Context::ForkAndExecute(
+	GSE_CALLABLE,
+	const bool is_traceable,
+	const program::Frame* frame,
+	const std::function< void( ChildContext* const subctx ) >& f
 ) {
 	CHECKACCUM( gc_space );
-	NEWV( result, ChildContext, m_gse, this, si, is_traceable );
-	// functions have access to parent variables
-	for ( auto& it : m_ref_contexts ) {
-		result->m_ref_contexts.insert_or_assign( it.first, it.second );
-	}
-	for ( auto& it : m_variables ) {
-		result->m_ref_contexts.insert_or_assign( it.first, this );
-	}
+	// nothing is copied, child sees parent variables through m_parent_context ( limited by m_parent_decl_limit )
+	NEWV( result, ChildContext, m_gse, this, si, is_traceable, frame );
 	f( result );
 	return result;
 }
 
 void Context::Clear() {
-	m_variables.clear();
-	for ( const auto& c : m_child_contexts ) {
-		c->Clear();
+	for ( auto& v : m_slots ) {
+		v.value = nullptr;
 	}
-}
-
-void Context::UnrefVariable( const std::string& name ) {
-	const auto& it = m_ref_contexts.find( name );
-	if ( it != m_ref_contexts.end() ) {
-		m_ref_contexts.erase( it );
-		for ( const auto& c : m_child_contexts ) {
-			c->UnrefVariable( name );
-		}
+	for ( auto& it : m_variables ) {
+		it.second.value = nullptr;
+	}
+	for ( auto* c = m_first_child_context ; c ; c = c->m_next_sibling_context ) {
+		c->Clear();
 	}
 }
 
-void Context::GetReachableObjects( std::unordered_set< Object* >& reachable_objects ) {
+void Context::GetReachableObjects( gc::MarkStack& reachable_objects ) {
 	gc::Object::GetReachableObjects( reachable_objects );
 
 	GC_DEBUG_BEGIN( "Context" );
 
-	GC_DEBUG_BEGIN( "variables" );
-	for ( const auto& v : m_variables ) {
-		GC_DEBUG_BEGIN( v.first );
-		GC_REACHABLE( v.second.value );
-		GC_DEBUG_END();
+	GC_DEBUG_BEGIN( "slots" );
+	for ( const auto& v : m_slots ) {
+		if ( v.value ) {
+			GC_REACHABLE( v.value );
+		}
 	}
 	GC_DEBUG_END();
 
-	GC_DEBUG_BEGIN( "ref_contexts" );
-	for ( const auto& it : m_ref_contexts ) {
-		GC_REACHABLE( it.second );
+	GC_DEBUG_BEGIN( "variables" );
+	for ( const auto& v : m_variables ) {
+		if ( v.second.value ) {
+			GC_DEBUG_BEGIN( v.first );
+			GC_REACHABLE( v.second.value );
+			GC_DEBUG_END();
+		}
 	}
 	GC_DEBUG_END();
 
 /*	GC_DEBUG_BEGIN( "child_contexts" );
-	for ( const auto& child : m_child_contexts ) {
+	for ( auto* child = m_first_child_context ; child ; child = child->m_next_sibling_context ) {
 		GC_REACHABLE( child );
 	}
 	GC_DEBUG_END();*/
@@ -183,16 +227,120 @@ void Context::GetReachableObjects( std::unordered_set< Object* >& reachable_obje
 
 }
 
+Context::var_info_t* Context::GetOwnVariable( const std::string& name ) {
+	if ( m_frame ) {
+		const auto slot = m_frame->GetSlot( name );
+		if ( slot != program::Frame::NO_SLOT ) {
+			return &m_slots[ slot ];
+		}
+	}
+	const auto it = m_variables.find( name );
+	return it != m_variables.end()
+		? &it->second
+		: nullptr;
+}
+
+Context::var_info_t* Context::GetOwnVariable( const program::Variable* variable, const program::variable_location_t& location ) {
+	if ( location.frame && location.frame == m_frame && !location.depth ) {
+		return &m_slots[ location.slot ];
+	}
+	return GetOwnVariable( variable->name );
+}
+
+Context::var_info_t* Context::FindVariable( const std::string& name, size_t limit, Context** owner ) {
+	auto* ctx = this;
+	while ( ctx ) {
+		auto* var = ctx->GetOwnVariable( name );
+		if ( var && var->value && ( limit == NOT_DECLARED || var->decl_index < limit ) ) {
+			if ( owner ) {
+				*owner = ctx;
+			}
+			return var;
+		}
+		limit = ctx->m_parent_decl_limit;
+		ctx = ctx->m_parent_context;
+	}
+	return nullptr;
+}
+
+Context::var_info_t* Context::FindVariable( const program::Variable* variable, const program::variable_location_t& location, Context** owner ) {
+	auto* ctx = this;
+	size_t limit = NOT_DECLARED;
+	for ( size_t i = 0 ; i < location.depth ; i++ ) {
+		if ( !ctx->m_parent_context ) {
+			// detached or running outside of context chain resolver expected
+			return FindVariable( variable->name, NOT_DECLARED, owner );
+		}
+		limit = ctx->m_parent_decl_limit;
+		ctx = ctx->m_parent_context;
+	}
+	if ( !location.frame ) {
+		// unresolved, nothing with such name exists in skipped contexts
+		return ctx->FindVariable( variable->name, limit, owner );
+	}
+	if ( ctx->m_frame == location.frame ) {
+		auto* var = &ctx->m_slots[ location.slot ];
+		if ( var->value && ( limit == NOT_DECLARED || var->decl_index < limit ) ) {
+			if ( owner ) {
+				*owner = ctx;
+			}
+			return var;
+		}
+	}
+	// not declared yet or destroyed, something from further up may be visible instead
+	return FindVariable( variable->name, NOT_DECLARED, owner );
+}
+
+void Context::Declare( var_info_t* var, const std::string& name, Value* const value, const bool is_const, CONTEXT_GSE_CALLABLE ) {
+	ASSERT( value, "value is null" );
+	if ( !var ) {
+		var = &m_variables[ name ];
+	}
+	else if ( var->value ) {
+		throw Exception( EC.INVALID_ASSIGNMENT, "Variable '" + name + "' already exists", CONTEXT_GSE_CALL );
+	}
+	var->value = value;
+	var->is_const = is_const;
+	if ( var->decl_index == NOT_DECLARED ) {
+		var->decl_index = m_decl_count++;
+	}
+}
+
+void Context::Update( var_info_t* var, Context* owner, const std::string& name, Value* const value, CONTEXT_GSE_CALLABLE ) {
+	ASSERT( value, "value is null" );
+	if ( !var ) {
+		throw Exception( EC.REFERENCE_ERROR, "Variable '" + name + "' is not defined", CONTEXT_GSE_CALL );
+	}
+	if ( var->is_const ) {
+		throw Exception( EC.INVALID_ASSIGNMENT, "Can't change value of const '" + name + "'", owner, si, ep );
+	}
+	var->value = value;
+}
+
 void Context::AddChildContext( ChildContext* const child ) {
-	ASSERT( m_child_contexts.find( child ) == m_child_contexts.end(), "child context already added" );
-	m_child_contexts.insert( child );
+	ASSERT( !child->m_prev_sibling_context && !child->m_next_sibling_context && m_first_child_context != child, "child context already added" );
+	child->m_next_sibling_context = m_first_child_context;
+	if ( m_first_child_context ) {
+		m_first_child_context->m_prev_sibling_context = child;
+	}
+	m_first_child_context = child;
 }
 
 void Context::RemoveChildContext( ChildContext* const child ) {
-	if ( !m_child_contexts.empty() ) { // ?
-		ASSERT( m_child_contexts.find( child ) != m_child_contexts.end(), "child context not found" );
-		m_child_contexts.erase( child );
+	auto* const prev = child->m_prev_sibling_context;
+	auto* const next = child->m_next_sibling_context;
+	if ( prev ) {
+		prev->m_next_sibling_context = next;
+	}
+	else {
+		ASSERT( m_first_child_context == child, "child context not found" );
+		m_first_child_context = next;
+	}
+	if ( next ) {
+		next->m_prev_sibling_context = prev;
 	}
+	child->m_prev_sibling_context = nullptr;
+	child->m_next_sibling_context = nullptr;
 }
 
 }
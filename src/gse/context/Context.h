@@ -12,6 +12,7 @@
 
 #include "gse/Types.h"
 #include "gse/value/Types.h"
+#include "gse/program/Types.h"
 
 #include "gse/Value.h"
 
@@ -26,15 +27,23 @@ namespace value {
 class Object;
 }
 
+namespace program {
+class Frame;
+class Variable;
+}
+
 namespace context {
 
 class ChildContext;
 
 class Context : public gc::Object {
 protected:
+	static const size_t NOT_DECLARED = (size_t)-1;
 	struct var_info_t {
 		Value* value;
 		bool is_const;
+		// order of first declaration within context, children only see variables declared before they were forked
+		size_t decl_index = NOT_DECLARED;
 	};
 	struct script_info_t {
 		const std::string path;
@@ -55,6 +64,26 @@ public:
 	void CreateConst( const std::string& name, Value* const value, CONTEXT_GSE_CALLABLE );
 	void UpdateVariable( const std::string& name, Value* const value, CONTEXT_GSE_CALLABLE );
 	void DestroyVariable( const std::string& name, CONTEXT_GSE_CALLABLE );
+
+	// same but use location from resolver if possible
+	Value* const GetVariable( const program::Variable* variable, CONTEXT_GSE_CALLABLE );
+	void CreateVariable( const program::Variable* variable, Value* const value, CONTEXT_GSE_CALLABLE );
+	void CreateConst( const program::Variable* variable, Value* const value, CONTEXT_GSE_CALLABLE );
+	void UpdateVariable( const program::Variable* variable, Value* const value, CONTEXT_GSE_CALLABLE );
+	void DestroyVariable( const program::Variable* variable, CONTEXT_GSE_CALLABLE );
+
+	// same but with location adjusted by runner ( i.e. if it didn't fork some of scopes )
+	Value* const GetVariable( const program::Variable* variable, const program::variable_location_t& location, CONTEXT_GSE_CALLABLE );
+	void CreateVariable( const program::Variable* variable, const program::variable_location_t& location, Value* const value, CONTEXT_GSE_CALLABLE );
+	void CreateConst( const program::Variable* variable, const program::variable_location_t& location, Value* const value, CONTEXT_GSE_CALLABLE );
+	void UpdateVariable( const program::Variable* variable, const program::variable_location_t& location, Value* const value, CONTEXT_GSE_CALLABLE );
+
+	// slots after ones of frame, for variables of nested scopes that runner doesn't fork ( see runner::VM )
+	// they are only reachable through adjusted locations, not by name
+	void AddHiddenSlots( const program::Frame* frame, const size_t count );
+	// undeclares variables in slots, i.e. before every run of scope that keeps its variables here
+	void ResetSlots( const size_t first, const size_t count );
+
 	void CreateBuiltin( const std::string& name, Value* const value, gse::ExecutionPointer& ep );
 
 	void Execute( const std::function< void() >& f );
@@ -64,13 +93,18 @@ public:
 		const bool is_traceable,
 		const std::function< void( ChildContext* const subctx ) >& f
 	);
+	ChildContext* const ForkAndExecute(
+		GSE_CALLABLE,
+		const bool is_traceable,
+		const program::Frame* frame,
+		const std::function< void( ChildContext* const subctx ) >& f
+	);
 
 	void Clear();
-	void UnrefVariable( const std::string& name );
 
-	virtual void GetReachableObjects( std::unordered_set< Object* >& reachable_objects ) override;
+	virtual void GetReachableObjects( gc::MarkStack& reachable_objects ) override;
 
-	virtual Context* GetParentContext() const = 0;
+	Context* GetParentContext() const;
 	virtual const bool IsTraceable() const = 0;
 	virtual const std::string& GetSourceLine( const size_t line_num ) const = 0;
 	virtual const si_t& GetSI() const = 0;
@@ -80,14 +114,31 @@ protected:
 
 	GSE* m_gse;
 
+	Context* m_parent_context = nullptr; // scope parent
+	size_t m_parent_decl_limit = 0; // how many parent variables were declared when this context was forked
+
+	// variables known to resolver, indexed by slot
+	const program::Frame* m_frame = nullptr;
+	std::vector< var_info_t > m_slots = {};
+
+	// everything else ( globals, builtins, variables of unresolved programs )
 	typedef std::unordered_map< std::string, var_info_t > variables_t;
 	variables_t m_variables = {};
-	typedef std::unordered_map< std::string, Context* > ref_contexts_t;
-	ref_contexts_t m_ref_contexts = {};
 
 private:
-	std::unordered_set< ChildContext* > m_child_contexts = {};
-	std::unordered_set< Value* > m_child_objects = {};
+	// children are kept in intrusive list so that forking is cheap
+	ChildContext* m_first_child_context = nullptr;
+	ChildContext* m_prev_sibling_context = nullptr;
+	ChildContext* m_next_sibling_context = nullptr;
+
+	size_t m_decl_count = 0;
+
+	var_info_t* GetOwnVariable( const std::string& name );
+	var_info_t* GetOwnVariable( const program::Variable* variable, const program::variable_location_t& location );
+	var_info_t* FindVariable( const std::string& name, size_t limit, Context** owner );
+	var_info_t* FindVariable( const program::Variable* variable, const program::variable_location_t& location, Context** owner );
+	void Declare( var_info_t* var, const std::string& name, Value* const value, const bool is_const, CONTEXT_GSE_CALLABLE );
+	void Update( var_info_t* var, Context* owner, const std::string& name, Value* const value, CONTEXT_GSE_CALLABLE );
 
 private:
 	friend class ChildContext;
@@ -23,10 +23,6 @@ GlobalContext::GlobalContext( GSE* gse, const std::string& source_path )
 			: util::String::Split( util::FS::ReadTextFile( source_path, GSE::PATH_SEPARATOR ), '\n' )
 	) {}
 
-Context* GlobalContext::GetParentContext() const {
-	return nullptr;
-}
-
 const bool GlobalContext::IsTraceable() const {
 	return false;
 }
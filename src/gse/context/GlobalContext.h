@@ -17,7 +17,6 @@ public:
 
 	GlobalContext( GSE* gse, const std::string& source_path );
 
-	Context* GetParentContext() const override;
 	const bool IsTraceable() const override;
 	const std::string& GetSourceLine( const size_t line_num ) const override;
 	const si_t& GetSI() const override;
@@ -186,25 +186,25 @@ private:
 		{
 			PO_TRUE,
 			[]( gc::Space* const gc_space ) {
-				return VALUE( value::Bool, , true );
+				return VALUE_SHARED( value::Bool, , true );
 			},
 		},
 		{
 			PO_FALSE,
 			[]( gc::Space* const gc_space ) {
-				return VALUE( value::Bool, , false );
+				return VALUE_SHARED( value::Bool, , false );
 			},
 		},
 		{
 			PO_NULL,
 			[]( gc::Space* const gc_space ) {
-				return VALUE( value::Null );
+				return VALUE_SHARED( value::Null );
 			},
 		},
 		{
 			PO_UNDEFINED,
 			[]( gc::Space* const gc_space ) {
-				return VALUE( value::Undefined );
+				return VALUE_SHARED( value::Undefined );
 			},
 		},
 	};
@@ -3,6 +3,7 @@
 #include <cstring>
 
 #include "gse/ExecutionPointer.h"
+#include "gse/program/Resolver.h"
 #include "gc/Space.h"
 
 #include "gse/value/String.h"
@@ -37,10 +38,11 @@ const program::Program* Parser::Parse() {
 	for ( auto& it : elements ) {
 		delete it;
 	}
+	program::Resolver().Resolve( program );
 	return program;
 }
 
-void Parser::GetReachableObjects( std::unordered_set< gc::Object* >& reachable_objects ) {
+void Parser::GetReachableObjects( gc::MarkStack& reachable_objects ) {
 	gc::Object::GetReachableObjects( reachable_objects );
 
 	GC_DEBUG_BEGIN( "Parser" );
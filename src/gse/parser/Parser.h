@@ -26,7 +26,7 @@ CLASS( Parser, gc::Object )
 
 	const program::Program* Parse();
 
-	void GetReachableObjects( std::unordered_set< gc::Object* >& reachable_objects ) override;
+	void GetReachableObjects( gc::MarkStack& reachable_objects ) override;
 
 protected:
 
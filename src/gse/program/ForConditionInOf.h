@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ForCondition.h"
+#include "Frame.h"
 
 namespace gse {
 namespace program {
@@ -23,6 +24,9 @@ public:
 	const for_inof_condition_type_t for_inof_type;
 	const Expression* expression;
 
+	// loop variable, filled by Resolver
+	mutable Frame frame = {};
+
 	const std::string ToString() const override;
 	const std::string Dump( const size_t depth = 0 ) const override;
 };
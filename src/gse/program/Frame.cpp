@@ -0,0 +1,50 @@
+#include "Frame.h"
+
+#include "common/Assert.h"
+
+namespace gse {
+namespace program {
+
+const size_t Frame::GetSize() const {
+	return m_names.size();
+}
+
+const size_t Frame::GetSlot( const std::string& name ) const {
+	const auto it = m_slots.find( name );
+	return it != m_slots.end()
+		? it->second
+		: NO_SLOT;
+}
+
+const std::string& Frame::GetName( const size_t slot ) const {
+	ASSERT( slot < m_names.size(), "slot out of range" );
+	return m_names.at( slot );
+}
+
+const size_t Frame::AddVariable( const std::string& name ) {
+	const auto it = m_slots.find( name );
+	if ( it != m_slots.end() ) {
+		return it->second;
+	}
+	const size_t slot = m_names.size();
+	m_names.push_back( name );
+	m_slots.insert(
+		{
+			name,
+			slot
+		}
+	);
+	return slot;
+}
+
+const Frame* Frame::GetObjectFrame() {
+	static const Frame s_object_frame = []() {
+		Frame frame;
+		frame.AddVariable( "this" );
+		return frame;
+	}();
+	return &s_object_frame;
+}
+
+}
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+namespace gse {
+namespace program {
+
+// names declared directly in scope ( or function parameters, or loop variable ), every name gets fixed slot
+// contexts created for element with frame store variables in slots instead of looking them up by name
+class Frame {
+public:
+	static const size_t NO_SLOT = (size_t)-1;
+
+	const size_t GetSize() const;
+	const size_t GetSlot( const std::string& name ) const;
+	const std::string& GetName( const size_t slot ) const;
+
+	// returns existing slot if name is already declared
+	const size_t AddVariable( const std::string& name );
+
+	// contexts of objects only have 'this'
+	static const Frame* GetObjectFrame();
+
+private:
+	std::vector< std::string > m_names = {};
+	std::unordered_map< std::string, size_t > m_slots = {};
+};
+
+}
+}
@@ -3,6 +3,8 @@
 #include "Variable.h"
 #include "Scope.h"
 
+#include "gse/runner/vm/Chunk.h"
+
 namespace gse {
 namespace program {
 
@@ -16,6 +18,7 @@ Function::~Function() {
 		delete it;
 	}
 	delete body;
+	delete chunk.load();
 }
 
 const std::string Function::ToString() const {
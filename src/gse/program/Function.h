@@ -1,10 +1,19 @@
 #pragma once
 
 #include <vector>
+#include <atomic>
 
 #include "Operand.h"
+#include "Frame.h"
 
 namespace gse {
+
+namespace runner {
+namespace vm {
+class Chunk;
+}
+}
+
 namespace program {
 
 class Variable;
@@ -19,6 +28,12 @@ public:
 	const std::vector< Variable* > parameters;
 	const Scope* body;
 
+	// parameters, in order, filled by Resolver
+	mutable Frame parameters_frame = {};
+
+	// bytecode of body that runs without own context, compiled by vm on first call
+	mutable std::atomic< const runner::vm::Chunk* > chunk = nullptr;
+
 	const std::string ToString() const override;
 	const std::string Dump( const size_t depth = 0 ) const override;
 };
@@ -0,0 +1,292 @@
+#include "Resolver.h"
+
+#include "Program.h"
+#include "Frame.h"
+#include "Scope.h"
+#include "Control.h"
+#include "Statement.h"
+#include "Conditional.h"
+#include "If.h"
+#include "ElseIf.h"
+#include "Else.h"
+#include "While.h"
+#include "For.h"
+#include "ForConditionInOf.h"
+#include "ForConditionExpressions.h"
+#include "Try.h"
+#include "Catch.h"
+#include "Switch.h"
+#include "Case.h"
+#include "SimpleCondition.h"
+#include "Expression.h"
+#include "Operator.h"
+#include "Variable.h"
+#include "Array.h"
+#include "Object.h"
+#include "Function.h"
+#include "Call.h"
+
+#include "common/Assert.h"
+
+namespace gse {
+namespace program {
+
+void Resolver::Resolve( const Program* program ) {
+	ASSERT( m_frames.empty(), "resolver already used" );
+
+	// declarations are collected first because closures may see variables declared after them
+	CollectScope( program->body );
+	ASSERT( !m_current_frame, "frames not popped" );
+
+	for ( const auto& reference : m_references ) {
+		ResolveReference( reference );
+	}
+
+	for ( const auto& frame : m_frames ) {
+		delete frame;
+	}
+	m_frames.clear();
+	m_references.clear();
+}
+
+void Resolver::PushFrame( const Frame* frame, Frame* declarations ) {
+	auto* f = new frame_t{
+		frame,
+		declarations,
+		m_current_frame,
+		{}
+	};
+	m_frames.push_back( f );
+	m_current_frame = f;
+}
+
+void Resolver::PopFrame() {
+	ASSERT( m_current_frame, "no frame to pop" );
+	m_current_frame = m_current_frame->parent;
+}
+
+void Resolver::CollectScope( const Scope* scope ) {
+	PushFrame( &scope->frame, &scope->frame );
+	for ( const auto& it : scope->body ) {
+		CollectControl( it );
+	}
+	PopFrame();
+}
+
+void Resolver::CollectControl( const Control* control ) {
+	switch ( control->control_type ) {
+		case Control::CT_STATEMENT: {
+			CollectExpression( ( (Statement*)control )->body );
+			break;
+		}
+		case Control::CT_CONDITIONAL: {
+			CollectConditional( (Conditional*)control );
+			break;
+		}
+		default:
+			THROW( "unexpected control type: " + control->Dump() );
+	}
+}
+
+void Resolver::CollectConditional( const Conditional* conditional ) {
+	switch ( conditional->conditional_type ) {
+		case Conditional::CT_IF: {
+			const auto* c = (If*)conditional;
+			CollectExpression( c->condition->expression );
+			CollectScope( c->body );
+			if ( c->els ) {
+				CollectConditional( c->els );
+			}
+			break;
+		}
+		case Conditional::CT_ELSEIF: {
+			const auto* c = (ElseIf*)conditional;
+			CollectExpression( c->condition->expression );
+			CollectScope( c->body );
+			if ( c->els ) {
+				CollectConditional( c->els );
+			}
+			break;
+		}
+		case Conditional::CT_ELSE: {
+			CollectScope( ( (Else*)conditional )->body );
+			break;
+		}
+		case Conditional::CT_WHILE: {
+			const auto* c = (While*)conditional;
+			CollectExpression( c->condition->expression );
+			CollectScope( c->body );
+			break;
+		}
+		case Conditional::CT_FOR: {
+			const auto* c = (For*)conditional;
+			switch ( c->condition->for_type ) {
+				case ForCondition::FCT_EXPRESSIONS: {
+					// evaluated in parent context
+					const auto* condition = (ForConditionExpressions*)c->condition;
+					CollectExpression( condition->init );
+					CollectExpression( condition->check );
+					CollectExpression( condition->iterate );
+					CollectScope( c->body );
+					break;
+				}
+				case ForCondition::FCT_IN_OF: {
+					// target is evaluated in parent context, then variable lives in own context around body
+					const auto* condition = (ForConditionInOf*)c->condition;
+					CollectExpression( condition->expression );
+					PushFrame( &condition->frame, &condition->frame );
+					condition->frame.AddVariable( condition->variable->name );
+					CollectVariable( condition->variable );
+					CollectScope( c->body );
+					PopFrame();
+					break;
+				}
+				default:
+					THROW( "unexpected for condition type: " + std::to_string( c->condition->for_type ) );
+			}
+			break;
+		}
+		case Conditional::CT_TRY: {
+			const auto* c = (Try*)conditional;
+			CollectScope( c->body );
+			// handlers aren't real object, they are evaluated in parent context
+			for ( const auto& it : c->handlers->handlers->ordered_properties ) {
+				CollectExpression( it.second );
+			}
+			break;
+		}
+		case Conditional::CT_SWITCH: {
+			const auto* s = (Switch*)conditional;
+			CollectExpression( s->condition->expression );
+			for ( const auto& c : s->cases ) {
+				if ( c->condition ) {
+					CollectExpression( c->condition->expression );
+				}
+				CollectScope( c->body );
+			}
+			break;
+		}
+		default:
+			THROW( "unexpected conditional type: " + conditional->Dump() );
+	}
+}
+
+void Resolver::CollectExpression( const Expression* expression ) {
+	if ( !expression ) {
+		return;
+	}
+	if ( expression->a ) {
+		CollectOperand( expression->a );
+	}
+	if ( expression->b ) {
+		// child name is not a variable
+		if ( !expression->op || expression->op->op != OT_CHILD || expression->b->type != Operand::OT_VARIABLE ) {
+			CollectOperand( expression->b );
+		}
+	}
+}
+
+void Resolver::CollectOperand( const Operand* operand ) {
+	switch ( operand->type ) {
+		case Operand::OT_VARIABLE: {
+			const auto* variable = (Variable*)operand;
+			if ( variable->hints != VH_NONE ) {
+				ASSERT( m_current_frame, "declaration outside of frame" );
+				if ( m_current_frame->declarations ) {
+					m_current_frame->declarations->AddVariable( variable->name );
+				}
+				else {
+					m_current_frame->dynamic_names.insert( variable->name );
+				}
+			}
+			CollectVariable( variable );
+			break;
+		}
+		case Operand::OT_ARRAY: {
+			for ( const auto& it : ( (Array*)operand )->elements ) {
+				CollectExpression( it );
+			}
+			break;
+		}
+		case Operand::OT_OBJECT: {
+			// properties are evaluated in object's own context
+			PushFrame( Frame::GetObjectFrame(), nullptr );
+			for ( const auto& it : ( (Object*)operand )->ordered_properties ) {
+				CollectExpression( it.second );
+			}
+			PopFrame();
+			break;
+		}
+		case Operand::OT_SCOPE: {
+			CollectScope( (Scope*)operand );
+			break;
+		}
+		case Operand::OT_EXPRESSION: {
+			CollectExpression( (Expression*)operand );
+			break;
+		}
+		case Operand::OT_FUNCTION: {
+			const auto* func = (Function*)operand;
+			PushFrame( &func->parameters_frame, &func->parameters_frame );
+			for ( const auto& it : func->parameters ) {
+				func->parameters_frame.AddVariable( it->name );
+				CollectVariable( it );
+			}
+			CollectScope( func->body );
+			PopFrame();
+			break;
+		}
+		case Operand::OT_CALL: {
+			const auto* call = (Call*)operand;
+			CollectExpression( call->callable );
+			for ( const auto& it : call->arguments ) {
+				CollectExpression( it );
+			}
+			break;
+		}
+		default: {
+			// values, loop controls, nothing
+		}
+	}
+}
+
+void Resolver::CollectVariable( const Variable* variable ) {
+	m_references.push_back(
+		{
+			variable,
+			m_current_frame
+		}
+	);
+}
+
+void Resolver::ResolveReference( const reference_t& reference ) const {
+	const auto& name = reference.variable->name;
+	auto& location = reference.variable->location;
+	size_t depth = 0;
+	for ( auto* f = reference.frame ; f ; f = f->parent ) {
+		if ( f->dynamic_names.find( name ) != f->dynamic_names.end() ) {
+			// may or may not exist here, can only be looked up by name
+			location = {};
+			return;
+		}
+		const auto slot = f->frame->GetSlot( name );
+		if ( slot != Frame::NO_SLOT ) {
+			location = {
+				f->frame,
+				depth,
+				slot
+			};
+			return;
+		}
+		depth++;
+	}
+	// global or builtin, skip all frames
+	location = {
+		nullptr,
+		depth,
+		0
+	};
+}
+
+}
+}
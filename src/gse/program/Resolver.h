@@ -0,0 +1,58 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_set>
+
+namespace gse {
+namespace program {
+
+class Program;
+class Frame;
+class Scope;
+class Control;
+class Conditional;
+class Expression;
+class Operand;
+class Variable;
+
+// assigns every variable of program a ( depth, slot ) location so that runner doesn't need to look it up by name
+// frames follow contexts that interpreter forks at runtime: one per scope, function parameters, for..in/of variable and object
+class Resolver {
+public:
+
+	void Resolve( const Program* program );
+
+private:
+
+	struct frame_t {
+		const Frame* frame;
+		Frame* declarations; // nullptr if variables declared here can't get slots ( i.e. inside object literal )
+		frame_t* parent;
+		std::unordered_set< std::string > dynamic_names;
+	};
+	std::vector< frame_t* > m_frames = {};
+	frame_t* m_current_frame = nullptr;
+
+	struct reference_t {
+		const Variable* variable;
+		const frame_t* frame;
+	};
+	std::vector< reference_t > m_references = {};
+
+	void PushFrame( const Frame* frame, Frame* declarations );
+	void PopFrame();
+
+	void CollectScope( const Scope* scope );
+	void CollectControl( const Control* control );
+	void CollectConditional( const Conditional* conditional );
+	void CollectExpression( const Expression* expression );
+	void CollectOperand( const Operand* operand );
+	void CollectVariable( const Variable* variable );
+
+	void ResolveReference( const reference_t& reference ) const;
+
+};
+
+}
+}
@@ -2,6 +2,8 @@
 
 #include "Control.h"
 
+#include "gse/runner/vm/Chunk.h"
+
 namespace gse {
 namespace program {
 
@@ -13,6 +15,7 @@ Scope::~Scope() {
 	for ( auto& it : body ) {
 		delete it;
 	}
+	delete chunk.load();
 }
 
 const std::string Scope::ToString() const {
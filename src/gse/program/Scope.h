@@ -1,10 +1,19 @@
 #pragma once
 
 #include <vector>
+#include <atomic>
 
 #include "Operand.h"
+#include "Frame.h"
 
 namespace gse {
+
+namespace runner {
+namespace vm {
+class Chunk;
+}
+}
+
 namespace program {
 
 class Control;
@@ -17,6 +26,12 @@ public:
 
 	const std::vector< const Control* > body;
 
+	// variables declared directly in scope, filled by Resolver
+	mutable Frame frame = {};
+
+	// bytecode, compiled by vm on first execution
+	mutable std::atomic< const runner::vm::Chunk* > chunk = nullptr;
+
 	const std::string ToString() const override;
 	const std::string Dump( const size_t depth = 0 ) const override;
 };
@@ -1,10 +1,21 @@
 #pragma once
 
 #include <cstdint>
+#include <cstddef>
 
 namespace gse {
 namespace program {
 
+class Frame;
+
+// where variable lives, assigned by Resolver
+// frame is not set if variable could not be resolved statically, then it's looked up by name starting from context at depth
+struct variable_location_t {
+	const Frame* frame = nullptr;
+	size_t depth = 0; // parent contexts to go up
+	size_t slot = 0;
+};
+
 enum variable_hints_t : uint8_t {
 	VH_NONE,
 	VH_CREATE_VAR,
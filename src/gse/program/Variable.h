@@ -5,10 +5,13 @@
 #include "Operand.h"
 
 #include "Types.h"
+#include "gse/value/Types.h"
 
 namespace gse {
 namespace program {
 
+class Frame;
+
 class Variable : public Operand {
 public:
 
@@ -17,6 +20,12 @@ public:
 	const std::string name;
 	const variable_hints_t hints;
 
+	// assigned by Resolver
+	mutable variable_location_t location = {};
+
+	// used when variable names property of object ( i.e. in 'a.b' ), filled on first access
+	mutable value::property_cache_t property = {};
+
 	const std::string ToString() const override;
 	const std::string Dump( const size_t depth = 0 ) const override;
 };
@@ -66,12 +66,28 @@ gse::Value* const Interpreter::Execute( context::Context* ctx, ExecutionPointer&
 	return EvaluateScope( ctx, ep, program->body );
 }
 
+gse::Value* const Interpreter::CallFunction( context::Context* ctx, const si_t& si, ExecutionPointer& ep, const program::Function* function, const function_arguments_t& arguments ) {
+	auto* gc_space = m_gc_space;
+	// same as ForkAndExecute(), without wrapping calls into std::function
+	NEWV( subctx, context::ChildContext, ctx->GetGSE(), ctx, si, true, &function->parameters_frame );
+	const auto& parameters = function->parameters;
+	for ( size_t i = 0 ; i < parameters.size() ; i++ ) { // inject passed arguments
+		subctx->CreateVariable(
+			parameters[ i ], i < arguments.size()
+				? arguments.at( i )
+				: VALUE_SHARED( value::Undefined ),
+			si, ep
+		);
+	}
+	return EvaluateScope( subctx, ep, function->body );
+}
+
 gse::Value* const Interpreter::EvaluateScope( context::Context* ctx, ExecutionPointer& ep, const Scope* scope, bool* returnflag ) {
 	CHECKACCUM( m_gc_space );
 	gse::Value* result = nullptr;
 
 	ctx->ForkAndExecute(
-		m_gc_space, ctx, scope->m_si, ep, false,
+		m_gc_space, ctx, scope->m_si, ep, false, &scope->frame,
 		[ this, &scope, &ep, &result, &returnflag ]( gse::context::ChildContext* const subctx ) {
 
 			for ( const auto& it : scope->body ) {
@@ -203,7 +219,7 @@ gse::Value* const Interpreter::EvaluateConditional( context::Context* ctx, Execu
 					const auto* condition = (ForConditionInOf*)c->condition;
 					const auto target = Deref( ctx, condition->m_si, ep, EvaluateExpression( ctx, ep, condition->expression ) );
 					ctx->ForkAndExecute(
-						m_gc_space, ctx, condition->m_si, ep, false, [ this, &gc_space, &target, &condition, &result, &ep, &c, &need_break, &need_clear, &returnflag ]( gse::context::ChildContext* const subctx ) {
+						m_gc_space, ctx, condition->m_si, ep, false, &condition->frame, [ this, &gc_space, &target, &condition, &result, &ep, &c, &need_break, &need_clear, &returnflag ]( gse::context::ChildContext* const subctx ) {
 
 							switch ( target->type ) {
 								case gse::Value::T_ARRAY: {
@@ -211,9 +227,9 @@ gse::Value* const Interpreter::EvaluateConditional( context::Context* ctx, Execu
 									switch ( condition->for_inof_type ) {
 										case ForConditionInOf::FIC_IN: {
 											for ( size_t i = 0 ; i < arr->value.size() ; i++ ) {
-												subctx->CreateConst( condition->variable->name, VALUE( Int, , i ), condition->m_si, ep );
+												subctx->CreateConst( condition->variable, VALUE_SHARED( Int, , i ), condition->m_si, ep );
 												result = EvaluateScope( subctx, ep, c->body, returnflag );
-												subctx->DestroyVariable( condition->variable->name, condition->m_si, ep );
+												subctx->DestroyVariable( condition->variable, condition->m_si, ep );
 												CheckBreakCondition( result, &need_break, &need_clear );
 												if ( need_break || ( returnflag && *returnflag ) ) {
 													if ( need_clear ) {
@@ -226,9 +242,9 @@ gse::Value* const Interpreter::EvaluateConditional( context::Context* ctx, Execu
 										}
 										case ForConditionInOf::FIC_OF: {
 											for ( const auto& v : arr->value ) {
-												subctx->CreateConst( condition->variable->name, v, condition->m_si, ep );
+												subctx->CreateConst( condition->variable, v, condition->m_si, ep );
 												result = EvaluateScope( subctx, ep, c->body, returnflag );
-												subctx->DestroyVariable( condition->variable->name, condition->m_si, ep );
+												subctx->DestroyVariable( condition->variable, condition->m_si, ep );
 												CheckBreakCondition( result, &need_break, &need_clear );
 												if ( need_break || ( returnflag && *returnflag ) ) {
 													if ( need_clear ) {
@@ -251,12 +267,12 @@ gse::Value* const Interpreter::EvaluateConditional( context::Context* ctx, Execu
 									}
 									for ( const auto& v : obj->value ) {
 										subctx->CreateConst(
-											condition->variable->name, condition->for_inof_type == ForConditionInOf::FIC_IN
+											condition->variable, condition->for_inof_type == ForConditionInOf::FIC_IN
 												? VALUE( String, , v.first )
 												: v.second, condition->m_si, ep
 										);
 										result = EvaluateScope( subctx, ep, c->body, returnflag );
-										subctx->DestroyVariable( condition->variable->name, condition->m_si, ep );
+										subctx->DestroyVariable( condition->variable, condition->m_si, ep );
 										if ( returnflag && *returnflag ) {
 											break;
 										}
@@ -385,9 +401,6 @@ gse::Value* const Interpreter::EvaluateExpression( context::Context* ctx, Execut
 	const auto& operation_not_supported_not_array = [ expression, &ctx, &ep ]( const std::string& a ) -> gse::Exception {
 		return gse::Exception( EC.OPERATION_NOT_SUPPORTED, "Operation " + expression->op->ToString() + " is not supported: " + a + " is not array", ctx, expression->op->m_si, ep );
 	};
-	const auto& math_error = [ expression, &ctx, &ep ]( const std::string& reason ) -> gse::Exception {
-		return gse::Exception( EC.MATH_ERROR, reason, ctx, expression->op->m_si, ep );
-	};
 	switch ( expression->op->op ) {
 		case OT_RETURN: {
 			ASSERT( returnflag, "return keyword not allowed here" );
@@ -454,13 +467,13 @@ gse::Value* const Interpreter::EvaluateExpression( context::Context* ctx, Execut
 						throw gse::Exception( EC.INVALID_ASSIGNMENT, "Can't assign to builtin: " + var->name, ctx, var->m_si, ep );
 					}
 					if ( var->hints & VH_CREATE_VAR ) {
-						ctx->CreateVariable( var->name, result, expression->a->m_si, ep );
+						ctx->CreateVariable( var, result, expression->a->m_si, ep );
 					}
 					else if ( var->hints & VH_CREATE_CONST ) {
-						ctx->CreateConst( var->name, result, expression->a->m_si, ep );
+						ctx->CreateConst( var, result, expression->a->m_si, ep );
 					}
 					else {
-						ctx->UpdateVariable( var->name, result, expression->a->m_si, ep );
+						ctx->UpdateVariable( var, result, expression->a->m_si, ep );
 					}
 					break;
 				}
@@ -478,10 +491,10 @@ gse::Value* const Interpreter::EvaluateExpression( context::Context* ctx, Execut
 		}
 		case OT_NOT: {
 			ASSERT( !expression->a, "unary not may not have left operand" );
-			return VALUE( Bool, , !EvaluateBool( ctx, ep, expression->b ) );
+			return VALUE_SHARED( Bool, , !EvaluateBool( ctx, ep, expression->b ) );
 		}
 #define CMP_OP( _op ) { \
-        return VALUE( Bool,, \
+        return VALUE_SHARED( Bool,, \
             *Deref( ctx, expression->a->m_si, ep, EvaluateOperand( ctx, ep, expression->a ) ) \
                 _op \
             *Deref( ctx, expression->b->m_si, ep, EvaluateOperand( ctx, ep, expression->b ) ) \
@@ -495,7 +508,7 @@ gse::Value* const Interpreter::EvaluateExpression( context::Context* ctx, Execut
 		case OT_GTE: CMP_OP( >= )
 #undef CMP_OP
 #define CMP_BOOL( _op ) { \
-        return VALUE( Bool,, \
+        return VALUE_SHARED( Bool,, \
             EvaluateBool( ctx, ep, expression->a ) _op \
                 EvaluateBool( ctx, ep, expression->b ) \
             ); \
@@ -503,96 +516,36 @@ gse::Value* const Interpreter::EvaluateExpression( context::Context* ctx, Execut
 		case OT_AND: CMP_BOOL( && )
 		case OT_OR: CMP_BOOL( || )
 #undef CMP_BOOL
-#define MATH_OP_BEGIN( _op, _allow_b_zero ) \
-            const auto av = Deref( ctx, expression->a->m_si, ep, EvaluateOperand( ctx, ep, expression->a ) ); \
-            const auto bv = Deref( ctx, expression->b->m_si, ep, EvaluateOperand( ctx, ep, expression->b ) ); \
-            const auto* a = av; \
-            const auto* b = bv; \
-            if ( a->type != b->type ) { \
-                throw operation_not_supported( a->ToString(), b->ToString() ); \
-            } \
-            switch ( a->type ) { \
-                case gse::Value::T_INT: { \
-                    const auto bval = ( (Int*)b )->value; \
-                    if ( !_allow_b_zero && bval == 0 ) { \
-                        throw math_error( "Division by zero" ); \
-                    } \
-                    return VALUE( Int,, ( (Int*)a )->value _op bval ); \
-                }
-#define MATH_OP_BEGIN_F( _op, _allow_b_zero ) \
-        MATH_OP_BEGIN( _op, _allow_b_zero ) \
-            case gse::Value::T_FLOAT: { \
-                const auto bval = ( (Float*)b )->value; \
-                if ( !_allow_b_zero && bval == 0.0f ) { \
-                    throw math_error( "Division by zero" ); \
-                } \
-                return VALUE( Float,, ( (Float*)a )->value _op bval ); \
-            }
-#define MATH_OP_END() \
-                default: \
-                    throw operation_not_supported( a->ToString(), b->ToString() ); \
-            }
-#define MATH_OP( _op, _allow_b_zero ) \
-        MATH_OP_BEGIN_F( _op, _allow_b_zero ) \
-        MATH_OP_END()
-		case OT_ADD: {
-			MATH_OP_BEGIN_F( +, true )
-				case gse::Value::T_STRING:
-					return VALUE( String, , ( (String*)a )->value + ( (String*)b )->value );
-				case gse::Value::T_ARRAY: {
-					array_elements_t elements = ( (value::Array*)a )->value;
-					elements.insert( elements.end(), ( (value::Array*)b )->value.begin(), ( (value::Array*)b )->value.end() );
-					return VALUE( value::Array, , elements );
-				}
-				case gse::Value::T_OBJECT: {
-					object_properties_t properties = ( (value::Object*)a )->value;
-					for ( const auto& it : ( (value::Object*)b )->value ) {
-						if ( properties.find( it.first ) != properties.end() ) {
-							throw gse::Exception( EC.OPERATION_FAILED, "Can't concatenate objects - duplicate key found: " + it.first, ctx, expression->op->m_si, ep );
-						}
-						properties.insert_or_assign( it.first, it.second );
-					}
-					auto si = expression->m_si;
-					return VALUEEXT( value::Object, GSE_CALL, properties );
-				}
-			MATH_OP_END()
-		}
-		case OT_SUB: {
-			MATH_OP( -, true )
-		}
-		case OT_MULT: {
-			MATH_OP( *, true )
-		}
-		case OT_DIV: {
-			MATH_OP( /, false )
-		}
+		case OT_ADD:
+		case OT_SUB:
+		case OT_MULT:
+		case OT_DIV:
 		case OT_MOD: {
-			MATH_OP_BEGIN( %, false )
-			MATH_OP_END()
+			const auto a = Deref( ctx, expression->a->m_si, ep, EvaluateOperand( ctx, ep, expression->a ) );
+			const auto b = Deref( ctx, expression->b->m_si, ep, EvaluateOperand( ctx, ep, expression->b ) );
+			return EvaluateMath( ctx, ep, expression, a, b );
 		}
-#undef MATH_OP
-#undef MATH_OP_BEGIN
-#undef MATH_OP_BEGIN_F
-#undef MATH_OP_END
 #define MATH_OP( _op ) \
         if ( expression->a ) { \
             ASSERT( !expression->b, "only one operand required, found two" ); \
-            const auto varname = EvaluateVarName( ctx, ep, expression->a ); \
-            gse::Value* value = ctx->GetVariable( varname, expression->a->m_si, ep ); \
+            const auto* var = EvaluateVariable( ctx, ep, expression->a ); \
+            ASSERT( var->hints == VH_NONE, "unexpected variable hints" ); \
+            gse::Value* value = ctx->GetVariable( var, expression->a->m_si, ep ); \
             if ( value->type != gse::Value::T_INT ) {                         \
                 throw gse::Exception( EC.TYPE_ERROR, "Expected int, found: " + expression->a->ToString(), ctx, expression->a->m_si, ep ); \
             } \
-            ctx->UpdateVariable( varname, VALUE( Int,, ( (Int*)value )->value _op 1 ), expression->a->m_si, ep ); \
+            ctx->UpdateVariable( var, VALUE_SHARED( Int,, ( (Int*)value )->value _op 1 ), expression->a->m_si, ep ); \
             return value; \
         } \
         else if ( expression->b ) { \
-            const auto varname = EvaluateVarName( ctx, ep, expression->b ); \
-            const gse::Value* value = ctx->GetVariable( varname, expression->b->m_si, ep ); \
+            const auto* var = EvaluateVariable( ctx, ep, expression->b ); \
+            ASSERT( var->hints == VH_NONE, "unexpected variable hints" ); \
+            const gse::Value* value = ctx->GetVariable( var, expression->b->m_si, ep ); \
             if ( value->type != gse::Value::T_INT ) { \
                 throw gse::Exception( EC.TYPE_ERROR, "Expected int, found: " + expression->b->ToString(), ctx, expression->b->m_si, ep ); \
             } \
-            const auto result = VALUE( Int,, ( (Int*)value )->value _op 1 ); \
-            ctx->UpdateVariable( varname, result, expression->b->m_si, ep ); \
+            const auto result = VALUE_SHARED( Int,, ( (Int*)value )->value _op 1 ); \
+            ctx->UpdateVariable( var, result, expression->b->m_si, ep ); \
             return result; \
         } \
         else { \
@@ -605,269 +558,78 @@ gse::Value* const Interpreter::EvaluateExpression( context::Context* ctx, Execut
 			MATH_OP( - )
 		}
 #undef MATH_OP
-#define MATH_OP_BEGIN( _op ) \
-        const auto varname = EvaluateVarName( ctx, ep, expression->a ); \
-        const auto av = Deref( ctx, expression->a->m_si, ep, ctx->GetVariable( varname, expression->a->m_si, ep ) ); \
-        const auto bv = Deref( ctx, expression->b->m_si, ep, EvaluateOperand( ctx, ep, expression->b ) ); \
-        const auto* a = av; \
-        const auto* b = bv; \
-        if ( a->type != b->type ) {                                 \
-            throw operation_not_supported( a->ToString(), b->ToString() ); \
-        } \
-        gse::Value* result = nullptr; \
-        switch ( a->type ) { \
-            case gse::Value::T_INT: { \
-                result = VALUE( Int,, ( (Int*)a )->value _op ( (Int*)b )->value ); \
-                break; \
-            }
-#define MATH_OP_BEGIN_F( _op ) \
-        MATH_OP_BEGIN( _op ) \
-            case gse::Value::T_FLOAT: { \
-                result = VALUE( Float,, ( (Float*)a )->value _op ( (Float*)b )->value ); \
-                break; \
-            }
-#define MATH_OP_END() \
-            default:  \
-                throw operation_not_supported( a->ToString(), b->ToString() ); \
-        } \
-        ctx->UpdateVariable( varname, result, expression->a->m_si, ep ); \
-        return result;
-#define MATH_OP( _op ) \
-        MATH_OP_BEGIN_F( _op ) \
-        MATH_OP_END()
-		case OT_INC_BY: {
-			MATH_OP_BEGIN_F( + )
-				case gse::Value::T_STRING: {
-					result = VALUE( String, , ( (String*)a )->value + ( (String*)b )->value );
-					break;
-				}
-				case gse::Value::T_ARRAY: {
-					array_elements_t elements = ( (value::Array*)a )->value;
-					elements.insert( elements.end(), ( (value::Array*)b )->value.begin(), ( (value::Array*)b )->value.end() );
-					result = VALUE( value::Array, , elements );
-					break;
-				}
-				case gse::Value::T_OBJECT: {
-					object_properties_t properties = ( (value::Object*)a )->value;
-					for ( const auto& it : ( (value::Object*)b )->value ) {
-						if ( properties.find( it.first ) != properties.end() ) {
-							throw gse::Exception( EC.OPERATION_FAILED, "Can't append object - duplicate key found: " + it.first, ctx, expression->op->m_si, ep );
-						}
-						properties.insert_or_assign( it.first, it.second );
-					}
-					auto si = expression->m_si;
-					return VALUEEXT( value::Object, GSE_CALL, properties );
-				}
-			MATH_OP_END()
-		}
-		case OT_DEC_BY: {
-			MATH_OP( - )
-		}
-		case OT_MULT_BY: {
-			MATH_OP( * )
-		}
-		case OT_DIV_BY: {
-			MATH_OP( / )
-		}
+		case OT_INC_BY:
+		case OT_DEC_BY:
+		case OT_MULT_BY:
+		case OT_DIV_BY:
 		case OT_MOD_BY: {
-			MATH_OP_BEGIN( % )
-			MATH_OP_END()
+			const auto* var = EvaluateVariable( ctx, ep, expression->a );
+			ASSERT( var->hints == VH_NONE, "unexpected variable hints" );
+			const auto a = Deref( ctx, expression->a->m_si, ep, ctx->GetVariable( var, expression->a->m_si, ep ) );
+			const auto b = Deref( ctx, expression->b->m_si, ep, EvaluateOperand( ctx, ep, expression->b ) );
+			bool need_update;
+			const auto result = EvaluateMathBy( ctx, ep, expression, a, b, &need_update );
+			if ( need_update ) {
+				ctx->UpdateVariable( var, result, expression->a->m_si, ep );
+			}
+			return result;
 		}
-#undef MATH_OP
-#undef MATH_OP_BEGIN
-#undef MATH_OP_BEGIN_F
-#undef MATH_OP_END
 		case OT_CHILD: {
 			ASSERT( expression->a, "parent object expected" );
-			const auto childname = EvaluateVarName( ctx, ep, expression->b );
-			const auto& not_an_object = [ &ctx, expression, &ep, &childname ]( const std::string& what, const si_t& si ) -> gse::Exception {
-				return gse::Exception( EC.INVALID_DEREFERENCE, "Could not get ." + childname + " of non-object: " + what, ctx, expression->op->m_si, ep );
-			};
+			const auto* child = EvaluateVariable( ctx, ep, expression->b );
+			ASSERT( child->hints == VH_NONE, "unexpected variable hints" );
+			gse::Value* parent = nullptr;
 			switch ( expression->a->type ) {
 				case Operand::OT_VARIABLE: {
-					const auto objv = ctx->GetVariable( ( (Variable*)expression->a )->name, expression->a->m_si, ep );
-					const auto* obj = objv;
-					if ( obj->type == gse::Value::T_VALUEREF ) {
-						obj = ( (ValueRef*)obj )->target;
-					}
-					if ( obj->type != gse::Value::T_OBJECT ) {
-						throw not_an_object( obj->ToString(), expression->a->m_si );
-					}
-					return ( (value::Object*)obj )->GetRef( childname );
+					parent = ctx->GetVariable( (Variable*)expression->a, expression->a->m_si, ep );
+					break;
 				}
 				case Operand::OT_OBJECT:
 				case Operand::OT_CALL: {
-					const auto objv = EvaluateOperand( ctx, ep, expression->a );
-					const auto* obj = objv;
-					ASSERT( obj->type == gse::Value::T_OBJECT, "parent is not object: " + obj->Dump() );
-					return ( (value::Object*)obj )->Get( childname );
+					parent = EvaluateOperand( ctx, ep, expression->a );
+					break;
 				}
 				case Operand::OT_EXPRESSION: {
-					const auto objv = Deref( ctx, expression->a->m_si, ep, EvaluateExpression( ctx, ep, (Expression*)expression->a ) );
-					const auto* obj = objv;
-					if ( obj->type != gse::Value::T_OBJECT ) {
-						throw not_an_object( obj->ToString(), expression->a->m_si );
-					}
-					return ( (value::Object*)obj )->GetRef( childname );
+					parent = EvaluateExpression( ctx, ep, (Expression*)expression->a );
+					break;
 				}
 				default: {
-					throw not_an_object( expression->a->ToString(), expression->a->m_si );
 				}
 			}
+			return EvaluateChild( ctx, ep, expression, child, parent );
 		}
 		case OT_AT: {
 			ASSERT( expression->a, "parent array expected" );
-			std::optional< size_t > index, from, to;
-			std::optional< std::string > key;
 			const auto val = EvaluateRange( ctx, ep, expression->b );
-			switch ( val->type ) {
-				case gse::Value::T_INT: {
-					index = ( (Int*)val )->value;
-					from = std::nullopt;
-					to = std::nullopt;
-					key = std::nullopt;
-					break;
-				}
-				case gse::Value::T_RANGE: {
-					const auto* range = (Range*)val;
-					index = std::nullopt;
-					from = range->from;
-					to = range->to;
-					key = std::nullopt;
-					break;
-				}
-				case gse::Value::T_STRING: {
-					index = std::nullopt;
-					from = std::nullopt;
-					to = std::nullopt;
-					key = ( (String*)val )->value;
-					break;
-				}
-				default:
-					THROW( "unexpected index type: " + val->ToString() );
-			}
-			const auto& check_indexable = [ &ctx, &ep, &index, &key, &from, &to ]( const gse::Value* const value, const si_t& si, const gse::Value::type_t expected_type ) {
-				if ( value->type != expected_type ) {
-					throw gse::Exception(
-						EC.INVALID_DEREFERENCE, "Could not get " +
-							( index.has_value()
-								? "index " + std::to_string( index.value() )
-								: key.has_value()
-									? "index " + key.value()
-									: "range [ " + std::to_string( from.value() ) + " : " + std::to_string( to.value() )
-							) +
-							" of non-indexable: " + value->ToString(), ctx, si, ep
-					);
-				}
-			};
-			const auto& process_indexable = [ this, &ctx, &ep, &index, &key, &from, &to, &check_indexable, &expression ]( const gse::Value* value ) {
-				if ( index.has_value() ) {
-					check_indexable( value, expression->a->m_si, gse::Value::T_ARRAY );
-					return ( (value::Array*)value )->GetRef( index.value() );
-				}
-				if ( key.has_value() ) {
-					check_indexable( value, expression->a->m_si, gse::Value::T_OBJECT );
-					return ( (value::Object*)value )->GetRef( key.value() );
-				}
-				else {
-					check_indexable( value, expression->a->m_si, gse::Value::T_ARRAY );
-					ValidateRange( ctx, expression->b->m_si, ep, (value::Array*)value, from, to );
-					return ( (value::Array*)value )->GetRangeRef( from, to );
-				}
-			};
+			gse::Value* target = nullptr;
 			switch ( expression->a->type ) {
 				case Operand::OT_VARIABLE: {
-					return process_indexable( ctx->GetVariable( ( (Variable*)expression->a )->name, expression->a->m_si, ep ) );
-				}
-				case Operand::OT_ARRAY: {
-					return process_indexable( EvaluateOperand( ctx, ep, expression->a ) );
-					/*const auto arr = EvaluateOperand( ctx, ep, expression->a );
-					check_indexable( arr, expression->a->m_si, gse::Value::T_ARRAY );
-					if ( index.has_value() ) {
-						return ( (value::Array*)arr )->Get( index.value() );
-					}
-					else {
-						ValidateRange( ctx, expression->b->m_si, ep, (value::Array*)arr, from, to );
-						return ( (value::Array*)arr )->GetSubArray( from, to );
-					}*/
+					target = ctx->GetVariable( (Variable*)expression->a, expression->a->m_si, ep );
+					break;
 				}
+				case Operand::OT_ARRAY:
 				case Operand::OT_OBJECT: {
-					return process_indexable( EvaluateOperand( ctx, ep, expression->a ) );
-					/*const auto obj = EvaluateOperand( ctx, ep, expression->a );
-					check_indexable( obj, expression->a->m_si, gse::Value::T_OBJECT );
-					if ( key.has_value() ) {
-						return ( (value::Object*)obj )->Get( key.value() );
-					}
-					else {
-						throw gse::Exception( EC.INVALID_DEREFERENCE, "Expected object key", ctx, expression->a->m_si, ep );
-					}*/
+					target = EvaluateOperand( ctx, ep, expression->a );
+					break;
 				}
 				case Operand::OT_EXPRESSION: {
-					const auto refv = EvaluateExpression( ctx, ep, (Expression*)expression->a );
-					const auto* ref = refv;
-					switch ( ref->type ) {
-						case gse::Value::T_STRING: {
-							const auto& v = ( (value::String*)ref )->value;
-							const auto f = from.has_value()
-								? from.value()
-								: 0;
-							if ( to.has_value() ) {
-								return VALUE( String, , v.substr( f, to.value() - f ) );
-							}
-							else {
-								return VALUE( String, , v.substr( f ) );
-							}
-						}
-						case gse::Value::T_ARRAY: {
-							return process_indexable( ref );
-							/*if ( index.has_value() ) {
-								return ( (value::Array*)ref )->Get( index.value() );
-							}
-							else {
-								return ( (value::Array*)ref )->GetRangeRef( from, to );
-							}*/
-						}
-						case gse::Value::T_OBJECT: {
-							return process_indexable( ref );
-							/*if ( key.has_value() ) {
-								return ( (value::Object*)ref )->Get( key.value() );
-							}
-							else {
-								throw gse::Exception( EC.INVALID_DEREFERENCE, "Expected object key", ctx, expression->a->m_si, ep );
-							}*/
-						}
-						case gse::Value::T_ARRAYREF: {
-							const auto* r = (ArrayRef*)ref;
-							return process_indexable( r->array->Get( r->index ) );
-						}
-						case gse::Value::T_ARRAYRANGEREF: {
-							THROW( "TODO: T_ARRAYRANGEREF" );
-						}
-						case gse::Value::T_LOOPCONTROL: {
-							THROW( "TODO: T_LOOPCONTROL" );
-						}
-						case gse::Value::T_OBJECTREF: {
-							return process_indexable( Deref( ctx, expression->a->m_si, ep, refv ) );
-						}
-						case gse::Value::T_VALUEREF: {
-							THROW( "TODO: T_VALUEREF" );
-						}
-						default:
-							check_indexable( ref, expression->a->m_si, gse::Value::T_ARRAY );
-					}
+					target = EvaluateExpression( ctx, ep, (Expression*)expression->a );
+					break;
 				}
 				case Operand::OT_VALUE: {
-					return process_indexable( ( (program::Value*)expression->a )->value );
+					target = ( (program::Value*)expression->a )->value;
+					break;
+				}
+				default: {
 				}
-				default:
-					THROW( "unsupported indexable type" );
 			}
+			return EvaluateAt( ctx, ep, expression, target, val );
 		}
 		case OT_PUSH: {
 			const gse::Value* arr = nullptr;
 			switch ( expression->a->type ) {
 				case Operand::OT_VARIABLE: {
-					arr = ctx->GetVariable( ( (Variable*)expression->a )->name, expression->a->m_si, ep );
+					arr = ctx->GetVariable( (Variable*)expression->a, expression->a->m_si, ep );
 					break;
 				}
 				case Operand::OT_EXPRESSION: {
@@ -878,18 +640,16 @@ gse::Value* const Interpreter::EvaluateExpression( context::Context* ctx, Execut
 					throw operation_not_supported_not_array( expression->a->ToString() );
 				}
 			}
-			if ( arr->type != gse::Value::T_ARRAY ) {
-				throw operation_not_supported_not_array( expression->a->ToString() );
-			}
+			auto* const target = ExpectArray( ctx, ep, expression, arr );
 			gse::Value* value = EvaluateOperand( ctx, ep, expression->b );
-			( (value::Array*)arr )->Append( value );
+			target->Append( value );
 			return value;
 		}
 		case OT_POP: {
 			const gse::Value* arr = nullptr;
 			switch ( expression->a->type ) {
 				case Operand::OT_VARIABLE: {
-					arr = ctx->GetVariable( ( (Variable*)expression->a )->name, expression->a->m_si, ep );
+					arr = ctx->GetVariable( (Variable*)expression->a, expression->a->m_si, ep );
 					break;
 				}
 				case Operand::OT_EXPRESSION: {
@@ -911,12 +671,12 @@ gse::Value* const Interpreter::EvaluateExpression( context::Context* ctx, Execut
 			}
 			return value
 				? value
-				: VALUE( value::Undefined );
+				: VALUE_SHARED( value::Undefined );
 		}
 		case OT_ERASE: {
 			switch ( expression->a->type ) {
 				case Operand::OT_VARIABLE: {
-					const auto arr = ctx->GetVariable( ( (Variable*)expression->a )->name, expression->a->m_si, ep );
+					const auto arr = ctx->GetVariable( (Variable*)expression->a, expression->a->m_si, ep );
 					if ( arr->type != gse::Value::T_ARRAY ) {
 						throw operation_not_supported_not_array( expression->a->ToString() );
 					}
@@ -936,7 +696,7 @@ gse::Value* const Interpreter::EvaluateExpression( context::Context* ctx, Execut
 					}
 					return value
 						? value
-						: VALUE( value::Undefined );
+						: VALUE_SHARED( value::Undefined );
 				}
 				default:
 					throw operation_not_supported_not_array( expression->a->ToString() );
@@ -979,7 +739,7 @@ gse::Value* const Interpreter::EvaluateOperand( context::Context* ctx, Execution
 			return ( (program::Value*)operand )->value;
 		}
 		case Operand::OT_VARIABLE: {
-			return ctx->GetVariable( ( (Variable*)operand )->name, operand->m_si, ep );
+			return ctx->GetVariable( (Variable*)operand, operand->m_si, ep );
 		}
 		case Operand::OT_ARRAY: {
 			auto* arr = (program::Array*)operand;
@@ -1014,12 +774,12 @@ gse::Value* const Interpreter::EvaluateOperand( context::Context* ctx, Execution
 		}
 		case Operand::OT_FUNCTION: {
 			const auto* func = (program::Function*)operand;
-			std::vector< std::string > parameters = {};
+#if defined( DEBUG ) || defined( FASTDEBUG )
 			for ( const auto& it : func->parameters ) {
 				ASSERT( it->hints == VH_NONE, "function parameters can't have modifiers" );
-				parameters.push_back( it->name );
 			}
-			return VALUE( Function, , this, ctx, parameters, new Program( func->body, false ) );
+#endif
+			return VALUE( Function, , this, ctx, func );
 		}
 		case Operand::OT_CALL: {
 			const auto* call = (Call*)operand;
@@ -1046,6 +806,360 @@ gse::Value* const Interpreter::EvaluateOperand( context::Context* ctx, Execution
 	}
 }
 
+gse::Value* const Interpreter::EvaluateMath( context::Context* ctx, ExecutionPointer& ep, const Expression* expression, const gse::Value* const a, const gse::Value* const b ) {
+	auto* gc_space = m_gc_space;
+	const auto& operation_not_supported = [ expression, &ctx, &ep ]( const std::string& a, const std::string& b ) -> gse::Exception {
+		return gse::Exception( EC.OPERATION_NOT_SUPPORTED, "Operation " + expression->op->ToString() + " is not supported between " + a + " and " + b, ctx, expression->op->m_si, ep );
+	};
+	const auto& math_error = [ expression, &ctx, &ep ]( const std::string& reason ) -> gse::Exception {
+		return gse::Exception( EC.MATH_ERROR, reason, ctx, expression->op->m_si, ep );
+	};
+	switch ( expression->op->op ) {
+#define MATH_OP_BEGIN( _op, _allow_b_zero ) \
+            if ( a->type != b->type ) { \
+                throw operation_not_supported( a->ToString(), b->ToString() ); \
+            } \
+            switch ( a->type ) { \
+                case gse::Value::T_INT: { \
+                    const auto bval = ( (Int*)b )->value; \
+                    if ( !_allow_b_zero && bval == 0 ) { \
+                        throw math_error( "Division by zero" ); \
+                    } \
+                    return VALUE_SHARED( Int,, ( (Int*)a )->value _op bval ); \
+                }
+#define MATH_OP_BEGIN_F( _op, _allow_b_zero ) \
+        MATH_OP_BEGIN( _op, _allow_b_zero ) \
+            case gse::Value::T_FLOAT: { \
+                const auto bval = ( (Float*)b )->value; \
+                if ( !_allow_b_zero && bval == 0.0f ) { \
+                    throw math_error( "Division by zero" ); \
+                } \
+                return VALUE( Float,, ( (Float*)a )->value _op bval ); \
+            }
+#define MATH_OP_END() \
+                default: \
+                    throw operation_not_supported( a->ToString(), b->ToString() ); \
+            }
+#define MATH_OP( _op, _allow_b_zero ) \
+        MATH_OP_BEGIN_F( _op, _allow_b_zero ) \
+        MATH_OP_END()
+		case OT_ADD: {
+			MATH_OP_BEGIN_F( +, true )
+				case gse::Value::T_STRING:
+					return VALUE( String, , ( (String*)a )->value + ( (String*)b )->value );
+				case gse::Value::T_ARRAY: {
+					array_elements_t elements = ( (value::Array*)a )->value;
+					elements.insert( elements.end(), ( (value::Array*)b )->value.begin(), ( (value::Array*)b )->value.end() );
+					return VALUE( value::Array, , elements );
+				}
+				case gse::Value::T_OBJECT: {
+					object_properties_t properties = ( (value::Object*)a )->value;
+					for ( const auto& it : ( (value::Object*)b )->value ) {
+						if ( properties.find( it.first ) != properties.end() ) {
+							throw gse::Exception( EC.OPERATION_FAILED, "Can't concatenate objects - duplicate key found: " + it.first, ctx, expression->op->m_si, ep );
+						}
+						properties.insert_or_assign( it.first, it.second );
+					}
+					auto si = expression->m_si;
+					return VALUEEXT( value::Object, GSE_CALL, properties );
+				}
+			MATH_OP_END()
+		}
+		case OT_SUB: {
+			MATH_OP( -, true )
+		}
+		case OT_MULT: {
+			MATH_OP( *, true )
+		}
+		case OT_DIV: {
+			MATH_OP( /, false )
+		}
+		case OT_MOD: {
+			MATH_OP_BEGIN( %, false )
+			MATH_OP_END()
+		}
+#undef MATH_OP
+#undef MATH_OP_BEGIN
+#undef MATH_OP_BEGIN_F
+#undef MATH_OP_END
+		default:
+			THROW( "operator " + expression->op->Dump() + " is not math operator" );
+	}
+}
+
+gse::Value* const Interpreter::EvaluateMathBy( context::Context* ctx, ExecutionPointer& ep, const Expression* expression, const gse::Value* const a, const gse::Value* const b, bool* need_update ) {
+	auto* gc_space = m_gc_space;
+	const auto& operation_not_supported = [ expression, &ctx, &ep ]( const std::string& a, const std::string& b ) -> gse::Exception {
+		return gse::Exception( EC.OPERATION_NOT_SUPPORTED, "Operation " + expression->op->ToString() + " is not supported between " + a + " and " + b, ctx, expression->op->m_si, ep );
+	};
+	*need_update = true;
+	switch ( expression->op->op ) {
+#define MATH_OP_BEGIN( _op ) \
+        if ( a->type != b->type ) {                                 \
+            throw operation_not_supported( a->ToString(), b->ToString() ); \
+        } \
+        gse::Value* result = nullptr; \
+        switch ( a->type ) { \
+            case gse::Value::T_INT: { \
+                result = VALUE_SHARED( Int,, ( (Int*)a )->value _op ( (Int*)b )->value ); \
+                break; \
+            }
+#define MATH_OP_BEGIN_F( _op ) \
+        MATH_OP_BEGIN( _op ) \
+            case gse::Value::T_FLOAT: { \
+                result = VALUE( Float,, ( (Float*)a )->value _op ( (Float*)b )->value ); \
+                break; \
+            }
+#define MATH_OP_END() \
+            default:  \
+                throw operation_not_supported( a->ToString(), b->ToString() ); \
+        } \
+        return result;
+#define MATH_OP( _op ) \
+        MATH_OP_BEGIN_F( _op ) \
+        MATH_OP_END()
+		case OT_INC_BY: {
+			MATH_OP_BEGIN_F( + )
+				case gse::Value::T_STRING: {
+					result = VALUE( String, , ( (String*)a )->value + ( (String*)b )->value );
+					break;
+				}
+				case gse::Value::T_ARRAY: {
+					array_elements_t elements = ( (value::Array*)a )->value;
+					elements.insert( elements.end(), ( (value::Array*)b )->value.begin(), ( (value::Array*)b )->value.end() );
+					result = VALUE( value::Array, , elements );
+					break;
+				}
+				case gse::Value::T_OBJECT: {
+					object_properties_t properties = ( (value::Object*)a )->value;
+					for ( const auto& it : ( (value::Object*)b )->value ) {
+						if ( properties.find( it.first ) != properties.end() ) {
+							throw gse::Exception( EC.OPERATION_FAILED, "Can't append object - duplicate key found: " + it.first, ctx, expression->op->m_si, ep );
+						}
+						properties.insert_or_assign( it.first, it.second );
+					}
+					auto si = expression->m_si;
+					*need_update = false;
+					return VALUEEXT( value::Object, GSE_CALL, properties );
+				}
+			MATH_OP_END()
+		}
+		case OT_DEC_BY: {
+			MATH_OP( - )
+		}
+		case OT_MULT_BY: {
+			MATH_OP( * )
+		}
+		case OT_DIV_BY: {
+			MATH_OP( / )
+		}
+		case OT_MOD_BY: {
+			MATH_OP_BEGIN( % )
+			MATH_OP_END()
+		}
+#undef MATH_OP
+#undef MATH_OP_BEGIN
+#undef MATH_OP_BEGIN_F
+#undef MATH_OP_END
+		default:
+			THROW( "operator " + expression->op->Dump() + " is not math assignment operator" );
+	}
+}
+
+gse::Value* const Interpreter::EvaluateChild( context::Context* ctx, ExecutionPointer& ep, const Expression* expression, const Variable* child, gse::Value* const parent ) {
+	ASSERT( expression->a, "parent object expected" );
+	const auto& not_an_object = [ &ctx, expression, &ep, child ]( const std::string& what, const si_t& si ) -> gse::Exception {
+		return gse::Exception( EC.INVALID_DEREFERENCE, "Could not get ." + child->name + " of non-object: " + what, ctx, expression->op->m_si, ep );
+	};
+	auto& property = child->property;
+	if ( !property.atom ) {
+		property.atom = value::Shape::Intern( child->name );
+	}
+	switch ( expression->a->type ) {
+		case Operand::OT_VARIABLE: {
+			const auto* obj = parent;
+			if ( obj->type == gse::Value::T_VALUEREF ) {
+				obj = ( (ValueRef*)obj )->target;
+			}
+			if ( obj->type != gse::Value::T_OBJECT ) {
+				throw not_an_object( obj->ToString(), expression->a->m_si );
+			}
+			return ( (value::Object*)obj )->GetRef( property.atom );
+		}
+		case Operand::OT_OBJECT:
+		case Operand::OT_CALL: {
+			const auto* obj = parent;
+			ASSERT( obj->type == gse::Value::T_OBJECT, "parent is not object: " + obj->Dump() );
+			return ( (value::Object*)obj )->Get( child->name, property );
+		}
+		case Operand::OT_EXPRESSION: {
+			const auto* obj = Deref( ctx, expression->a->m_si, ep, parent );
+			if ( obj->type != gse::Value::T_OBJECT ) {
+				throw not_an_object( obj->ToString(), expression->a->m_si );
+			}
+			return ( (value::Object*)obj )->GetRef( property.atom );
+		}
+		default: {
+			throw not_an_object( expression->a->ToString(), expression->a->m_si );
+		}
+	}
+}
+
+gse::Value* const Interpreter::EvaluateAt( context::Context* ctx, ExecutionPointer& ep, const Expression* expression, gse::Value* const target, gse::Value* const val ) {
+	auto* gc_space = m_gc_space;
+	ASSERT( expression->a, "parent array expected" );
+	std::optional< size_t > index, from, to;
+	std::optional< std::string > key;
+	switch ( val->type ) {
+		case gse::Value::T_INT: {
+			index = ( (Int*)val )->value;
+			from = std::nullopt;
+			to = std::nullopt;
+			key = std::nullopt;
+			break;
+		}
+		case gse::Value::T_RANGE: {
+			const auto* range = (Range*)val;
+			index = std::nullopt;
+			from = range->from;
+			to = range->to;
+			key = std::nullopt;
+			break;
+		}
+		case gse::Value::T_STRING: {
+			index = std::nullopt;
+			from = std::nullopt;
+			to = std::nullopt;
+			key = ( (String*)val )->value;
+			break;
+		}
+		default:
+			THROW( "unexpected index type: " + val->ToString() );
+	}
+	const auto& check_indexable = [ &ctx, &ep, &index, &key, &from, &to ]( const gse::Value* const value, const si_t& si, const gse::Value::type_t expected_type ) {
+		if ( value->type != expected_type ) {
+			throw gse::Exception(
+				EC.INVALID_DEREFERENCE, "Could not get " +
+					( index.has_value()
+						? "index " + std::to_string( index.value() )
+						: key.has_value()
+							? "index " + key.value()
+							: "range [ " + std::to_string( from.value() ) + " : " + std::to_string( to.value() )
+					) +
+					" of non-indexable: " + value->ToString(), ctx, si, ep
+			);
+		}
+	};
+	const auto& process_indexable = [ this, &ctx, &ep, &index, &key, &from, &to, &check_indexable, &expression ]( const gse::Value* value ) {
+		if ( index.has_value() ) {
+			check_indexable( value, expression->a->m_si, gse::Value::T_ARRAY );
+			return ( (value::Array*)value )->GetRef( index.value() );
+		}
+		if ( key.has_value() ) {
+			check_indexable( value, expression->a->m_si, gse::Value::T_OBJECT );
+			return ( (value::Object*)value )->GetRef( key.value() );
+		}
+		else {
+			check_indexable( value, expression->a->m_si, gse::Value::T_ARRAY );
+			ValidateRange( ctx, expression->b->m_si, ep, (value::Array*)value, from, to );
+			return ( (value::Array*)value )->GetRangeRef( from, to );
+		}
+	};
+	switch ( expression->a->type ) {
+		case Operand::OT_VARIABLE: {
+			return process_indexable( target );
+		}
+		case Operand::OT_ARRAY: {
+			return process_indexable( target );
+			/*const auto arr = EvaluateOperand( ctx, ep, expression->a );
+			check_indexable( arr, expression->a->m_si, gse::Value::T_ARRAY );
+			if ( index.has_value() ) {
+				return ( (value::Array*)arr )->Get( index.value() );
+			}
+			else {
+				ValidateRange( ctx, expression->b->m_si, ep, (value::Array*)arr, from, to );
+				return ( (value::Array*)arr )->GetSubArray( from, to );
+			}*/
+		}
+		case Operand::OT_OBJECT: {
+			return process_indexable( target );
+			/*const auto obj = EvaluateOperand( ctx, ep, expression->a );
+			check_indexable( obj, expression->a->m_si, gse::Value::T_OBJECT );
+			if ( key.has_value() ) {
+				return ( (value::Object*)obj )->Get( key.value() );
+			}
+			else {
+				throw gse::Exception( EC.INVALID_DEREFERENCE, "Expected object key", ctx, expression->a->m_si, ep );
+			}*/
+		}
+		case Operand::OT_EXPRESSION: {
+			const auto* ref = target;
+			switch ( ref->type ) {
+				case gse::Value::T_STRING: {
+					const auto& v = ( (value::String*)ref )->value;
+					const auto f = from.has_value()
+						? from.value()
+						: 0;
+					if ( to.has_value() ) {
+						return VALUE( String, , v.substr( f, to.value() - f ) );
+					}
+					else {
+						return VALUE( String, , v.substr( f ) );
+					}
+				}
+				case gse::Value::T_ARRAY: {
+					return process_indexable( ref );
+					/*if ( index.has_value() ) {
+						return ( (value::Array*)ref )->Get( index.value() );
+					}
+					else {
+						return ( (value::Array*)ref )->GetRangeRef( from, to );
+					}*/
+				}
+				case gse::Value::T_OBJECT: {
+					return process_indexable( ref );
+					/*if ( key.has_value() ) {
+						return ( (value::Object*)ref )->Get( key.value() );
+					}
+					else {
+						throw gse::Exception( EC.INVALID_DEREFERENCE, "Expected object key", ctx, expression->a->m_si, ep );
+					}*/
+				}
+				case gse::Value::T_ARRAYREF: {
+					const auto* r = (ArrayRef*)ref;
+					return process_indexable( r->array->Get( r->index ) );
+				}
+				case gse::Value::T_ARRAYRANGEREF: {
+					THROW( "TODO: T_ARRAYRANGEREF" );
+				}
+				case gse::Value::T_LOOPCONTROL: {
+					THROW( "TODO: T_LOOPCONTROL" );
+				}
+				case gse::Value::T_OBJECTREF: {
+					return process_indexable( Deref( ctx, expression->a->m_si, ep, target ) );
+				}
+				case gse::Value::T_VALUEREF: {
+					THROW( "TODO: T_VALUEREF" );
+				}
+				default:
+					check_indexable( ref, expression->a->m_si, gse::Value::T_ARRAY );
+			}
+		}
+		case Operand::OT_VALUE: {
+			return process_indexable( target );
+		}
+		default:
+			THROW( "unsupported indexable type" );
+	}
+}
+
+value::Array* const Interpreter::ExpectArray( context::Context* ctx, ExecutionPointer& ep, const Expression* expression, const gse::Value* const value ) {
+	if ( value->type != gse::Value::T_ARRAY ) {
+		throw gse::Exception( EC.OPERATION_NOT_SUPPORTED, "Operation " + expression->op->ToString() + " is not supported: " + expression->a->ToString() + " is not array", ctx, expression->op->m_si, ep );
+	}
+	return (value::Array*)value;
+}
+
 const std::string Interpreter::EvaluateString( context::Context* ctx, ExecutionPointer& ep, const Operand* operand ) {
 	const auto result = Deref( ctx, operand->m_si, ep, EvaluateOperand( ctx, ep, operand ) );
 	if ( result->type != gse::Value::T_STRING ) {
@@ -1056,31 +1170,16 @@ const std::string Interpreter::EvaluateString( context::Context* ctx, ExecutionP
 
 gse::Value* const Interpreter::EvaluateRange( context::Context* ctx, ExecutionPointer& ep, const Operand* operand, const bool only_index ) {
 	CHECKACCUM( m_gc_space );
-	auto* gc_space = m_gc_space;
 	ASSERT( operand, "index operand missing" );
-	const auto& get_index = [ &ctx, &ep, &operand, this, &only_index, &gc_space ]( gse::Value* const value ) -> gse::Value* {
-		switch ( value->type ) {
-			case gse::Value::T_INT:
-			case gse::Value::T_STRING:
-				return value;
-			case gse::Value::T_RANGE: {
-				ASSERT( !only_index, "range not allowed here" );
-				const auto* range = (Range*)value;
-				return VALUE( Range, , range->from, range->to );
-			}
-			default:
-				throw gse::Exception( EC.INVALID_DEREFERENCE, "Invalid index - expected int or string, got: " + value->ToString(), ctx, operand->m_si, ep );
-		}
-	};
 	switch ( operand->type ) {
 		case Operand::OT_VALUE: {
-			return get_index( ( (program::Value*)operand )->value );
+			return GetIndex( ctx, ep, operand, ( (program::Value*)operand )->value, only_index );
 		}
 		case Operand::OT_VARIABLE: {
-			return get_index( ctx->GetVariable( ( (Variable*)operand )->name, operand->m_si, ep ) );
+			return GetIndex( ctx, ep, operand, ctx->GetVariable( (Variable*)operand, operand->m_si, ep ), only_index );
 		}
 		case Operand::OT_EXPRESSION: {
-			return get_index( Deref( ctx, operand->m_si, ep, EvaluateExpression( ctx, ep, (Expression*)operand ) ) );
+			return GetIndex( ctx, ep, operand, Deref( ctx, operand->m_si, ep, EvaluateExpression( ctx, ep, (Expression*)operand ) ), only_index );
 		}
 		default: {
 			THROW( "unexpected index type: " + operand->ToString() );
@@ -1088,6 +1187,22 @@ gse::Value* const Interpreter::EvaluateRange( context::Context* ctx, ExecutionPo
 	}
 }
 
+gse::Value* const Interpreter::GetIndex( context::Context* ctx, ExecutionPointer& ep, const Operand* operand, gse::Value* const value, const bool only_index ) {
+	auto* gc_space = m_gc_space;
+	switch ( value->type ) {
+		case gse::Value::T_INT:
+		case gse::Value::T_STRING:
+			return value;
+		case gse::Value::T_RANGE: {
+			ASSERT( !only_index, "range not allowed here" );
+			const auto* range = (Range*)value;
+			return VALUE( Range, , range->from, range->to );
+		}
+		default:
+			throw gse::Exception( EC.INVALID_DEREFERENCE, "Invalid index - expected int or string, got: " + value->ToString(), ctx, operand->m_si, ep );
+	}
+}
+
 const bool Interpreter::EvaluateBool( context::Context* ctx, ExecutionPointer& ep, const Operand* operand ) {
 	const auto result = Deref( ctx, operand->m_si, ep, EvaluateOperand( ctx, ep, operand ) );
 	if ( result->type != gse::Value::T_BOOL ) {
@@ -1124,7 +1239,9 @@ gse::Value* const Interpreter::Deref( context::Context* ctx, const si_t& si, Exe
 			}
 			case gse::Value::T_OBJECTREF: {
 				const auto* ref = (ObjectRef*)value;
-				return ref->object->Get( ref->key );
+				return ref->atom
+					? ref->object->Get( ref->atom )
+					: ref->object->Get( ref->key );
 			}
 			case gse::Value::T_VALUEREF: {
 				return ( (ValueRef*)value )->target;
@@ -1141,7 +1258,12 @@ void Interpreter::WriteByRef( context::Context* ctx, const si_t& si, ExecutionPo
 	switch ( ref->type ) {
 		case gse::Value::T_OBJECTREF: {
 			const auto* r = (ObjectRef*)ref;
-			r->object->Set( r->key, value, GSE_CALL );
+			if ( r->atom ) {
+				r->object->Set( r->atom, value, GSE_CALL );
+			}
+			else {
+				r->object->Set( r->key, value, GSE_CALL );
+			}
 			break;
 		}
 		case gse::Value::T_ARRAYREF: {
@@ -1216,21 +1338,15 @@ Interpreter::Function::Function(
 	gc::Space* const gc_space,
 	Interpreter* runner,
 	context::Context* context,
-	const std::vector< std::string >& parameters,
-	const Program* const program
+	const program::Function* const function
 )
 	: value::Callable( gc_space, context )
 	, runner( runner )
 	, context( context )
-	, parameters( parameters )
-	, program( program ) {
+	, function( function ) {
 }
 
-Interpreter::Function::~Function() {
-	delete program;
-}
-
-void Interpreter::Function::GetReachableObjects( std::unordered_set< gc::Object* >& reachable_objects ) {
+void Interpreter::Function::GetReachableObjects( gc::MarkStack& reachable_objects ) {
 	value::Callable::GetReachableObjects( reachable_objects );
 
 	GC_DEBUG_BEGIN( "Function" );
@@ -1246,26 +1362,15 @@ void Interpreter::Function::GetReachableObjects( std::unordered_set< gc::Object*
 gse::Value* Interpreter::Function::Run( GSE_CALLABLE, const function_arguments_t& arguments ) {
 	CHECKACCUM( gc_space );
 	gse::Value* result = nullptr;
-	context->ForkAndExecute(
-		GSE_CALL, true, [ this, &arguments, &si, &ep, &result, &gc_space ]( context::ChildContext* const subctx ) {
-			for ( size_t i = 0 ; i < parameters.size() ; i++ ) { // inject passed arguments
-				subctx->CreateVariable(
-					parameters[ i ], i < arguments.size()
-						? arguments.at( i )
-						: VALUE( value::Undefined ),
-					si, ep
-				);
-			}
-			ep.WithSI(
-				si, [ this, &result, &subctx, &ep ]() {
-					result = runner->Execute( subctx, ep, program );
-				}
-			);
+	ep.WithSI(
+		si, [ this, &result, &si, &ep, &arguments ]() {
+			std::lock_guard guard( runner->m_execute_mutex );
+			result = runner->CallFunction( context, si, ep, function, arguments );
 		}
 	);
 	return result
 		? result
-		: VALUE( Undefined ); // functions return undefined by default
+		: VALUE_SHARED( Undefined ); // functions return undefined by default
 }
 
 }
@@ -19,6 +19,7 @@ class Conditional;
 class Expression;
 class Operand;
 class Variable;
+class Function;
 }
 
 namespace value {
@@ -38,36 +39,45 @@ private:
 	// TODO: make it multithreaded
 	std::recursive_mutex m_execute_mutex;
 
+protected:
+
 	class Function : public value::Callable {
 	public:
 		Function(
 			gc::Space* const gc_space,
 			Interpreter* runner,
 			context::Context* context,
-			const std::vector< std::string >& parameters,
-			const program::Program* const program
+			const program::Function* const function
 		);
-		~Function();
-		void GetReachableObjects( std::unordered_set< gc::Object* >& reachable_objects ) override;
+		void GetReachableObjects( gc::MarkStack& reachable_objects ) override;
 		Value* Run( GSE_CALLABLE, const value::function_arguments_t& arguments ) override;
 	private:
 		Interpreter* runner;
 		context::Context* context;
-		const std::vector< std::string > parameters;
-		const program::Program* const program;
+		const program::Function* const function; // owned by program that declared it
 	};
 
-	Value* const EvaluateScope( context::Context* ctx, ExecutionPointer& ep, const program::Scope* scope, bool* returnflag = nullptr );
+	// ctx is context of closure
+	virtual Value* const CallFunction( context::Context* ctx, const si_t& si, ExecutionPointer& ep, const program::Function* function, const value::function_arguments_t& arguments );
+	virtual Value* const EvaluateScope( context::Context* ctx, ExecutionPointer& ep, const program::Scope* scope, bool* returnflag = nullptr );
 	Value* const EvaluateStatement( context::Context* ctx, ExecutionPointer& ep, const program::Statement* statement, bool* returnflag = nullptr );
 	Value* const EvaluateConditional( context::Context* ctx, ExecutionPointer& ep, const program::Conditional* conditional, bool is_nested, bool* returnflag = nullptr );
 	Value* const EvaluateExpression( context::Context* ctx, ExecutionPointer& ep, const program::Expression* expression, bool* returnflag = nullptr );
 	Value* const EvaluateOperand( context::Context* ctx, ExecutionPointer& ep, const program::Operand* operand );
 	const std::string EvaluateString( context::Context* ctx, ExecutionPointer& ep, const program::Operand* operand );
 	Value* const EvaluateRange( context::Context* ctx, ExecutionPointer& ep, const program::Operand* operand, const bool only_index = false );
+	Value* const GetIndex( context::Context* ctx, ExecutionPointer& ep, const program::Operand* operand, Value* const value, const bool only_index = false );
 	const bool EvaluateBool( context::Context* ctx, ExecutionPointer& ep, const program::Operand* operand );
 	const program::Variable* EvaluateVariable( context::Context* ctx, ExecutionPointer& ep, const program::Operand* operand );
 	const std::string EvaluateVarName( context::Context* ctx, ExecutionPointer& ep, const program::Operand* operand );
 
+	// operators applied to already evaluated operands
+	Value* const EvaluateMath( context::Context* ctx, ExecutionPointer& ep, const program::Expression* expression, const Value* const a, const Value* const b );
+	Value* const EvaluateMathBy( context::Context* ctx, ExecutionPointer& ep, const program::Expression* expression, const Value* const a, const Value* const b, bool* need_update );
+	Value* const EvaluateChild( context::Context* ctx, ExecutionPointer& ep, const program::Expression* expression, const program::Variable* child, Value* const parent );
+	Value* const EvaluateAt( context::Context* ctx, ExecutionPointer& ep, const program::Expression* expression, Value* const target, Value* const val );
+	value::Array* const ExpectArray( context::Context* ctx, ExecutionPointer& ep, const program::Expression* expression, const Value* const value );
+
 	Value* const Deref( context::Context* ctx, const si_t& si, ExecutionPointer& ep, Value* const value );
 	void WriteByRef( context::Context* ctx, const si_t& si, ExecutionPointer& ep, Value* const ref, Value* const value );
 	void ValidateRange( context::Context* ctx, const si_t& si, ExecutionPointer& ep, const value::Array* array, const std::optional< size_t > from, const std::optional< size_t > to );
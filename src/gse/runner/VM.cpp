@@ -0,0 +1,595 @@
+#include "VM.h"
+
+#include <vector>
+
+#include "vm/Chunk.h"
+#include "vm/Compiler.h"
+
+#include "gse/Exception.h"
+#include "gse/context/Context.h"
+#include "gse/context/ChildContext.h"
+#include "gse/program/Program.h"
+#include "gse/program/Scope.h"
+#include "gse/program/Expression.h"
+#include "gse/program/Operand.h"
+#include "gse/program/Variable.h"
+#include "gse/program/Function.h"
+#include "gse/program/Call.h"
+#include "gse/program/Statement.h"
+#include "gse/program/Conditional.h"
+#include "gse/value/Bool.h"
+#include "gse/value/Int.h"
+#include "gse/value/Array.h"
+#include "gse/value/Object.h"
+#include "gse/value/Callable.h"
+#include "gse/value/LoopControl.h"
+#include "gse/value/Undefined.h"
+
+#include "gc/Space.h"
+
+namespace gse {
+
+using namespace program;
+using namespace value;
+
+namespace runner {
+
+using namespace vm;
+
+VM::VM( gc::Space* const gc_space )
+	: Interpreter( gc_space ) {}
+
+gse::Value* const VM::CallFunction( context::Context* ctx, const si_t& si, ExecutionPointer& ep, const program::Function* function, const function_arguments_t& arguments ) {
+	const auto* chunk = GetChunk( function );
+	if ( chunk->code.empty() ) {
+		// needs own context
+		return Interpreter::CallFunction( ctx, si, ep, function, arguments );
+	}
+	return Run( ctx, ep, chunk, nullptr, &arguments );
+}
+
+gse::Value* const VM::EvaluateScope( context::Context* ctx, ExecutionPointer& ep, const Scope* scope, bool* returnflag ) {
+	return Run( ctx, ep, GetChunk( scope ), returnflag );
+}
+
+// compiled once per scope or function, on first execution
+template< typename ELEMENT_T >
+static const Chunk* GetOrCompile( const ELEMENT_T* element ) {
+	const auto* chunk = element->chunk.load( std::memory_order_acquire );
+	if ( !chunk ) {
+		const Chunk* compiled = Compiler().Compile( element );
+		if ( element->chunk.compare_exchange_strong( chunk, compiled, std::memory_order_acq_rel ) ) {
+			chunk = compiled;
+		}
+		else {
+			// other thread was faster
+			delete compiled;
+		}
+	}
+	return chunk;
+}
+
+const Chunk* VM::GetChunk( const Scope* scope ) {
+	return GetOrCompile( scope );
+}
+
+const Chunk* VM::GetChunk( const program::Function* function ) {
+	return GetOrCompile( function );
+}
+
+gse::Value* const VM::GetLocal( context::Context* ctx, ExecutionPointer& ep, const local_t& local, const Variable* variable ) {
+	return local.value
+		? local.value
+		: ctx->GetVariable( variable->name, variable->m_si, ep );
+}
+
+void VM::CreateLocal( context::Context* ctx, ExecutionPointer& ep, local_t& local, const Variable* variable, gse::Value* const value, const bool is_const ) {
+	ASSERT( value, "value is null" );
+	if ( local.value ) {
+		throw gse::Exception( EC.INVALID_ASSIGNMENT, "Variable '" + variable->name + "' already exists", ctx, variable->m_si, ep );
+	}
+	local.value = value;
+	local.is_const = is_const;
+}
+
+void VM::UpdateLocal( context::Context* ctx, ExecutionPointer& ep, local_t& local, const Variable* variable, gse::Value* const value ) {
+	ASSERT( value, "value is null" );
+	if ( !local.value ) {
+		ctx->UpdateVariable( variable->name, value, variable->m_si, ep );
+	}
+	else if ( local.is_const ) {
+		throw gse::Exception( EC.INVALID_ASSIGNMENT, "Can't change value of const '" + variable->name + "'", ctx, variable->m_si, ep );
+	}
+	else {
+		local.value = value;
+	}
+}
+
+const bool VM::ToBool( context::Context* ctx, ExecutionPointer& ep, const Operand* operand, gse::Value* const value ) {
+	const auto* result = value && value->type == gse::Value::T_BOOL
+		? value
+		: Deref( ctx, operand->m_si, ep, value );
+	if ( result->type != gse::Value::T_BOOL ) {
+		throw gse::Exception( EC.TYPE_ERROR, "Expected bool, found: " + operand->ToString(), ctx, operand->m_si, ep );
+	}
+	return ( (Bool*)result )->value;
+}
+
+gse::Value* const VM::Run( context::Context* ctx, ExecutionPointer& ep, const Chunk* chunk, bool* returnflag, const function_arguments_t* arguments ) {
+	CHECKACCUM( m_gc_space );
+	auto* gc_space = m_gc_space;
+
+	// most chunks are small enough to keep everything on stack
+	static constexpr size_t INLINE_REGISTERS = 16;
+	static constexpr size_t INLINE_FLAGS = 8;
+	static constexpr size_t INLINE_LOCALS = 8;
+	gse::Value* inline_registers[INLINE_REGISTERS];
+	bool inline_flags[INLINE_FLAGS] = {};
+	local_t inline_locals[INLINE_LOCALS]; // every local is cleared or set before use
+	std::vector< gse::Value* > heap_registers = {};
+	std::vector< char > heap_flags = {};
+	std::vector< local_t > heap_locals = {};
+	gse::Value** const regs = chunk->registers_count <= INLINE_REGISTERS
+		? inline_registers
+		: ( heap_registers.resize( chunk->registers_count ), heap_registers.data() );
+	bool* const flags = chunk->flags_count <= INLINE_FLAGS
+		? inline_flags
+		: ( heap_flags.resize( chunk->flags_count, 0 ), (bool*)heap_flags.data() );
+	local_t* const locals = chunk->locals_count <= INLINE_LOCALS
+		? inline_locals
+		: ( heap_locals.resize( chunk->locals_count ), heap_locals.data() );
+	regs[ 0 ] = nullptr;
+
+	const auto* const code = chunk->code.data();
+	const auto* const locations = chunk->locations.data();
+	const instruction_t* ip = code;
+
+#define R( _reg ) regs[ ip->_reg ]
+#define P( _type ) ( (const _type*)ip->p )
+#define FLAGPTR( _flag ) ( ip->_flag == Chunk::NO_FLAG \
+    ? nullptr \
+    : &flags[ ip->_flag ] )
+
+#if defined( __GNUC__ )
+	// threaded dispatch, every handler jumps directly to next one
+#define GSE_VM_LABEL( _name ) &&L_##_name,
+	static const void* const s_labels[] = {
+		GSE_VM_OPCODES( GSE_VM_LABEL )
+	};
+#undef GSE_VM_LABEL
+#define OPCODE( _name ) L_##_name:
+#define DISPATCH() goto *s_labels[ ip->op ]
+	DISPATCH();
+#else
+#define OPCODE( _name ) case OP_##_name:
+#define DISPATCH() continue
+	for ( ;; ) {
+		switch ( ip->op ) {
+#endif
+#define NEXT() { \
+    ip++; \
+    DISPATCH(); \
+}
+#define JUMP( _target ) { \
+    ip = code + ( _target ); \
+    DISPATCH(); \
+}
+
+	OPCODE( END ) {
+		if ( returnflag && flags[ 0 ] ) {
+			*returnflag = true;
+		}
+		return regs[ 0 ];
+	}
+
+	OPCODE( JMP ) {
+		JUMP( ip->c );
+	}
+
+	OPCODE( JMP_IF_FLAG ) {
+		if ( flags[ ip->b ] ) {
+			JUMP( ip->c );
+		}
+		NEXT();
+	}
+
+	OPCODE( JMP_IF_FALSE ) {
+		if ( !ToBool( ctx, ep, P( Operand ), R( a ) ) ) {
+			JUMP( ip->c );
+		}
+		NEXT();
+	}
+
+	OPCODE( JMP_IF_TRUE ) {
+		if ( ToBool( ctx, ep, P( Operand ), R( a ) ) ) {
+			JUMP( ip->c );
+		}
+		NEXT();
+	}
+
+	OPCODE( FLAG_SET ) {
+		flags[ ip->b ] = true;
+		NEXT();
+	}
+
+	OPCODE( FLAG_CLEAR ) {
+		flags[ ip->b ] = false;
+		NEXT();
+	}
+
+	OPCODE( ENTER ) {
+		const auto* scope = P( Scope );
+		NEWV( subctx, context::ChildContext, ctx->GetGSE(), ctx, scope->m_si, false, &scope->frame );
+		if ( ip->a ) {
+			subctx->AddHiddenSlots( &scope->frame, ip->a );
+		}
+		ctx = subctx;
+		NEXT();
+	}
+
+	OPCODE( CLEAR_SLOTS ) {
+		ctx->ResetSlots( ip->a, ip->c );
+		NEXT();
+	}
+
+	OPCODE( CLEAR_LOCALS ) {
+		for ( size_t i = ip->a ; i < ip->a + ip->c ; i++ ) {
+			locals[ i ] = {
+				nullptr,
+				false
+			};
+		}
+		NEXT();
+	}
+
+	OPCODE( ARGUMENTS ) {
+		ASSERT( arguments, "arguments not passed" );
+		for ( size_t i = 0 ; i < ip->c ; i++ ) {
+			locals[ i ] = {
+				i < arguments->size()
+					? arguments->at( i )
+					: VALUE_SHARED( value::Undefined ),
+				false
+			};
+		}
+		NEXT();
+	}
+
+	OPCODE( LEAVE ) {
+#if defined( DEBUG ) || defined( FASTDEBUG )
+		if ( m_are_scope_context_joins_enabled ) {
+			( (context::ChildContext*)ctx )->JoinContext();
+		}
+#endif
+		ctx = ctx->GetParentContext();
+		NEXT();
+	}
+
+	OPCODE( LOAD_NULL ) {
+		R( a ) = nullptr;
+		NEXT();
+	}
+
+	OPCODE( LOAD_CONST ) {
+		R( a ) = (gse::Value*)ip->p;
+		NEXT();
+	}
+
+	OPCODE( LOAD_BOOL ) {
+		R( a ) = VALUE_SHARED( Bool, , ip->b );
+		NEXT();
+	}
+
+	OPCODE( MOVE ) {
+		R( a ) = R( b );
+		NEXT();
+	}
+
+	OPCODE( DEREF ) {
+		R( a ) = Deref( ctx, P( Operand )->m_si, ep, R( a ) );
+		NEXT();
+	}
+
+	OPCODE( NULL_UNLESS_FLAG ) {
+		if ( !flags[ ip->b ] ) {
+			R( a ) = nullptr;
+		}
+		NEXT();
+	}
+
+	OPCODE( GET_VAR ) {
+		const auto* var = P( Variable );
+		R( a ) = ctx->GetVariable( var, locations[ ip->c ], var->m_si, ep );
+		NEXT();
+	}
+
+	OPCODE( CREATE_VAR ) {
+		const auto* var = P( Variable );
+		ctx->CreateVariable( var, locations[ ip->c ], R( a ), var->m_si, ep );
+		NEXT();
+	}
+
+	OPCODE( CREATE_CONST ) {
+		const auto* var = P( Variable );
+		ctx->CreateConst( var, locations[ ip->c ], R( a ), var->m_si, ep );
+		NEXT();
+	}
+
+	OPCODE( UPDATE_VAR ) {
+		const auto* var = P( Variable );
+		ctx->UpdateVariable( var, locations[ ip->c ], R( a ), var->m_si, ep );
+		NEXT();
+	}
+
+#define INCDEC( _op, _is_post ) { \
+    const auto* var = P( Variable ); \
+    const auto& location = locations[ ip->c ]; \
+    gse::Value* value = ctx->GetVariable( var, location, var->m_si, ep ); \
+    if ( value->type != gse::Value::T_INT ) { \
+        throw gse::Exception( EC.TYPE_ERROR, "Expected int, found: " + var->ToString(), ctx, var->m_si, ep ); \
+    } \
+    auto* const result = VALUE_SHARED( Int, , ( (Int*)value )->value _op 1 ); \
+    ctx->UpdateVariable( var, location, result, var->m_si, ep ); \
+    R( a ) = _is_post \
+        ? value \
+        : result; \
+    NEXT(); \
+}
+	OPCODE( INC_PRE ) INCDEC( +, false )
+	OPCODE( INC_POST ) INCDEC( +, true )
+	OPCODE( DEC_PRE ) INCDEC( -, false )
+	OPCODE( DEC_POST ) INCDEC( -, true )
+#undef INCDEC
+
+	OPCODE( GET_LOCAL ) {
+		R( a ) = GetLocal( ctx, ep, locals[ ip->c ], P( Variable ) );
+		NEXT();
+	}
+
+	OPCODE( CREATE_LOCAL ) {
+		CreateLocal( ctx, ep, locals[ ip->c ], P( Variable ), R( a ), false );
+		NEXT();
+	}
+
+	OPCODE( CREATE_LOCAL_CONST ) {
+		CreateLocal( ctx, ep, locals[ ip->c ], P( Variable ), R( a ), true );
+		NEXT();
+	}
+
+	OPCODE( UPDATE_LOCAL ) {
+		UpdateLocal( ctx, ep, locals[ ip->c ], P( Variable ), R( a ) );
+		NEXT();
+	}
+
+#define INCDEC( _op, _is_post ) { \
+    const auto* var = P( Variable ); \
+    auto& local = locals[ ip->c ]; \
+    gse::Value* value = GetLocal( ctx, ep, local, var ); \
+    if ( value->type != gse::Value::T_INT ) { \
+        throw gse::Exception( EC.TYPE_ERROR, "Expected int, found: " + var->ToString(), ctx, var->m_si, ep ); \
+    } \
+    auto* const result = VALUE_SHARED( Int, , ( (Int*)value )->value _op 1 ); \
+    UpdateLocal( ctx, ep, local, var, result ); \
+    R( a ) = _is_post \
+        ? value \
+        : result; \
+    NEXT(); \
+}
+	OPCODE( INC_PRE_LOCAL ) INCDEC( +, false )
+	OPCODE( INC_POST_LOCAL ) INCDEC( +, true )
+	OPCODE( DEC_PRE_LOCAL ) INCDEC( -, false )
+	OPCODE( DEC_POST_LOCAL ) INCDEC( -, true )
+#undef INCDEC
+
+#define MATH( _op ) { \
+    const auto* a = R( b ); \
+    const auto* b = R( c ); \
+    if ( a->type == gse::Value::T_INT && b->type == gse::Value::T_INT ) { \
+        R( a ) = VALUE_SHARED( Int, , ( (Int*)a )->value _op ( (Int*)b )->value ); \
+    } \
+    else { \
+        R( a ) = EvaluateMath( ctx, ep, P( Expression ), a, b ); \
+    } \
+    NEXT(); \
+}
+	OPCODE( ADD ) MATH( + )
+	OPCODE( SUB ) MATH( - )
+	OPCODE( MULT ) MATH( * )
+#undef MATH
+
+	OPCODE( MATH ) {
+		R( a ) = EvaluateMath( ctx, ep, P( Expression ), R( b ), R( c ) );
+		NEXT();
+	}
+
+	OPCODE( MATH_BY ) {
+		bool need_update;
+		R( a ) = EvaluateMathBy( ctx, ep, P( Expression ), R( b ), R( c ), &need_update );
+		if ( !need_update ) {
+			// skip update
+			ip++;
+		}
+		NEXT();
+	}
+
+#define CMP( _op ) { \
+    const auto* a = R( b ); \
+    const auto* b = R( c ); \
+    R( a ) = VALUE_SHARED( Bool, , a->type == gse::Value::T_INT && b->type == gse::Value::T_INT \
+        ? ( (Int*)a )->value _op ( (Int*)b )->value \
+        : *a _op *b \
+    ); \
+    NEXT(); \
+}
+	OPCODE( EQ ) CMP( == )
+	OPCODE( NE ) CMP( != )
+	OPCODE( LT ) CMP( < )
+	OPCODE( LTE ) CMP( <= )
+	OPCODE( GT ) CMP( > )
+	OPCODE( GTE ) CMP( >= )
+#undef CMP
+
+	OPCODE( NOT ) {
+		R( a ) = VALUE_SHARED( Bool, , !ToBool( ctx, ep, P( Operand ), R( b ) ) );
+		NEXT();
+	}
+
+	OPCODE( NEW_ARRAY ) {
+		R( a ) = VALUE( value::Array, , array_elements_t( regs + ip->b, regs + ip->b + ip->c ) );
+		NEXT();
+	}
+
+	OPCODE( NEW_FUNCTION ) {
+		const auto* func = P( program::Function );
+		R( a ) = VALUE( Function, , this, ctx, func );
+		NEXT();
+	}
+
+	OPCODE( NEW_LOOP_CONTROL ) {
+		R( a ) = VALUE( value::LoopControl, , (loop_control_type_t)ip->b );
+		NEXT();
+	}
+
+	OPCODE( CALLABLE ) {
+		const auto* call = P( Call );
+		auto* const callable = Deref( ctx, call->m_si, ep, R( a ) );
+		ASSERT( callable, "callable is null" );
+		if ( callable->type != gse::Value::T_CALLABLE ) {
+			throw gse::Exception( EC.INVALID_CALL, "Callable expected, found: " + callable->ToString(), ctx, call->m_si, ep );
+		}
+		R( a ) = callable;
+		NEXT();
+	}
+
+	OPCODE( CALL ) {
+		const auto* call = P( Call );
+		const function_arguments_t arguments( regs + ip->b + 1, regs + ip->b + 1 + ip->c );
+		R( a ) = ( (Callable*)R( b ) )->Run( gc_space, ctx, call->m_si, ep, arguments );
+		NEXT();
+	}
+
+	OPCODE( CHILD ) {
+		const auto* expression = P( Expression );
+		R( a ) = EvaluateChild( ctx, ep, expression, (Variable*)expression->b, R( b ) );
+		NEXT();
+	}
+
+	OPCODE( CHILD_VALUE ) {
+		const auto* expression = P( Expression );
+		const auto* child = (Variable*)expression->b;
+		auto* parent = R( b );
+		if ( parent->type == gse::Value::T_OBJECT ) {
+			R( a ) = ( (value::Object*)parent )->Get( child->name, child->property );
+		}
+		else {
+			R( a ) = Deref( ctx, expression->m_si, ep, EvaluateChild( ctx, ep, expression, child, parent ) );
+		}
+		NEXT();
+	}
+
+	OPCODE( INDEX ) {
+		R( a ) = GetIndex( ctx, ep, P( Operand ), R( a ) );
+		NEXT();
+	}
+
+	OPCODE( AT ) {
+		R( a ) = EvaluateAt( ctx, ep, P( Expression ), R( b ), R( c ) );
+		NEXT();
+	}
+
+	OPCODE( AT_VALUE ) {
+		const auto* target = R( b );
+		const auto* index = R( c );
+		if ( target->type == gse::Value::T_ARRAY && index->type == gse::Value::T_INT ) {
+			R( a ) = ( (value::Array*)target )->Get( ( (Int*)index )->value );
+		}
+		else {
+			const auto* expression = P( Expression );
+			R( a ) = Deref( ctx, expression->m_si, ep, EvaluateAt( ctx, ep, expression, R( b ), R( c ) ) );
+		}
+		NEXT();
+	}
+
+	OPCODE( EXPECT_ARRAY ) {
+		ExpectArray( ctx, ep, P( Expression ), R( a ) );
+		NEXT();
+	}
+
+	OPCODE( APPEND ) {
+		( (value::Array*)R( a ) )->Append( R( b ) );
+		NEXT();
+	}
+
+	OPCODE( WRITE_REF ) {
+		WriteByRef( ctx, P( Expression )->a->m_si, ep, R( a ), R( b ) );
+		NEXT();
+	}
+
+	OPCODE( LOOP_CHECK ) {
+		bool need_break;
+		bool need_clear;
+		CheckBreakCondition( R( a ), &need_break, &need_clear );
+		if ( need_clear ) {
+			R( a ) = nullptr;
+		}
+		if ( need_break || ( ip->b != Chunk::NO_FLAG && flags[ ip->b ] ) ) {
+			JUMP( ip->c );
+		}
+		NEXT();
+	}
+
+	OPCODE( FOR_CHECK ) {
+		bool need_break;
+		bool need_clear;
+		CheckBreakCondition( R( a ), &need_break, &need_clear );
+		if ( need_break || ( ip->b != Chunk::NO_FLAG && flags[ ip->b ] ) ) {
+			if ( need_clear ) {
+				R( a ) = nullptr;
+			}
+			JUMP( ip->c );
+		}
+		NEXT();
+	}
+
+	OPCODE( FOR_END ) {
+		if ( R( a ) && R( a )->type == gse::Value::T_LOOPCONTROL ) {
+			// we don't want to break out from parent scope
+			if ( ip->b != Chunk::NO_FLAG ) {
+				flags[ ip->b ] = false;
+			}
+			R( a ) = nullptr;
+		}
+		NEXT();
+	}
+
+	OPCODE( FALLBACK_EXPRESSION ) {
+		R( a ) = EvaluateExpression( ctx, ep, P( Expression ), FLAGPTR( b ) );
+		NEXT();
+	}
+
+	OPCODE( FALLBACK_OPERAND ) {
+		R( a ) = EvaluateOperand( ctx, ep, P( Operand ) );
+		NEXT();
+	}
+
+	OPCODE( FALLBACK_CONDITIONAL ) {
+		R( a ) = EvaluateConditional( ctx, ep, P( Conditional ), false, FLAGPTR( b ) );
+		NEXT();
+	}
+
+#if !defined( __GNUC__ )
+		}
+	}
+#endif
+
+#undef JUMP
+#undef NEXT
+#undef DISPATCH
+#undef OPCODE
+#undef FLAGPTR
+#undef P
+#undef R
+}
+
+}
+}
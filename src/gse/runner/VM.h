@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Interpreter.h"
+
+namespace gse {
+
+namespace runner {
+
+namespace vm {
+class Chunk;
+}
+
+// executes scopes compiled to bytecode, rare constructs are delegated to interpreter
+CLASS( VM, Interpreter )
+
+	VM( gc::Space* const gc_space );
+
+protected:
+
+	Value* const CallFunction( context::Context* ctx, const si_t& si, ExecutionPointer& ep, const program::Function* function, const value::function_arguments_t& arguments ) override;
+	Value* const EvaluateScope( context::Context* ctx, ExecutionPointer& ep, const program::Scope* scope, bool* returnflag = nullptr ) override;
+
+private:
+
+	// variable of frame that has no context at runtime
+	struct local_t {
+		Value* value;
+		bool is_const;
+	};
+
+	const vm::Chunk* GetChunk( const program::Scope* scope );
+	const vm::Chunk* GetChunk( const program::Function* function );
+	Value* const Run( context::Context* ctx, ExecutionPointer& ep, const vm::Chunk* chunk, bool* returnflag, const value::function_arguments_t* arguments = nullptr );
+
+	// undeclared locals are looked up by name, same as variables in context
+	Value* const GetLocal( context::Context* ctx, ExecutionPointer& ep, const local_t& local, const program::Variable* variable );
+	void CreateLocal( context::Context* ctx, ExecutionPointer& ep, local_t& local, const program::Variable* variable, Value* const value, const bool is_const );
+	void UpdateLocal( context::Context* ctx, ExecutionPointer& ep, local_t& local, const program::Variable* variable, Value* const value );
+
+	const bool ToBool( context::Context* ctx, ExecutionPointer& ep, const program::Operand* operand, Value* const value );
+
+};
+
+}
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include "gse/program/Types.h"
+
+namespace gse {
+namespace runner {
+namespace vm {
+
+// all instructions of vm, list is reused for dispatch table
+// a, b, c are registers, flags or counts, c is also jump target, p is program element or constant
+#define GSE_VM_OPCODES( _x ) \
+    _x( END )                  /* finish chunk */ \
+    _x( JMP )                  /* goto c */ \
+    _x( JMP_IF_FLAG )          /* if flag b: goto c */ \
+    _x( JMP_IF_FALSE )         /* if not bool a ( p operand ): goto c */ \
+    _x( JMP_IF_TRUE )          /* if bool a ( p operand ): goto c */ \
+    _x( FLAG_SET )             /* flag b = true */ \
+    _x( FLAG_CLEAR )           /* flag b = false */ \
+    _x( ENTER )                /* fork context for scope p, with a hidden slots for unforked scopes inside */ \
+    _x( CLEAR_SLOTS )          /* undeclare slots [ a ... a + c ) */ \
+    _x( CLEAR_LOCALS )         /* undeclare locals [ a ... a + c ) */ \
+    _x( ARGUMENTS )            /* declare c parameters of function p as first locals */ \
+    _x( LEAVE )                /* return to parent context */ \
+    _x( LOAD_NULL )            /* a = nullptr */ \
+    _x( LOAD_CONST )           /* a = value p */ \
+    _x( LOAD_BOOL )            /* a = bool b */ \
+    _x( MOVE )                 /* a = b */ \
+    _x( DEREF )                /* a = deref a ( p operand ) */ \
+    _x( NULL_UNLESS_FLAG )     /* if not flag b: a = nullptr */ \
+    _x( GET_VAR )              /* a = variable p at location c */ \
+    _x( CREATE_VAR )           /* new variable p at location c = a */ \
+    _x( CREATE_CONST )         /* new const p at location c = a */ \
+    _x( UPDATE_VAR )           /* variable p at location c = a */ \
+    _x( INC_PRE )              /* a = ++variable p at location c */ \
+    _x( INC_POST )             /* a = variable p at location c ++ */ \
+    _x( DEC_PRE )              /* a = --variable p at location c */ \
+    _x( DEC_POST )             /* a = variable p at location c -- */ \
+    _x( GET_LOCAL )            /* a = variable p in local c */ \
+    _x( CREATE_LOCAL )         /* new variable p in local c = a */ \
+    _x( CREATE_LOCAL_CONST )   /* new const p in local c = a */ \
+    _x( UPDATE_LOCAL )         /* variable p in local c = a */ \
+    _x( INC_PRE_LOCAL )        /* a = ++variable p in local c */ \
+    _x( INC_POST_LOCAL )       /* a = variable p in local c ++ */ \
+    _x( DEC_PRE_LOCAL )        /* a = --variable p in local c */ \
+    _x( DEC_POST_LOCAL )       /* a = variable p in local c -- */ \
+    _x( ADD )                  /* a = b + c ( p expression ) */ \
+    _x( SUB )                  /* a = b - c ( p expression ) */ \
+    _x( MULT )                 /* a = b * c ( p expression ) */ \
+    _x( MATH )                 /* a = b <op of expression p> c */ \
+    _x( MATH_BY )              /* a = b <op of expression p> c, skips next instruction ( update ) if value shouldn't be written */ \
+    _x( EQ )                   /* a = b == c */ \
+    _x( NE )                   /* a = b != c */ \
+    _x( LT )                   /* a = b < c */ \
+    _x( LTE )                  /* a = b <= c */ \
+    _x( GT )                   /* a = b > c */ \
+    _x( GTE )                  /* a = b >= c */ \
+    _x( NOT )                  /* a = !bool b ( p operand ) */ \
+    _x( NEW_ARRAY )            /* a = [ b ... b + c ) */ \
+    _x( NEW_FUNCTION )         /* a = function p */ \
+    _x( NEW_LOOP_CONTROL )     /* a = loop control of type b */ \
+    _x( CALLABLE )             /* a = deref a, must be callable ( p call ) */ \
+    _x( CALL )                 /* a = b( b + 1 ... b + 1 + c ) ( p call ) */ \
+    _x( CHILD )                /* a = b.<name> ( p expression ) */ \
+    _x( CHILD_VALUE )          /* a = deref b.<name> ( p expression ), without creating reference */ \
+    _x( INDEX )                /* a = index from a ( p operand ) */ \
+    _x( AT )                   /* a = b[ c ] ( p expression ) */ \
+    _x( AT_VALUE )             /* a = deref b[ c ] ( p expression ), without creating reference */ \
+    _x( EXPECT_ARRAY )         /* a must be array ( p expression ) */ \
+    _x( APPEND )               /* a []= b */ \
+    _x( WRITE_REF )            /* *a = b ( p expression ) */ \
+    _x( LOOP_CHECK )           /* while loop result a, flag b, on break goto c */ \
+    _x( FOR_CHECK )            /* for loop result a, flag b, on break goto c */ \
+    _x( FOR_END )              /* for loop result a, flag b */ \
+    _x( FALLBACK_EXPRESSION )  /* a = interpreted expression p, flag b */ \
+    _x( FALLBACK_OPERAND )     /* a = interpreted operand p */ \
+    _x( FALLBACK_CONDITIONAL ) /* a = interpreted conditional p, flag b */
+
+enum opcode_t : uint8_t {
+#define GSE_VM_OPCODE( _name ) OP_##_name,
+	GSE_VM_OPCODES( GSE_VM_OPCODE )
+#undef GSE_VM_OPCODE
+};
+
+struct instruction_t {
+	opcode_t op;
+	uint32_t a;
+	uint32_t b;
+	uint32_t c;
+	const void* p;
+};
+
+// bytecode of one scope ( or function ), immutable once compiled
+// register 0 holds scope result, flag 0 is set if scope wants to return to its caller
+class Chunk {
+public:
+	static const uint32_t NO_FLAG = (uint32_t)-1;
+
+	std::vector< instruction_t > code = {};
+
+	// locations of variables, adjusted for scopes that vm doesn't fork
+	std::vector< program::variable_location_t > locations = {};
+
+	uint32_t registers_count = 0;
+	uint32_t flags_count = 0;
+	// variables of frames that have no context at runtime, only in chunks of functions
+	uint32_t locals_count = 0;
+};
+
+}
+}
+}
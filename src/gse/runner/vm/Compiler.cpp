@@ -0,0 +1,1010 @@
+#include "Compiler.h"
+
+#include "gse/program/Scope.h"
+#include "gse/program/Frame.h"
+#include "gse/program/Control.h"
+#include "gse/program/Statement.h"
+#include "gse/program/Conditional.h"
+#include "gse/program/If.h"
+#include "gse/program/ElseIf.h"
+#include "gse/program/Else.h"
+#include "gse/program/While.h"
+#include "gse/program/For.h"
+#include "gse/program/ForConditionExpressions.h"
+#include "gse/program/SimpleCondition.h"
+#include "gse/program/Expression.h"
+#include "gse/program/Operator.h"
+#include "gse/program/Operand.h"
+#include "gse/program/Variable.h"
+#include "gse/program/Value.h"
+#include "gse/program/Array.h"
+#include "gse/program/Function.h"
+#include "gse/program/Call.h"
+#include "gse/program/LoopControl.h"
+
+#include "common/Assert.h"
+
+namespace gse {
+
+using namespace program;
+
+namespace runner {
+namespace vm {
+
+Chunk* const Compiler::Compile( const Scope* scope ) {
+	ASSERT( !m_chunk, "compiler already used" );
+	m_chunk = new Chunk();
+	m_next_register = 1; // 0 is result
+	m_next_flag = 1; // 0 is returnflag of caller
+	m_chunk->registers_count = m_next_register;
+	m_chunk->flags_count = m_next_flag;
+	CompileScope( scope, 0, 0 );
+	Emit( OP_END );
+	ASSERT( m_frames.empty(), "frames not popped" );
+	ASSERT( m_hosts.empty(), "hosts not popped" );
+	return m_chunk;
+}
+
+Chunk* const Compiler::Compile( const program::Function* function ) {
+	ASSERT( !m_chunk, "compiler already used" );
+	m_chunk = new Chunk();
+	const auto& parameters_frame = function->parameters_frame;
+	const auto parameters_count = parameters_frame.GetSize();
+	if ( !IsSelfContained( function->body ) || parameters_count != function->parameters.size() ) {
+		return m_chunk;
+	}
+	const auto& info = GetSelfContained( function->body );
+	if ( info.has_shadowing ) {
+		return m_chunk;
+	}
+	for ( size_t i = 0 ; i < parameters_count ; i++ ) {
+		if ( info.names.find( parameters_frame.GetName( i ) ) != info.names.end() ) {
+			return m_chunk;
+		}
+	}
+	m_next_register = 1; // 0 is result
+	m_next_flag = 1; // 0 is returnflag of caller
+	m_chunk->registers_count = m_next_register;
+	m_chunk->flags_count = m_next_flag;
+
+	// parameters are first locals
+	m_hosts.push_back(
+		{
+			nullptr,
+			0,
+			(uint32_t)parameters_count,
+			(uint32_t)parameters_count
+		}
+	);
+	m_hosted_frames.insert(
+		{
+			&parameters_frame,
+			{
+				nullptr,
+				0
+			}
+		}
+	);
+	m_frames.push_back( true );
+	m_elided_frames++;
+	Emit( OP_ARGUMENTS, 0, 0, parameters_count, function );
+	CompileScope( function->body, 0, 0 );
+	Emit( OP_END );
+	m_elided_frames--;
+	m_frames.pop_back();
+	m_chunk->locals_count = m_hosts.back().max;
+	m_hosts.pop_back();
+
+	ASSERT( m_frames.empty(), "frames not popped" );
+	ASSERT( m_hosts.empty(), "hosts not popped" );
+	return m_chunk;
+}
+
+const uint32_t Compiler::AllocRegister() {
+	const auto result = m_next_register++;
+	if ( m_next_register > m_chunk->registers_count ) {
+		m_chunk->registers_count = m_next_register;
+	}
+	return result;
+}
+
+const uint32_t Compiler::AllocFlag() {
+	const auto result = m_next_flag++;
+	if ( m_next_flag > m_chunk->flags_count ) {
+		m_chunk->flags_count = m_next_flag;
+	}
+	return result;
+}
+
+const size_t Compiler::Emit( const opcode_t op, const uint32_t a, const uint32_t b, const uint32_t c, const void* p ) {
+	m_chunk->code.push_back(
+		{
+			op,
+			a,
+			b,
+			c,
+			p
+		}
+	);
+	return m_chunk->code.size() - 1;
+}
+
+void Compiler::PatchJump( const size_t index ) {
+	m_chunk->code[ index ].c = m_chunk->code.size();
+}
+
+void Compiler::Escape( const Operand* operand ) {
+	// interpreter and closures rely on resolver locations, so every scope around them must be forked
+	if ( m_elided_frames ) {
+		THROW( "vm compiler: unexpected " + operand->ToString() + " inside of unforked scope" );
+	}
+}
+
+const uint32_t Compiler::Location( const Variable* variable ) {
+	auto location = variable->location;
+	const auto depth = location.depth;
+	for ( size_t i = 0 ; i < depth && i < m_frames.size() ; i++ ) {
+		if ( m_frames[ m_frames.size() - 1 - i ] ) {
+			// this context won't exist at runtime
+			location.depth--;
+		}
+	}
+	if ( location.frame ) {
+		const auto it = m_hosted_frames.find( location.frame );
+		if ( it != m_hosted_frames.end() ) {
+			// depth already points to host
+			location.frame = it->second.first;
+			location.slot += it->second.second;
+		}
+	}
+	m_chunk->locations.push_back( location );
+	return m_chunk->locations.size() - 1;
+}
+
+void Compiler::EmitVariable( const opcode_t op, const uint32_t reg, const Variable* variable ) {
+	const auto it = variable->location.frame
+		? m_hosted_frames.find( variable->location.frame )
+		: m_hosted_frames.end();
+	if ( it == m_hosted_frames.end() || it->second.first ) {
+		Emit( op, reg, 0, Location( variable ), variable );
+		return;
+	}
+	opcode_t local_op;
+	switch ( op ) {
+		case OP_GET_VAR: {
+			local_op = OP_GET_LOCAL;
+			break;
+		}
+		case OP_CREATE_VAR: {
+			local_op = OP_CREATE_LOCAL;
+			break;
+		}
+		case OP_CREATE_CONST: {
+			local_op = OP_CREATE_LOCAL_CONST;
+			break;
+		}
+		case OP_UPDATE_VAR: {
+			local_op = OP_UPDATE_LOCAL;
+			break;
+		}
+		case OP_INC_PRE: {
+			local_op = OP_INC_PRE_LOCAL;
+			break;
+		}
+		case OP_INC_POST: {
+			local_op = OP_INC_POST_LOCAL;
+			break;
+		}
+		case OP_DEC_PRE: {
+			local_op = OP_DEC_PRE_LOCAL;
+			break;
+		}
+		case OP_DEC_POST: {
+			local_op = OP_DEC_POST_LOCAL;
+			break;
+		}
+		default:
+			THROW( "opcode " + std::to_string( op ) + " has no counterpart for locals" );
+	}
+	Emit( local_op, reg, 0, it->second.second + variable->location.slot, variable );
+}
+
+const bool Compiler::CompileScope( const Scope* scope, const uint32_t flag, const uint32_t dst ) {
+	bool is_elided = false;
+	if ( IsSelfContained( scope ) ) {
+		const auto& info = GetSelfContained( scope );
+		is_elided = m_hosts.empty()
+			// outermost scope must be forked if something inside needs slots
+			? info.names.empty()
+			// undeclared variables are looked up by name, that would skip frame that doesn't exist at runtime
+			: !info.is_shadowing;
+	}
+	ASSERT( is_elided || m_hosts.empty() || m_hosts.back().frame, "can't fork scope inside function without context" );
+	const auto variables_count = scope->frame.GetSize();
+	if ( !is_elided ) {
+		m_hosts.push_back(
+			{
+				&scope->frame,
+				Emit( OP_ENTER, 0, 0, 0, scope ),
+				0,
+				0
+			}
+		);
+	}
+	else if ( variables_count ) {
+		ASSERT( !m_hosts.empty(), "no host for variables" );
+		auto& host = m_hosts.back();
+		const auto first = ( host.frame
+			? host.frame->GetSize()
+			: 0 ) + host.used;
+		m_hosted_frames.insert(
+			{
+				&scope->frame,
+				{
+					host.frame,
+					first
+				}
+			}
+		);
+		host.used += variables_count;
+		if ( host.used > host.max ) {
+			host.max = host.used;
+		}
+		// previous run ( i.e. loop iteration ) may have left them declared
+		Emit(
+			host.frame
+				? OP_CLEAR_SLOTS
+				: OP_CLEAR_LOCALS, first, 0, variables_count
+		);
+	}
+	m_frames.push_back( is_elided );
+	if ( is_elided ) {
+		m_elided_frames++;
+	}
+
+	Emit( OP_LOAD_NULL, dst );
+	const auto f = AllocFlag();
+	std::vector< size_t > returns = {};
+	for ( const auto& it : scope->body ) {
+		bool may_return = false;
+		switch ( it->control_type ) {
+			case Control::CT_STATEMENT: {
+				may_return = CompileStatement( (Statement*)it, f, dst );
+				break;
+			}
+			case Control::CT_CONDITIONAL: {
+				may_return = CompileConditional( (Conditional*)it, false, f, dst );
+				break;
+			}
+			default:
+				THROW( "unexpected control type: " + it->Dump() );
+		}
+		if ( may_return ) {
+			returns.push_back( Emit( OP_JMP_IF_FLAG, 0, f ) );
+		}
+	}
+	if ( !returns.empty() ) {
+		const auto skip = Emit( OP_JMP );
+		for ( const auto& it : returns ) {
+			PatchJump( it );
+		}
+		// flags are always cleared after use so that scopes don't need to reset them
+		Emit( OP_FLAG_CLEAR, 0, f );
+		if ( flag != Chunk::NO_FLAG ) {
+			Emit( OP_FLAG_SET, 0, flag );
+		}
+		PatchJump( skip );
+	}
+	m_next_flag = f;
+
+	if ( is_elided ) {
+		m_elided_frames--;
+		if ( variables_count ) {
+			m_hosts.back().used -= variables_count;
+		}
+	}
+	else {
+		const auto& host = m_hosts.back();
+		m_chunk->code[ host.enter ].a = host.max;
+		m_hosts.pop_back();
+	}
+	m_frames.pop_back();
+	if ( !is_elided ) {
+		Emit( OP_LEAVE );
+	}
+	return !returns.empty() && flag != Chunk::NO_FLAG;
+}
+
+const bool Compiler::CompileStatement( const Statement* statement, const uint32_t flag, const uint32_t dst ) {
+	const auto* expression = statement->body;
+	if ( !CompileExpression( expression, flag, dst ) ) {
+		// statements have no result unless they return
+		Emit( OP_LOAD_NULL, dst );
+		return false;
+	}
+	if ( !IsNative( expression, true ) ) {
+		Emit( OP_NULL_UNLESS_FLAG, dst, flag );
+	}
+	return true;
+}
+
+const bool Compiler::CompileConditional( const Conditional* conditional, const bool is_nested, const uint32_t flag, const uint32_t dst ) {
+	if ( !IsNative( conditional, is_nested ) ) {
+		Escape( nullptr );
+		Emit( OP_FALLBACK_CONDITIONAL, dst, flag, 0, conditional );
+		return flag != Chunk::NO_FLAG;
+	}
+	switch ( conditional->conditional_type ) {
+		case Conditional::CT_IF:
+		case Conditional::CT_ELSEIF: {
+			const SimpleCondition* condition;
+			const Scope* body;
+			const Conditional* els;
+			if ( conditional->conditional_type == Conditional::CT_IF ) {
+				const auto* c = (If*)conditional;
+				condition = c->condition;
+				body = c->body;
+				els = c->els;
+			}
+			else {
+				const auto* c = (ElseIf*)conditional;
+				condition = c->condition;
+				body = c->body;
+				els = c->els;
+			}
+			const auto reg = AllocRegister();
+			CompileExpression( condition->expression, Chunk::NO_FLAG, reg );
+			const auto jump_else = Emit( OP_JMP_IF_FALSE, reg, 0, 0, condition->expression );
+			m_next_register = reg;
+			bool may_return = CompileScope( body, flag, dst );
+			const auto jump_end = Emit( OP_JMP );
+			PatchJump( jump_else );
+			if ( els ) {
+				if ( CompileConditional( els, true, flag, dst ) ) {
+					may_return = true;
+				}
+			}
+			else {
+				Emit( OP_LOAD_NULL, dst );
+			}
+			PatchJump( jump_end );
+			return may_return;
+		}
+		case Conditional::CT_ELSE: {
+			return CompileScope( ( (Else*)conditional )->body, flag, dst );
+		}
+		case Conditional::CT_WHILE: {
+			const auto* c = (While*)conditional;
+			Emit( OP_LOAD_NULL, dst );
+			const auto top = m_chunk->code.size();
+			const auto reg = AllocRegister();
+			CompileExpression( c->condition->expression, Chunk::NO_FLAG, reg );
+			const auto jump_end = Emit( OP_JMP_IF_FALSE, reg, 0, 0, c->condition->expression );
+			m_next_register = reg;
+			CompileScope( c->body, flag, dst );
+			const auto jump_break = Emit( OP_LOOP_CHECK, dst, flag );
+			Emit( OP_JMP, 0, 0, top );
+			PatchJump( jump_end );
+			PatchJump( jump_break );
+			return flag != Chunk::NO_FLAG;
+		}
+		case Conditional::CT_FOR: {
+			const auto* c = (For*)conditional;
+			const auto* condition = (ForConditionExpressions*)c->condition;
+			Emit( OP_LOAD_NULL, dst );
+			const auto reg = AllocRegister();
+			bool may_return = false;
+			if ( condition->init && CompileExpression( condition->init, flag, reg ) ) {
+				may_return = true;
+			}
+			const auto top = m_chunk->code.size();
+			CompileExpression( condition->check, Chunk::NO_FLAG, reg );
+			const auto jump_end = Emit( OP_JMP_IF_FALSE, reg, 0, 0, condition->check );
+			// body can't return from parent scope
+			CompileScope( c->body, Chunk::NO_FLAG, dst );
+			const auto jump_break = Emit( OP_FOR_CHECK, dst, flag );
+			if ( condition->iterate && CompileExpression( condition->iterate, flag, reg ) ) {
+				may_return = true;
+			}
+			Emit( OP_JMP, 0, 0, top );
+			PatchJump( jump_end );
+			PatchJump( jump_break );
+			Emit( OP_FOR_END, dst, flag );
+			m_next_register = reg;
+			return may_return;
+		}
+		default:
+			THROW( "unexpected conditional type: " + conditional->Dump() );
+	}
+}
+
+const bool Compiler::CompileExpression( const Expression* expression, const uint32_t flag, const uint32_t dst ) {
+	if ( !expression->op ) {
+		ASSERT( !expression->b, "expression has second operand but no operator" );
+		ASSERT( expression->a, "expression is empty" );
+		CompileOperand( expression->a, dst );
+		return false;
+	}
+	const auto op = expression->op->op;
+	const bool is_return = op == OT_RETURN || op == OT_BREAK || op == OT_CONTINUE;
+	if ( !IsNative( expression, flag != Chunk::NO_FLAG ) ) {
+		Escape( expression );
+		Emit( OP_FALLBACK_EXPRESSION, dst, flag, 0, expression );
+		return is_return && flag != Chunk::NO_FLAG;
+	}
+	const auto mark = m_next_register;
+	switch ( op ) {
+		case OT_RETURN: {
+			ASSERT( !expression->a, "unexpected left operand before return" );
+			CompileOperand( expression->b, dst );
+			CompileDeref( expression->b, dst );
+			Emit( OP_FLAG_SET, 0, flag );
+			break;
+		}
+		case OT_BREAK:
+		case OT_CONTINUE: {
+			CompileOperand( expression->b, dst );
+			Emit( OP_FLAG_SET, 0, flag );
+			break;
+		}
+		case OT_ASSIGN: {
+			CompileOperand( expression->b, dst );
+			CompileDeref( expression->b, dst );
+			if ( expression->a->type == Operand::OT_VARIABLE ) {
+				const auto* var = (Variable*)expression->a;
+				if ( var->hints & VH_CREATE_VAR ) {
+					EmitVariable( OP_CREATE_VAR, dst, var );
+				}
+				else if ( var->hints & VH_CREATE_CONST ) {
+					EmitVariable( OP_CREATE_CONST, dst, var );
+				}
+				else {
+					EmitVariable( OP_UPDATE_VAR, dst, var );
+				}
+			}
+			else {
+				// property of object or element of array
+				const auto target = AllocRegister();
+				CompileExpression( (Expression*)expression->a, Chunk::NO_FLAG, target );
+				Emit( OP_WRITE_REF, target, dst, 0, expression );
+			}
+			break;
+		}
+		case OT_NOT: {
+			ASSERT( !expression->a, "unary not may not have left operand" );
+			CompileOperand( expression->b, dst );
+			Emit( OP_NOT, dst, dst, 0, expression->b );
+			break;
+		}
+		case OT_EQ:
+		case OT_NE:
+		case OT_LT:
+		case OT_LTE:
+		case OT_GT:
+		case OT_GTE:
+		case OT_ADD:
+		case OT_SUB:
+		case OT_MULT:
+		case OT_DIV:
+		case OT_MOD: {
+			const auto reg = AllocRegister();
+			CompileOperand( expression->a, dst );
+			CompileDeref( expression->a, dst );
+			CompileOperand( expression->b, reg );
+			CompileDeref( expression->b, reg );
+			opcode_t opcode;
+			switch ( op ) {
+				case OT_EQ: {
+					opcode = OP_EQ;
+					break;
+				}
+				case OT_NE: {
+					opcode = OP_NE;
+					break;
+				}
+				case OT_LT: {
+					opcode = OP_LT;
+					break;
+				}
+				case OT_LTE: {
+					opcode = OP_LTE;
+					break;
+				}
+				case OT_GT: {
+					opcode = OP_GT;
+					break;
+				}
+				case OT_GTE: {
+					opcode = OP_GTE;
+					break;
+				}
+				case OT_ADD: {
+					opcode = OP_ADD;
+					break;
+				}
+				case OT_SUB: {
+					opcode = OP_SUB;
+					break;
+				}
+				case OT_MULT: {
+					opcode = OP_MULT;
+					break;
+				}
+				default:
+					opcode = OP_MATH;
+			}
+			Emit( opcode, dst, dst, reg, expression );
+			break;
+		}
+		case OT_AND:
+		case OT_OR: {
+			// short-circuit, same as && and || of interpreter
+			const auto jump = op == OT_AND
+				? OP_JMP_IF_FALSE
+				: OP_JMP_IF_TRUE;
+			CompileOperand( expression->a, dst );
+			const auto jump_a = Emit( jump, dst, 0, 0, expression->a );
+			CompileOperand( expression->b, dst );
+			const auto jump_b = Emit( jump, dst, 0, 0, expression->b );
+			Emit( OP_LOAD_BOOL, dst, op == OT_AND );
+			const auto jump_end = Emit( OP_JMP );
+			PatchJump( jump_a );
+			PatchJump( jump_b );
+			Emit( OP_LOAD_BOOL, dst, op != OT_AND );
+			PatchJump( jump_end );
+			break;
+		}
+		case OT_INC:
+		case OT_DEC: {
+			// postfix if variable is on the left
+			const auto* var = (Variable*)( expression->a
+				? expression->a
+				: expression->b );
+			ASSERT( var->hints == VH_NONE, "unexpected variable hints" );
+			opcode_t opcode;
+			if ( op == OT_INC ) {
+				opcode = expression->a
+					? OP_INC_POST
+					: OP_INC_PRE;
+			}
+			else {
+				opcode = expression->a
+					? OP_DEC_POST
+					: OP_DEC_PRE;
+			}
+			EmitVariable( opcode, dst, var );
+			break;
+		}
+		case OT_INC_BY:
+		case OT_DEC_BY:
+		case OT_MULT_BY:
+		case OT_DIV_BY:
+		case OT_MOD_BY: {
+			const auto* var = (Variable*)expression->a;
+			ASSERT( var->hints == VH_NONE, "unexpected variable hints" );
+			const auto reg = AllocRegister();
+			EmitVariable( OP_GET_VAR, dst, var );
+			Emit( OP_DEREF, dst, 0, 0, var );
+			CompileOperand( expression->b, reg );
+			CompileDeref( expression->b, reg );
+			Emit( OP_MATH_BY, dst, dst, reg, expression );
+			EmitVariable( OP_UPDATE_VAR, dst, var );
+			break;
+		}
+		case OT_CHILD: {
+			ASSERT( expression->a, "parent object expected" );
+			ASSERT( ( (Variable*)expression->b )->hints == VH_NONE, "unexpected variable hints" );
+			if ( expression->a->type == Operand::OT_EXPRESSION ) {
+				// not dereferenced, EvaluateChild will do it
+				CompileExpression( (Expression*)expression->a, Chunk::NO_FLAG, dst );
+			}
+			else {
+				CompileOperand( expression->a, dst );
+			}
+			Emit( OP_CHILD, dst, dst, 0, expression );
+			break;
+		}
+		case OT_AT: {
+			ASSERT( expression->a, "parent array expected" );
+			// index is evaluated first
+			const auto reg = AllocRegister();
+			CompileOperand( expression->b, reg );
+			if ( expression->b->type == Operand::OT_EXPRESSION ) {
+				Emit( OP_DEREF, reg, 0, 0, expression->b );
+			}
+			Emit( OP_INDEX, reg, 0, 0, expression->b );
+			CompileOperand( expression->a, dst );
+			Emit( OP_AT, dst, dst, reg, expression );
+			break;
+		}
+		case OT_PUSH: {
+			const auto reg = AllocRegister();
+			CompileOperand( expression->a, reg );
+			if ( expression->a->type == Operand::OT_EXPRESSION ) {
+				Emit( OP_DEREF, reg, 0, 0, expression->a );
+			}
+			Emit( OP_EXPECT_ARRAY, reg, 0, 0, expression );
+			CompileOperand( expression->b, dst );
+			Emit( OP_APPEND, reg, dst );
+			break;
+		}
+		default:
+			THROW( "operator " + expression->op->Dump() + " can't be compiled" );
+	}
+	m_next_register = mark;
+	return is_return;
+}
+
+void Compiler::CompileOperand( const Operand* operand, const uint32_t dst ) {
+	ASSERT( operand, "operand is null" );
+	switch ( operand->type ) {
+		case Operand::OT_VALUE: {
+			Emit( OP_LOAD_CONST, dst, 0, 0, ( (program::Value*)operand )->value );
+			break;
+		}
+		case Operand::OT_VARIABLE: {
+			const auto* var = (Variable*)operand;
+			EmitVariable( OP_GET_VAR, dst, var );
+			break;
+		}
+		case Operand::OT_ARRAY: {
+			const auto& elements = ( (program::Array*)operand )->elements;
+			const auto mark = m_next_register;
+			for ( size_t i = 0 ; i < elements.size() ; i++ ) {
+				AllocRegister();
+			}
+			for ( size_t i = 0 ; i < elements.size() ; i++ ) {
+				CompileExpression( elements[ i ], Chunk::NO_FLAG, mark + i );
+			}
+			Emit( OP_NEW_ARRAY, dst, mark, elements.size() );
+			m_next_register = mark;
+			break;
+		}
+		case Operand::OT_SCOPE: {
+			CompileScope( (Scope*)operand, Chunk::NO_FLAG, dst );
+			break;
+		}
+		case Operand::OT_EXPRESSION: {
+			CompileExpression( (Expression*)operand, Chunk::NO_FLAG, dst );
+			break;
+		}
+		case Operand::OT_FUNCTION: {
+			// closure keeps current context
+			Escape( operand );
+#if defined( DEBUG ) || defined( FASTDEBUG )
+			for ( const auto& it : ( (program::Function*)operand )->parameters ) {
+				ASSERT( it->hints == VH_NONE, "function parameters can't have modifiers" );
+			}
+#endif
+			Emit( OP_NEW_FUNCTION, dst, 0, 0, operand );
+			break;
+		}
+		case Operand::OT_CALL: {
+			const auto* call = (Call*)operand;
+			const auto mark = m_next_register;
+			for ( size_t i = 0 ; i < call->arguments.size() + 1 ; i++ ) {
+				AllocRegister();
+			}
+			CompileExpression( call->callable, Chunk::NO_FLAG, mark );
+			Emit( OP_CALLABLE, mark, 0, 0, call );
+			for ( size_t i = 0 ; i < call->arguments.size() ; i++ ) {
+				const auto* argument = call->arguments[ i ];
+				CompileExpression( argument, Chunk::NO_FLAG, mark + 1 + i );
+				CompileDeref( argument, mark + 1 + i );
+			}
+			Emit( OP_CALL, dst, mark, call->arguments.size(), call );
+			m_next_register = mark;
+			break;
+		}
+		case Operand::OT_LOOP_CONTROL: {
+			Emit( OP_NEW_LOOP_CONTROL, dst, ( (program::LoopControl*)operand )->loop_control_type );
+			break;
+		}
+		default: {
+			// objects get their own context, leave them ( and anything unexpected ) to interpreter
+			Escape( operand );
+			Emit( OP_FALLBACK_OPERAND, dst, 0, 0, operand );
+		}
+	}
+}
+
+void Compiler::CompileDeref( const Operand* operand, const uint32_t reg ) {
+	if ( NeedsDeref( operand ) ) {
+		auto& last = m_chunk->code.back();
+		if ( last.op == OP_AT && last.a == reg && last.p == operand ) {
+			// element is read right away, no need for reference
+			last.op = OP_AT_VALUE;
+		}
+		else if ( last.op == OP_CHILD && last.a == reg && last.p == operand && IsObjectParent( ( (Expression*)operand )->a ) ) {
+			// same for properties, VM can look them up through inline cache then
+			last.op = OP_CHILD_VALUE;
+		}
+		else {
+			Emit( OP_DEREF, reg, 0, 0, operand );
+		}
+	}
+}
+
+const bool Compiler::IsSelfContained( const Scope* scope ) {
+	const auto it = m_self_contained.find( scope );
+	if ( it != m_self_contained.end() ) {
+		if ( m_declared_names ) {
+			m_declared_names->insert( it->second.names.begin(), it->second.names.end() );
+		}
+		m_has_shadowing |= it->second.has_shadowing;
+		return it->second.is_self_contained;
+	}
+	auto* const outer_names = m_declared_names;
+	const bool had_shadowing = m_has_shadowing;
+	std::unordered_set< std::string > names = {};
+	m_declared_names = &names;
+	m_has_shadowing = false;
+	bool result = true;
+	for ( const auto& control : scope->body ) {
+		switch ( control->control_type ) {
+			case Control::CT_STATEMENT: {
+				result = IsSelfContained( ( (Statement*)control )->body, true );
+				break;
+			}
+			case Control::CT_CONDITIONAL: {
+				result = IsSelfContained( (Conditional*)control, false, true );
+				break;
+			}
+			default:
+				result = false;
+		}
+		if ( !result ) {
+			break;
+		}
+	}
+	m_declared_names = outer_names;
+	bool is_shadowing = false;
+	for ( size_t i = 0 ; i < scope->frame.GetSize() ; i++ ) {
+		if ( !names.insert( scope->frame.GetName( i ) ).second ) {
+			is_shadowing = true;
+		}
+	}
+	const bool has_shadowing = m_has_shadowing || is_shadowing;
+	m_has_shadowing = had_shadowing || has_shadowing;
+	if ( outer_names ) {
+		outer_names->insert( names.begin(), names.end() );
+	}
+	m_self_contained.insert(
+		{
+			scope,
+			{
+				result,
+				std::move( names ),
+				is_shadowing,
+				has_shadowing
+			}
+		}
+	);
+	return result;
+}
+
+const Compiler::self_contained_t& Compiler::GetSelfContained( const Scope* scope ) {
+	IsSelfContained( scope );
+	return m_self_contained.at( scope );
+}
+
+const bool Compiler::IsSelfContained( const Conditional* conditional, const bool is_nested, const bool has_flag ) {
+	if ( !IsNative( conditional, is_nested ) ) {
+		return false;
+	}
+	switch ( conditional->conditional_type ) {
+		case Conditional::CT_IF: {
+			const auto* c = (If*)conditional;
+			return IsSelfContained( c->condition->expression, false ) && IsSelfContained( c->body ) && ( !c->els || IsSelfContained( c->els, true, has_flag ) );
+		}
+		case Conditional::CT_ELSEIF: {
+			const auto* c = (ElseIf*)conditional;
+			return IsSelfContained( c->condition->expression, false ) && IsSelfContained( c->body ) && ( !c->els || IsSelfContained( c->els, true, has_flag ) );
+		}
+		case Conditional::CT_ELSE: {
+			return IsSelfContained( ( (Else*)conditional )->body );
+		}
+		case Conditional::CT_WHILE: {
+			const auto* c = (While*)conditional;
+			return IsSelfContained( c->condition->expression, false ) && IsSelfContained( c->body );
+		}
+		case Conditional::CT_FOR: {
+			const auto* c = (For*)conditional;
+			const auto* condition = (ForConditionExpressions*)c->condition;
+			return ( !condition->init || IsSelfContained( condition->init, has_flag ) ) &&
+				IsSelfContained( condition->check, false ) &&
+				( !condition->iterate || IsSelfContained( condition->iterate, has_flag ) ) &&
+				IsSelfContained( c->body );
+		}
+		default:
+			return false;
+	}
+}
+
+const bool Compiler::IsSelfContained( const Expression* expression, const bool has_flag ) {
+	if ( !IsNative( expression, has_flag ) ) {
+		return false;
+	}
+	// variables are always handled natively, everything else is same as standalone operand
+	return ( !expression->a || IsSelfContained( expression->a ) ) && ( !expression->b || IsSelfContained( expression->b ) );
+}
+
+const bool Compiler::IsSelfContained( const Operand* operand ) {
+	switch ( operand->type ) {
+		case Operand::OT_VALUE:
+		case Operand::OT_VARIABLE:
+		case Operand::OT_LOOP_CONTROL:
+			return true;
+		case Operand::OT_ARRAY: {
+			for ( const auto& it : ( (program::Array*)operand )->elements ) {
+				if ( !IsSelfContained( it, false ) ) {
+					return false;
+				}
+			}
+			return true;
+		}
+		case Operand::OT_SCOPE:
+			return IsSelfContained( (Scope*)operand );
+		case Operand::OT_EXPRESSION:
+			return IsSelfContained( (Expression*)operand, false );
+		case Operand::OT_CALL: {
+			const auto* call = (Call*)operand;
+			if ( !IsSelfContained( call->callable, false ) ) {
+				return false;
+			}
+			for ( const auto& it : call->arguments ) {
+				if ( !IsSelfContained( it, false ) ) {
+					return false;
+				}
+			}
+			return true;
+		}
+		default:
+			return false;
+	}
+}
+
+const bool Compiler::IsNative( const Conditional* conditional, const bool is_nested ) {
+	switch ( conditional->conditional_type ) {
+		case Conditional::CT_IF:
+		case Conditional::CT_WHILE:
+			return true;
+		case Conditional::CT_ELSEIF:
+		case Conditional::CT_ELSE:
+			// interpreter will report error if not nested
+			return is_nested;
+		case Conditional::CT_FOR:
+			return ( (For*)conditional )->condition->for_type == ForCondition::FCT_EXPRESSIONS;
+		default:
+			// try, switch
+			return false;
+	}
+}
+
+const bool Compiler::IsNative( const Expression* expression, const bool has_flag ) {
+	if ( !expression->op ) {
+		return true;
+	}
+	const auto* a = expression->a;
+	const auto* b = expression->b;
+	switch ( expression->op->op ) {
+		case OT_RETURN:
+		case OT_BREAK:
+		case OT_CONTINUE:
+			return has_flag && b;
+		case OT_ASSIGN:
+			return a && b && (
+				( a->type == Operand::OT_VARIABLE && ( (Variable*)a )->name[ 0 ] != '#' ) ||
+					a->type == Operand::OT_EXPRESSION
+			);
+		case OT_NOT:
+			return b;
+		case OT_EQ:
+		case OT_NE:
+		case OT_LT:
+		case OT_LTE:
+		case OT_GT:
+		case OT_GTE:
+		case OT_AND:
+		case OT_OR:
+		case OT_ADD:
+		case OT_SUB:
+		case OT_MULT:
+		case OT_DIV:
+		case OT_MOD:
+			return a && b;
+		case OT_INC:
+		case OT_DEC:
+			return a
+				? !b && a->type == Operand::OT_VARIABLE
+				: b && b->type == Operand::OT_VARIABLE;
+		case OT_INC_BY:
+		case OT_DEC_BY:
+		case OT_MULT_BY:
+		case OT_DIV_BY:
+		case OT_MOD_BY:
+			return a && b && a->type == Operand::OT_VARIABLE;
+		case OT_CHILD:
+			return a && b && b->type == Operand::OT_VARIABLE && (
+				a->type == Operand::OT_VARIABLE ||
+					a->type == Operand::OT_OBJECT ||
+					a->type == Operand::OT_CALL ||
+					a->type == Operand::OT_EXPRESSION
+			);
+		case OT_AT:
+			return a && b && (
+				b->type == Operand::OT_VALUE ||
+					b->type == Operand::OT_VARIABLE ||
+					b->type == Operand::OT_EXPRESSION
+			) && (
+				a->type == Operand::OT_VARIABLE ||
+					a->type == Operand::OT_ARRAY ||
+					a->type == Operand::OT_OBJECT ||
+					a->type == Operand::OT_EXPRESSION ||
+					a->type == Operand::OT_VALUE
+			);
+		case OT_PUSH:
+			return a && b && ( a->type == Operand::OT_VARIABLE || a->type == Operand::OT_EXPRESSION );
+		default:
+			// throw, pop, erase, range
+			return false;
+	}
+}
+
+const bool Compiler::NeedsDeref( const Operand* operand ) {
+	switch ( operand->type ) {
+		case Operand::OT_VALUE:
+		case Operand::OT_ARRAY:
+		case Operand::OT_OBJECT:
+		case Operand::OT_FUNCTION:
+		case Operand::OT_LOOP_CONTROL:
+			return false;
+		case Operand::OT_EXPRESSION: {
+			const auto* expression = (Expression*)operand;
+			if ( !expression->op ) {
+				return NeedsDeref( expression->a );
+			}
+			switch ( expression->op->op ) {
+				case OT_ASSIGN:
+				case OT_NOT:
+				case OT_EQ:
+				case OT_NE:
+				case OT_LT:
+				case OT_LTE:
+				case OT_GT:
+				case OT_GTE:
+				case OT_AND:
+				case OT_OR:
+				case OT_ADD:
+				case OT_SUB:
+				case OT_MULT:
+				case OT_DIV:
+				case OT_MOD:
+				case OT_INC:
+				case OT_DEC:
+					return false;
+				default:
+					return true;
+			}
+		}
+		default:
+			return true;
+	}
+}
+
+const bool Compiler::IsObjectParent( const Operand* operand ) {
+	// other operands are rejected by EvaluateChild
+	switch ( operand->type ) {
+		case Operand::OT_VARIABLE:
+		case Operand::OT_OBJECT:
+		case Operand::OT_CALL:
+		case Operand::OT_EXPRESSION:
+			return true;
+		default:
+			return false;
+	}
+}
+
+}
+}
+}
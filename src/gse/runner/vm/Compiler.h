@@ -0,0 +1,106 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <cstdint>
+#include <cstddef>
+
+#include "Chunk.h"
+
+namespace gse {
+
+namespace program {
+class Frame;
+class Scope;
+class Control;
+class Statement;
+class Conditional;
+class Expression;
+class Operand;
+class Variable;
+class Function;
+}
+
+namespace runner {
+namespace vm {
+
+// translates scope ( with everything nested in it ) to bytecode
+// scopes that never expose their context ( to closures, objects or interpreter fallbacks ) are not forked
+// their variables ( if any ) are kept in extra slots of nearest forked context, or in locals of chunk if function runs without context
+class Compiler {
+public:
+
+	Chunk* const Compile( const program::Scope* scope );
+	// body of function that runs in context of closure, with parameters and variables in locals
+	// returns chunk without code if function needs its own context
+	Chunk* const Compile( const program::Function* function );
+
+private:
+
+	Chunk* m_chunk = nullptr;
+	uint32_t m_next_register = 0;
+	uint32_t m_next_flag = 0;
+
+	// scopes that are being compiled, true if scope is not forked at runtime
+	std::vector< bool > m_frames = {};
+	size_t m_elided_frames = 0;
+
+	// forked scopes that keep variables of unforked ones
+	struct host_t {
+		const program::Frame* frame; // nullptr for locals of chunk
+		size_t enter; // instruction to patch with hidden slots count
+		uint32_t used;
+		uint32_t max;
+	};
+	std::vector< host_t > m_hosts = {};
+	// frame of unforked scope -> frame of its host ( nullptr for locals ) and first slot in it
+	std::unordered_map< const program::Frame*, std::pair< const program::Frame*, size_t > > m_hosted_frames = {};
+
+	struct self_contained_t {
+		bool is_self_contained;
+		// rest is only meaningful if scope is self-contained, otherwise not everything was checked
+		std::unordered_set< std::string > names; // declared in scope itself or anywhere inside
+		bool is_shadowing; // redeclares own variable somewhere inside
+		bool has_shadowing; // same for any scope inside, including itself
+	};
+	std::unordered_map< const program::Scope*, self_contained_t > m_self_contained = {};
+	// names declared by scopes checked so far, collected for scope that is being checked
+	std::unordered_set< std::string >* m_declared_names = nullptr;
+	bool m_has_shadowing = false;
+
+	const uint32_t AllocRegister();
+	const uint32_t AllocFlag();
+	const size_t Emit( const opcode_t op, const uint32_t a = 0, const uint32_t b = 0, const uint32_t c = 0, const void* p = nullptr );
+	void PatchJump( const size_t index );
+	void Escape( const program::Operand* operand );
+	const uint32_t Location( const program::Variable* variable );
+	// emits op for variable in context, or its counterpart for locals
+	void EmitVariable( const opcode_t op, const uint32_t reg, const program::Variable* variable );
+
+	// return true if flag may be set
+	const bool CompileScope( const program::Scope* scope, const uint32_t flag, const uint32_t dst );
+	const bool CompileStatement( const program::Statement* statement, const uint32_t flag, const uint32_t dst );
+	const bool CompileConditional( const program::Conditional* conditional, const bool is_nested, const uint32_t flag, const uint32_t dst );
+	const bool CompileExpression( const program::Expression* expression, const uint32_t flag, const uint32_t dst );
+	void CompileOperand( const program::Operand* operand, const uint32_t dst );
+	void CompileDeref( const program::Operand* operand, const uint32_t reg );
+
+	// same decisions as Compile*, without emitting anything
+	const bool IsSelfContained( const program::Scope* scope );
+	const self_contained_t& GetSelfContained( const program::Scope* scope );
+	const bool IsSelfContained( const program::Conditional* conditional, const bool is_nested, const bool has_flag );
+	const bool IsSelfContained( const program::Expression* expression, const bool has_flag );
+	const bool IsSelfContained( const program::Operand* operand );
+
+	static const bool IsNative( const program::Conditional* conditional, const bool is_nested );
+	static const bool IsNative( const program::Expression* expression, const bool has_flag );
+	static const bool NeedsDeref( const program::Operand* operand );
+	static const bool IsObjectParent( const program::Operand* operand );
+
+};
+
+}
+}
+}
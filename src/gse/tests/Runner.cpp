@@ -6,13 +6,17 @@
 #include "gse/GSE.h"
 #include "gse/context/GlobalContext.h"
 #include "gse/runner/Interpreter.h"
+#include "gse/runner/VM.h"
 #include "gse/ExecutionPointer.h"
 #include "gse/program/Program.h"
+#include "gse/program/Resolver.h"
 #include "gc/Space.h"
 #include "mocks/Mocks.h"
 
 #include "util/String.h"
 
+#include <functional>
+
 namespace gse {
 namespace tests {
 
@@ -23,45 +27,63 @@ void AddRunnerTests( task::gsetests::GSETests* task ) {
 #define VALIDATE() { \
     GT_ASSERT( actual_output == expected_output, ", actual output:\n" + actual_output ); \
 }
-	task->AddTest(
-		"test if interpreter executes programs correctly",
-		GT( expected_output ) {
-			auto* gc_space = gse->GetGCSpace();
-			
-			gc_space->Accumulate(
-				nullptr,
-				[ &gse, &gc_space ]() {
-					
-					NEWV( interpreter, runner::Interpreter, gc_space );
-					
-					context::GlobalContext* context = gse->CreateGlobalContext();
-					context->AddSourceLines( util::String::Split( GetTestSource(), '\n' ) );
-					mocks::AddMocks( gc_space, context, {} );
-					
-					gse->LogCaptureStart();
-					const auto* test_program = gse::tests::GetTestProgram( gse->GetGCSpace() );
-					ASSERT( test_program, "test program is null" );
-					try {
-						ExecutionPointer ep;
-						interpreter->Execute( context, ep, test_program );
-					}
-					catch ( const std::runtime_error& e ) {
+	const std::vector< std::pair< std::string, std::function< runner::Runner*( gc::Space* const gc_space ) > > > runners = {
+		{
+			"interpreter", []( gc::Space* const gc_space ) -> runner::Runner* {
+				NEWV( interpreter, runner::Interpreter, gc_space );
+				return interpreter;
+			}
+		},
+		{
+			"vm", []( gc::Space* const gc_space ) -> runner::Runner* {
+				NEWV( vm, runner::VM, gc_space );
+				return vm;
+			}
+		},
+	};
+	for ( const auto& it : runners ) {
+		task->AddTest(
+			"test if " + it.first + " executes programs correctly",
+			GT( expected_output, it ) {
+				auto* gc_space = gse->GetGCSpace();
+				
+				gc_space->Accumulate(
+					nullptr,
+					[ &gse, &gc_space, &it ]() {
+						
+						auto* runner = it.second( gc_space );
+						
+						context::GlobalContext* context = gse->CreateGlobalContext();
+						context->AddSourceLines( util::String::Split( GetTestSource(), '\n' ) );
+						mocks::AddMocks( gc_space, context, {} );
+						
+						gse->LogCaptureStart();
+						const auto* test_program = gse::tests::GetTestProgram( gse->GetGCSpace() );
+						ASSERT( test_program, "test program is null" );
+						// same as parser does
+						program::Resolver().Resolve( test_program );
+						try {
+							ExecutionPointer ep;
+							runner->Execute( context, ep, test_program );
+						}
+						catch ( const std::runtime_error& e ) {
+							delete test_program;
+							context->Clear();
+							throw;
+						}
 						delete test_program;
 						context->Clear();
-						throw;
+						
 					}
-					delete test_program;
-					context->Clear();
-					
-				}
-			);
-			const auto actual_output = gse->LogCaptureStopGet();
-			
-			VALIDATE();
-			
-			GT_OK();
-		}
-	);
+				);
+				const auto actual_output = gse->LogCaptureStopGet();
+				
+				VALIDATE();
+				
+				GT_OK();
+			}
+		);
+	}
 	
 }
 
@@ -45,55 +45,63 @@ void AddScriptsTests( task::gsetests::GSETests* task ) {
 	const auto scripts = c->HasDebugFlag( config::Config::DF_GSE_TESTS_SCRIPT )
 		? std::vector< std::string >{ c->GetGSETestsScript() }
 		: util::FS::ListDirectory( tests_path, true, GSE::PATH_SEPARATOR );
+	// every script must behave same on all runners
+	const std::vector< std::pair< std::string, config::gse_runner_t > > runner_types = {
+		{ "interpreter", config::GR_INTERPRETER },
+		{ "vm",          config::GR_VM },
+	};
 	for ( const auto& script : scripts ) {
 		if ( script.substr( 0, tests_path.size() + 2 ) == tests_path + GSE::PATH_SEPARATOR + "_" ) {
 			continue; // these should not be tested directly (i.e. includes)
 		}
-		task->AddTest(
-			"testing " + script,
-			GT( script ) {
-				auto* gc_space = gse->GetGCSpace();
-				
-				parser::Parser* parser = nullptr;
-				runner::Runner* runner = nullptr;
-				const program::Program* program = nullptr;
-				context::GlobalContext* context = nullptr;
-				
-				std::string last_error = "";
-				try {
-					const auto source = util::FS::ReadTextFile( script, GSE::PATH_SEPARATOR );
-					parser = gse->GetParser( script, source );
-					context = gse->CreateGlobalContext( script );
-					mocks::AddMocks( gc_space, context, { script } );
-					runner = gse->GetRunner();
-					ExecutionPointer ep;
-					gc_space->Accumulate(
-						nullptr,
-						[ &runner, &context, &ep, &program, &parser ]() {
-							program = parser->Parse();
-							runner->Execute( context, ep, program );
+		for ( const auto& runner_type : runner_types ) {
+			task->AddTest(
+				"testing " + script + " ( " + runner_type.first + " )",
+				GT( script, runner_type ) {
+					auto* gc_space = gse->GetGCSpace();
+					
+					parser::Parser* parser = nullptr;
+					runner::Runner* runner = nullptr;
+					const program::Program* program = nullptr;
+					context::GlobalContext* context = nullptr;
+					
+					std::string last_error = "";
+					try {
+						gse->SetRunnerType( runner_type.second );
+						const auto source = util::FS::ReadTextFile( script, GSE::PATH_SEPARATOR );
+						parser = gse->GetParser( script, source );
+						context = gse->CreateGlobalContext( script );
+						mocks::AddMocks( gc_space, context, { script } );
+						runner = gse->GetRunner();
+						ExecutionPointer ep;
+						gc_space->Accumulate(
+							nullptr,
+							[ &runner, &context, &ep, &program, &parser ]() {
+								program = parser->Parse();
+								runner->Execute( context, ep, program );
+							}
+						);
+					}
+					catch ( Exception& e ) {
+						last_error = e.ToString();
+						if ( context ) {
+							context = nullptr;
 						}
-					);
-				}
-				catch ( Exception& e ) {
-					last_error = e.ToString();
-					if ( context ) {
-						context = nullptr;
 					}
+					catch ( std::runtime_error const& e ) {
+						last_error = (std::string)"Internal error: " + e.what();
+					};
+					
+					gse->Finish();
+					
+					if ( program ) {
+						DELETE( program );
+					}
+					
+					return last_error;
 				}
-				catch ( std::runtime_error const& e ) {
-					last_error = (std::string)"Internal error: " + e.what();
-				};
-				
-				gse->Finish();
-				
-				if ( program ) {
-					DELETE( program );
-				}
-				
-				return last_error;
-			}
-		);
+			);
+		}
 	}
 }
 
@@ -12,7 +12,9 @@
 #include "gse/value/Int.h"
 #include "gse/value/String.h"
 #include "gse/tests/Tests.h"
+#include "gse/Wrappable.h"
 #include "gse/ExecutionPointer.h"
+#include "gc/Space.h"
 
 namespace gse {
 namespace tests {
@@ -20,6 +22,32 @@ namespace mocks {
 
 static std::unordered_map< std::string, Value* > s_global_map = {};
 
+// native object with cached wrapper and lazily read property
+class Counter : public Wrappable {
+public:
+	int64_t count = 0;
+
+	WRAPDEFS_PTR( Counter )
+};
+
+WRAPIMPL_CACHED_BEGIN( Counter )
+	WRAPIMPL_LAZY_BEGIN
+		WRAPIMPL_LAZY( "count", Int, self->count )
+	WRAPIMPL_LAZY_END
+	WRAPIMPL_PROPS
+		{
+			"increment",
+			NATIVE_CALL( this ) {
+				N_EXPECT_ARGS( 0 );
+				count++;
+				return VALUE( value::Undefined );
+			} )
+		},
+	};
+WRAPIMPL_CACHED_END_PTR()
+
+static Counter s_counter = {};
+
 void Test::AddMocks( gc::Space* const gc_space, context::GlobalContext* ctx, const test_info_t& test_info ) {
 	value::object_properties_t mocks = {
 		{
@@ -84,6 +112,36 @@ void Test::AddMocks( gc::Space* const gc_space, context::GlobalContext* ctx, con
 				return VALUE( value::Undefined );
 			} )
 		},
+		{
+			"get_counter",
+			NATIVE_CALL() {
+				N_EXPECT_ARGS( 0 );
+				return s_counter.Wrap( GSE_CALL );
+			} )
+		},
+		{
+			"get_wrappers_created",
+			NATIVE_CALL() {
+				N_EXPECT_ARGS( 0 );
+				return VALUE( value::Int,, Wrappable::GetWrappersCreated() );
+			} )
+		},
+		{
+			"gc_stats",
+			NATIVE_CALL() {
+				N_EXPECT_ARGS( 0 );
+				const auto stats = gc_space->GetStats();
+				return VALUE( value::Object,, GSE_CALL_NOGC, value::object_properties_t{
+					{ "cycles", VALUE( value::Int,, stats.cycles ) },
+					{ "objects_total", VALUE( value::Int,, stats.objects_total ) },
+					{ "objects_marked", VALUE( value::Int,, stats.objects_marked ) },
+					{ "mark_us", VALUE( value::Int,, stats.mark_us ) },
+					{ "objects_swept", VALUE( value::Int,, stats.objects_swept ) },
+					{ "sweep_us", VALUE( value::Int,, stats.sweep_us ) },
+					{ "is_cycle_finished", VALUE( value::Bool,, stats.is_cycle_finished ) },
+				} );
+			} )
+		},
 	};
 	{
 		ExecutionPointer ep;
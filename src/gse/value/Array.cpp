@@ -18,7 +18,7 @@ Value* const Array::Get( const size_t index ) {
 
 	return ( index < value.size() )
 		? value[ index ]
-		: VALUEEXT( value::Undefined, m_gc_space );
+		: value::Undefined::Shared( m_gc_space );
 }
 
 Value* const Array::GetSubArray( const std::optional< size_t > from, const std::optional< size_t > to ) {
@@ -79,7 +79,7 @@ Value* const Array::FromVector( GSE_CALLABLE, const std::vector< Wrappable* >* d
 	return VALUE( Array, , elements );
 }
 
-void Array::GetReachableObjects( std::unordered_set< gc::Object* >& reachable_objects ) {
+void Array::GetReachableObjects( gc::MarkStack& reachable_objects ) {
 	Value::GetReachableObjects( reachable_objects );
 
 	GC_DEBUG_BEGIN( "Array" );
@@ -5,7 +5,7 @@
 namespace gse {
 namespace value {
 
-void ArrayRangeRef::GetReachableObjects( std::unordered_set< gc::Object* >& reachable_objects ) {
+void ArrayRangeRef::GetReachableObjects( gc::MarkStack& reachable_objects ) {
 	Value::GetReachableObjects( reachable_objects );
 
 	GC_DEBUG_BEGIN( "ArrayRangeRef" );
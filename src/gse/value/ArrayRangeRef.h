@@ -24,7 +24,7 @@ public:
 	const std::optional< size_t > from;
 	const std::optional< size_t > to;
 
-	void GetReachableObjects( std::unordered_set< gc::Object* >& reachable_objects ) override;
+	void GetReachableObjects( gc::MarkStack& reachable_objects ) override;
 
 };
 
@@ -17,6 +17,14 @@ public:
 
 	bool value;
 
+	static Bool* const Shared( gc::Space* const gc_space, const bool value ) {
+		static Bool* const s_true = new Bool( nullptr, true );
+		static Bool* const s_false = new Bool( nullptr, false );
+		return value
+			? s_true
+			: s_false;
+	}
+
 };
 
 }
@@ -11,7 +11,7 @@ Callable::Callable( gc::Space* const gc_space, context::Context* ctx )
 	ASSERT( ctx, "callable ctx is null" );
 }
 
-void Callable::GetReachableObjects( std::unordered_set< gc::Object* >& reachable_objects ) {
+void Callable::GetReachableObjects( gc::MarkStack& reachable_objects ) {
 	Value::GetReachableObjects( reachable_objects );
 
 	GC_DEBUG_BEGIN( "Callable" );
@@ -26,7 +26,7 @@ public:
 
 	virtual Value* Run( GSE_CALLABLE, const function_arguments_t& arguments ) = 0;
 
-	void GetReachableObjects( std::unordered_set< gc::Object* >& reachable_objects ) override;
+	void GetReachableObjects( gc::MarkStack& reachable_objects ) override;
 
 	context::Context* const m_ctx = nullptr;
 
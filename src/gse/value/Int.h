@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <vector>
 
 #include "gse/Value.h"
 
@@ -21,6 +22,25 @@ public:
 	Int( gc::Space* const gc_space, const Int& other )
 		: Int( gc_space, other.value ) {}
 
+	// range of ints that are preallocated and shared
+	static constexpr int64_t SHARED_MIN = -128;
+	static constexpr int64_t SHARED_MAX = 1023;
+
+	static Int* const Shared( gc::Space* const gc_space, const int64_t value ) {
+		if ( value < SHARED_MIN || value > SHARED_MAX ) {
+			return VALUE( Int, , value );
+		}
+		static const std::vector< Int* > s_shared = []() {
+			std::vector< Int* > result = {};
+			result.reserve( SHARED_MAX - SHARED_MIN + 1 );
+			for ( int64_t i = SHARED_MIN ; i <= SHARED_MAX ; i++ ) {
+				result.push_back( new Int( nullptr, i ) );
+			}
+			return result;
+		}();
+		return s_shared[ value - SHARED_MIN ];
+	}
+
 };
 
 }
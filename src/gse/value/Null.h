@@ -11,6 +11,11 @@ public:
 	Null( gc::Space* const gc_space, const Null& other )
 		: Null( gc_space ) {}
 
+	static Null* const Shared( gc::Space* const gc_space ) {
+		static Null* const s_shared = new Null( nullptr );
+		return s_shared;
+	}
+
 };
 
 }
@@ -1,5 +1,8 @@
 #include "Object.h"
 
+#include <algorithm>
+#include <stdexcept>
+
 #include "Undefined.h"
 #include "ObjectRef.h"
 #include "Exception.h"
@@ -8,22 +11,34 @@
 #include "gse/context/Context.h"
 #include "ValueRef.h"
 #include "gse/context/ChildContext.h"
+#include "gse/program/Frame.h"
 #include "gc/Space.h"
 
 namespace gse {
 namespace value {
 
-Object::Object( GSE_CALLABLE, object_properties_t initial_value, const object_class_t object_class, Wrappable* wrapobj, wrapsetter_t* wrapsetter )
+Object::Object( GSE_CALLABLE, object_properties_t initial_value, const object_class_t object_class, Wrappable* wrapobj, wrapsetter_t* wrapsetter, const wrapgetters_t* wrapgetters )
 	: Value( gc_space, GetType() )
-	, m_value( initial_value )
 	, object_class( object_class )
 	, wrapobj( wrapobj )
 	, wrapsetter( wrapsetter )
 	, m_si( si )
 	, m_ep( ep ) {
 	ASSERT( ctx, "object ctx is null" );
+	m_slots.reserve( initial_value.size() );
+	for ( const auto& it : initial_value ) {
+		if ( it.second && it.second->type != T_UNDEFINED ) {
+			AddProperty( it.first, it.second );
+		}
+	}
+	if ( wrapgetters ) {
+		ASSERT( wrapobj, "wrapgetters without wrapobj" );
+		for ( const auto& it : *wrapgetters ) {
+			AddProperty( it.first, it.second( wrapobj, nullptr, GSE_CALL ), it.second );
+		}
+	}
 	ctx->ForkAndExecute(
-		GSE_CALL, false, [ this, &gc_space, &si, &ep, &wrapobj ]( context::ChildContext* const subctx ) {
+		GSE_CALL, false, program::Frame::GetObjectFrame(), [ this, &gc_space, &si, &ep, &wrapobj ]( context::ChildContext* const subctx ) {
 			m_ctx = subctx;
 			m_this = VALUE( value::ValueRef, , this );
 			m_ctx->CreateConst( "this", m_this, si, ep );
@@ -38,34 +53,90 @@ Object::~Object() {
 	if ( wrapobj ) {
 		wrapobj->Unlink( this );
 	}
+	if ( m_dictionary ) {
+		delete m_dictionary;
+	}
 }
 
 Value* const Object::Get( const object_key_t& key ) {
 	CHECKACCUM( m_gc_space );
 
-	const auto& it = m_value.find( key );
-	return it != m_value.end()
-		? it->second
-		: VALUEEXT( value::Undefined, m_gc_space );
+	const auto slot = FindSlot( key );
+	return slot != Shape::NO_SLOT
+		? Read( slot )
+		: value::Undefined::Shared( m_gc_space );
+}
+
+Value* const Object::Get( const atom_t atom ) {
+	CHECKACCUM( m_gc_space );
+
+	const auto slot = m_shape->Find( atom );
+	return slot != Shape::NO_SLOT
+		? Read( slot )
+		: value::Undefined::Shared( m_gc_space );
+}
+
+Value* const Object::Get( const object_key_t& key, property_cache_t& cache ) {
+	CHECKACCUM( m_gc_space );
+
+	if ( cache.shape == m_shape ) {
+		return Read( cache.slot );
+	}
+	if ( !cache.atom ) {
+		cache.atom = Shape::Intern( key );
+	}
+	const auto slot = m_shape->Find( cache.atom );
+	if ( slot == Shape::NO_SLOT ) {
+		return value::Undefined::Shared( m_gc_space );
+	}
+	// private shapes change in place, so only shared ones can be remembered
+	if ( !m_dictionary ) {
+		cache.shape = m_shape;
+		cache.slot = slot;
+	}
+	return Read( slot );
 }
 
 void Object::Assign( const object_key_t& key, Value* const new_value, const std::function< void() >& f_on_set ) {
+	const auto atom = Shape::TryIntern( key );
+	if ( atom ) {
+		Assign( atom, new_value, f_on_set );
+		return;
+	}
+	const auto slot = m_dictionary
+		? m_dictionary->FindOwn( key )
+		: Shape::NO_SLOT;
+	if ( slot != Shape::NO_SLOT ) {
+		Assign( m_dictionary->GetKey( slot ), new_value, f_on_set );
+	}
+	else if ( new_value && new_value->type != T_UNDEFINED ) {
+		if ( f_on_set ) {
+			f_on_set();
+		}
+		AddProperty( key, new_value );
+	}
+}
+
+void Object::Assign( const atom_t atom, Value* const new_value, const std::function< void() >& f_on_set ) {
 	CHECKACCUM( m_gc_space );
 
 	const bool has_value = new_value && new_value->type != T_UNDEFINED;
-	const auto it = m_value.find( key );
+	const auto slot = m_shape->Find( atom );
 	if (
-		( has_value && ( it == m_value.end() || new_value != it->second ) ) ||
-			( !has_value && it != m_value.end() )
+		( has_value && ( slot == Shape::NO_SLOT || new_value != m_slots[ slot ] ) ) ||
+			( !has_value && slot != Shape::NO_SLOT )
 		) {
 		if ( f_on_set ) {
 			f_on_set();
 		}
-		if ( has_value ) {
-			m_value.insert_or_assign( key, new_value );
+		if ( !has_value ) {
+			RemoveProperty( slot );
+		}
+		else if ( slot == Shape::NO_SLOT ) {
+			AddProperty( atom, new_value );
 		}
 		else {
-			m_value.erase( key );
+			m_slots[ slot ] = new_value;
 		}
 	}
 }
@@ -73,12 +144,15 @@ void Object::Assign( const object_key_t& key, Value* const new_value, const std:
 void Object::Set( const object_key_t& key, Value* const new_value, GSE_CALLABLE ) {
 	Assign(
 		key, new_value, [ this, &key, &new_value, &ctx, &si, &ep, &gc_space ]() {
-			if ( wrapobj ) {
-				if ( !wrapsetter ) {
-					GSE_ERROR( EC.INVALID_ASSIGNMENT, "Property is read-only" );
-				}
-				wrapsetter( wrapobj, key, new_value, GSE_CALL );
-			}
+			WrapSet( key, new_value, GSE_CALL );
+		}
+	);
+}
+
+void Object::Set( const atom_t atom, Value* const new_value, GSE_CALLABLE ) {
+	Assign(
+		atom, new_value, [ this, &atom, &new_value, &ctx, &si, &ep, &gc_space ]() {
+			WrapSet( *atom, new_value, GSE_CALL );
 		}
 	);
 }
@@ -87,7 +161,7 @@ void Object::ValidatePrimitivity( GSE_CALLABLE, const std::string& prefix ) cons
 	if ( !object_class.empty() ) {
 		GSE_ERROR( gse::EC.GAME_ERROR, "Unexpected non-primitive object at " + prefix + " : " + object_class );
 	}
-	for ( const auto& v : m_value ) {
+	for ( const auto& v : value ) {
 		if ( v.second->type == T_OBJECT ) {
 			( (Object*)v.second )->ValidatePrimitivity( GSE_CALL, prefix + "." + v.first );
 		}
@@ -96,7 +170,15 @@ void Object::ValidatePrimitivity( GSE_CALLABLE, const std::string& prefix ) cons
 
 Value* const Object::GetRef( const object_key_t& key ) {
 	CHECKACCUM( m_gc_space );
-	return VALUEEXT( ObjectRef, m_gc_space, this, key );
+	const auto atom = Shape::TryIntern( key );
+	return atom
+		? VALUEEXT( ObjectRef, m_gc_space, this, atom )
+		: VALUEEXT( ObjectRef, m_gc_space, this, key );
+}
+
+Value* const Object::GetRef( const atom_t atom ) {
+	CHECKACCUM( m_gc_space );
+	return VALUEEXT( ObjectRef, m_gc_space, this, atom );
 }
 
 void Object::Unlink() {
@@ -105,7 +187,7 @@ void Object::Unlink() {
 	type = T_UNDEFINED; // make sure all corresponding variables are inaccessible in scripts
 }
 
-void Object::GetReachableObjects( std::unordered_set< gc::Object* >& reachable_objects ) {
+void Object::GetReachableObjects( gc::MarkStack& reachable_objects ) {
 	Value::GetReachableObjects( reachable_objects );
 
 	GC_DEBUG_BEGIN( "Object" );
@@ -119,9 +201,9 @@ void Object::GetReachableObjects( std::unordered_set< gc::Object* >& reachable_o
 	GC_REACHABLE( m_this );
 
 	GC_DEBUG_BEGIN( "properties" );
-	for ( const auto& v : m_value ) {
-		GC_DEBUG_BEGIN( v.first );
-		GC_REACHABLE( v.second );
+	for ( size_t slot = 0 ; slot < m_slots.size() ; slot++ ) {
+		GC_DEBUG_BEGIN( *m_shape->GetKey( slot ) );
+		GC_REACHABLE( m_slots[ slot ] );
 		GC_DEBUG_END();
 	}
 	GC_DEBUG_END();
@@ -133,5 +215,185 @@ context::ChildContext* const Object::GetContext() const {
 	return m_ctx;
 }
 
+void Object::WrapSet( const object_key_t& key, Value* const new_value, GSE_CALLABLE ) {
+	if ( wrapobj ) {
+		if ( !wrapsetter ) {
+			GSE_ERROR( EC.INVALID_ASSIGNMENT, "Property is read-only" );
+		}
+		wrapsetter( wrapobj, key, new_value, GSE_CALL );
+	}
+}
+
+const size_t Object::FindSlot( const object_key_t& key ) const {
+	const auto atom = Shape::FindAtom( key );
+	if ( atom ) {
+		return m_shape->Find( atom );
+	}
+	return m_dictionary
+		? m_dictionary->FindOwn( key )
+		: Shape::NO_SLOT;
+}
+
+Value* const Object::Read( const size_t slot ) const {
+	if ( !m_getters.empty() && m_getters[ slot ] && wrapobj ) {
+		ExecutionPointer ep;
+		m_slots[ slot ] = m_getters[ slot ]( wrapobj, m_slots[ slot ], m_gc_space, m_ctx, m_si, ep );
+	}
+	return m_slots[ slot ];
+}
+
+void Object::AddProperty( const object_key_t& key, Value* const value ) {
+	const auto atom = Shape::TryIntern( key );
+	if ( atom ) {
+		AddProperty( atom, value );
+	}
+	else {
+		// keys that aren't interned can't be in shared shapes
+		if ( !m_dictionary ) {
+			m_dictionary = m_shape->CreateDictionary();
+			m_shape = m_dictionary;
+		}
+		AddProperty( m_dictionary->Own( key ), value );
+	}
+}
+
+void Object::AddProperty( const atom_t atom, Value* const value, wrapgetter_t* const getter ) {
+	const Shape* shared = nullptr;
+	if ( !m_dictionary && m_shape->GetSize() < Shape::MAX_SHARED_SIZE ) {
+		shared = m_shape->With( atom );
+	}
+	if ( shared ) {
+		m_shape = shared;
+	}
+	else {
+		if ( !m_dictionary ) {
+			m_dictionary = m_shape->CreateDictionary();
+			m_shape = m_dictionary;
+		}
+		m_dictionary->Add( atom );
+	}
+	if ( getter && m_getters.empty() ) {
+		m_getters.resize( m_slots.size(), nullptr );
+	}
+	m_slots.push_back( value );
+	if ( !m_getters.empty() ) {
+		m_getters.push_back( getter );
+	}
+}
+
+void Object::RemoveProperty( const size_t slot ) {
+	ASSERT( slot < m_slots.size(), "slot out of range" );
+	// shared shapes only grow, objects that lose properties get private shape
+	if ( !m_dictionary ) {
+		m_dictionary = m_shape->CreateDictionary();
+		m_shape = m_dictionary;
+	}
+	m_dictionary->Remove( slot );
+	m_slots[ slot ] = m_slots.back();
+	m_slots.pop_back();
+	if ( !m_getters.empty() ) {
+		m_getters[ slot ] = m_getters.back();
+		m_getters.pop_back();
+	}
+}
+
+Object::properties_t::properties_t( const Object* const object )
+	: m_object( object ) {}
+
+Object::properties_t::const_iterator Object::properties_t::begin() const {
+	const auto& order = m_object->m_shape->GetOrder();
+	return order.empty()
+		? end()
+		: const_iterator( m_object, order.front(), 0 );
+}
+
+Object::properties_t::const_iterator Object::properties_t::end() const {
+	return const_iterator( m_object, Shape::NO_SLOT, Shape::NO_SLOT );
+}
+
+Object::properties_t::const_iterator Object::properties_t::find( const object_key_t& key ) const {
+	const auto slot = m_object->FindSlot( key );
+	return slot != Shape::NO_SLOT
+		? const_iterator( m_object, slot, Shape::NO_SLOT )
+		: end();
+}
+
+Value* const Object::properties_t::at( const object_key_t& key ) const {
+	const auto it = find( key );
+	if ( it == end() ) {
+		throw std::out_of_range( "object property not found: " + key );
+	}
+	return ( *it ).second;
+}
+
+const size_t Object::properties_t::count( const object_key_t& key ) const {
+	return find( key ) != end()
+		? 1
+		: 0;
+}
+
+const size_t Object::properties_t::size() const {
+	return m_object->m_slots.size();
+}
+
+const bool Object::properties_t::empty() const {
+	return m_object->m_slots.empty();
+}
+
+Object::properties_t::operator object_properties_t() const {
+	object_properties_t result = {};
+	for ( size_t slot = 0 ; slot < m_object->m_slots.size() ; slot++ ) {
+		result.insert(
+			{
+				*m_object->m_shape->GetKey( slot ),
+				m_object->Read( slot )
+			}
+		);
+	}
+	return result;
+}
+
+Object::properties_t::const_iterator::const_iterator( const Object* const object, const size_t slot, const size_t pos )
+	: m_object( object )
+	, m_slot( slot )
+	, m_pos( pos ) {}
+
+const Object::properties_t::property_t Object::properties_t::const_iterator::operator*() const {
+	ASSERT( m_slot < m_object->m_slots.size(), "object iterator out of range" );
+	return {
+		*m_object->m_shape->GetKey( m_slot ),
+		m_object->Read( m_slot )
+	};
+}
+
+const Object::properties_t::const_iterator::arrow_t Object::properties_t::const_iterator::operator->() const {
+	return { operator*() };
+}
+
+Object::properties_t::const_iterator& Object::properties_t::const_iterator::operator++() {
+	ASSERT( m_slot != Shape::NO_SLOT, "object iterator out of range" );
+	const auto& order = m_object->m_shape->GetOrder();
+	if ( m_pos == Shape::NO_SLOT ) {
+		m_pos = std::find( order.begin(), order.end(), m_slot ) - order.begin();
+	}
+	m_pos++;
+	if ( m_pos < order.size() ) {
+		m_slot = order[ m_pos ];
+	}
+	else {
+		m_slot = Shape::NO_SLOT;
+		m_pos = Shape::NO_SLOT;
+	}
+	return *this;
+}
+
+const bool Object::properties_t::const_iterator::operator==( const const_iterator& other ) const {
+	return m_slot == other.m_slot && m_object == other.m_object;
+}
+
+const bool Object::properties_t::const_iterator::operator!=( const const_iterator& other ) const {
+	return !operator==( other );
+}
+
 }
 }
@@ -3,11 +3,12 @@
 #include <map>
 #include <string>
 #include <functional>
-#include <unordered_set>
+#include <vector>
 
 #include "gse/Value.h"
 
 #include "Types.h"
+#include "Shape.h"
 #include "gse/Types.h"
 #include "gse/ExecutionPointer.h"
 
@@ -32,21 +33,76 @@ public:
 	static const type_t GetType() { return Value::T_OBJECT; }
 
 	typedef void (wrapsetter_t)( Wrappable*, const std::string&, Value* const, GSE_CALLABLE ); // ( obj, key, value, GSE_CALL )
-	Object( GSE_CALLABLE, object_properties_t initial_value = {}, const object_class_t object_class = "", Wrappable* wrapobj = nullptr, wrapsetter_t* wrapsetter = nullptr );
+	// reads property of wrapped object when it's accessed, previous value is passed so that it could be returned if unchanged
+	typedef Value* (wrapgetter_t)( Wrappable*, Value* const, GSE_CALLABLE ); // ( obj, previous value, GSE_CALL )
+	typedef std::vector< std::pair< atom_t, wrapgetter_t* > > wrapgetters_t;
+	Object( GSE_CALLABLE, object_properties_t initial_value = {}, const object_class_t object_class = "", Wrappable* wrapobj = nullptr, wrapsetter_t* wrapsetter = nullptr, const wrapgetters_t* wrapgetters = nullptr );
 	~Object();
 
+	// read-only view of properties that behaves like object_properties_t, iterated in order of keys
+	class properties_t {
+	public:
+
+		struct property_t {
+			const object_key_t& first;
+			Value* const second;
+		};
+
+		class const_iterator {
+		public:
+			const_iterator() = default;
+			const_iterator( const Object* const object, const size_t slot, const size_t pos );
+
+			const property_t operator*() const;
+			struct arrow_t {
+				const property_t property;
+				const property_t* operator->() const { return &property; }
+			};
+			const arrow_t operator->() const;
+			const_iterator& operator++();
+			const bool operator==( const const_iterator& other ) const;
+			const bool operator!=( const const_iterator& other ) const;
+
+		private:
+			const Object* m_object = nullptr;
+			size_t m_slot = Shape::NO_SLOT;
+			size_t m_pos = Shape::NO_SLOT; // position in shape order, NO_SLOT if not known yet ( i.e. after find() )
+		};
+
+		properties_t( const Object* const object );
+
+		const_iterator begin() const;
+		const_iterator end() const;
+		const_iterator find( const object_key_t& key ) const;
+		Value* const at( const object_key_t& key ) const;
+		const size_t count( const object_key_t& key ) const;
+		const size_t size() const;
+		const bool empty() const;
+
+		operator object_properties_t() const;
+
+	private:
+		const Object* const m_object;
+	};
+
 	Value* const Get( const object_key_t& key );
+	Value* const Get( const atom_t atom );
+	// for access sites that know property name in advance, key is interned on first call
+	Value* const Get( const object_key_t& key, property_cache_t& cache );
 	void Assign( const object_key_t& key, Value* const new_value, const std::function< void() >& f_on_set = nullptr );
+	void Assign( const atom_t atom, Value* const new_value, const std::function< void() >& f_on_set = nullptr );
 	void Set( const object_key_t& key, Value* const new_value, GSE_CALLABLE );
+	void Set( const atom_t atom, Value* const new_value, GSE_CALLABLE );
 	void ValidatePrimitivity( GSE_CALLABLE, const std::string& prefix = "" ) const;
 
-	const object_properties_t& value = m_value;
+	const properties_t value = { this };
 
 	Value* const GetRef( const object_key_t& key );
+	Value* const GetRef( const atom_t atom );
 
 	void Unlink();
 
-	void GetReachableObjects( std::unordered_set< gc::Object* >& reachable_objects ) override;
+	void GetReachableObjects( gc::MarkStack& reachable_objects ) override;
 
 	const object_class_t object_class;
 	Wrappable* wrapobj;
@@ -62,7 +118,18 @@ public:
 private:
 	Value* m_this = nullptr;
 
-	object_properties_t m_value = {};
+	const Shape* m_shape = Shape::Empty();
+	Shape* m_dictionary = nullptr; // same as m_shape if object has private shape
+	mutable std::vector< Value* > m_slots = {}; // lazy slots are refreshed on read
+	std::vector< wrapgetter_t* > m_getters = {}; // per slot, empty if object has no lazy properties
+
+	void WrapSet( const object_key_t& key, Value* const new_value, GSE_CALLABLE );
+	const size_t FindSlot( const object_key_t& key ) const;
+	Value* const Read( const size_t slot ) const;
+	// key is interned if possible, otherwise it's owned by dictionary shape
+	void AddProperty( const object_key_t& key, Value* const value );
+	void AddProperty( const atom_t atom, Value* const value, wrapgetter_t* const getter = nullptr );
+	void RemoveProperty( const size_t slot );
 
 };
 
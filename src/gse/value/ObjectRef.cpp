@@ -5,7 +5,7 @@
 namespace gse {
 namespace value {
 
-void ObjectRef::GetReachableObjects( std::unordered_set< gc::Object* >& reachable_objects ) {
+void ObjectRef::GetReachableObjects( gc::MarkStack& reachable_objects ) {
 	Value::GetReachableObjects( reachable_objects );
 
 	GC_DEBUG_BEGIN( "ObjectRef" );
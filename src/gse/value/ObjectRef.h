@@ -2,6 +2,8 @@
 
 #include "gse/Value.h"
 
+#include "Types.h"
+
 namespace gse {
 namespace value {
 
@@ -12,15 +14,26 @@ public:
 
 	static const type_t GetType() { return Value::T_OBJECTREF; }
 
-	ObjectRef( gc::Space* const gc_space, value::Object* object, const std::string& key )
+	ObjectRef( gc::Space* const gc_space, value::Object* object, const atom_t atom )
+		: Value( gc_space, GetType() )
+		, object( object )
+		, atom( atom )
+		, key( *atom ) {}
+	ObjectRef( gc::Space* const gc_space, value::Object* object, const object_key_t& key )
 		: Value( gc_space, GetType() )
 		, object( object )
-		, key( key ) {}
+		, atom( nullptr )
+		, key( m_key )
+		, m_key( key ) {}
 
 	value::Object* object;
-	const std::string key;
+	const atom_t atom; // nullptr if key isn't interned
+	const object_key_t& key;
+
+	void GetReachableObjects( gc::MarkStack& reachable_objects ) override;
 
-	void GetReachableObjects( std::unordered_set< gc::Object* >& reachable_objects ) override;
+private:
+	const object_key_t m_key = ""; // copy of key that isn't interned
 
 };
 
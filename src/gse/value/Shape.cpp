@@ -0,0 +1,254 @@
+#include "Shape.h"
+
+#include <mutex>
+#include <unordered_set>
+#include <algorithm>
+#include <cctype>
+
+#include "common/Assert.h"
+
+namespace gse {
+namespace value {
+
+// up to this size finding slot by comparing atoms is faster than hashing
+static const size_t LINEAR_SEARCH_MAX = 8;
+
+static std::mutex s_atoms_mutex;
+static std::unordered_set< object_key_t > s_atoms = {}; // set nodes never move, so pointers to keys are stable
+
+static std::mutex s_transitions_mutex;
+static size_t s_shared_shapes_count = 0;
+
+static const bool IsName( const object_key_t& key ) {
+	if ( key.empty() || key.size() > Shape::MAX_ATOM_LENGTH || std::isdigit( (unsigned char)key.front() ) ) {
+		return false;
+	}
+	for ( const auto c : key ) {
+		if ( !std::isalnum( (unsigned char)c ) && c != '_' ) {
+			return false;
+		}
+	}
+	return true;
+}
+
+Shape::Shape( const bool is_dictionary )
+	: is_dictionary( is_dictionary ) {}
+
+Shape::~Shape() {
+	delete m_index.load();
+	delete m_order.load();
+	for ( const auto& it : m_transitions ) {
+		delete it.second;
+	}
+}
+
+atom_t Shape::FindAtom( const object_key_t& key ) {
+	std::lock_guard< std::mutex > guard( s_atoms_mutex );
+	const auto it = s_atoms.find( key );
+	return it != s_atoms.end()
+		? &*it
+		: nullptr;
+}
+
+atom_t Shape::Intern( const object_key_t& key ) {
+	std::lock_guard< std::mutex > guard( s_atoms_mutex );
+	return &*s_atoms.insert( key ).first;
+}
+
+atom_t Shape::TryIntern( const object_key_t& key ) {
+	std::lock_guard< std::mutex > guard( s_atoms_mutex );
+	const auto it = s_atoms.find( key );
+	if ( it != s_atoms.end() ) {
+		return &*it;
+	}
+	if ( !IsName( key ) || s_atoms.size() >= MAX_ATOMS ) {
+		return nullptr;
+	}
+	return &*s_atoms.insert( key ).first;
+}
+
+const Shape* Shape::Empty() {
+	static const Shape s_empty( false );
+	return &s_empty;
+}
+
+const Shape* Shape::With( const atom_t atom ) const {
+	ASSERT( !is_dictionary, "dictionary shapes are modified in place" );
+	ASSERT( Find( atom ) == NO_SLOT, "property already exists in shape" );
+
+	// objects of same kind are usually built in same order, so most of time it's same transition as before
+	const auto* last = m_last_transition.load( std::memory_order_acquire );
+	if ( last && last->m_keys.back() == atom ) {
+		return last;
+	}
+
+	std::lock_guard< std::mutex > guard( s_transitions_mutex );
+	const Shape* result;
+	const auto it = m_transitions.find( atom );
+	if ( it != m_transitions.end() ) {
+		result = it->second;
+	}
+	else if ( m_transitions.size() >= MAX_TRANSITIONS || s_shared_shapes_count >= MAX_SHARED_SHAPES ) {
+		return nullptr;
+	}
+	else {
+		s_shared_shapes_count++;
+		auto* shape = new Shape( false );
+		shape->m_keys.reserve( m_keys.size() + 1 );
+		shape->m_keys = m_keys;
+		shape->m_keys.push_back( atom );
+		m_transitions.insert(
+			{
+				atom,
+				shape
+			}
+		);
+		result = shape;
+	}
+	m_last_transition.store( result, std::memory_order_release );
+	return result;
+}
+
+Shape* Shape::CreateDictionary() const {
+	auto* shape = new Shape( true );
+	shape->m_keys = m_keys;
+	shape->m_order.store( new order_t( GetOrder() ) );
+	shape->GetIndex();
+	return shape;
+}
+
+void Shape::Add( const atom_t atom ) {
+	ASSERT( is_dictionary, "only dictionary shapes can be modified" );
+	auto* index = GetIndex();
+	ASSERT( index->find( atom ) == index->end(), "property already exists in shape" );
+	const size_t slot = m_keys.size();
+	m_keys.push_back( atom );
+	index->insert(
+		{
+			atom,
+			slot
+		}
+	);
+	auto* order = m_order.load();
+	order->insert(
+		std::lower_bound(
+			order->begin(), order->end(), atom, [ this ]( const size_t s, const atom_t a ) {
+				return *m_keys.at( s ) < *a;
+			}
+		), slot
+	);
+}
+
+const atom_t Shape::Own( const object_key_t& key ) {
+	ASSERT( is_dictionary, "only dictionary shapes can own keys" );
+	return &*m_own_keys.insert( key ).first;
+}
+
+const size_t Shape::FindOwn( const object_key_t& key ) const {
+	const auto it = m_own_keys.find( key );
+	return it != m_own_keys.end()
+		? Find( &*it )
+		: NO_SLOT;
+}
+
+void Shape::Remove( const size_t slot ) {
+	ASSERT( is_dictionary, "only dictionary shapes can be modified" );
+	ASSERT( slot < m_keys.size(), "slot out of range" );
+	auto* index = GetIndex();
+	auto* order = m_order.load();
+	const size_t last = m_keys.size() - 1;
+	const auto atom = m_keys.at( slot );
+	index->erase( atom );
+	order->erase( std::find( order->begin(), order->end(), slot ) );
+	if ( slot != last ) {
+		m_keys[ slot ] = m_keys.at( last );
+		index->at( m_keys.at( slot ) ) = slot;
+		*std::find( order->begin(), order->end(), last ) = slot;
+	}
+	m_keys.pop_back();
+	if ( !m_own_keys.empty() ) {
+		const auto it = m_own_keys.find( *atom );
+		if ( it != m_own_keys.end() && &*it == atom ) {
+			m_own_keys.erase( it );
+		}
+	}
+}
+
+const size_t Shape::Find( const atom_t atom ) const {
+	if ( !is_dictionary && m_keys.size() <= LINEAR_SEARCH_MAX ) {
+		for ( size_t slot = 0 ; slot < m_keys.size() ; slot++ ) {
+			if ( m_keys[ slot ] == atom ) {
+				return slot;
+			}
+		}
+		return NO_SLOT;
+	}
+	const auto* index = GetIndex();
+	const auto it = index->find( atom );
+	if ( it != index->end() ) {
+		return it->second;
+	}
+	// same key may be owned by dictionary if it was added before it got interned
+	if ( !m_own_keys.empty() ) {
+		const auto own_it = m_own_keys.find( *atom );
+		if ( own_it != m_own_keys.end() && &*own_it != atom ) {
+			return Find( &*own_it );
+		}
+	}
+	return NO_SLOT;
+}
+
+const size_t Shape::GetSize() const {
+	return m_keys.size();
+}
+
+const atom_t Shape::GetKey( const size_t slot ) const {
+	ASSERT( slot < m_keys.size(), "slot out of range" );
+	return m_keys[ slot ];
+}
+
+const Shape::order_t& Shape::GetOrder() const {
+	auto* order = m_order.load( std::memory_order_acquire );
+	if ( !order ) {
+		order = new order_t( m_keys.size() );
+		for ( size_t slot = 0 ; slot < m_keys.size() ; slot++ ) {
+			( *order )[ slot ] = slot;
+		}
+		std::sort(
+			order->begin(), order->end(), [ this ]( const size_t a, const size_t b ) {
+				return *m_keys[ a ] < *m_keys[ b ];
+			}
+		);
+		order_t* expected = nullptr;
+		if ( !m_order.compare_exchange_strong( expected, order, std::memory_order_acq_rel ) ) {
+			delete order;
+			order = expected;
+		}
+	}
+	return *order;
+}
+
+Shape::index_t* Shape::GetIndex() const {
+	auto* index = m_index.load( std::memory_order_acquire );
+	if ( !index ) {
+		index = new index_t();
+		index->reserve( m_keys.size() );
+		for ( size_t slot = 0 ; slot < m_keys.size() ; slot++ ) {
+			index->insert(
+				{
+					m_keys[ slot ],
+					slot
+				}
+			);
+		}
+		index_t* expected = nullptr;
+		if ( !m_index.compare_exchange_strong( expected, index, std::memory_order_acq_rel ) ) {
+			delete index;
+			index = expected;
+		}
+	}
+	return index;
+}
+
+}
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <atomic>
+
+#include "Types.h"
+
+namespace gse {
+namespace value {
+
+// hidden class of object: which properties it has and in which slot each property value is stored
+// shared shapes are immutable, objects that got same properties in same order share same shape,
+// so property access sites can remember slot for shape they saw last time ( see property_cache_t )
+// objects with too many properties, with removed properties, or with keys that aren't interned get private ( dictionary ) shape instead
+class Shape {
+public:
+	static const size_t NO_SLOT = (size_t)-1;
+
+	// keep transition tree small, objects used as dictionaries don't need shared shapes
+	static const size_t MAX_SHARED_SIZE = 64;
+	static const size_t MAX_TRANSITIONS = 64; // per shape
+	static const size_t MAX_SHARED_SHAPES = 65536;
+
+	// atoms are never freed, so keys that come from data rather than from code are interned only while they look like names
+	static const size_t MAX_ATOM_LENGTH = 64;
+	static const size_t MAX_ATOMS = 65536;
+
+	typedef std::vector< size_t > order_t;
+
+	~Shape();
+
+	// returns nullptr if name was never interned ( then no object can have such property )
+	static atom_t FindAtom( const object_key_t& key );
+	// for keys known in advance ( property names in code, names used by engine )
+	static atom_t Intern( const object_key_t& key );
+	// for keys computed at runtime, returns nullptr if key shouldn't be interned ( then object keeps it in its dictionary shape )
+	static atom_t TryIntern( const object_key_t& key );
+
+	// shape without properties, all objects start from it
+	static const Shape* Empty();
+
+	// shape of object after adding property to object of this shape, nullptr if too many shared shapes exist already
+	const Shape* With( const atom_t atom ) const;
+
+	// private modifiable copy, owned by object
+	Shape* CreateDictionary() const;
+
+	// dictionary shapes only, property is appended to slots
+	void Add( const atom_t atom );
+	// dictionary shapes only, stores key that wasn't interned, it's released when its property is removed
+	const atom_t Own( const object_key_t& key );
+	const size_t FindOwn( const object_key_t& key ) const;
+	// dictionary shapes only, last slot is moved into freed slot
+	void Remove( const size_t slot );
+
+	const size_t Find( const atom_t atom ) const;
+	const size_t GetSize() const;
+	const atom_t GetKey( const size_t slot ) const;
+
+	// slots sorted by property names, objects are iterated in this order
+	const order_t& GetOrder() const;
+
+	const bool is_dictionary;
+
+private:
+	Shape( const bool is_dictionary );
+
+	typedef std::unordered_map< atom_t, size_t > index_t;
+
+	std::vector< atom_t > m_keys = {};
+	std::unordered_set< object_key_t > m_own_keys = {}; // dictionary shapes only
+
+	// built on first use, small shapes are scanned linearly instead
+	mutable std::atomic< index_t* > m_index = nullptr;
+	mutable std::atomic< order_t* > m_order = nullptr;
+
+	// guarded by global shapes lock, last one is checked without lock
+	mutable std::unordered_map< atom_t, const Shape* > m_transitions = {};
+	mutable std::atomic< const Shape* > m_last_transition = nullptr;
+
+	index_t* GetIndex() const;
+
+};
+
+}
+}
@@ -13,6 +13,19 @@ namespace value {
 typedef std::string object_key_t; // keep it simple for now
 typedef std::map< object_key_t, Value* > object_properties_t;
 
+// interned property name, equal names always point to same string ( see Shape::Intern )
+// keys that aren't interned are owned by dictionary shape of single object instead ( see Shape::Own )
+typedef const object_key_t* atom_t;
+
+class Shape;
+
+// inline cache of property access site, remembers atom and where property was found last time
+struct property_cache_t {
+	atom_t atom = nullptr;
+	const Shape* shape = nullptr;
+	size_t slot = 0;
+};
+
 typedef std::vector< Value* > array_elements_t;
 
 typedef std::vector< Value* > function_arguments_t;
@@ -16,6 +16,11 @@ public:
 	Undefined( gc::Space* const gc_space, const Undefined& other )
 		: Undefined( gc_space ) {}
 
+	static Undefined* const Shared( gc::Space* const gc_space ) {
+		static Undefined* const s_shared = new Undefined( nullptr );
+		return s_shared;
+	}
+
 };
 
 }
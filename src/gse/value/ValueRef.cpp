@@ -3,7 +3,7 @@
 namespace gse {
 namespace value {
 
-void ValueRef::GetReachableObjects( std::unordered_set< gc::Object* >& reachable_objects ) {
+void ValueRef::GetReachableObjects( gc::MarkStack& reachable_objects ) {
 	Value::GetReachableObjects( reachable_objects );
 
 	GC_DEBUG_BEGIN( "ValueRef" );
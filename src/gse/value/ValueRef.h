@@ -18,7 +18,7 @@ public:
 
 	Value* const target;
 
-	void GetReachableObjects( std::unordered_set< gc::Object* >& reachable_objects ) override;
+	void GetReachableObjects( gc::MarkStack& reachable_objects ) override;
 
 };
 
@@ -5,60 +5,75 @@
 
 #include "util/FS.h"
 #include "types/Sound.h"
+#include "audio/Mixer.h"
 
 namespace loader {
 namespace sound {
 
-SDL2::~SDL2() {
-	for ( auto& sound : m_sounds ) {
-		DELETE( sound.second );
-	}
-}
-
 types::Sound* SDL2::LoadSoundImpl( const std::string& filename ) {
 
-	sound_map_t::iterator it = m_sounds.find( filename );
-	if ( it != m_sounds.end() ) {
-		return it->second;
-	}
-	else {
-
-		Log( "Loading sound \"" + filename + "\"" );
+	Log( "Loading sound \"" + filename + "\"" );
 
-		Uint8* wav_buffer = nullptr; // buffer containing our audio file
-		Uint32 wav_length = 0; // length of our sample
-		SDL_AudioSpec wav_spec; // the specs of our piece of music
+	Uint8* wav_buffer = nullptr; // buffer containing our audio file
+	Uint32 wav_length = 0; // length of our sample
+	SDL_AudioSpec wav_spec; // the specs of our piece of music
 
-		SDL_AudioSpec* ret = nullptr;
+	/* Load the WAV */
+	// the specs, length and buffer of our wav are filled
+	if ( !SDL_LoadWAV( filename.c_str(), &wav_spec, &wav_buffer, &wav_length ) ) {
+		return nullptr;
+	}
 
-		/* Load the WAV */
-		// the specs, length and buffer of our wav are filled
-		ret = SDL_LoadWAV( filename.c_str(), &wav_spec, &wav_buffer, &wav_length );
-		if ( !ret ) {
-			return nullptr;
-		}
+	// convert to native format of mixer once, so that it doesn't need to care about formats
+	SDL_AudioCVT cvt;
+	const auto ret = SDL_BuildAudioCVT( &cvt, wav_spec.format, wav_spec.channels, wav_spec.freq, AUDIO_S16SYS, audio::Mixer::CHANNELS, audio::Mixer::FREQUENCY );
+	if ( ret < 0 ) {
+		Log( "Unsupported format of sound \"" + filename + "\": " + SDL_GetError() );
+		SDL_FreeWAV( wav_buffer );
+		return nullptr;
+	}
 
-		NEWV( sound, types::Sound );
-		sound->m_name = filename;
+	NEWV( sound, types::Sound );
+	sound->m_name = filename;
 
+	if ( ret == 0 ) {
+		// already in native format, keep buffer of SDL instead of copying it
+		sound->m_data = std::shared_ptr< const unsigned char[] >(
+			wav_buffer, []( const unsigned char* data ) {
+				SDL_FreeWAV( (Uint8*)data );
+			}
+		);
 		sound->m_buffer_size = wav_length;
-		sound->m_buffer = (unsigned char*)malloc( sound->m_buffer_size );
-		memcpy( ptr( sound->m_buffer, 0, wav_length ), wav_buffer, wav_length );
-
-		sound->m_spec.channels = wav_spec.channels;
-		sound->m_spec.format = wav_spec.format;
-		sound->m_spec.freq = wav_spec.freq;
-		sound->m_spec.padding = wav_spec.padding;
-		sound->m_spec.samples = wav_spec.samples;
-		sound->m_spec.silence = wav_spec.silence;
-		sound->m_spec.size = wav_spec.size;
-
+	}
+	else {
+		cvt.len = wav_length;
+		cvt.buf = (Uint8*)SDL_malloc( wav_length * cvt.len_mult );
+		memcpy( cvt.buf, wav_buffer, wav_length );
 		SDL_FreeWAV( wav_buffer );
+		if ( SDL_ConvertAudio( &cvt ) < 0 ) {
+			Log( "Failed to convert sound \"" + filename + "\": " + SDL_GetError() );
+			SDL_free( cvt.buf );
+			DELETE( sound );
+			return nullptr;
+		}
+		sound->m_data = std::shared_ptr< const unsigned char[] >(
+			cvt.buf, []( const unsigned char* data ) {
+				SDL_free( (void*)data );
+			}
+		);
+		sound->m_buffer_size = cvt.len_cvt;
+	}
+	sound->m_buffer = sound->m_data.get();
 
-		m_sounds[ filename ] = sound;
+	sound->m_spec.channels = audio::Mixer::CHANNELS;
+	sound->m_spec.format = AUDIO_S16SYS;
+	sound->m_spec.freq = audio::Mixer::FREQUENCY;
+	sound->m_spec.padding = wav_spec.padding;
+	sound->m_spec.samples = wav_spec.samples;
+	sound->m_spec.silence = 0;
+	sound->m_spec.size = sound->m_buffer_size;
 
-		return sound;
-	}
+	return sound;
 }
 
 }
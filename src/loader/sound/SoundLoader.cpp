@@ -1,15 +1,123 @@
 #include "SoundLoader.h"
 
+#include "engine/Engine.h"
+#include "types/Sound.h"
+
 namespace loader {
 namespace sound {
 
+SoundLoader::~SoundLoader() {
+	WaitForPrefetch();
+	for ( auto& it : m_sounds ) {
+		auto* sound = it.second.get();
+		if ( sound ) {
+			DELETE( sound );
+		}
+	}
+}
+
+void SoundLoader::Stop() {
+	// thread pool is stopped after modules
+	WaitForPrefetch();
+}
+
 types::Sound* SoundLoader::LoadSound( const resource::resource_t res ) {
-	return LoadSoundImpl( GetPath( res ) );
+	return Get( GetPath( res ) );
 }
 
 types::Sound* SoundLoader::LoadCustomSound( const std::string& filename ) {
-	return LoadSoundImpl( GetCustomFilename( filename ) );
+	return Get( GetCustomFilename( filename ) );
 }
 
+void SoundLoader::PrefetchCustomSound( const std::string& filename ) {
+	const auto& path = GetCustomFilename( filename );
+
+	std::lock_guard prefetch_guard( m_prefetch_mutex );
+	if ( m_is_prefetch_stopped ) {
+		return;
+	}
+
+	auto promise = std::make_shared< std::promise< types::Sound* > >();
+	{
+		std::lock_guard guard( m_sounds_mutex );
+		if ( m_sounds.find( path ) != m_sounds.end() ) {
+			return; // already loaded or being loaded
+		}
+		m_sounds.insert(
+			{
+				path,
+				promise->get_future().share()
+			}
+		);
+	}
+
+	if ( !m_prefetch ) {
+		m_prefetch = new common::ThreadPool::TaskGroup( g_engine->GetThreadPool(), m_prefetch_canceled );
+	}
+	m_prefetch->Run(
+		[ this, path, promise ]() {
+			try {
+				Load( path, *promise );
+			}
+			catch ( const std::exception& e ) {
+				// sound will be loaded again when it's needed, then error reaches whoever needs it
+				Log( "Failed to prefetch " + path + ": " + e.what() );
+			}
+		}
+	);
+}
+
+types::Sound* SoundLoader::Get( const std::string& path ) {
+	std::shared_future< types::Sound* > future;
+	std::promise< types::Sound* > promise;
+	{
+		std::lock_guard guard( m_sounds_mutex );
+		const auto it = m_sounds.find( path );
+		if ( it != m_sounds.end() ) {
+			future = it->second;
+		}
+		else {
+			m_sounds.insert(
+				{
+					path,
+					promise.get_future().share()
+				}
+			);
+		}
+	}
+	if ( future.valid() ) {
+		// waits if sound is being prefetched right now
+		return future.get();
+	}
+	return Load( path, promise );
+}
+
+types::Sound* SoundLoader::Load( const std::string& path, std::promise< types::Sound* >& promise ) {
+	try {
+		auto* const sound = LoadSoundImpl( path );
+		promise.set_value( sound );
+		return sound;
+	}
+	catch ( ... ) {
+		// don't leave broken promise behind, current waiters get nullptr and next Get() tries again
+		{
+			std::lock_guard guard( m_sounds_mutex );
+			m_sounds.erase( path );
+		}
+		promise.set_value( nullptr );
+		throw;
+	}
+}
+
+void SoundLoader::WaitForPrefetch() {
+	std::lock_guard guard( m_prefetch_mutex );
+	m_is_prefetch_stopped = true;
+	if ( m_prefetch ) {
+		m_prefetch->Wait();
+		delete m_prefetch;
+		m_prefetch = nullptr;
+	}
+}
+
+}
 }
-}
\ No newline at end of file
@@ -1,9 +1,14 @@
 #pragma once
 
 #include <string>
+#include <unordered_map>
+#include <future>
+#include <mutex>
 
 #include "loader/Loader.h"
 
+#include "common/ThreadPool.h"
+
 namespace types {
 class Sound;
 }
@@ -11,13 +16,40 @@ class Sound;
 namespace loader {
 namespace sound {
 
+/**
+ * Every sound is decoded ( and converted to native format of audio::Mixer ) only once, then cached until shutdown.
+ *   sounds can be prefetched in background, loading prefetched sound waits for it instead of loading it again
+ *   returns nullptr if sound can't be loaded
+ */
 CLASS( SoundLoader, Loader )
 
+	virtual ~SoundLoader();
+
+	void Stop() override;
+
 	types::Sound* LoadSound( const resource::resource_t res );
 	types::Sound* LoadCustomSound( const std::string& filename );
 
+	// may be called from any thread
+	void PrefetchCustomSound( const std::string& filename );
+
 protected:
+	// called once per file, possibly from worker thread
 	virtual types::Sound* LoadSoundImpl( const std::string& filename ) = 0;
+
+private:
+	std::mutex m_sounds_mutex;
+	std::unordered_map< std::string, std::shared_future< types::Sound* > > m_sounds = {};
+
+	std::mutex m_prefetch_mutex;
+	bool m_is_prefetch_stopped = false;
+	common::mt_flag_t m_prefetch_canceled = false; // never set, every started prefetch must finish
+	common::ThreadPool::TaskGroup* m_prefetch = nullptr;
+
+	types::Sound* Get( const std::string& path );
+	types::Sound* Load( const std::string& path, std::promise< types::Sound* >& promise );
+	void WaitForPrefetch();
+
 };
 
 }
@@ -0,0 +1,234 @@
+#include "Async.h"
+
+#include <chrono>
+#include <algorithm>
+
+namespace logger {
+
+static std::atomic< size_t > s_next_id = 1;
+
+// for FlushAll()
+static std::mutex s_instances_mutex;
+static std::vector< Async* > s_instances = {};
+// set while current thread is draining, to not deadlock if something fails inside Drain()
+static thread_local bool t_is_draining = false;
+
+void FlushAll() {
+	if ( t_is_draining ) {
+		return;
+	}
+	std::lock_guard guard( s_instances_mutex );
+	for ( const auto& instance : s_instances ) {
+		instance->Flush();
+	}
+}
+
+// rings of current thread ( per Async ), they stay alive in Async after thread exits until writer drains them
+struct thread_rings_t {
+	std::vector< std::pair< size_t, std::shared_ptr< Async::Ring > > > rings = {};
+	~thread_rings_t() {
+		for ( const auto& it : rings ) {
+			it.second->m_is_abandoned = true;
+		}
+	}
+};
+static thread_local thread_rings_t t_rings = {};
+
+Async::Ring::Ring()
+	: m_records( RING_SIZE ) {
+	//
+}
+
+Async::Async( const std::vector< Logger* >& targets, const bool is_bounded )
+	: m_id( s_next_id++ )
+	, m_targets( targets )
+	, m_is_bounded( is_bounded ) {
+	m_writer = std::thread(
+		[ this ]() {
+			WriterLoop();
+		}
+	);
+	std::lock_guard guard( s_instances_mutex );
+	s_instances.push_back( this );
+}
+
+Async::~Async() {
+	{
+		std::lock_guard guard( s_instances_mutex );
+		s_instances.erase( std::find( s_instances.begin(), s_instances.end(), this ) );
+	}
+	m_is_running = false;
+	m_wake_cv.notify_one();
+	m_writer.join();
+	Drain();
+	{
+		// let logging threads release their rings
+		std::lock_guard guard( m_rings_mutex );
+		for ( const auto& ring : m_rings ) {
+			ring->m_is_abandoned = true;
+		}
+	}
+	for ( const auto& target : m_targets ) {
+		delete target;
+	}
+}
+
+void Async::Log( const std::string& text ) {
+	Push(
+		{
+			LL_INFO,
+			(uint64_t)std::chrono::high_resolution_clock::now().time_since_epoch().count(),
+			"",
+			text
+		}
+	);
+}
+
+void Async::Log( const record_t& record ) {
+	Push( record_t( record ) );
+}
+
+void Async::Flush() {
+	Drain();
+}
+
+const size_t Async::GetDroppedCount() const {
+	return m_dropped_count;
+}
+
+Async::Ring* Async::GetRing() {
+	for ( const auto& it : t_rings.rings ) {
+		if ( it.first == m_id ) {
+			return it.second.get();
+		}
+	}
+	t_rings.rings.erase(
+		std::remove_if(
+			t_rings.rings.begin(), t_rings.rings.end(), []( const std::pair< size_t, std::shared_ptr< Ring > >& it ) {
+				return it.second->m_is_abandoned.load();
+			}
+		), t_rings.rings.end()
+	);
+	const auto ring = std::make_shared< Ring >();
+	t_rings.rings.push_back(
+		{
+			m_id,
+			ring
+		}
+	);
+	std::lock_guard guard( m_rings_mutex );
+	m_rings.push_back( ring );
+	return ring.get();
+}
+
+void Async::Push( record_t&& record ) {
+	auto* ring = GetRing();
+	const auto tail = ring->m_tail.load( std::memory_order_relaxed );
+	size_t used = tail - ring->m_head.load( std::memory_order_acquire );
+	if ( used >= RING_SIZE ) {
+		if ( m_is_bounded ) {
+			m_dropped_count++;
+			return;
+		}
+		do {
+			m_wake_cv.notify_one();
+			std::this_thread::yield();
+			used = tail - ring->m_head.load( std::memory_order_acquire );
+		}
+		while ( used >= RING_SIZE );
+	}
+	if ( m_is_bounded && record.text.size() > BOUNDED_TEXT_MAX ) {
+		record.text.resize( BOUNDED_TEXT_MAX );
+		record.text += "...";
+	}
+	ring->m_records[ tail % RING_SIZE ] = std::move( record );
+	ring->m_tail.store( tail + 1, std::memory_order_release );
+	if ( used + 1 == RING_SIZE / 2 ) {
+		// wake writer early instead of waiting for next tick
+		m_wake_cv.notify_one();
+	}
+}
+
+void Async::Drain() {
+	std::lock_guard drain_guard( m_drain_mutex );
+	struct draining_t {
+		draining_t() {
+			t_is_draining = true;
+		}
+		~draining_t() {
+			t_is_draining = false;
+		}
+	} draining;
+
+	std::vector< std::shared_ptr< Ring > > rings = {};
+	{
+		std::lock_guard guard( m_rings_mutex );
+		rings = m_rings;
+	}
+
+	for ( const auto& ring : rings ) {
+		auto head = ring->m_head.load( std::memory_order_relaxed );
+		const auto tail = ring->m_tail.load( std::memory_order_acquire );
+		while ( head != tail ) {
+			m_batch.push_back( std::move( ring->m_records[ head % RING_SIZE ] ) );
+			head++;
+		}
+		ring->m_head.store( head, std::memory_order_release );
+	}
+
+	const size_t dropped = m_dropped_count;
+	if ( dropped != m_dropped_reported ) {
+		m_batch.push_back(
+			{
+				LL_WARNING,
+				(uint64_t)std::chrono::high_resolution_clock::now().time_since_epoch().count(),
+				GetName(),
+				std::to_string( dropped - m_dropped_reported ) + " message(s) dropped because log buffer was full"
+			}
+		);
+		m_dropped_reported = dropped;
+	}
+
+	if ( !m_batch.empty() ) {
+		// rings are drained one by one, restore order between threads
+		std::stable_sort(
+			m_batch.begin(), m_batch.end(), []( const record_t& a, const record_t& b ) {
+				return a.time < b.time;
+			}
+		);
+		for ( const auto& record : m_batch ) {
+			const auto text = Format( record );
+			for ( const auto& target : m_targets ) {
+				target->Log( text );
+			}
+		}
+		m_batch.clear();
+		for ( const auto& target : m_targets ) {
+			target->Flush();
+		}
+	}
+
+	{
+		// forget rings of exited threads once they are empty
+		std::lock_guard guard( m_rings_mutex );
+		m_rings.erase(
+			std::remove_if(
+				m_rings.begin(), m_rings.end(), []( const std::shared_ptr< Ring >& ring ) {
+					return ring->m_is_abandoned && ring->m_head == ring->m_tail;
+				}
+			), m_rings.end()
+		);
+	}
+}
+
+void Async::WriterLoop() {
+	while ( m_is_running ) {
+		{
+			std::unique_lock lock( m_wake_mutex );
+			m_wake_cv.wait_for( lock, std::chrono::milliseconds( 10 ) );
+		}
+		Drain();
+	}
+}
+
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+#include "Logger.h"
+
+namespace logger {
+
+/**
+ * Moves formatting and output of logs out of logging threads.
+ *   every logging thread gets own single-producer ring of records, pushing to it takes no locks
+ *   writer thread drains all rings in batches ( ordered by time ), passes formatted lines to targets and flushes them once per batch
+ *   when ring is full, logging thread waits for writer, or drops message if bounded ( messages are also truncated then )
+ */
+CLASS( Async, Logger )
+
+	static constexpr size_t RING_SIZE = 1024;
+	static constexpr size_t BOUNDED_TEXT_MAX = 1024;
+
+	// takes ownership of targets
+	Async( const std::vector< Logger* >& targets, const bool is_bounded );
+	~Async();
+
+	void Log( const std::string& text ) override;
+	void Log( const record_t& record ) override;
+	// writes everything that was logged so far
+	void Flush() override;
+
+	const size_t GetDroppedCount() const;
+
+	// one per logging thread per Async
+	class Ring {
+	public:
+		Ring();
+		std::vector< record_t > m_records;
+		std::atomic< size_t > m_head = 0; // next to read, changed only by writer
+		std::atomic< size_t > m_tail = 0; // next to write, changed only by owning thread
+		std::atomic< bool > m_is_abandoned = false; // owning thread or Async is gone
+	};
+
+private:
+
+	const size_t m_id;
+	const std::vector< Logger* > m_targets;
+	const bool m_is_bounded;
+
+	std::mutex m_rings_mutex;
+	std::vector< std::shared_ptr< Ring > > m_rings = {};
+
+	std::atomic< bool > m_is_running = true;
+	std::atomic< size_t > m_dropped_count = 0;
+	size_t m_dropped_reported = 0;
+	std::mutex m_wake_mutex;
+	std::condition_variable m_wake_cv;
+
+	std::mutex m_drain_mutex;
+	std::vector< record_t > m_batch = {};
+
+	std::thread m_writer;
+
+	Ring* GetRing();
+	void Push( record_t&& record );
+	void Drain();
+	void WriterLoop();
+
+};
+
+}
@@ -0,0 +1,48 @@
+#include "Logger.h"
+
+namespace logger {
+
+std::atomic< level_t > g_level = LL_DEBUG;
+
+#ifdef DEBUG
+static std::atomic< uint64_t > s_last_time = 0;
+#endif
+
+void Logger::Log( const record_t& record ) {
+	Log( Format( record ) );
+}
+
+const std::string Logger::Format( const record_t& record ) {
+	std::string result = "";
+	result.reserve( record.source.size() + record.text.size() + 32 );
+#ifdef DEBUG
+	const auto last_time = s_last_time.exchange( record.time );
+	const auto duration = last_time && record.time > last_time
+		? record.time - last_time
+		: 0;
+	result += "[+" + std::to_string( duration ) + "ns] ";
+#endif
+	if ( !record.source.empty() ) {
+		result += "<" + record.source + "> ";
+	}
+	switch ( record.level ) {
+		case LL_DEBUG: {
+			result += "DEBUG: ";
+			break;
+		}
+		case LL_WARNING: {
+			result += "WARNING: ";
+			break;
+		}
+		case LL_ERROR: {
+			result += "ERROR: ";
+			break;
+		}
+		default: {
+		}
+	}
+	result += record.text;
+	return result;
+}
+
+}
@@ -4,10 +4,18 @@
 
 #include "common/Module.h"
 
+#include "Types.h"
+
 namespace logger {
 
 CLASS( Logger, common::Module )
 	virtual void Log( const std::string& text ) = 0;
+	// formats and logs immediately by default
+	virtual void Log( const record_t& record );
+	// loggers may buffer output until this is called
+	virtual void Flush() {}
+
+	static const std::string Format( const record_t& record );
 };
 
 }
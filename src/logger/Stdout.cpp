@@ -6,14 +6,21 @@ namespace logger {
 
 std::atomic< bool > g_is_muted = false;
 
+Stdout::Stdout( const bool is_buffered )
+	: m_is_buffered( is_buffered ) {}
+
 void Stdout::Log( const std::string& text ) {
 	if ( !g_is_muted ) {
 #ifdef DEBUG
 		g_debug_stats._mutex.lock();
 		if ( !g_debug_stats._readonly ) { // don't spam from debug overlay
 #endif
-			util::LogHelper::Println( text );
-			util::LogHelper::Flush();
+			if ( m_is_buffered ) {
+				util::LogHelper::Print( text + '\n' );
+			}
+			else {
+				util::LogHelper::Println( text );
+			}
 #ifdef DEBUG
 		}
 		g_debug_stats._mutex.unlock();
@@ -21,4 +28,8 @@ void Stdout::Log( const std::string& text ) {
 	}
 }
 
+void Stdout::Flush() {
+	util::LogHelper::Flush();
+}
+
 }
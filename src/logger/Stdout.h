@@ -11,7 +11,14 @@ extern std::atomic< bool > g_is_muted;
 
 CLASS( Stdout, Logger )
 
+	// buffered output is written only on Flush()
+	Stdout( const bool is_buffered = false );
+
 	void Log( const std::string& text ) override;
+	void Flush() override;
+
+private:
+	const bool m_is_buffered;
 
 };
 
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <atomic>
+
+namespace logger {
+
+enum level_t : uint8_t {
+	LL_DEBUG,
+	LL_INFO,
+	LL_WARNING,
+	LL_ERROR,
+};
+
+// messages below this level are removed at compile time ( only if logged with LOG_AT )
+#ifndef GLSMAC_LOG_LEVEL
+#if defined( DEBUG ) || defined( FASTDEBUG )
+#define GLSMAC_LOG_LEVEL logger::LL_DEBUG
+#else
+#define GLSMAC_LOG_LEVEL logger::LL_INFO
+#endif
+#endif
+
+// messages below this level are skipped at runtime, set from --log-level
+extern std::atomic< level_t > g_level;
+
+// unformatted message, text is built by logger ( possibly in other thread )
+struct record_t {
+	level_t level;
+	uint64_t time; // nanoseconds
+	std::string source;
+	std::string text;
+};
+
+}
@@ -22,6 +22,7 @@
 #if defined( DEBUG ) || defined( FASTDEBUG )
 
 #include "logger/Stdout.h"
+#include "logger/Async.h"
 #include "graphics/Null.h"
 #include "loader/font/Null.h"
 #include "loader/texture/Null.h"
@@ -51,6 +52,7 @@
 
 #include "task/gseprompt/GSEPrompt.h"
 #include "task/gsetests/GSETests.h"
+#include "task/benchmarks/Benchmarks.h"
 
 #endif
 
@@ -155,9 +157,16 @@ int main( const int argc, const char* argv[] ) {
 	std::vector< logger::Logger* > loggers = {};
 
 #if defined( DEBUG ) || defined( FASTDEBUG )
+	logger::g_level = config.GetLogLevel();
 	if ( !config.HasDebugFlag( config::Config::DF_QUIET ) ) {
-		loggers.push_back( new logger::Stdout() );
+		if ( config.HasDebugFlag( config::Config::DF_LOG_SYNC ) ) {
+			loggers.push_back( new logger::Stdout() );
+		}
+		else {
+			loggers.push_back( new logger::Async( { new logger::Stdout( true ) }, config.HasDebugFlag( config::Config::DF_LOG_BOUNDED ) ) );
+		}
 	}
+	// console ui is not thread-safe, it's fed from logging threads as before
 	if ( legacy_ui ) {
 		loggers.push_back( new logger::Console() );
 	}
@@ -194,6 +203,10 @@ int main( const int argc, const char* argv[] ) {
 			NEWV( task, task::gsetests::GSETests );
 			scheduler.AddTask( task );
 		}
+		else if ( config.HasDebugFlag( config::Config::DF_BENCHMARKS ) ) {
+			NEWV( task, task::benchmarks::Benchmarks );
+			scheduler.AddTask( task );
+		}
 		else if ( config.HasDebugFlag( config::Config::DF_GSE_PROMPT_JS ) ) {
 			NEWV( task, task::gseprompt::GSEPrompt, "js" );
 			scheduler.AddTask( task );
@@ -149,6 +149,11 @@ void Network::DestroyResponse( const MT_Response& response ) {
 
 }
 
+void Network::OnRequestQueued() {
+	// don't let request wait until network thread wakes up by itself
+	m_impl.Wake();
+}
+
 void Network::AddEvent( const Event& event ) {
 	m_events_out.push_back( event );
 }
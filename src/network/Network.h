@@ -5,6 +5,7 @@
 #include "Types.h"
 
 #include "Event.h"
+#include "RingBuffer.h"
 
 namespace types {
 class Packet;
@@ -56,13 +57,10 @@ protected:
 		std::string remote_address = "";
 		fd_t fd = 0;
 		cid_t cid = 0;
-		struct {
-			char* data1 = nullptr;
-			char* data2 = nullptr;
-			char* data = nullptr;
-			char* ptr = nullptr;
-			size_t len = 0;
-		} buffer = {};
+		RingBuffer in = {};
+		RingBuffer out = {};
+		bool want_write = false; // unsent data is waiting for socket to become writable
+		bool flush_queued = false;
 		time_t last_data_at = 0;
 		bool ping_needed = false;
 		bool ping_sent = false;
@@ -75,7 +73,6 @@ protected:
 		std::unordered_map< cid_t, fd_t > cid_to_fd = {};
 		cid_t next_cid = 1; // 0 is reserved for server
 		struct {
-			void* client_addr = nullptr;
 			fd_t newfd = 0;
 			std::vector< int > to_remove = {};
 		} tmp = {};
@@ -102,6 +99,28 @@ protected:
 		int Receive( const fd_t fd, void* buf, const int len ) const;
 		int Send( const fd_t fd, const void* buf, const int len ) const;
 		void CloseSocket( const fd_t fd ) const;
+
+		// scatter/gather versions
+		int ReceiveV( const fd_t fd, const RingBuffer::segment_t* segments, const uint8_t count ) const;
+		int SendV( const fd_t fd, const RingBuffer::segment_t* segments, const uint8_t count ) const;
+
+		// only watched sockets are reported by Wait()
+		void WatchSocket( const fd_t fd );
+		void UnwatchSocket( const fd_t fd );
+		// also report socket when it becomes writable
+		void SetWantWrite( const fd_t fd, const bool want_write );
+		// blocks until some watched sockets are ready, Wake() is called or timeout expires
+		// fills ready_fds with sockets that may be read from ( or written to )
+		void Wait( const int timeout_ms, std::vector< fd_t >& ready_fds );
+		// interrupts Wait(), can be called from any thread
+		void Wake();
+
+	private:
+		// platform-specific readiness notification ( epoll on linux )
+		struct poller_t;
+		poller_t* m_poller = nullptr;
+		void CreatePoller();
+		void DestroyPoller();
 	};
 
 	Impl m_impl = {};
@@ -116,6 +135,7 @@ protected:
 	const MT_Response ProcessRequest( const MT_Request& request, MT_CANCELABLE ) override;
 	void DestroyRequest( const MT_Request& request ) override;
 	void DestroyResponse( const MT_Response& response ) override;
+	void OnRequestQueued() override;
 
 	const MT_Response Error( const std::string& errmsg = "" ) const;
 	const MT_Response Success() const;
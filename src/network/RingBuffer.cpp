@@ -0,0 +1,181 @@
+#include "RingBuffer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <cstdlib>
+
+namespace network {
+
+RingBuffer::RingBuffer() {
+	//
+}
+
+RingBuffer::~RingBuffer() {
+	if ( m_data ) {
+		free( m_data );
+	}
+}
+
+RingBuffer::RingBuffer( RingBuffer&& other ) noexcept
+	: m_data( other.m_data )
+	, m_capacity( other.m_capacity )
+	, m_read_pos( other.m_read_pos )
+	, m_size( other.m_size ) {
+	other.m_data = nullptr;
+	other.m_capacity = 0;
+	other.m_read_pos = 0;
+	other.m_size = 0;
+}
+
+RingBuffer& RingBuffer::operator=( RingBuffer&& other ) noexcept {
+	if ( this != &other ) {
+		if ( m_data ) {
+			free( m_data );
+		}
+		m_data = other.m_data;
+		m_capacity = other.m_capacity;
+		m_read_pos = other.m_read_pos;
+		m_size = other.m_size;
+		other.m_data = nullptr;
+		other.m_capacity = 0;
+		other.m_read_pos = 0;
+		other.m_size = 0;
+	}
+	return *this;
+}
+
+const size_t RingBuffer::GetSize() const {
+	return m_size;
+}
+
+const size_t RingBuffer::GetFree() const {
+	return m_capacity - m_size;
+}
+
+const bool RingBuffer::IsEmpty() const {
+	return m_size == 0;
+}
+
+void RingBuffer::Reserve( const size_t free_size ) {
+	if ( GetFree() < free_size ) {
+		Grow( m_size + free_size );
+	}
+}
+
+const uint8_t RingBuffer::GetReadSegments( segment_t segments[ 2 ] ) const {
+	if ( !m_size ) {
+		return 0;
+	}
+	const size_t first = std::min( m_size, m_capacity - m_read_pos );
+	segments[ 0 ] = {
+		m_data + m_read_pos,
+		first
+	};
+	if ( first == m_size ) {
+		return 1;
+	}
+	segments[ 1 ] = {
+		m_data,
+		m_size - first
+	};
+	return 2;
+}
+
+const uint8_t RingBuffer::GetWriteSegments( segment_t segments[ 2 ] ) {
+	const size_t free_size = GetFree();
+	if ( !free_size ) {
+		return 0;
+	}
+	const size_t write_pos = ( m_read_pos + m_size ) & ( m_capacity - 1 );
+	const size_t first = std::min( free_size, m_capacity - write_pos );
+	segments[ 0 ] = {
+		m_data + write_pos,
+		first
+	};
+	if ( first == free_size ) {
+		return 1;
+	}
+	segments[ 1 ] = {
+		m_data,
+		free_size - first
+	};
+	return 2;
+}
+
+void RingBuffer::Produce( const size_t size ) {
+	ASSERT( size <= GetFree(), "ring buffer overflow" );
+	m_size += size;
+}
+
+void RingBuffer::Consume( const size_t size ) {
+	ASSERT( size <= m_size, "ring buffer underflow" );
+	m_size -= size;
+	if ( m_size ) {
+		m_read_pos = ( m_read_pos + size ) & ( m_capacity - 1 );
+	}
+	else {
+		// start from beginning so that next data is less likely to wrap
+		m_read_pos = 0;
+	}
+}
+
+void RingBuffer::Append( const void* data, const size_t size ) {
+	Reserve( size );
+	segment_t segments[ 2 ];
+	const auto count = GetWriteSegments( segments );
+	const size_t first = std::min( size, segments[ 0 ].size );
+	memcpy( segments[ 0 ].data, data, first );
+	if ( first < size ) {
+		ASSERT( count == 2, "ring buffer free space mismatch" );
+		memcpy( segments[ 1 ].data, (const char*)data + first, size - first );
+	}
+	m_size += size;
+}
+
+void RingBuffer::Peek( void* dst, const size_t offset, const size_t size ) const {
+	ASSERT( offset + size <= m_size, "ring buffer peek out of range" );
+	const size_t pos = ( m_read_pos + offset ) & ( m_capacity - 1 );
+	const size_t first = std::min( size, m_capacity - pos );
+	memcpy( dst, m_data + pos, first );
+	if ( first < size ) {
+		memcpy( (char*)dst + first, m_data, size - first );
+	}
+}
+
+const char* RingBuffer::GetContiguous( const size_t offset, const size_t size ) const {
+	ASSERT( offset + size <= m_size, "ring buffer access out of range" );
+	const size_t pos = ( m_read_pos + offset ) & ( m_capacity - 1 );
+	if ( pos + size > m_capacity ) {
+		return nullptr;
+	}
+	return m_data + pos;
+}
+
+void RingBuffer::Clear() {
+	m_read_pos = 0;
+	m_size = 0;
+}
+
+void RingBuffer::Grow( const size_t min_capacity ) {
+	size_t capacity = m_capacity
+		? m_capacity
+		: MIN_CAPACITY;
+	while ( capacity < min_capacity ) {
+		capacity *= 2;
+	}
+	if ( capacity == m_capacity ) {
+		return;
+	}
+	char* data = (char*)malloc( capacity );
+	if ( m_size ) {
+		Peek( data, 0, m_size );
+	}
+	if ( m_data ) {
+		free( m_data );
+	}
+	m_data = data;
+	m_capacity = capacity;
+	m_read_pos = 0;
+}
+
+}
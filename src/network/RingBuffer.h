@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "common/Common.h"
+
+namespace network {
+
+/**
+ * Byte queue for socket io.
+ *   capacity is power of two and grows when needed, data is never compacted
+ *   free and used space are exposed as up to two contiguous segments, to be filled and drained with scatter/gather io
+ */
+CLASS( RingBuffer, common::Class )
+
+	struct segment_t {
+		char* data;
+		size_t size;
+	};
+
+	RingBuffer();
+	~RingBuffer();
+
+	RingBuffer( RingBuffer&& other ) noexcept;
+	RingBuffer& operator=( RingBuffer&& other ) noexcept;
+	RingBuffer( const RingBuffer& other ) = delete;
+	RingBuffer& operator=( const RingBuffer& other ) = delete;
+
+	const size_t GetSize() const;
+	const size_t GetFree() const;
+	const bool IsEmpty() const;
+
+	// make sure at least this many bytes can be written without growing
+	void Reserve( const size_t free_size );
+
+	// used space, returns number of segments ( 0-2 )
+	const uint8_t GetReadSegments( segment_t segments[ 2 ] ) const;
+	// free space, returns number of segments ( 0-2 )
+	const uint8_t GetWriteSegments( segment_t segments[ 2 ] );
+
+	// mark bytes written into write segments as used
+	void Produce( const size_t size );
+	// drop bytes from beginning
+	void Consume( const size_t size );
+
+	// copies data to the end, grows if needed
+	void Append( const void* data, const size_t size );
+
+	// copies size bytes starting at offset from beginning
+	void Peek( void* dst, const size_t offset, const size_t size ) const;
+
+	// pointer to size bytes starting at offset if they don't wrap around, nullptr otherwise
+	const char* GetContiguous( const size_t offset, const size_t size ) const;
+
+	// forgets data but keeps memory
+	void Clear();
+
+private:
+	static constexpr size_t MIN_CAPACITY = 4096;
+
+	char* m_data = nullptr;
+	size_t m_capacity = 0;
+	size_t m_read_pos = 0;
+	size_t m_size = 0;
+
+	void Grow( const size_t min_capacity );
+
+};
+
+}
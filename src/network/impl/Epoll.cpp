@@ -0,0 +1,106 @@
+#include "network/Network.h"
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <cerrno>
+
+namespace network {
+
+struct Network::Impl::poller_t {
+	int epoll_fd;
+	int wake_fd;
+	std::vector< struct epoll_event > events;
+};
+
+void Network::Impl::CreatePoller() {
+	ASSERT( !m_poller, "poller already created" );
+	const int epoll_fd = epoll_create1( EPOLL_CLOEXEC );
+	if ( epoll_fd == -1 ) {
+		THROW( "epoll_create1 failed: " + GetErrorMessage( GetLastErrorCode() ) );
+	}
+	const int wake_fd = eventfd( 0, EFD_NONBLOCK | EFD_CLOEXEC );
+	if ( wake_fd == -1 ) {
+		close( epoll_fd );
+		THROW( "eventfd failed: " + GetErrorMessage( GetLastErrorCode() ) );
+	}
+	struct epoll_event ev = {};
+	ev.events = EPOLLIN;
+	ev.data.fd = wake_fd;
+	epoll_ctl( epoll_fd, EPOLL_CTL_ADD, wake_fd, &ev );
+	m_poller = new poller_t{
+		epoll_fd,
+		wake_fd,
+		std::vector< struct epoll_event >( 64 ),
+	};
+}
+
+void Network::Impl::DestroyPoller() {
+	if ( m_poller ) {
+		close( m_poller->wake_fd );
+		close( m_poller->epoll_fd );
+		delete m_poller;
+		m_poller = nullptr;
+	}
+}
+
+void Network::Impl::WatchSocket( const fd_t fd ) {
+	struct epoll_event ev = {};
+	ev.events = EPOLLIN;
+	ev.data.fd = fd;
+	if ( epoll_ctl( m_poller->epoll_fd, EPOLL_CTL_ADD, fd, &ev ) == -1 ) {
+		THROW( "failed to watch socket " + std::to_string( fd ) + ": " + GetErrorMessage( GetLastErrorCode() ) );
+	}
+}
+
+void Network::Impl::UnwatchSocket( const fd_t fd ) {
+	// may be not watched ( i.e. if it failed to bind ), that's fine
+	epoll_ctl( m_poller->epoll_fd, EPOLL_CTL_DEL, fd, nullptr );
+}
+
+void Network::Impl::SetWantWrite( const fd_t fd, const bool want_write ) {
+	struct epoll_event ev = {};
+	ev.events = want_write
+		? EPOLLIN | EPOLLOUT
+		: EPOLLIN;
+	ev.data.fd = fd;
+	epoll_ctl( m_poller->epoll_fd, EPOLL_CTL_MOD, fd, &ev );
+}
+
+void Network::Impl::Wait( const int timeout_ms, std::vector< fd_t >& ready_fds ) {
+	ready_fds.clear();
+	auto& events = m_poller->events;
+	const int count = epoll_wait( m_poller->epoll_fd, events.data(), events.size(), timeout_ms );
+	if ( count <= 0 ) {
+		return; // timeout or interrupted by signal
+	}
+	for ( int i = 0 ; i < count ; i++ ) {
+		const int fd = events[ i ].data.fd;
+		if ( fd == m_poller->wake_fd ) {
+			uint64_t value;
+			while ( read( m_poller->wake_fd, &value, sizeof( value ) ) > 0 ) {}
+		}
+		else {
+			// errors and hangups are reported as readable, subsequent read will fail
+			ready_fds.push_back( fd );
+		}
+	}
+	if ( (size_t)count == events.size() ) {
+		// there may be more, get them all at once next time
+		events.resize( events.size() * 2 );
+	}
+}
+
+void Network::Impl::Wake() {
+	const uint64_t value = 1;
+	while ( write( m_poller->wake_fd, &value, sizeof( value ) ) == -1 ) {
+		if ( errno == EAGAIN ) {
+			break; // counter is full, so poller is already woken
+		}
+		if ( errno != EINTR ) {
+			THROW( "failed to wake poller: " + GetErrorMessage( GetLastErrorCode() ) );
+		}
+	}
+}
+
+}
@@ -0,0 +1,72 @@
+#include "network/Network.h"
+
+#include <algorithm>
+#include <mutex>
+#include <condition_variable>
+
+// used on platforms without epoll
+// sockets are not really watched, all of them are reported as ready and caller gets EAGAIN from those that aren't
+
+namespace network {
+
+// how often sockets are polled while there are any
+#define POLL_INTERVAL_MS 1
+
+struct Network::Impl::poller_t {
+	std::mutex mutex;
+	std::condition_variable cv;
+	bool is_woken;
+	std::vector< fd_t > fds;
+};
+
+void Network::Impl::CreatePoller() {
+	ASSERT( !m_poller, "poller already created" );
+	m_poller = new poller_t();
+	m_poller->is_woken = false;
+}
+
+void Network::Impl::DestroyPoller() {
+	if ( m_poller ) {
+		delete m_poller;
+		m_poller = nullptr;
+	}
+}
+
+void Network::Impl::WatchSocket( const fd_t fd ) {
+	std::lock_guard guard( m_poller->mutex );
+	m_poller->fds.push_back( fd );
+}
+
+void Network::Impl::UnwatchSocket( const fd_t fd ) {
+	std::lock_guard guard( m_poller->mutex );
+	auto& fds = m_poller->fds;
+	fds.erase( std::remove( fds.begin(), fds.end(), fd ), fds.end() );
+}
+
+void Network::Impl::SetWantWrite( const fd_t fd, const bool want_write ) {
+	// every socket is reported anyway
+}
+
+void Network::Impl::Wait( const int timeout_ms, std::vector< fd_t >& ready_fds ) {
+	std::unique_lock lock( m_poller->mutex );
+	const int wait_ms = m_poller->fds.empty()
+		? timeout_ms
+		: std::min( timeout_ms, POLL_INTERVAL_MS );
+	m_poller->cv.wait_for(
+		lock, std::chrono::milliseconds( wait_ms ), [ this ]() {
+			return m_poller->is_woken;
+		}
+	);
+	m_poller->is_woken = false;
+	ready_fds = m_poller->fds;
+}
+
+void Network::Impl::Wake() {
+	{
+		std::lock_guard guard( m_poller->mutex );
+		m_poller->is_woken = true;
+	}
+	m_poller->cv.notify_one();
+}
+
+}
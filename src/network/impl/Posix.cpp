@@ -2,6 +2,7 @@
 
 #include <fcntl.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <unistd.h>
 #include <signal.h>
 #include <thread>
@@ -10,10 +11,11 @@ namespace network {
 
 Network::Impl::Impl() {
 	signal( SIGPIPE, SIG_IGN );
+	CreatePoller();
 }
 
 Network::Impl::~Impl() {
-
+	DestroyPoller();
 }
 
 void Network::Impl::Start() {
@@ -65,6 +67,26 @@ int Network::Impl::Send( const fd_t fd, const void* buf, const int len ) const {
 	return send( fd, buf, len, MSG_NOSIGNAL );
 }
 
+int Network::Impl::ReceiveV( const fd_t fd, const RingBuffer::segment_t* segments, const uint8_t count ) const {
+	struct iovec iov[ 2 ];
+	ASSERT( count <= 2, "too many segments" );
+	for ( uint8_t i = 0 ; i < count ; i++ ) {
+		iov[ i ].iov_base = segments[ i ].data;
+		iov[ i ].iov_len = segments[ i ].size;
+	}
+	return readv( fd, iov, count );
+}
+
+int Network::Impl::SendV( const fd_t fd, const RingBuffer::segment_t* segments, const uint8_t count ) const {
+	struct iovec iov[ 2 ];
+	ASSERT( count <= 2, "too many segments" );
+	for ( uint8_t i = 0 ; i < count ; i++ ) {
+		iov[ i ].iov_base = segments[ i ].data;
+		iov[ i ].iov_len = segments[ i ].size;
+	}
+	return writev( fd, iov, count ); // SIGPIPE is ignored
+}
+
 void Network::Impl::CloseSocket( const fd_t socket ) const {
 	shutdown( socket, SHUT_WR );
 	close( socket );
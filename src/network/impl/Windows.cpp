@@ -7,9 +7,11 @@ static WSADATA wsa_data = {};
 Network::Impl::Impl() {
 	Log( "Initializing Winsock" );
 	WSAStartup( MAKEWORD( 2, 2 ), &wsa_data );
+	CreatePoller();
 }
 
 Network::Impl::~Impl() {
+	DestroyPoller();
 	Log( "Deinitializing Winsock" );
 	WSACleanup();
 }
@@ -59,4 +61,33 @@ int Network::Impl::Send( const fd_t fd, const void* buf, const int len ) const {
 	return send( fd, (const char*)buf, len, 0 );
 }
 
+int Network::Impl::ReceiveV( const fd_t fd, const RingBuffer::segment_t* segments, const uint8_t count ) const {
+	WSABUF bufs[ 2 ];
+	ASSERT( count <= 2, "too many segments" );
+	for ( uint8_t i = 0 ; i < count ; i++ ) {
+		bufs[ i ].buf = segments[ i ].data;
+		bufs[ i ].len = (ULONG)segments[ i ].size;
+	}
+	DWORD received = 0;
+	DWORD flags = 0;
+	if ( WSARecv( fd, bufs, count, &received, &flags, nullptr, nullptr ) != 0 ) {
+		return -1;
+	}
+	return (int)received;
+}
+
+int Network::Impl::SendV( const fd_t fd, const RingBuffer::segment_t* segments, const uint8_t count ) const {
+	WSABUF bufs[ 2 ];
+	ASSERT( count <= 2, "too many segments" );
+	for ( uint8_t i = 0 ; i < count ; i++ ) {
+		bufs[ i ].buf = segments[ i ].data;
+		bufs[ i ].len = (ULONG)segments[ i ].size;
+	}
+	DWORD sent = 0;
+	if ( WSASend( fd, bufs, count, &sent, 0, nullptr, nullptr ) != 0 ) {
+		return -1;
+	}
+	return (int)sent;
+}
+
 }
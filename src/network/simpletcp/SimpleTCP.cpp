@@ -1,4 +1,6 @@
 #include <thread>
+#include <chrono>
+#include <algorithm>
 
 #ifdef _WIN32
 #include <ws2tcpip.h>
@@ -25,8 +27,6 @@
 namespace network {
 namespace simpletcp {
 
-static socklen_t sockaddr_in_size = sizeof( struct sockaddr_in );
-
 SimpleTCP::SimpleTCP()
 	: Network() {
 
@@ -124,6 +124,7 @@ MT_Response SimpleTCP::ListenStart() {
 
 		ASSERT( m_server.listening_sockets.find( socket_data.fd ) == m_server.listening_sockets.end(), "duplicate listening socket id" );
 		m_server.listening_sockets[ socket_data.fd ] = socket_data;
+		m_impl.WatchSocket( socket_data.fd );
 	}
 
 	freeaddrinfo( res );
@@ -248,15 +249,15 @@ MT_Response SimpleTCP::Connect( const std::string& remote_address, MT_CANCELABLE
 		return error( "Unsupported IP type: " + remote_address );
 	}
 
-	m_client.socket.buffer.len = 0;
-	m_client.socket.buffer.data1 = (char*)malloc( BUFFER_SIZE );
-	m_client.socket.buffer.data2 = (char*)malloc( BUFFER_SIZE );
-	m_client.socket.buffer.data = m_client.socket.buffer.data1;
-	m_client.socket.buffer.ptr = m_client.socket.buffer.data;
+	m_client.socket.in.Clear();
+	m_client.socket.out.Clear();
+	m_client.socket.want_write = false;
+	m_client.socket.flush_queued = false;
 	m_client.socket.last_data_at = time( nullptr );
 	m_client.socket.ping_needed = false;
 	m_client.socket.pong_needed = false;
 	m_client.socket.ping_sent = false;
+	m_impl.WatchSocket( m_client.socket.fd );
 
 	Log( "Connection successful" );
 
@@ -266,10 +267,7 @@ MT_Response SimpleTCP::Connect( const std::string& remote_address, MT_CANCELABLE
 MT_Response SimpleTCP::Disconnect() {
 
 	if ( m_client.socket.fd ) {
-		CloseSocket( m_client.socket.fd, 0, true ); // no need to send event if disconnect was initiated by user
-		free( m_client.socket.buffer.data1 );
-		free( m_client.socket.buffer.data2 );
-		m_client.socket.fd = 0;
+		CloseServerSocket( true ); // no need to send event if disconnect was initiated by user
 	}
 
 	return Success();
@@ -312,18 +310,15 @@ void SimpleTCP::ProcessEvents() {
 					}
 					auto it = m_server.client_sockets.find( fd );
 					if ( it != m_server.client_sockets.end() ) { // if not found it may mean event is old so can be ignored
-						if ( !WriteToSocket( it->second.fd, event.data.packet_data ) ) {
+						if ( !WriteToSocket( it->second, event.data.packet_data ) ) {
 							CloseClientSocket( it->second );
 							m_server.client_sockets.erase( it );
 						}
 					}
 				}
 				else if ( m_client.socket.fd ) {
-					if ( !WriteToSocket( m_client.socket.fd, event.data.packet_data ) ) {
-						CloseSocket( m_client.socket.fd );
-						free( m_client.socket.buffer.data1 );
-						free( m_client.socket.buffer.data2 );
-						m_client.socket.fd = 0;
+					if ( !WriteToSocket( m_client.socket, event.data.packet_data ) ) {
+						CloseServerSocket();
 					}
 				}
 				break;
@@ -362,92 +357,111 @@ void SimpleTCP::ProcessEvents() {
 			}
 		}
 	}
+	// send everything at once
+	FlushQueued();
 }
 
 void SimpleTCP::Iterate() {
-	Network::Iterate();
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds( MAX_WAIT_MS );
+	do {
+		// requests and outgoing packets
+		Network::Iterate();
 
-	m_tmp.now = time( nullptr );
+		m_tmp.now = time( nullptr );
+		if ( m_tmp.now != m_last_pings_at ) {
+			m_last_pings_at = m_tmp.now;
+			ProcessPings();
+		}
 
-	// accept new connections (server)
-	if ( !m_server.listening_sockets.empty() ) {
-		// Log( "Checking for connections" ); // SPAMMY
-		for ( auto& it : m_server.listening_sockets ) {
+		// sleep until there is something to do, new requests wake it up too
+		m_tmp.tmpint = std::chrono::duration_cast< std::chrono::milliseconds >( deadline - std::chrono::steady_clock::now() ).count();
+		m_impl.Wait( std::max( m_tmp.tmpint, 0 ), m_ready_fds );
 
-			m_server.tmp.newfd = accept( it.first, (sockaddr*)&m_server.tmp.client_addr, &sockaddr_in_size );
-			if ( m_server.tmp.newfd != -1 ) {
+		m_tmp.now = time( nullptr );
+		for ( const auto fd : m_ready_fds ) {
+			ProcessReadySocket( fd );
+		}
+		FlushQueued();
+	}
+	while ( std::chrono::steady_clock::now() < deadline );
+}
 
-				Log( "Accepting connection " + std::to_string( m_server.tmp.newfd ) );
+void SimpleTCP::Accept( const fd_t listening_fd ) {
+	struct sockaddr_storage client_addr;
+	socklen_t client_addr_size;
+	char ip_str[INET6_ADDRSTRLEN];
 
-				m_impl.ConfigureSocket( m_server.tmp.newfd );
+	// accept everything that is pending
+	while ( true ) {
+		client_addr_size = sizeof( client_addr );
+		m_server.tmp.newfd = accept( listening_fd, (sockaddr*)&client_addr, &client_addr_size );
+		if ( m_impl.IsSocketInvalid( m_server.tmp.newfd ) ) {
+			break;
+		}
 
-				remote_socket_data_t data;
-				data.buffer.len = 0;
-				data.buffer.data1 = (char*)malloc( BUFFER_SIZE );
-				data.buffer.data2 = (char*)malloc( BUFFER_SIZE );
-				data.buffer.data = data.buffer.data1;
-				data.buffer.ptr = data.buffer.data;
-				data.fd = m_server.tmp.newfd;
+		Log( "Accepting connection " + std::to_string( m_server.tmp.newfd ) );
 
-				data.remote_address = inet_ntoa( ( (struct sockaddr_in*)&m_server.tmp.client_addr )->sin_addr );
+		m_impl.ConfigureSocket( m_server.tmp.newfd );
 
-				data.last_data_at = m_tmp.now;
-				data.ping_needed = false;
-				data.pong_needed = false;
-				data.ping_sent = false;
-				if ( m_server.next_cid == UINT32_MAX ) {
-					m_server.next_cid = 1;
-				}
-				data.cid = m_server.next_cid++;
-				m_server.cid_to_fd[ data.cid ] = data.fd;
+		ip_str[ 0 ] = '\0';
+		if ( client_addr.ss_family == AF_INET6 ) {
+			inet_ntop( AF_INET6, &( (struct sockaddr_in6*)&client_addr )->sin6_addr, ip_str, sizeof( ip_str ) );
+		}
+		else {
+			inet_ntop( AF_INET, &( (struct sockaddr_in*)&client_addr )->sin_addr, ip_str, sizeof( ip_str ) );
+		}
 
-				ASSERT( m_server.client_sockets.find( data.fd ) == m_server.client_sockets.end(), "client socket already added" );
-				m_server.client_sockets[ data.fd ] = data;
+		remote_socket_data_t data;
+		data.fd = m_server.tmp.newfd;
+		data.remote_address = ip_str;
+		data.last_data_at = m_tmp.now;
+		data.ping_needed = false;
+		data.pong_needed = false;
+		data.ping_sent = false;
+		if ( m_server.next_cid == UINT32_MAX ) {
+			m_server.next_cid = 1;
+		}
+		data.cid = m_server.next_cid++;
+		m_server.cid_to_fd[ data.cid ] = data.fd;
 
-				Log( "Accepted connection from " + data.remote_address + " (cid " + std::to_string( data.cid ) + ")" );
+		Log( "Accepted connection from " + data.remote_address + " (cid " + std::to_string( data.cid ) + ")" );
 
-				m_tmp.event.Clear();
-				m_tmp.event.type = Event::ET_CLIENT_CONNECT;
-				m_tmp.event.data.remote_address = data.remote_address;
-				m_tmp.event.cid = data.cid;
+		m_tmp.event.Clear();
+		m_tmp.event.type = Event::ET_CLIENT_CONNECT;
+		m_tmp.event.data.remote_address = data.remote_address;
+		m_tmp.event.cid = data.cid;
 
-				AddEvent( m_tmp.event );
-			}
-		}
+		ASSERT( m_server.client_sockets.find( data.fd ) == m_server.client_sockets.end(), "client socket already added" );
+		m_impl.WatchSocket( data.fd );
+		m_server.client_sockets.emplace( data.fd, std::move( data ) );
+
+		AddEvent( m_tmp.event );
 	}
+}
 
-	// process pings
-	for ( auto it = m_server.client_sockets.begin() ; it != m_server.client_sockets.end() ; ) {
-		if ( !MaybePingDo( it->second ) ) {
-			CloseClientSocket( it->second );
-			m_server.client_sockets.erase( it++ );
-		}
-		else {
-			++it;
-		}
+void SimpleTCP::ProcessReadySocket( const fd_t fd ) {
+	if ( m_server.listening_sockets.find( fd ) != m_server.listening_sockets.end() ) {
+		Accept( fd );
+		return;
 	}
-	if ( m_client.socket.fd ) {
-		if ( !MaybePingDo( m_client.socket ) ) {
-			CloseSocket( m_client.socket.fd );
-			free( m_client.socket.buffer.data1 );
-			free( m_client.socket.buffer.data2 );
-			m_client.socket.fd = 0;
+	if ( m_client.socket.fd && fd == m_client.socket.fd ) {
+		if ( !FlushSocket( m_client.socket ) || !ReadFromSocket( m_client.socket ) ) {
+			CloseServerSocket();
 		}
+		return;
 	}
-
-	// read from connection (client)
-	if ( m_client.socket.fd ) {
-		if ( !ReadFromSocket( m_client.socket ) ) {
-			CloseSocket( m_client.socket.fd );
-			free( m_client.socket.buffer.data1 );
-			free( m_client.socket.buffer.data2 );
-			m_client.socket.fd = 0;
+	const auto it = m_server.client_sockets.find( fd );
+	if ( it != m_server.client_sockets.end() ) { // may be already closed
+		if ( !FlushSocket( it->second ) || !ReadFromSocket( it->second ) ) {
+			CloseClientSocket( it->second );
+			m_server.client_sockets.erase( it );
 		}
 	}
+}
 
-	// read from connections (server)
+void SimpleTCP::ProcessPings() {
 	for ( auto it = m_server.client_sockets.begin() ; it != m_server.client_sockets.end() ; ) {
-		if ( !ReadFromSocket( it->second ) ) {
+		if ( !MaybePing( it->second ) || !MaybePingDo( it->second ) ) {
 			CloseClientSocket( it->second );
 			m_server.client_sockets.erase( it++ );
 		}
@@ -455,172 +469,163 @@ void SimpleTCP::Iterate() {
 			++it;
 		}
 	}
+	if ( m_client.socket.fd ) {
+		if ( !MaybePing( m_client.socket ) || !MaybePingDo( m_client.socket ) ) {
+			CloseServerSocket();
+		}
+	}
 }
 
 bool SimpleTCP::ReadFromSocket( remote_socket_data_t& socket ) {
 
-	// max allowed size to read
-	m_tmp.tmpint = ( BUFFER_SIZE - socket.buffer.len );
+	// always leave room for biggest packet so that any incomplete one can be finished
+	socket.in.Reserve( BUFFER_SIZE );
 
-	//Log( "Reading up to " + std::to_string( m_tmp.tmpint ) + " bytes from " + std::to_string( socket.fd ) + " (buffer=" + std::to_string( (long int) socket.buffer.ptr ) + ", BUFFER_SIZE=" + std::to_string( BUFFER_SIZE ) + " buffer len = " + std::to_string( socket.buffer.len ) + ")" );
-	m_tmp.tmpint2 = m_impl.Receive( socket.fd, socket.buffer.ptr, m_tmp.tmpint );
+	RingBuffer::segment_t segments[2];
+	m_tmp.tmpint2 = m_impl.ReceiveV( socket.fd, segments, socket.in.GetWriteSegments( segments ) );
 
 	if ( m_tmp.tmpint2 < 0 ) {
 		m_tmp.tmpint = m_impl.GetLastErrorCode();
 		if ( m_impl.IsConnectionIdle( m_tmp.tmpint ) ) {
-			// no pending data
-			if ( !MaybePing( socket ) ) {
-				return false;
-			}
-		}
-		else {
-			Log( "Connection failed (result=" + std::to_string( m_tmp.tmpint2 ) + " code=" + std::to_string( m_tmp.tmpint ) + ")" );
-			return false;
+			return true; // no pending data
 		}
+		Log( "Connection failed (result=" + std::to_string( m_tmp.tmpint2 ) + " code=" + std::to_string( m_tmp.tmpint ) + ")" );
+		return false;
 	}
 
 	if ( m_tmp.tmpint2 == 0 ) {
-		// no pending data
-		if ( !MaybePing( socket ) ) {
-			return false;
-		}
+		Log( "Connection closed by remote host" );
+		return false;
 	}
 
-	if ( m_tmp.tmpint2 > 0 ) {
+	socket.in.Produce( m_tmp.tmpint2 );
 
-		//Log( "Read " + std::to_string( m_tmp.tmpint2 ) + " bytes into buffer " + std::to_string( (long long)socket.buffer.ptr ) + " (size=" + std::to_string( socket.buffer.len ) + ")" );
+	socket.last_data_at = m_tmp.now;
+	socket.ping_needed = false;
+	socket.pong_needed = false;
 
-		socket.last_data_at = m_tmp.now;
-		socket.ping_needed = false;
-		socket.pong_needed = false;
-
-		socket.buffer.len += m_tmp.tmpint2;
-		socket.buffer.ptr += m_tmp.tmpint2;
-
-	}
-
-	{
-
-		if ( socket.buffer.len == 0 ) {
-			return true; // no new data
+	// process all complete packets, they are read directly from ring and are only copied when they wrap around its end
+	int32_t size;
+	while ( socket.in.GetSize() >= sizeof( size ) ) {
+		socket.in.Peek( &size, 0, sizeof( size ) );
+		if ( size == 0 ) {
+			// zero length means 'bye'
+			Log( "Connection closed by remote host" );
+			return false;
 		}
-
-		//Log( "Trying to process buffer " + to_string( (long int) socket.buffer.data ) + " ( size=" + to_string( socket.buffer.len ) + " )" );
-		if ( socket.buffer.len < sizeof( m_tmp.tmpint ) ) {
-			//Log( "Buffer " + to_string( (long int) socket.buffer.data ) + " does not contain full size field yet ( " + to_string( socket.buffer.len ) + " < " + to_string( sizeof( m_tmp.tmpint ) ) + " )" );
-			return true;
+		if ( size < 0 || size > BUFFER_SIZE ) {
+			Log( "Invalid packet size ( " + std::to_string( size ) + " ), closing connection" );
+			return false;
+		}
+		if ( socket.in.GetSize() < sizeof( size ) + size ) {
+			break; // wait for rest of data
 		}
 
-		m_tmp.ptr = socket.buffer.data;
-		memcpy( &m_tmp.tmpint, m_tmp.ptr, sizeof( m_tmp.tmpint ) );
-		m_tmp.tmpint2 = sizeof( m_tmp.tmpint ) + m_tmp.tmpint;
-
-		if ( socket.buffer.len < m_tmp.tmpint2 ) {
-			//Log( "Buffer " + std::to_string( (long int) socket.buffer.data ) + " does not contain all data yet ( " + std::to_string( socket.buffer.len ) + " < " + std::to_string( m_tmp.tmpint2 ) + " )" );
-			return true;
+		m_tmp.event.Clear();
+		m_tmp.event.cid = socket.cid;
+		m_tmp.event.data.remote_address = socket.remote_address;
+		const char* data = socket.in.GetContiguous( sizeof( size ), size );
+		if ( data ) {
+			m_tmp.event.data.packet_data.assign( data, size );
 		}
 		else {
-			//Log( "Buffer " + std::to_string( (long int) socket.buffer.data ) + " contains enough data ( " + std::to_string( socket.buffer.len ) + " >= " + std::to_string( m_tmp.tmpint2 ) + " )" );
+			m_tmp.event.data.packet_data.resize( size );
+			socket.in.Peek( m_tmp.event.data.packet_data.data(), sizeof( size ), size );
 		}
+		socket.in.Consume( sizeof( size ) + size );
 
-		//Log( "Processing buffer " + to_string( (long int) m_tmp.ptr ) + " ( size=" + to_string( m_tmp.tmpint2 ) + " )" );
-
-		if ( m_tmp.tmpint == 0 && m_tmp.tmpint2 == sizeof( m_tmp.tmpint ) ) {
-			// zero length means 'bye'
-			Log( "Connection closed by remote host" );
-			return false;
-		}
+		ProcessPacket( socket );
+	}
 
-		m_tmp.ptr += sizeof( m_tmp.tmpint );
-
-		{
-			//Log( "Read packet (" + std::to_string( m_tmp.tmpint ) + " bytes)" );
-			m_tmp.event.Clear();
-			m_tmp.event.cid = socket.cid;
-			m_tmp.event.data.remote_address = socket.remote_address;
-			m_tmp.event.data.packet_data = std::string( m_tmp.ptr, m_tmp.tmpint );
-			try {
-				types::Packet p( types::Packet::PT_NONE );
-				p.Deserialize( types::Buffer( m_tmp.event.data.packet_data ) );
-				// quick hack to respond to pings without escalating events outside
-				// TODO: refactor
-				if ( p.type == types::Packet::PT_PING ) {
-					//Log( "Ping received" );
-					socket.pong_needed = true;
-				}
-				else if ( p.type == types::Packet::PT_PONG ) {
-					//Log( "Pong received" );
-					socket.ping_sent = false;
-				}
-				else {
-					//Log( "Sending event" );
-					m_tmp.event.type = Event::ET_PACKET;
-					AddEvent( m_tmp.event );
-				}
-			}
-			catch ( std::runtime_error& err ) {
-				m_tmp.event.type = Event::ET_ERROR;
-				m_tmp.event.data.packet_data = err.what();
-				AddEvent( m_tmp.event );
-			}
+	// answer pings right away
+	return MaybePingDo( socket );
+}
 
+void SimpleTCP::ProcessPacket( remote_socket_data_t& socket ) {
+	try {
+		types::Packet p( types::Packet::PT_NONE );
+		p.Deserialize( types::Buffer( m_tmp.event.data.packet_data ) );
+		// quick hack to respond to pings without escalating events outside
+		// TODO: refactor
+		if ( p.type == types::Packet::PT_PING ) {
+			//Log( "Ping received" );
+			socket.pong_needed = true;
+		}
+		else if ( p.type == types::Packet::PT_PONG ) {
+			//Log( "Pong received" );
+			socket.ping_sent = false;
 		}
+		else {
+			//Log( "Sending event" );
+			m_tmp.event.type = Event::ET_PACKET;
+			AddEvent( m_tmp.event );
+		}
+	}
+	catch ( std::runtime_error& err ) {
+		m_tmp.event.type = Event::ET_ERROR;
+		m_tmp.event.data.packet_data = err.what();
+		AddEvent( m_tmp.event );
+	}
+}
 
-		//Log( "Processed " + std::to_string( m_tmp.tmpint2 ) + " bytes" );
+bool SimpleTCP::WriteToSocket( remote_socket_data_t& socket, const std::string& data ) {
+	//Log( "WriteToSocket( " + to_string( socket.fd ) + " )" ); // SPAMMY
+	ASSERT( data.size() <= BUFFER_SIZE, "packet size overflow ( " + std::to_string( data.size() ) + " > " + std::to_string( BUFFER_SIZE ) + "), consider increasing BUFFER_SIZE" );
+	const int32_t size = data.size();
+	if ( socket.out.GetSize() + sizeof( size ) + size > MAX_PENDING_WRITE ) {
+		Log( "Too much unsent data for " + std::to_string( socket.fd ) + ", remote host is not reading" );
+		return false;
+	}
+	// size and data go out together, along with other packets queued meanwhile
+	socket.out.Append( &size, sizeof( size ) );
+	socket.out.Append( data.data(), data.size() );
+	if ( !socket.flush_queued && !socket.want_write ) {
+		socket.flush_queued = true;
+		m_fds_to_flush.push_back( socket.fd );
+	}
+	return true;
+}
 
-		if ( m_tmp.tmpint2 > 0 ) {
-			ASSERT( socket.buffer.len >= m_tmp.tmpint2, "processed more than total" );
-			socket.buffer.len -= m_tmp.tmpint2;
-			if ( socket.buffer.len > 0 ) {
-				if ( socket.buffer.data == socket.buffer.data1 ) {
-					//Log( "SWAP data1 -> data2" );
-					memcpy( socket.buffer.data2, socket.buffer.data + m_tmp.tmpint2, socket.buffer.len );
-					socket.buffer.data = socket.buffer.data2;
-				}
-				else {
-					//Log( "SWAP data2 -> data1" );
-					memcpy( socket.buffer.data1, socket.buffer.data + m_tmp.tmpint2, socket.buffer.len );
-					socket.buffer.data = socket.buffer.data1;
-				}
+bool SimpleTCP::FlushSocket( remote_socket_data_t& socket ) {
+	socket.flush_queued = false;
+	RingBuffer::segment_t segments[2];
+	while ( !socket.out.IsEmpty() ) {
+		m_tmp.tmpint2 = m_impl.SendV( socket.fd, segments, socket.out.GetReadSegments( segments ) );
+		if ( m_tmp.tmpint2 < 0 ) {
+			m_tmp.tmpint = m_impl.GetLastErrorCode();
+			if ( m_impl.IsConnectionIdle( m_tmp.tmpint ) ) {
+				break; // socket buffer is full, continue when it becomes writable
 			}
-			socket.buffer.ptr = socket.buffer.data + socket.buffer.len;
-
-			//Log( "Buffer size changed to " + to_string( socket.buffer.len ) );
+			Log( "Error writing to socket (errno=" + std::to_string( m_tmp.tmpint ) + " pending=" + std::to_string( socket.out.GetSize() ) + ")" );
+			return false;
 		}
-
-		return true;
-
+		socket.out.Consume( m_tmp.tmpint2 );
+	}
+	const bool want_write = !socket.out.IsEmpty();
+	if ( want_write != socket.want_write ) {
+		socket.want_write = want_write;
+		m_impl.SetWantWrite( socket.fd, want_write );
 	}
-	THROW( "?" );
-	return false;
+	return true;
 }
 
-bool SimpleTCP::WriteToSocket( int fd, const std::string& data ) {
-	//Log( "WriteToSocket( " + to_string( fd ) + " )" ); // SPAMMY
-	m_tmp.tmpint2 = data.size();
-	//Log( "Writing " + to_string( m_tmp.tmpint2 ) + " bytes" );
-	// send size
-	m_tmp.tmpint = m_impl.Send( fd, &m_tmp.tmpint2, sizeof( m_tmp.tmpint2 ) );
-	if ( m_tmp.tmpint <= 0 ) {
-		m_tmp.tmpint = m_impl.GetLastErrorCode();
-		if ( m_impl.IsConnectionIdle( m_tmp.tmpint ) ) {
-			return true; // no data but connection is alive
+void SimpleTCP::FlushQueued() {
+	for ( const auto fd : m_fds_to_flush ) {
+		if ( m_client.socket.fd && fd == m_client.socket.fd ) {
+			if ( m_client.socket.flush_queued && !FlushSocket( m_client.socket ) ) {
+				CloseServerSocket();
+			}
+			continue;
 		}
-		Log( "Error writing size to socket (errno=" + std::to_string( m_tmp.tmpint ) + " size=" + std::to_string( m_tmp.tmpint ) + " reqsize=" + std::to_string( m_tmp.tmpint2 ) + ")" );
-
-		return false;
-	}
-	// send data
-	m_tmp.tmpint = m_impl.Send( fd, data.data(), data.size() );
-	if ( m_tmp.tmpint2 <= 0 ) {
-		if ( errno == EAGAIN ) {
-			return true; // no data but connection is alive
+		const auto it = m_server.client_sockets.find( fd );
+		if ( it != m_server.client_sockets.end() && it->second.flush_queued ) { // may be closed already
+			if ( !FlushSocket( it->second ) ) {
+				CloseClientSocket( it->second );
+				m_server.client_sockets.erase( it );
+			}
 		}
-		Log( "Error writing data to socket" );
-		return false;
 	}
-	//Log( "Write successful" );
-	return true;
+	m_fds_to_flush.clear();
 }
 
 bool SimpleTCP::MaybePing( remote_socket_data_t& socket ) {
@@ -661,14 +666,14 @@ bool SimpleTCP::MaybePingDo( remote_socket_data_t& socket ) {
 		types::Packet packet( types::Packet::PT_PING );
 		std::string data = packet.Serialize().ToString();
 		socket.ping_sent = true;
-		return WriteToSocket( socket.fd, data );
+		return WriteToSocket( socket, data );
 	}
 	if ( socket.pong_needed ) {
 		//Log( "Ping received, sending pong to " + std::to_string( socket.fd ) + " (cid " + std::to_string( socket.cid ) + ")" );
 		types::Packet packet( types::Packet::PT_PONG );
 		socket.pong_needed = false;
 		std::string data = packet.Serialize().ToString();
-		return WriteToSocket( socket.fd, data );
+		return WriteToSocket( socket, data );
 	}
 
 	return true;
@@ -676,6 +681,7 @@ bool SimpleTCP::MaybePingDo( remote_socket_data_t& socket ) {
 
 void SimpleTCP::CloseSocket( int fd, cid_t cid, bool skip_event ) {
 	Log( "Closing socket " + std::to_string( fd ) );
+	m_impl.UnwatchSocket( fd );
 	uint32_t bye = 0;
 	m_impl.Send( fd, &bye, sizeof( bye ) );
 	m_impl.CloseSocket( fd );
@@ -692,16 +698,25 @@ void SimpleTCP::CloseSocket( int fd, cid_t cid, bool skip_event ) {
 	}
 }
 
-void SimpleTCP::CloseClientSocket( const remote_socket_data_t& socket ) {
+void SimpleTCP::CloseClientSocket( remote_socket_data_t& socket ) {
 	ASSERT( GetCurrentConnectionMode() == CM_SERVER, "can't close client socket as non-server" );
 	ASSERT( socket.cid != 0, "client socket can't have cid 0" );
 	Log( "Closing connection to " + socket.remote_address + " ( cid " + std::to_string( socket.cid ) + " )" );
+	FlushSocket( socket ); // best effort
 	CloseSocket( socket.fd, socket.cid );
-	free( socket.buffer.data1 );
-	free( socket.buffer.data2 );
 	InvalidateEventsForDisconnectedClient( socket.cid );
 	m_server.cid_to_fd.erase( socket.cid );
 }
 
+void SimpleTCP::CloseServerSocket( const bool skip_event ) {
+	FlushSocket( m_client.socket ); // best effort
+	CloseSocket( m_client.socket.fd, 0, skip_event );
+	m_client.socket.in.Clear();
+	m_client.socket.out.Clear();
+	m_client.socket.want_write = false;
+	m_client.socket.flush_queued = false;
+	m_client.socket.fd = 0;
+}
+
 }
 }
@@ -32,13 +32,33 @@ protected:
 	void ProcessEvents() override;
 
 private:
+	// Iterate() keeps waiting for socket activity for up to this long, same as network thread step, so that latency isn't bound by thread sleep
+	static const int MAX_WAIT_MS = 10;
+	// peer that doesn't read gets disconnected when this much data is waiting to be sent to it
+	static const size_t MAX_PENDING_WRITE = 16 * 1024 * 1024;
+
+	std::vector< fd_t > m_ready_fds = {};
+	std::vector< fd_t > m_fds_to_flush = {};
+	time_t m_last_pings_at = 0;
+
+	void Accept( const fd_t listening_fd );
+	void ProcessReadySocket( const fd_t fd );
+	void ProcessPings();
+
 	// true on success, false on error
 	bool ReadFromSocket( remote_socket_data_t& socket );
-	bool WriteToSocket( int fd, const std::string& data );
+	// handles packet in m_tmp.event.data.packet_data
+	void ProcessPacket( remote_socket_data_t& socket );
+	// data is only queued, it's sent with other queued data on next FlushQueued()
+	bool WriteToSocket( remote_socket_data_t& socket, const std::string& data );
+	bool FlushSocket( remote_socket_data_t& socket );
+	void FlushQueued();
 	bool MaybePing( remote_socket_data_t& socket );
 	bool MaybePingDo( remote_socket_data_t& socket );
 	void CloseSocket( int fd, network::cid_t cid = 0, bool skip_event = false );
-	void CloseClientSocket( const remote_socket_data_t& socket );
+	void CloseClientSocket( remote_socket_data_t& socket );
+	// connection to server ( in client mode )
+	void CloseServerSocket( const bool skip_event = false );
 
 #ifdef DEBUG
 	bool m_need_pings = true;
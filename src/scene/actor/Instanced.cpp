@@ -214,7 +214,7 @@ const types::Buffer Instanced::Serialize() const {
 
 	buf.WriteInt( m_next_instance_id );
 
-	buf.WriteString( m_actor->Serialize().ToString() );
+	buf.WriteNested( *m_actor );
 
 	return buf;
 }
@@ -243,7 +243,7 @@ void Instanced::Deserialize( types::Buffer buf ) {
 
 	m_next_instance_id = buf.ReadInt();
 
-	m_actor->Deserialize( buf.ReadString() );
+	m_actor->Deserialize( buf.ReadNested() );
 
 	m_need_world_matrix_update = true;
 }
@@ -37,9 +37,10 @@ void Sound::GetNextBuffer( uint8_t* buffer, int len ) {
 		return;
 	}
 
+	size_t pos = m_pos.load( std::memory_order_relaxed );
 	size_t newlen = 0;
-	if ( len + m_pos > m_sound->m_buffer_size ) {
-		newlen = m_sound->m_buffer_size - m_pos;
+	if ( len + pos > m_sound->m_buffer_size ) {
+		newlen = m_sound->m_buffer_size - pos;
 		//if ( !m_is_repeatable ) { // need to test this first (maybe not needed at all)
 		memset( ptr( buffer, newlen, len - newlen ), 0, len - newlen );
 		Stop();
@@ -50,9 +51,11 @@ void Sound::GetNextBuffer( uint8_t* buffer, int len ) {
 		memset( ptr( buffer, 0, len ), 0, len );
 	}
 	else {
-		memcpy( ptr( buffer, 0, len ), ptr( m_sound->m_buffer, m_pos, len ), len );
+		// sound data isn't allocated by us ( see loader::sound ), so it can't be checked with ptr()
+		memcpy( ptr( buffer, 0, len ), m_sound->m_buffer + pos, len );
 	}
-	m_pos += len;
+	// if main thread rewound sound meanwhile - keep its position
+	m_pos.compare_exchange_strong( pos, pos + len, std::memory_order_relaxed );
 	if ( m_is_finished && m_is_repeatable ) {
 		Rewind();
 
@@ -139,7 +142,7 @@ const bool Sound::IsReadyToBeDeleted() const {
 }
 
 const size_t Sound::GetPos() const {
-	return m_pos;
+	return m_pos.load( std::memory_order_relaxed );
 }
 
 const float Sound::GetVolume() const {
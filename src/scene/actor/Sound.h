@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+
 #include "Actor.h"
 
 #include "util/Timer.h"
@@ -53,8 +55,9 @@ private:
 
 	float m_volume = 1.0;
 
-	bool m_is_finished = false;
-	size_t m_pos = 0;
+	// these are changed both by mixing thread ( see audio::Mixer ) and by main thread
+	std::atomic< bool > m_is_finished = false;
+	std::atomic< size_t > m_pos = 0;
 };
 
 }
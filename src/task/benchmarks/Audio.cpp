@@ -0,0 +1,115 @@
+#include "Audio.h"
+
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+#include "Benchmarks.h"
+
+#include "audio/Mixer.h"
+#include "scene/actor/Sound.h"
+#include "types/Sound.h"
+#include "util/random/Random.h"
+
+namespace task {
+namespace benchmarks {
+
+void AddAudioBenchmarks( Benchmarks* task ) {
+
+	task->AddBenchmark(
+		"offline mixing of 10 seconds of audio ( old per-sample mixer vs audio::Mixer )",
+		BM() {
+			// same as audio::sdl2::SDL2 uses
+			const size_t frequency = 22050;
+			const size_t block_length = 4096;
+			const float volume = 0.75f;
+			const float lowering_per_voice = 0.92f;
+			const size_t length = frequency * 10;
+
+			// few different looping sounds, 3 seconds each
+			util::random::Random random( 12345 );
+			std::vector< types::Sound* > sounds = {};
+			for ( size_t s = 0 ; s < 4 ; s++ ) {
+				auto* sound = new types::Sound();
+				const size_t samples = frequency * 3;
+				sound->m_buffer_size = samples * sizeof( int16_t );
+				auto* pcm = new int16_t[ samples ];
+				const float pitch = 220.0f * ( s + 1 );
+				for ( size_t i = 0 ; i < samples ; i++ ) {
+					pcm[ i ] = (int16_t)( 12000.0f * std::sin( 2.0f * (float)M_PI * pitch * i / frequency ) + random.GetInt64( -500, 500 ) );
+				}
+				sound->m_data = std::shared_ptr< const unsigned char[] >(
+					(unsigned char*)pcm, []( const unsigned char* data ) {
+						delete[] (const int16_t*)data;
+					}
+				);
+				sound->m_buffer = sound->m_data.get();
+				sounds.push_back( sound );
+			}
+
+			for ( const size_t voices_count : { 8, 64, 256 } ) {
+				task->LogBenchmark( "  " + std::to_string( voices_count ) + " voices:" );
+
+				std::vector< scene::actor::Sound* > actors = {};
+				for ( size_t v = 0 ; v < voices_count ; v++ ) {
+					auto* actor = new scene::actor::Sound( "Voice" + std::to_string( v ), sounds[ v % sounds.size() ] );
+					actor->SetRepeatable( true );
+					actor->SetAutoPlay( true );
+					actor->SetVolume( random.GetFloat( 0.2f, 1.0f ) );
+					actors.push_back( actor );
+				}
+				std::vector< int16_t > out( length );
+
+				// what audio::sdl2::SDL2::Mix did before
+				std::vector< double > old_mix_buffer( block_length );
+				std::vector< int16_t > old_buffer( block_length );
+				const auto old_ns = task->Measure(
+					[ &actors, &old_mix_buffer, &old_buffer, &out, block_length, volume, lowering_per_voice ]() {
+						for ( size_t pos = 0 ; pos < length ; pos += block_length ) {
+							memset( old_mix_buffer.data(), 0, block_length * sizeof( double ) );
+							for ( const auto& actor : actors ) {
+								if ( actor->IsActive() ) {
+									actor->GetNextBuffer( (uint8_t*)old_buffer.data(), block_length * sizeof( int16_t ) );
+									for ( size_t i = 0 ; i < block_length ; i++ ) {
+										old_mix_buffer[ i ] = old_mix_buffer[ i ] + old_buffer[ i ] * actor->GetVolume() * volume * pow( lowering_per_voice, actors.size() );
+									}
+								}
+							}
+							for ( size_t i = 0 ; i < block_length ; i++ ) {
+								old_buffer[ i ] = floor( old_mix_buffer[ i ] );
+							}
+							memcpy( out.data() + pos, old_buffer.data(), std::min( block_length, length - pos ) * sizeof( int16_t ) );
+						}
+					}
+				);
+				task->LogRate( "old mixer", length, old_ns, "samples" );
+
+				audio::Mixer mixer( block_length, volume, lowering_per_voice );
+				for ( const auto& actor : actors ) {
+					mixer.AddVoice( actor );
+				}
+				const auto new_ns = task->Measure(
+					[ &mixer, &out ]() {
+						mixer.Render( out.data(), length );
+					}
+				);
+				task->LogRate( "audio::Mixer", length, new_ns, "samples" );
+				task->LogBenchmark( "    realtime factor: " + std::to_string( (size_t)( 10000000000.0 / new_ns ) ) + "x ( was " + std::to_string( (size_t)( 10000000000.0 / old_ns ) ) + "x )" );
+
+				for ( const auto& actor : actors ) {
+					mixer.RemoveVoice( actor );
+					delete actor;
+				}
+			}
+
+			for ( const auto& sound : sounds ) {
+				delete sound;
+			}
+		}
+	);
+
+}
+
+}
+}
@@ -0,0 +1,96 @@
+#include "Benchmarks.h"
+
+#include <chrono>
+
+#include "engine/Engine.h"
+#include "util/LogHelper.h"
+
+#include "Serialization.h"
+#include "Checksum.h"
+#include "ThreadPool.h"
+#include "Network.h"
+#include "Units.h"
+#include "TileDeltas.h"
+#include "Logging.h"
+#include "Audio.h"
+#include "EditorStroke.h"
+
+namespace task {
+namespace benchmarks {
+
+void Benchmarks::Start() {
+	AddSerializationBenchmarks( this );
+	AddChecksumBenchmarks( this );
+	AddThreadPoolBenchmarks( this );
+	AddNetworkBenchmarks( this );
+	AddUnitsBenchmarks( this );
+	AddTileDeltasBenchmarks( this );
+	AddLoggingBenchmarks( this );
+	AddAudioBenchmarks( this );
+	AddEditorStrokeBenchmarks( this );
+}
+
+void Benchmarks::Stop() {
+	LogBenchmark( "Benchmarks complete." );
+	m_benchmarks.clear();
+}
+
+void Benchmarks::Iterate() {
+	if ( m_current_benchmark_index < m_benchmarks.size() ) {
+		const auto& it = m_benchmarks[ m_current_benchmark_index++ ];
+		LogBenchmark( it.first + ":" );
+		it.second( this );
+	}
+	else if ( m_current_benchmark_index == m_benchmarks.size() ) {
+		m_current_benchmark_index++;
+		g_engine->ShutDown();
+	}
+}
+
+void Benchmarks::AddBenchmark( const std::string& name, const benchmark_t benchmark ) {
+	m_benchmarks.push_back(
+		{
+			name,
+			benchmark
+		}
+	);
+}
+
+void Benchmarks::LogBenchmark( const std::string& text ) {
+	util::LogHelper::Println( text );
+	util::LogHelper::Flush();
+}
+
+const uint64_t Benchmarks::Measure( const std::function< void() >& f, const size_t min_iterations, const size_t min_duration_ms ) {
+	const auto min_duration = std::chrono::milliseconds( min_duration_ms );
+	size_t iterations = 0;
+	const auto begin = std::chrono::steady_clock::now();
+	auto elapsed = std::chrono::steady_clock::duration::zero();
+	while ( iterations < min_iterations || elapsed < min_duration ) {
+		f();
+		iterations++;
+		elapsed = std::chrono::steady_clock::now() - begin;
+	}
+	return std::chrono::duration_cast< std::chrono::nanoseconds >( elapsed ).count() / iterations;
+}
+
+void Benchmarks::LogDuration( const std::string& label, const uint64_t ns ) {
+	LogBenchmark( "    " + label + ": " + std::to_string( ns / 1000 ) + "us" );
+}
+
+void Benchmarks::LogThroughput( const std::string& label, const size_t bytes, const uint64_t ns ) {
+	const double mbps = ns
+		? (double)bytes / ( 1024.0 * 1024.0 ) / ( (double)ns / 1000000000.0 )
+		: 0.0;
+	LogBenchmark( "    " + label + ": " + std::to_string( bytes ) + " bytes in " + std::to_string( ns / 1000 ) + "us ( " + std::to_string( (size_t)mbps ) + " MB/s )" );
+}
+
+void Benchmarks::LogRate( const std::string& label, const size_t count, const uint64_t ns, const std::string& unit ) {
+	const double rate = ns
+		? (double)count / ( (double)ns / 1000000000.0 )
+		: 0.0;
+	LogBenchmark( "    " + label + ": " + std::to_string( count ) + " " + unit + " in " + std::to_string( ns / 1000 ) + "us ( " + std::to_string( (size_t)rate ) + " " + unit + "/s )" );
+}
+
+}
+}
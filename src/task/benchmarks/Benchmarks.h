@@ -0,0 +1,39 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "common/Task.h"
+
+namespace task {
+namespace benchmarks {
+
+class Benchmarks;
+
+typedef std::function< void( Benchmarks* task ) > benchmark_t;
+#define BM( ... ) [ __VA_ARGS__ ]( task::benchmarks::Benchmarks* task ) -> void
+
+CLASS( Benchmarks, common::Task )
+	void Start() override;
+	void Stop() override;
+	void Iterate() override;
+
+	void AddBenchmark( const std::string& name, const benchmark_t benchmark );
+	void LogBenchmark( const std::string& text );
+
+	// runs f repeatedly ( at least min_iterations times and at least min_duration_ms total ), returns average nanoseconds per run
+	const uint64_t Measure( const std::function< void() >& f, const size_t min_iterations = 3, const size_t min_duration_ms = 500 );
+
+	// helpers for reporting
+	void LogDuration( const std::string& label, const uint64_t ns );
+	void LogThroughput( const std::string& label, const size_t bytes, const uint64_t ns );
+	void LogRate( const std::string& label, const size_t count, const uint64_t ns, const std::string& unit );
+
+private:
+	size_t m_current_benchmark_index = 0;
+	std::vector< std::pair< std::string, benchmark_t > > m_benchmarks = {};
+};
+
+}
+}
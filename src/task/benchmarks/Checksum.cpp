@@ -0,0 +1,80 @@
+#include "Checksum.h"
+
+#include <vector>
+
+#include "Benchmarks.h"
+
+#include "util/crc32/CRC32.h"
+#include "util/random/Random.h"
+
+namespace task {
+namespace benchmarks {
+
+void AddChecksumBenchmarks( Benchmarks* task ) {
+
+	task->AddBenchmark(
+		"crc32c of 64MB game state",
+		BM() {
+			const size_t size = 64 * 1024 * 1024;
+			std::vector< uint8_t > data( size );
+			util::random::Random random( 12345 );
+			for ( auto& b : data ) {
+				b = random.GetUInt( 0, 255 );
+			}
+
+			util::crc32::crc_t crc = 0;
+			const auto hw_ns = task->Measure(
+				[ &data, &crc ]() {
+					crc = util::crc32::CRC32::Calculate( data.data(), data.size() );
+				}
+			);
+			task->LogThroughput(
+				util::crc32::CRC32::HasHardwareSupport()
+					? "CRC32::Calculate ( hardware )"
+					: "CRC32::Calculate ( no hardware support, slice-by-8 )", size, hw_ns
+			);
+
+			util::crc32::crc_t portable_crc = 0;
+			const auto portable_ns = task->Measure(
+				[ &data, &portable_crc ]() {
+					portable_crc = util::crc32::CRC32::CalculatePortable( data.data(), data.size() );
+				}
+			);
+			task->LogThroughput( "CRC32::CalculatePortable ( slice-by-8 )", size, portable_ns );
+
+			ASSERT( crc == portable_crc, "hardware and portable crc32c mismatch" );
+		}
+	);
+
+	task->AddBenchmark(
+		"write and read 1M int fields ( per-field checksum )",
+		BM() {
+			const size_t count = 1000000;
+
+			types::Buffer buf;
+			const auto write_ns = task->Measure(
+				[ &buf ]() {
+					buf = types::Buffer();
+					for ( size_t i = 0 ; i < count ; i++ ) {
+						buf.WriteInt( i );
+					}
+				}
+			);
+			task->LogThroughput( "WriteInt", buf.lenw, write_ns );
+
+			const auto read_ns = task->Measure(
+				[ &buf ]() {
+					types::Buffer b = buf;
+					for ( size_t i = 0 ; i < count ; i++ ) {
+						b.ReadInt();
+					}
+				}
+			);
+			task->LogThroughput( "ReadInt", buf.lenw, read_ns );
+		}
+	);
+
+}
+
+}
+}
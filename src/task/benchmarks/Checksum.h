@@ -0,0 +1,11 @@
+#pragma once
+
+namespace task {
+namespace benchmarks {
+
+class Benchmarks;
+
+void AddChecksumBenchmarks( Benchmarks* task );
+
+}
+}
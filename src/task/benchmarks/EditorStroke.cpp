@@ -0,0 +1,115 @@
+#include "EditorStroke.h"
+
+#include <vector>
+#include <unordered_set>
+#include <cstdlib>
+
+#include "Benchmarks.h"
+
+#include "game/backend/map/tile/Tiles.h"
+#include "game/backend/map/tile/Tile.h"
+
+namespace task {
+namespace benchmarks {
+
+void AddEditorStrokeBenchmarks( Benchmarks* task ) {
+
+	task->AddBenchmark(
+		"recomputed items per map editor stroke with 9x9 brush",
+		BM() {
+			namespace tile = game::backend::map::tile;
+			typedef std::vector< tile::Tile* > tiles_t;
+
+			tile::Tiles tiles( 64, 64 );
+
+			// same diagonal square as map_editor::brush::Square draws, center is far from edges so no wrapping is needed
+			const ssize_t brush_width = 9;
+			const ssize_t cx = 32;
+			const ssize_t cy = 32;
+			tiles_t brush = {};
+			for ( ssize_t dy = -brush_width ; dy <= brush_width ; dy++ ) {
+				for ( ssize_t dx = -brush_width ; dx <= brush_width ; dx++ ) {
+					if ( ( dx & 1 ) != ( dy & 1 ) || std::abs( dx ) + std::abs( dy ) > brush_width ) {
+						continue;
+					}
+					brush.push_back( &tiles.At( cx + dx, cy + dy ) );
+				}
+			}
+
+			struct stroke_t {
+				const std::string name;
+				const tile::attribute_t attribute;
+				const uint16_t flags;
+				const size_t reload_radius; // tiles around drawn tile that previous approach reloaded fully
+			};
+			const std::vector< stroke_t > strokes = {
+				// corners are shared and coastlines reach 2 tiles, so elevation strokes reload as many tiles as before ( only outer ring skips yields )
+				{ "elevation", tile::ATTRIBUTE_ELEVATION, 0, 2 },
+				{ "moisture", tile::ATTRIBUTE_MOISTURE, 0, 1 },
+				{ "rockiness", tile::ATTRIBUTE_ROCKINESS, 0, 1 },
+				{ "resource", tile::ATTRIBUTE_BONUS, 0, 0 },
+				{ "river", tile::ATTRIBUTE_FEATURES, tile::FEATURE_RIVER, 1 },
+				{ "monolith", tile::ATTRIBUTE_FEATURES, tile::FEATURE_MONOLITH, 0 },
+				{ "road", tile::ATTRIBUTE_TERRAFORMING, tile::TERRAFORMING_ROAD, 1 },
+				{ "mine", tile::ATTRIBUTE_TERRAFORMING, tile::TERRAFORMING_MINE, 0 },
+			};
+
+			for ( const auto& stroke : strokes ) {
+
+				// previous approach: every tile around every drawn one got yields and full reload
+				std::unordered_set< tile::Tile* > reloaded = {};
+				for ( auto* t : brush ) {
+					reloaded.insert( t );
+					if ( stroke.reload_radius >= 1 ) {
+						for ( auto* n : t->neighbours ) {
+							reloaded.insert( n );
+							if ( stroke.reload_radius >= 2 ) {
+								reloaded.insert( n->neighbours.begin(), n->neighbours.end() );
+							}
+						}
+					}
+				}
+
+				tiles_t dirty_tiles = {};
+				const auto f_stroke = [ &brush, &stroke, &dirty_tiles ]() {
+					dirty_tiles.clear();
+					for ( auto* t : brush ) {
+						t->Touch( stroke.attribute, dirty_tiles, stroke.flags );
+					}
+					for ( auto* t : dirty_tiles ) {
+						t->Validate( t->dirty );
+					}
+				};
+				const auto ns = task->Measure( f_stroke );
+
+				// run once more to count what was invalidated
+				dirty_tiles.clear();
+				for ( auto* t : brush ) {
+					t->Touch( stroke.attribute, dirty_tiles, stroke.flags );
+				}
+				size_t yields = 0, textures = 0, sprites = 0;
+				for ( auto* t : dirty_tiles ) {
+					if ( t->dirty & tile::ATTRIBUTE_YIELDS ) {
+						yields++;
+					}
+					if ( t->dirty & tile::ATTRIBUTE_TEXTURES ) {
+						textures++;
+					}
+					else if ( t->dirty & tile::ATTRIBUTE_SPRITES ) {
+						sprites++;
+					}
+					t->Validate( t->dirty );
+				}
+
+				task->LogBenchmark( "    " + stroke.name + " ( " + std::to_string( brush.size() ) + " tiles drawn ):" );
+				task->LogBenchmark( "      before: " + std::to_string( reloaded.size() ) + " yields, " + std::to_string( reloaded.size() ) + " full tile reloads" );
+				task->LogBenchmark( "      after: " + std::to_string( yields ) + " yields, " + std::to_string( textures ) + " full tile reloads, " + std::to_string( sprites ) + " sprite reloads" );
+				task->LogDuration( "invalidation", ns );
+			}
+		}
+	);
+
+}
+
+}
+}
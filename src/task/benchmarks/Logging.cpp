@@ -0,0 +1,186 @@
+#include "Logging.h"
+
+#include <mutex>
+#include <chrono>
+#include <cstdio>
+
+#include "Benchmarks.h"
+
+#include "engine/Engine.h"
+#include "common/ThreadPool.h"
+#include "logger/Async.h"
+
+namespace task {
+namespace benchmarks {
+
+// writes to temporary file, like Stdout does to terminal
+CLASS( FileLogger, logger::Logger )
+
+	FileLogger()
+		: m_file( std::tmpfile() ) {
+		ASSERT( m_file, "could not create temporary file" );
+	}
+
+	~FileLogger() {
+		std::fclose( m_file );
+	}
+
+	void Log( const std::string& text ) override {
+		std::fputs( text.c_str(), m_file );
+		std::fputc( '\n', m_file );
+	}
+
+	void Flush() override {
+		std::fflush( m_file );
+		m_flushes++;
+	}
+
+	size_t m_flushes = 0;
+
+private:
+	std::FILE* const m_file;
+};
+
+static const logger::record_t MakeRecord( const size_t thread, const size_t i ) {
+	return {
+		logger::LL_DEBUG,
+		(uint64_t)std::chrono::high_resolution_clock::now().time_since_epoch().count(),
+		"game::backend::unit::UnitManager#" + std::to_string( thread ),
+		"Spawning unit #" + std::to_string( i ) + " ( ScoutPatrol ) at Tile( 40, 20 )"
+	};
+}
+
+void AddLoggingBenchmarks( Benchmarks* task ) {
+
+	task->AddBenchmark(
+		"100k debug logs from 4 threads ( synchronous vs async logger )",
+		BM() {
+			auto* pool = g_engine->GetThreadPool();
+			const size_t threads = 4;
+			const size_t count = 100000;
+			common::mt_flag_t canceled = false;
+
+			// formatting and output in logging thread under global lock, flush after every line ( how Stdout logger worked )
+			auto* sync_target = new FileLogger();
+			std::mutex sync_mutex;
+			size_t sync_runs = 0;
+			const auto sync_ns = task->Measure(
+				[ pool, sync_target, &sync_mutex, &sync_runs, &canceled ]() {
+					pool->ParallelFor(
+						0, threads, [ sync_target, &sync_mutex ]( const size_t from, const size_t to ) {
+							for ( size_t thread = from ; thread < to ; thread++ ) {
+								for ( size_t i = 0 ; i < count / threads ; i++ ) {
+									const auto text = logger::Logger::Format( MakeRecord( thread, i ) );
+									std::lock_guard guard( sync_mutex );
+									sync_target->Log( text );
+									sync_target->Flush();
+								}
+							}
+						}, canceled, 1
+					);
+					sync_runs++;
+				}
+			);
+			task->LogRate( "synchronous", count, sync_ns, "messages" );
+			task->LogBenchmark( "    flushes per run: " + std::to_string( sync_target->m_flushes / sync_runs ) );
+			delete sync_target;
+
+			// logging threads only push records, formatting and output happen in writer thread
+			auto* async_target = new FileLogger();
+			auto* async = new logger::Async( { async_target }, false );
+			uint64_t push_ns_total = 0;
+			size_t runs = 0;
+			const auto async_ns = task->Measure(
+				[ pool, async, &push_ns_total, &runs, &canceled ]() {
+					const auto begin = std::chrono::steady_clock::now();
+					pool->ParallelFor(
+						0, threads, [ async ]( const size_t from, const size_t to ) {
+							for ( size_t thread = from ; thread < to ; thread++ ) {
+								for ( size_t i = 0 ; i < count / threads ; i++ ) {
+									async->Log( MakeRecord( thread, i ) );
+								}
+							}
+						}, canceled, 1
+					);
+					push_ns_total += std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::steady_clock::now() - begin ).count();
+					runs++;
+					async->Flush(); // wait for output too
+				}
+			);
+			task->LogRate( "async, logging threads only", count, push_ns_total / runs, "messages" );
+			task->LogRate( "async, until written", count, async_ns, "messages" );
+			task->LogBenchmark( "    flushes per run: " + std::to_string( async_target->m_flushes / runs ) );
+			delete async; // deletes target too
+		}
+	);
+
+	task->AddBenchmark(
+		"burst of 100k logs from 4 threads into bounded async logger",
+		BM() {
+			auto* pool = g_engine->GetThreadPool();
+			const size_t threads = 4;
+			const size_t count = 100000;
+			common::mt_flag_t canceled = false;
+
+			auto* target = new FileLogger();
+			auto* async = new logger::Async( { target }, true );
+			const auto begin = std::chrono::steady_clock::now();
+			pool->ParallelFor(
+				0, threads, [ async ]( const size_t from, const size_t to ) {
+					for ( size_t thread = from ; thread < to ; thread++ ) {
+						for ( size_t i = 0 ; i < count / threads ; i++ ) {
+							async->Log( MakeRecord( thread, i ) );
+						}
+					}
+				}, canceled, 1
+			);
+			const uint64_t ns = std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::steady_clock::now() - begin ).count();
+			task->LogRate( "logging threads", count, ns, "messages" );
+			async->Flush();
+			task->LogBenchmark( "    dropped: " + std::to_string( async->GetDroppedCount() ) + " ( at most " + std::to_string( logger::Async::RING_SIZE ) + " pending messages per thread )" );
+			delete async;
+		}
+	);
+
+	task->AddBenchmark(
+		"1M debug logs filtered out by --log-level",
+		BM() {
+			const size_t count = 1000000;
+			const auto level = logger::g_level.load();
+			logger::g_level = logger::LL_INFO;
+
+			// message is built and then discarded
+			size_t eager_bytes = 0;
+			const auto eager_ns = task->Measure(
+				[ &eager_bytes ]() {
+					for ( size_t i = 0 ; i < count ; i++ ) {
+						const auto text = "Spawning unit #" + std::to_string( i ) + " ( ScoutPatrol ) at Tile( 40, 20 )";
+						if ( common::Class::IsLogged( logger::LL_DEBUG ) ) {
+							eager_bytes += text.size();
+						}
+					}
+				}
+			);
+			task->LogRate( "eager formatting", count, eager_ns, "messages" );
+
+			// what LOG_AT does
+			size_t lazy_bytes = 0;
+			const auto lazy_ns = task->Measure(
+				[ &lazy_bytes ]() {
+					for ( size_t i = 0 ; i < count ; i++ ) {
+						if ( common::Class::IsLogged( logger::LL_DEBUG ) ) {
+							lazy_bytes += ( "Spawning unit #" + std::to_string( i ) + " ( ScoutPatrol ) at Tile( 40, 20 )" ).size();
+						}
+					}
+				}
+			);
+			task->LogRate( "LOG_AT", count, lazy_ns, "messages" );
+
+			logger::g_level = level;
+		}
+	);
+
+}
+
+}
+}
@@ -0,0 +1,530 @@
+#include "Network.h"
+
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <unordered_map>
+
+#ifndef _WIN32
+
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <poll.h>
+
+#endif
+
+#include "Benchmarks.h"
+#include "Serialization.h"
+
+#include "common/Thread.h"
+#include "network/simpletcp/SimpleTCP.h"
+#include "types/Packet.h"
+#include "types/Buffer.h"
+#include "game/backend/connection/Snapshot.h"
+#include "game/backend/map/tile/Tiles.h"
+
+namespace task {
+namespace benchmarks {
+
+#ifndef _WIN32
+
+// only to know where to connect
+CLASS( LoopbackServer, network::simpletcp::SimpleTCP )
+	static const int PORT = GLSMAC_PORT;
+};
+
+static const network::MT_Response WaitForResult( network::Network* const network, const common::mt_id_t mt_id ) {
+	while ( true ) {
+		const auto result = network->MT_GetResult( mt_id );
+		if ( result.result != network::R_NONE ) {
+			return result;
+		}
+		std::this_thread::sleep_for( std::chrono::microseconds( 50 ) );
+	}
+}
+
+static bool SendAll( const int fd, const char* data, size_t size ) {
+	while ( size ) {
+		const auto sent = send( fd, data, size, MSG_NOSIGNAL );
+		if ( sent <= 0 ) {
+			return false;
+		}
+		data += sent;
+		size -= sent;
+	}
+	return true;
+}
+
+static bool ReceiveAll( const int fd, char* data, size_t size ) {
+	while ( size ) {
+		const auto received = recv( fd, data, size, 0 );
+		if ( received <= 0 ) {
+			return false;
+		}
+		data += received;
+		size -= received;
+	}
+	return true;
+}
+
+#endif
+
+void AddNetworkBenchmarks( Benchmarks* task ) {
+
+#ifndef _WIN32
+
+	task->AddBenchmark(
+		"SimpleTCP loopback echo, 32 clients",
+		BM() {
+			const size_t clients_count = 32;
+			const size_t packets_per_client = 1000;
+			const size_t window = 8; // packets in flight per client
+			const size_t payload_size = 64;
+
+			// server runs in thread with same rate as real network thread
+			LoopbackServer* server;
+			NEW( server, LoopbackServer );
+			common::Thread* thread;
+			NEW( thread, common::Thread, "NETWORK" );
+			thread->SetIPS( 100 );
+			thread->AddModule( server );
+			thread->T_Start();
+
+			const auto stop_server = [ server, thread ]() {
+				thread->T_Stop();
+				while ( thread->T_IsRunning() ) {
+					std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+				}
+				DELETE( thread );
+				DELETE( server );
+			};
+
+			if ( WaitForResult( server, server->MT_Connect( network::CM_SERVER ) ).result != network::R_SUCCESS ) {
+				task->LogBenchmark( "    failed to start server" );
+				stop_server();
+				return;
+			}
+
+			// echoes packets back through same MT requests as game does
+			std::atomic< bool > is_done = false;
+			std::thread echo(
+				[ server, &is_done ]() {
+					std::vector< common::mt_id_t > sends = {};
+					while ( !is_done ) {
+						const auto events = WaitForResult( server, server->MT_GetEvents() ).events;
+						for ( const auto& event : events ) {
+							if ( event.type == network::Event::ET_PACKET ) {
+								sends.push_back( server->MT_SendEvent( event ) );
+							}
+						}
+						sends.erase(
+							std::remove_if(
+								sends.begin(), sends.end(), [ server ]( const common::mt_id_t mt_id ) {
+									return server->MT_GetResult( mt_id ).result != network::R_NONE;
+								}
+							), sends.end()
+						);
+						if ( events.empty() ) {
+							std::this_thread::sleep_for( std::chrono::microseconds( 50 ) );
+						}
+					}
+					for ( const auto mt_id : sends ) {
+						WaitForResult( server, mt_id );
+					}
+				}
+			);
+
+			std::atomic< bool > is_started = false;
+			std::atomic< size_t > failed_clients = 0;
+			std::vector< std::vector< uint64_t > > latencies( clients_count );
+			std::vector< std::thread > clients = {};
+			for ( size_t c = 0 ; c < clients_count ; c++ ) {
+				clients.emplace_back(
+					[ &is_started, &failed_clients, &latencies, c ]() {
+						auto& client_latencies = latencies[ c ];
+						client_latencies.reserve( packets_per_client );
+
+						const int fd = socket( AF_INET, SOCK_STREAM, 0 );
+						int one = 1;
+						setsockopt( fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof( one ) );
+						struct timeval timeout = {
+							5,
+							0
+						};
+						setsockopt( fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof( timeout ) );
+						struct sockaddr_in addr = {};
+						addr.sin_family = AF_INET;
+						addr.sin_port = htons( LoopbackServer::PORT );
+						addr.sin_addr.s_addr = htonl( INADDR_LOOPBACK );
+						if ( connect( fd, (struct sockaddr*)&addr, sizeof( addr ) ) == -1 ) {
+							failed_clients++;
+							close( fd );
+							return;
+						}
+
+						while ( !is_started ) {
+							std::this_thread::yield();
+						}
+
+						types::Packet packet( types::Packet::PT_MESSAGE );
+						packet.data.str.resize( payload_size );
+						const auto send_packet = [ fd, &packet ]() -> bool {
+							const uint64_t now = std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::steady_clock::now().time_since_epoch() ).count();
+							memcpy( packet.data.str.data(), &now, sizeof( now ) );
+							const auto data = packet.Serialize().ToString();
+							const int32_t size = data.size();
+							std::string frame( (const char*)&size, sizeof( size ) );
+							frame += data;
+							return SendAll( fd, frame.data(), frame.size() );
+						};
+
+						size_t sent = 0;
+						bool ok = true;
+						while ( ok && sent < window ) {
+							ok = send_packet();
+							sent++;
+						}
+						std::string data = {};
+						while ( ok && client_latencies.size() < packets_per_client ) {
+							int32_t size;
+							if ( !ReceiveAll( fd, (char*)&size, sizeof( size ) ) || size <= 0 ) {
+								ok = false;
+								break;
+							}
+							data.resize( size );
+							if ( !ReceiveAll( fd, data.data(), size ) ) {
+								ok = false;
+								break;
+							}
+							types::Packet response( types::Packet::PT_NONE );
+							response.Deserialize( types::Buffer( data ) );
+							uint64_t sent_at;
+							memcpy( &sent_at, response.data.str.data(), sizeof( sent_at ) );
+							const uint64_t now = std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::steady_clock::now().time_since_epoch() ).count();
+							client_latencies.push_back( now - sent_at );
+							if ( sent < packets_per_client ) {
+								ok = send_packet();
+								sent++;
+							}
+						}
+						if ( !ok ) {
+							failed_clients++;
+						}
+
+						// 'bye'
+						const int32_t bye = 0;
+						SendAll( fd, (const char*)&bye, sizeof( bye ) );
+						close( fd );
+					}
+				);
+			}
+
+			// let server accept everyone before measuring
+			std::this_thread::sleep_for( std::chrono::milliseconds( 100 ) );
+			const auto begin = std::chrono::steady_clock::now();
+			is_started = true;
+			for ( auto& client : clients ) {
+				client.join();
+			}
+			const uint64_t ns = std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::steady_clock::now() - begin ).count();
+
+			is_done = true;
+			echo.join();
+			WaitForResult( server, server->MT_Disconnect() );
+			stop_server();
+
+			if ( failed_clients ) {
+				task->LogBenchmark( "    " + std::to_string( failed_clients ) + " client(s) failed" );
+			}
+			std::vector< uint64_t > all_latencies = {};
+			for ( const auto& client_latencies : latencies ) {
+				all_latencies.insert( all_latencies.end(), client_latencies.begin(), client_latencies.end() );
+			}
+			if ( all_latencies.empty() ) {
+				return;
+			}
+			std::sort( all_latencies.begin(), all_latencies.end() );
+
+			task->LogRate( "round trips ( " + std::to_string( window ) + " in flight per client )", all_latencies.size(), ns, "packets" );
+			task->LogDuration( "p50 latency", all_latencies[ all_latencies.size() / 2 ] );
+			task->LogDuration( "p99 latency", all_latencies[ all_latencies.size() * 99 / 100 ] );
+		}
+	);
+
+	task->AddBenchmark(
+		"world snapshot download, 8 clients joining at once, 10ms round trip",
+		BM() {
+			typedef game::backend::connection::Snapshot Snapshot;
+			const size_t clients_count = 8;
+			const auto latency = std::chrono::milliseconds( 10 );
+
+			struct config_t {
+				std::string name;
+				size_t window;
+				size_t chunk_size;
+				bool is_shared;
+				bool is_compressed;
+			};
+			const std::vector< config_t > configs = {
+				{ "stop-and-wait, snapshot per client ( previous )", 1, 16384, false, false },
+				{ "window of 8, shared snapshot", 8, 16384, true, false },
+				{ "window of 8, shared compressed snapshot", 8, 16384, true, true },
+				{ "window of 16 with 32KB chunks, shared snapshot", 16, 32768, true, false },
+				{ "window of 16 with 32KB chunks, shared compressed snapshot", 16, 32768, true, true },
+			};
+
+			game::backend::map::tile::Tiles tiles( 160, 80 );
+			FillTiles( tiles );
+			const auto f_serialize = [ &tiles ]() -> std::string {
+				return tiles.Serialize().ToString();
+			};
+			const auto expected = f_serialize();
+
+			LoopbackServer* server;
+			NEW( server, LoopbackServer );
+			common::Thread* thread;
+			NEW( thread, common::Thread, "NETWORK" );
+			thread->SetIPS( 100 );
+			thread->AddModule( server );
+			thread->T_Start();
+
+			const auto stop_server = [ server, thread ]() {
+				thread->T_Stop();
+				while ( thread->T_IsRunning() ) {
+					std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+				}
+				DELETE( thread );
+				DELETE( server );
+			};
+
+			if ( WaitForResult( server, server->MT_Connect( network::CM_SERVER ) ).result != network::R_SUCCESS ) {
+				task->LogBenchmark( "    failed to start server" );
+				stop_server();
+				return;
+			}
+
+			task->LogBenchmark( "    snapshot is " + std::to_string( expected.size() ) + " bytes" );
+
+			for ( const auto& config : configs ) {
+
+				// handles download packets same way as connection::Server does
+				std::atomic< bool > is_done = false;
+				std::atomic< size_t > snapshots_built = 0;
+				size_t sent_bytes = 0;
+				std::thread responder(
+					[ server, &config, &f_serialize, &is_done, &snapshots_built, &sent_bytes ]() {
+						struct download_t {
+							size_t next_offset;
+							std::shared_ptr< const Snapshot > snapshot;
+						};
+						std::unordered_map< network::cid_t, download_t > downloads = {};
+						std::weak_ptr< const Snapshot > shared_snapshot = {};
+						std::vector< common::mt_id_t > sends = {};
+						while ( !is_done ) {
+							const auto events = WaitForResult( server, server->MT_GetEvents() ).events;
+							for ( const auto& event : events ) {
+								if ( event.type != network::Event::ET_PACKET ) {
+									continue;
+								}
+								types::Packet packet( types::Packet::PT_NONE );
+								packet.Deserialize( types::Buffer( event.data.packet_data ) );
+								if ( packet.type == types::Packet::PT_DOWNLOAD_REQUEST ) {
+									auto snapshot = config.is_shared
+										? shared_snapshot.lock()
+										: nullptr;
+									if ( !snapshot ) {
+										snapshot = std::make_shared< const Snapshot >( f_serialize(), config.chunk_size, config.is_compressed );
+										shared_snapshot = snapshot;
+										snapshots_built++;
+									}
+									downloads[ event.cid ] = {
+										0,
+										snapshot
+									};
+									types::Packet p( types::Packet::PT_DOWNLOAD_RESPONSE );
+									p.data.num = snapshot->GetSize();
+									p.udata.download.size = snapshot->GetChunkSize();
+									sends.push_back( server->MT_SendPacket( &p, event.cid ) );
+								}
+								else if ( packet.type == types::Packet::PT_DOWNLOAD_NEXT_CHUNK_REQUEST ) {
+									const auto it = downloads.find( event.cid );
+									if ( it == downloads.end() || packet.udata.download.offset != it->second.next_offset ) {
+										continue;
+									}
+									types::Packet p( types::Packet::PT_DOWNLOAD_NEXT_CHUNK_RESPONSE );
+									it->second.snapshot->WriteChunk( packet.udata.download.offset, p );
+									sent_bytes += p.data.str.size();
+									sends.push_back( server->MT_SendPacket( &p, event.cid ) );
+									it->second.next_offset += packet.udata.download.size;
+									if ( it->second.next_offset >= it->second.snapshot->GetSize() ) {
+										downloads.erase( it );
+									}
+								}
+							}
+							sends.erase(
+								std::remove_if(
+									sends.begin(), sends.end(), [ server ]( const common::mt_id_t mt_id ) {
+										return server->MT_GetResult( mt_id ).result != network::R_NONE;
+									}
+								), sends.end()
+							);
+							if ( events.empty() ) {
+								std::this_thread::sleep_for( std::chrono::microseconds( 50 ) );
+							}
+						}
+						for ( const auto mt_id : sends ) {
+							WaitForResult( server, mt_id );
+						}
+					}
+				);
+
+				std::atomic< bool > is_started = false;
+				std::atomic< size_t > failed_clients = 0;
+				std::vector< std::thread > clients = {};
+				for ( size_t c = 0 ; c < clients_count ; c++ ) {
+					clients.emplace_back(
+						[ &config, &is_started, &failed_clients, &expected, latency ]() {
+							const int fd = socket( AF_INET, SOCK_STREAM, 0 );
+							int one = 1;
+							setsockopt( fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof( one ) );
+							struct sockaddr_in addr = {};
+							addr.sin_family = AF_INET;
+							addr.sin_port = htons( LoopbackServer::PORT );
+							addr.sin_addr.s_addr = htonl( INADDR_LOOPBACK );
+							if ( connect( fd, (struct sockaddr*)&addr, sizeof( addr ) ) == -1 ) {
+								failed_clients++;
+								close( fd );
+								return;
+							}
+
+							while ( !is_started ) {
+								std::this_thread::yield();
+							}
+
+							// requests are held back for one round trip to simulate latency
+							typedef std::chrono::steady_clock::time_point time_point_t;
+							std::deque< std::pair< time_point_t, std::string > > outgoing = {};
+							const auto f_queue = [ &outgoing, latency ]( const types::Packet& packet ) {
+								const auto data = packet.Serialize().ToString();
+								const int32_t size = data.size();
+								std::string frame( (const char*)&size, sizeof( size ) );
+								frame += data;
+								outgoing.push_back(
+									{
+										std::chrono::steady_clock::now() + latency,
+										frame
+									}
+								);
+							};
+
+							size_t total_size = 0;
+							size_t chunk_size = 0;
+							size_t requested_size = 0;
+							std::string buffer = {};
+							const auto f_request_chunks = [ &config, &f_queue, &total_size, &chunk_size, &requested_size, &buffer ]() {
+								while ( requested_size < total_size && requested_size - buffer.size() < config.window * chunk_size ) {
+									types::Packet p( types::Packet::PT_DOWNLOAD_NEXT_CHUNK_REQUEST );
+									p.udata.download.offset = requested_size;
+									p.udata.download.size = std::min( chunk_size, total_size - requested_size );
+									f_queue( p );
+									requested_size += p.udata.download.size;
+								}
+							};
+
+							f_queue( types::Packet( types::Packet::PT_DOWNLOAD_REQUEST ) );
+							bool ok = true;
+							std::string data = {};
+							while ( ok && ( !total_size || buffer.size() < total_size ) ) {
+								const auto now = std::chrono::steady_clock::now();
+								while ( ok && !outgoing.empty() && outgoing.front().first <= now ) {
+									ok = SendAll( fd, outgoing.front().second.data(), outgoing.front().second.size() );
+									outgoing.pop_front();
+								}
+								int timeout_ms = 5000;
+								if ( !outgoing.empty() ) {
+									timeout_ms = std::chrono::duration_cast< std::chrono::milliseconds >( outgoing.front().first - now ).count() + 1;
+								}
+								struct pollfd pfd = {
+									fd,
+									POLLIN,
+									0
+								};
+								const auto polled = poll( &pfd, 1, timeout_ms );
+								if ( polled < 0 || ( polled == 0 && outgoing.empty() ) ) {
+									ok = false;
+									break;
+								}
+								if ( polled == 0 ) {
+									continue;
+								}
+								int32_t size;
+								if ( !ReceiveAll( fd, (char*)&size, sizeof( size ) ) || size <= 0 ) {
+									ok = false;
+									break;
+								}
+								data.resize( size );
+								if ( !ReceiveAll( fd, data.data(), size ) ) {
+									ok = false;
+									break;
+								}
+								types::Packet response( types::Packet::PT_NONE );
+								response.Deserialize( types::Buffer( data ) );
+								if ( response.type == types::Packet::PT_DOWNLOAD_RESPONSE ) {
+									total_size = response.data.num;
+									chunk_size = response.udata.download.size;
+									buffer.reserve( total_size );
+								}
+								else if ( response.type == types::Packet::PT_DOWNLOAD_NEXT_CHUNK_RESPONSE ) {
+									ok = response.udata.download.offset == buffer.size() && Snapshot::ReadChunk( response, buffer );
+								}
+								f_request_chunks();
+							}
+							if ( !ok || buffer != expected ) {
+								failed_clients++;
+							}
+
+							// 'bye'
+							const int32_t bye = 0;
+							SendAll( fd, (const char*)&bye, sizeof( bye ) );
+							close( fd );
+						}
+					);
+				}
+
+				// let server accept everyone before measuring
+				std::this_thread::sleep_for( std::chrono::milliseconds( 100 ) );
+				const auto begin = std::chrono::steady_clock::now();
+				is_started = true;
+				for ( auto& client : clients ) {
+					client.join();
+				}
+				const uint64_t ns = std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::steady_clock::now() - begin ).count();
+				is_done = true;
+				responder.join();
+
+				if ( failed_clients ) {
+					task->LogBenchmark( "    " + std::to_string( failed_clients ) + " client(s) failed" );
+				}
+				task->LogDuration( config.name, ns );
+				task->LogBenchmark( "      ( " + std::to_string( snapshots_built ) + " snapshot(s) built, " + std::to_string( sent_bytes / clients_count ) + " bytes sent per client )" );
+			}
+
+			WaitForResult( server, server->MT_Disconnect() );
+			stop_server();
+		}
+	);
+
+#endif
+
+}
+
+}
+}
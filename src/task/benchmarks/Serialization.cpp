@@ -0,0 +1,184 @@
+#include "Serialization.h"
+
+#include "Benchmarks.h"
+
+#include "types/Buffer.h"
+#include "game/backend/map/tile/Tiles.h"
+#include "util/random/Random.h"
+
+namespace task {
+namespace benchmarks {
+
+void FillTiles( game::backend::map::tile::Tiles& tiles ) {
+	using namespace game::backend::map::tile;
+	util::random::Random random( 12345 );
+	for ( size_t y = 0 ; y < tiles.GetHeight() ; y++ ) {
+		for ( size_t x = y & 1 ; x < tiles.GetWidth() ; x += 2 ) {
+			auto& tile = tiles.At( x, y );
+			for ( auto& c : tile.elevation.corners ) {
+				*c = random.GetInt64( ELEVATION_MIN, ELEVATION_MAX );
+			}
+			tile.moisture = random.GetUInt( MOISTURE_ARID, MOISTURE_RAINY );
+			tile.rockiness = random.GetUInt( ROCKINESS_FLAT, ROCKINESS_ROCKY );
+			tile.bonus = random.GetUInt( BONUS_NONE, BONUS_MINERALS );
+			tile.features = random.GetUInt( 0, FEATURE_DUNES );
+			tile.terraforming = random.GetUInt( 0, TERRAFORMING_AIRBASE );
+			tile.yields = {
+				{ "Nutrients", random.GetUInt( 0, 4 ) },
+				{ "Minerals",  random.GetUInt( 0, 4 ) },
+				{ "Energy",    random.GetUInt( 0, 4 ) },
+			};
+			tile.Update();
+		}
+	}
+}
+
+void AddSerializationBenchmarks( Benchmarks* task ) {
+
+	task->AddBenchmark(
+		"serialize and deserialize full Tiles object ( 256x128 )",
+		BM() {
+			game::backend::map::tile::Tiles tiles( 256, 128 );
+			FillTiles( tiles );
+
+			size_t size = 0;
+			const auto serialize_ns = task->Measure(
+				[ &tiles, &size ]() {
+					const auto buf = tiles.Serialize();
+					size = buf.lenw;
+				}
+			);
+			task->LogThroughput( "Tiles::Serialize", size, serialize_ns );
+
+			const auto serialized = tiles.Serialize();
+			const auto deserialize_ns = task->Measure(
+				[ &serialized ]() {
+					game::backend::map::tile::Tiles t;
+					t.Deserialize( serialized );
+				}
+			);
+			task->LogThroughput( "Tiles::Deserialize", serialized.lenw, deserialize_ns );
+		}
+	);
+
+	task->AddBenchmark(
+		"write and read 1M strings to/from types::Buffer",
+		BM() {
+			const size_t count = 1000000;
+			const std::string value = "0123456789abcdef0123456789abcdef";
+
+			size_t size = 0;
+			const auto write_ns = task->Measure(
+				[ &value, &size ]() {
+					types::Buffer buf;
+					for ( size_t i = 0 ; i < count ; i++ ) {
+						buf.WriteString( value );
+					}
+					size = buf.lenw;
+				}
+			);
+			task->LogThroughput( "WriteString", size, write_ns );
+
+			const auto reserved_write_ns = task->Measure(
+				[ &value, &size ]() {
+					types::Buffer buf;
+					buf.Reserve( size );
+					for ( size_t i = 0 ; i < count ; i++ ) {
+						buf.WriteString( value );
+					}
+				}
+			);
+			task->LogThroughput( "WriteString ( with Reserve )", size, reserved_write_ns );
+
+			types::Buffer buf;
+			for ( size_t i = 0 ; i < count ; i++ ) {
+				buf.WriteString( value );
+			}
+
+			const auto read_ns = task->Measure(
+				[ &buf ]() {
+					types::Buffer b = buf;
+					for ( size_t i = 0 ; i < count ; i++ ) {
+						b.ReadString();
+					}
+				}
+			);
+			task->LogThroughput( "ReadString", buf.lenw, read_ns );
+
+			const auto read_view_ns = task->Measure(
+				[ &buf ]() {
+					types::Buffer b = buf;
+					for ( size_t i = 0 ; i < count ; i++ ) {
+						b.ReadStringView();
+					}
+				}
+			);
+			task->LogThroughput( "ReadStringView", buf.lenw, read_view_ns );
+		}
+	);
+
+	task->AddBenchmark(
+		"write and read 100k records nested 3 levels deep",
+		BM() {
+			const size_t count = 100000;
+
+			const auto write_record = []( types::Buffer& b, const size_t i ) {
+				b.WriteInt( i );
+				b.WriteFloat( i * 0.5f );
+				b.WriteString( "record" );
+			};
+
+			size_t size = 0;
+			const auto copy_ns = task->Measure(
+				[ &write_record, &size ]() {
+					types::Buffer buf;
+					for ( size_t i = 0 ; i < count ; i++ ) {
+						types::Buffer outer;
+						types::Buffer inner;
+						write_record( inner, i );
+						outer.WriteString( inner.ToStringView() );
+						buf.WriteString( outer.ToStringView() );
+					}
+					size = buf.lenw;
+				}
+			);
+			task->LogThroughput( "nested WriteString", size, copy_ns );
+
+			types::Buffer buf;
+			const auto nested_ns = task->Measure(
+				[ &write_record, &buf ]() {
+					buf = types::Buffer();
+					for ( size_t i = 0 ; i < count ; i++ ) {
+						buf.WriteNested(
+							[ &write_record, i ]( types::Buffer& outer ) {
+								outer.WriteNested(
+									[ &write_record, i ]( types::Buffer& inner ) {
+										write_record( inner, i );
+									}
+								);
+							}
+						);
+					}
+				}
+			);
+			task->LogThroughput( "WriteNested", buf.lenw, nested_ns );
+
+			const auto read_ns = task->Measure(
+				[ &buf ]() {
+					types::Buffer b = buf;
+					for ( size_t i = 0 ; i < count ; i++ ) {
+						auto inner = b.ReadNested().ReadNested();
+						inner.ReadInt();
+						inner.ReadFloat();
+						inner.ReadStringView();
+					}
+				}
+			);
+			task->LogThroughput( "ReadNested", buf.lenw, read_ns );
+		}
+	);
+
+}
+
+}
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+namespace game {
+namespace backend {
+namespace map {
+namespace tile {
+class Tiles;
+}
+}
+}
+}
+
+namespace task {
+namespace benchmarks {
+
+class Benchmarks;
+
+void AddSerializationBenchmarks( Benchmarks* task );
+
+// random but deterministic map contents, for benchmarks that need realistic serialized world
+void FillTiles( game::backend::map::tile::Tiles& tiles );
+
+}
+}
@@ -0,0 +1,70 @@
+#include "ThreadPool.h"
+
+#include <vector>
+
+#include "Benchmarks.h"
+
+#include "engine/Engine.h"
+#include "common/ThreadPool.h"
+#include "util/Perlin.h"
+
+namespace task {
+namespace benchmarks {
+
+void AddThreadPoolBenchmarks( Benchmarks* task ) {
+
+	task->AddBenchmark(
+		"perlin noise for 512x256 tiles ( same work as map generator elevations )",
+		BM() {
+			auto* pool = g_engine->GetThreadPool();
+			const size_t w = 512;
+			const size_t h = 256;
+			const util::Perlin perlin( 12345 );
+			std::vector< float > values( w * h );
+
+			const auto f = [ &perlin, &values ]( const size_t from, const size_t to ) {
+				for ( size_t i = from ; i < to ; i++ ) {
+					values[ i ] = perlin.Noise( (float)( i % w ), (float)( i / w ) + 0.5f, 0.0f, 128 );
+				}
+			};
+
+			const auto serial_ns = task->Measure(
+				[ &f, &values ]() {
+					f( 0, values.size() );
+				}
+			);
+			task->LogRate( "serial", values.size(), serial_ns, "tiles" );
+
+			common::mt_flag_t canceled = false;
+			const auto parallel_ns = task->Measure(
+				[ pool, &f, &values, &canceled ]() {
+					pool->ParallelFor( 0, values.size(), f, canceled );
+				}
+			);
+			task->LogRate( "ParallelFor ( " + std::to_string( pool->GetConcurrency() ) + " threads )", values.size(), parallel_ns, "tiles" );
+		}
+	);
+
+	task->AddBenchmark(
+		"fork/join overhead of 100k empty tasks",
+		BM() {
+			auto* pool = g_engine->GetThreadPool();
+			const size_t count = 100000;
+			common::mt_flag_t canceled = false;
+			const auto ns = task->Measure(
+				[ pool, &canceled ]() {
+					common::ThreadPool::TaskGroup group( pool, canceled );
+					for ( size_t i = 0 ; i < count ; i++ ) {
+						group.Run( []() {} );
+					}
+					group.Wait();
+				}
+			);
+			task->LogRate( "TaskGroup::Run", count, ns, "tasks" );
+		}
+	);
+
+}
+
+}
+}
@@ -0,0 +1,218 @@
+#include "TileDeltas.h"
+
+#include <vector>
+#include <string>
+#include <unordered_set>
+#include <cstdlib>
+
+#include "Benchmarks.h"
+
+#include "game/backend/map/tile/Tiles.h"
+#include "game/backend/map/tile/Tile.h"
+#include "game/backend/map/tile/TileState.h"
+#include "game/backend/map/tile/View.h"
+#include "game/frontend/tile/Tile.h"
+#include "util/random/Random.h"
+
+namespace task {
+namespace benchmarks {
+
+void AddTileDeltasBenchmarks( Benchmarks* task ) {
+
+	task->AddBenchmark(
+		"tile updates around one map editor stroke with 9x9 brush",
+		BM() {
+			namespace tile = game::backend::map::tile;
+			typedef tile::View View;
+			typedef game::frontend::tile::Tile FrontendTile;
+			const size_t width = 100;
+			const size_t height = 100;
+			const ssize_t brush_width = 9; // same diagonal square as map_editor::brush::Square draws
+			const ssize_t reload_width = brush_width + 2; // neighbours of brush tiles get their corners changed too
+
+			// only tiles with even x + y exist, center is far from edges so no wrapping is needed
+			const ssize_t cx = 50;
+			const ssize_t cy = 50;
+			tile::Tiles tiles( width, height );
+			std::vector< tile::Tile* > reloaded = {};
+			std::vector< tile::Tile* > brush = {};
+			for ( ssize_t dy = -reload_width ; dy <= reload_width ; dy++ ) {
+				for ( ssize_t dx = -reload_width ; dx <= reload_width ; dx++ ) {
+					const ssize_t distance = std::abs( dx ) + std::abs( dy );
+					if ( ( dx & 1 ) != ( dy & 1 ) || distance > reload_width ) {
+						continue;
+					}
+					auto* t = &tiles.At( cx + dx, cy + dy );
+					reloaded.push_back( t );
+					if ( distance <= brush_width ) {
+						brush.push_back( t );
+					}
+				}
+			}
+			const size_t count = reloaded.size();
+
+			util::random::Random random( 12345 );
+			std::vector< tile::TileState > states( count );
+			for ( size_t i = 0 ; i < count ; i++ ) {
+				auto* t = reloaded[ i ];
+				*t->elevation.center = random.GetInt64( -500, 1500 );
+				for ( auto* e : t->elevation.corners ) {
+					*e = random.GetInt64( -500, 1500 );
+				}
+				t->is_water_tile = false;
+				t->moisture = random.GetUInt( 1, 3 );
+				t->rockiness = random.GetUInt( 1, 3 );
+				t->bonus = tile::BONUS_NONE;
+				t->features = tile::FEATURE_NONE;
+				t->terraforming = tile::TERRAFORMING_NONE;
+				t->yields = {
+					{ "Nutrients", 1 },
+					{ "Minerals", 0 },
+					{ "Energy", 1 }
+				};
+				auto& ts = states[ i ];
+				ts.is_coastline_corner = false;
+				for ( auto& l : ts.layers ) {
+					for ( auto* v : { &l.coords.center, &l.coords.left, &l.coords.top, &l.coords.right, &l.coords.bottom } ) {
+						*v = {
+							random.GetFloat( -1.0f, 1.0f ),
+							random.GetFloat( -1.0f, 1.0f ),
+							random.GetFloat( -1.0f, 1.0f )
+						};
+					}
+					for ( auto* v : { &l.tex_coords.center, &l.tex_coords.left, &l.tex_coords.top, &l.tex_coords.right, &l.tex_coords.bottom } ) {
+						*v = {
+							random.GetFloat( 0.0f, 1.0f ),
+							random.GetFloat( 0.0f, 1.0f )
+						};
+					}
+					for ( auto* c : { &l.colors.center, &l.colors.left, &l.colors.top, &l.colors.right, &l.colors.bottom } ) {
+						*c = types::Color( random.GetFloat( 0.0f, 1.0f ), random.GetFloat( 0.0f, 1.0f ), random.GetFloat( 0.0f, 1.0f ) );
+					}
+				}
+				ts.sprites = {
+					{ "Forest", 0, "Forest", {} }
+				};
+			}
+
+			// what backend sent and what frontend shows before stroke
+			std::vector< View > sent( count );
+			std::vector< FrontendTile* > frontend_tiles( width * height, nullptr );
+			for ( size_t i = 0 ; i < count ; i++ ) {
+				auto* t = reloaded[ i ];
+				sent[ i ].Set( t, &states[ i ] );
+				NEWV( frontend_tile, FrontendTile, t->coord );
+				frontend_tile->Update( *t, states[ i ] );
+				frontend_tiles[ t->coord.y * width + t->coord.x ] = frontend_tile;
+			}
+
+			// raising elevation moves corners ( shared with neighbours ), vertical coords and shading of land,
+			// but textures, features, yields etc stay
+			std::unordered_set< tile::elevation_t* > raised = {};
+			for ( auto* t : brush ) {
+				raised.insert( t->elevation.center );
+				raised.insert( t->elevation.corners.begin(), t->elevation.corners.end() );
+			}
+			for ( auto* e : raised ) {
+				*e += 500;
+			}
+			for ( size_t i = 0 ; i < count ; i++ ) {
+				const auto* t = reloaded[ i ];
+				const tile::elevation_t* const elevations[ View::CORNERS ] = {
+					t->elevation.center,
+					t->elevation.left,
+					t->elevation.top,
+					t->elevation.right,
+					t->elevation.bottom,
+				};
+				for ( const auto layer : { tile::LAYER_LAND, tile::LAYER_WATER } ) {
+					auto& l = states[ i ].layers[ layer ];
+					types::Vec3* const coords[ View::CORNERS ] = { &l.coords.center, &l.coords.left, &l.coords.top, &l.coords.right, &l.coords.bottom };
+					types::Color* const colors[ View::CORNERS ] = { &l.colors.center, &l.colors.left, &l.colors.top, &l.colors.right, &l.colors.bottom };
+					for ( size_t c = 0 ; c < View::CORNERS ; c++ ) {
+						if ( *elevations[ c ] != sent[ i ].elevations[ c ] ) {
+							coords[ c ]->z -= 0.1f;
+							colors[ c ]->value.red *= 0.9f;
+						}
+					}
+				}
+			}
+
+			const auto measure = [ &task, &reloaded, &states, &sent, &frontend_tiles, count ]( const std::string& label ) {
+
+				// previous approach: request carried pointers to backend tiles and tile states,
+				// frontend read them and rebuilt everything about every reloaded tile ( Tile::Update still does that, plus filling its view )
+				const auto update_ns = task->Measure(
+					[ &reloaded, &states, &frontend_tiles, count ]() {
+						for ( size_t i = 0 ; i < count ; i++ ) {
+							const auto* t = reloaded[ i ];
+							frontend_tiles[ t->coord.y * width + t->coord.x ]->Update( *t, states[ i ] );
+						}
+					}
+				);
+
+				// same as Game::PushTileUpdates, except sent views are kept so that every run encodes same deltas
+				std::vector< uint8_t > deltas = {};
+				size_t changed = 0;
+				const auto encode_ns = task->Measure(
+					[ &deltas, &changed, &reloaded, &states, &sent, count ]() {
+						deltas.clear();
+						changed = 0;
+						View view;
+						for ( size_t i = 0 ; i < count ; i++ ) {
+							view.Set( reloaded[ i ], &states[ i ] );
+							const auto fields = view.Compare( sent[ i ] );
+							if ( fields ) {
+								view.WriteDelta( deltas, reloaded[ i ]->coord, fields );
+								changed++;
+							}
+						}
+					}
+				);
+
+				// same as frontend Game handling FR_UPDATE_TILES
+				const auto apply_ns = task->Measure(
+					[ &deltas, &frontend_tiles ]() {
+						const uint8_t* ptr = deltas.data();
+						const uint8_t* const end = ptr + deltas.size();
+						while ( ptr < end ) {
+							const auto coords = View::ReadDeltaCoords( ptr, end );
+							frontend_tiles[ coords.y * width + coords.x ]->ApplyDelta( ptr, end );
+						}
+					}
+				);
+
+				for ( size_t i = 0 ; i < count ; i++ ) {
+					sent[ i ].Set( reloaded[ i ], &states[ i ] );
+				}
+
+				task->LogBenchmark( "  " + label + ": " + std::to_string( count ) + " tiles reloaded, " + std::to_string( changed ) + " of them changed" );
+				task->LogBenchmark( "    pointers: " + std::to_string( count * 2 * sizeof( void* ) ) + " bytes, but frontend reads whole backend tiles and tile states" );
+				task->LogBenchmark( "    deltas: " + std::to_string( deltas.size() ) + " bytes ( " + std::to_string( deltas.size() / count ) + " per tile )" );
+				task->LogDuration( "frontend Tile::Update of every reloaded tile", update_ns );
+				task->LogDuration( "backend compare and delta encode", encode_ns );
+				task->LogDuration( "frontend delta apply and refresh", apply_ns );
+				task->LogDuration( "deltas total", encode_ns + apply_ns );
+			};
+
+			// geometry changes, so frontend has to rebuild meshes either way
+			measure( "elevation stroke" );
+
+			// nothing visible changes, frontend only needs new values
+			for ( auto* t : reloaded ) {
+				t->yields.at( "Nutrients" )++;
+			}
+			measure( "yields change" );
+
+			for ( const auto& frontend_tile : frontend_tiles ) {
+				if ( frontend_tile ) {
+					DELETE( frontend_tile );
+				}
+			}
+		}
+	);
+
+}
+
+}
+}
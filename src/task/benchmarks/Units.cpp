@@ -0,0 +1,319 @@
+#include "Units.h"
+
+#include <vector>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <algorithm>
+
+#include "Benchmarks.h"
+
+#include "game/backend/unit/Store.h"
+#include "util/random/Random.h"
+
+namespace task {
+namespace benchmarks {
+
+void AddUnitsBenchmarks( Benchmarks* task ) {
+
+	task->AddBenchmark(
+		"50k units on 180x90 map ( unit store vs map of heap objects )",
+		BM() {
+			typedef game::backend::unit::Store Store;
+			const size_t count = 50000;
+			const size_t w = 180;
+			const size_t h = 90;
+			const size_t owners = 8;
+			const size_t queries = 1000;
+			const size_t radius = 3;
+
+			util::random::Random random( 12345 );
+			std::vector< Store::hot_t > hots( count );
+			for ( auto& hot : hots ) {
+				hot.y = random.GetUInt( 0, h - 1 );
+				hot.x = random.GetUInt( 0, w / 2 - 1 ) * 2 + hot.y % 2; // only tiles with even x + y exist
+				hot.owner = random.GetUInt( 0, owners - 1 );
+				hot.movement = 0.0f;
+				hot.health = 1.0f;
+				hot.morale = 0;
+			}
+			std::vector< std::pair< size_t, size_t > > centers( queries );
+			for ( auto& c : centers ) {
+				c.second = random.GetUInt( 0, h - 1 );
+				c.first = random.GetUInt( 0, w / 2 - 1 ) * 2 + c.second % 2;
+			}
+
+			// previous layout: id -> heap object, every access is pointer chase
+			std::map< size_t, std::unique_ptr< Store::hot_t > > units_map = {};
+			const auto map_add_ns = task->Measure(
+				[ &units_map, &hots ]() {
+					units_map.clear();
+					for ( size_t i = 0 ; i < count ; i++ ) {
+						units_map.insert(
+							{
+								i + 1,
+								std::make_unique< Store::hot_t >( hots[ i ] )
+							}
+						);
+					}
+				}
+			);
+			task->LogRate( "std::map insert", count, map_add_ns, "units" );
+
+			Store store;
+			const auto store_add_ns = task->Measure(
+				[ &store, &hots ]() {
+					store.Clear();
+					store.SetMapSize( w, h );
+					for ( size_t i = 0 ; i < count ; i++ ) {
+						store.Add( i + 1, nullptr, hots[ i ] );
+					}
+				}
+			);
+			task->LogRate( "Store::Add", count, store_add_ns, "units" );
+
+			size_t found = 0;
+			const auto map_moves_ns = task->Measure(
+				[ &units_map, &found ]() {
+					for ( size_t owner = 0 ; owner < owners ; owner++ ) {
+						for ( const auto& it : units_map ) {
+							if ( it.second->owner == owner && it.second->movement >= 0.1f ) {
+								found++;
+								break;
+							}
+						}
+					}
+				}
+			);
+			task->LogRate( "moves left check, std::map", count * owners, map_moves_ns, "units" );
+
+			const auto store_moves_ns = task->Measure(
+				[ &store, &found ]() {
+					for ( size_t owner = 0 ; owner < owners ; owner++ ) {
+						if ( store.HasMovesLeft( owner, 0.1f ) ) {
+							found++;
+						}
+					}
+				}
+			);
+			task->LogRate( "moves left check, Store", count * owners, store_moves_ns, "units" );
+
+			std::vector< Store::hot_t* > map_result = {};
+			const auto map_radius_ns = task->Measure(
+				[ &units_map, &centers, &map_result ]() {
+					for ( const auto& c : centers ) {
+						map_result.clear();
+						for ( const auto& it : units_map ) {
+							const auto& u = *it.second;
+							size_t dx = u.x > c.first
+								? u.x - c.first
+								: c.first - u.x;
+							dx = std::min( dx, w - dx );
+							const size_t dy = u.y > c.second
+								? u.y - c.second
+								: c.second - u.y;
+							if ( u.owner == 0 && dx + dy <= radius * 2 ) {
+								map_result.push_back( it.second.get() );
+							}
+						}
+					}
+				}
+			);
+			task->LogRate( "units of player within " + std::to_string( radius ) + " tiles, std::map scan", queries, map_radius_ns, "queries" );
+
+			Store::units_t store_result = {};
+			size_t matches = 0;
+			const auto store_radius_ns = task->Measure(
+				[ &store, &centers, &store_result, &matches ]() {
+					for ( const auto& c : centers ) {
+						store_result.clear();
+						store.FindInRadius( c.first, c.second, radius, 0, store_result );
+						matches += store_result.size();
+					}
+				}
+			);
+			task->LogRate( "units of player within " + std::to_string( radius ) + " tiles, Store::FindInRadius", queries, store_radius_ns, "queries" );
+
+			const auto store_rect_ns = task->Measure(
+				[ &store, &centers, &store_result, &matches ]() {
+					for ( const auto& c : centers ) {
+						store_result.clear();
+						store.FindInRect( c.first, c.second, c.first + 15, c.second + 15, Store::ANY_OWNER, store_result );
+						matches += store_result.size();
+					}
+				}
+			);
+			task->LogRate( "all units in 16x16 rect, Store::FindInRect", queries, store_rect_ns, "queries" );
+
+			// every unit moves one tile diagonally and back, like during turn with all units moving
+			const auto store_update_ns = task->Measure(
+				[ &store, &hots ]() {
+					for ( size_t pass = 0 ; pass < 2 ; pass++ ) {
+						for ( size_t i = 0 ; i < count ; i++ ) {
+							auto hot = hots[ i ];
+							if ( !pass ) {
+								hot.x = ( hot.x + 1 ) % w;
+								hot.y = hot.y + 1 < h
+									? hot.y + 1
+									: hot.y - 1;
+							}
+							store.Update( i + 1, hot );
+						}
+					}
+				}
+			);
+			task->LogRate( "Store::Update with tile change", count * 2, store_update_ns, "units" );
+
+			const auto store_churn_ns = task->Measure(
+				[ &store, &hots ]() {
+					for ( size_t i = 0 ; i < count ; i += 10 ) {
+						store.Remove( i + 1 );
+					}
+					for ( size_t i = 0 ; i < count ; i += 10 ) {
+						store.Add( i + 1, nullptr, hots[ i ] );
+					}
+				}
+			);
+			task->LogRate( "Store::Remove and Store::Add of every 10th unit", count / 5, store_churn_ns, "operations" );
+
+			task->LogBenchmark( "    ( " + std::to_string( found + matches ) + " results )" );
+		}
+	);
+
+	task->AddBenchmark(
+		"mass move between tiles with 50-unit stacks ( order built on every render vs persistently sorted stack )",
+		BM() {
+			// mirrors what frontend::tile::Tile does with units, minus sprites
+			struct unit_t {
+				size_t id;
+				size_t weight;
+			};
+			const size_t stack_size = 50;
+			const size_t visible = 12; // rendered unit and fake badges
+			const size_t moves = 1000;
+
+			util::random::Random random( 12345 );
+			std::vector< unit_t > units( stack_size * 2 );
+			for ( size_t i = 0 ; i < units.size() ; i++ ) {
+				units[ i ].id = i + 1;
+				units[ i ].weight = random.GetUInt( 0, 400 );
+			}
+			std::vector< size_t > new_weights( moves );
+			for ( auto& w : new_weights ) {
+				w = random.GetUInt( 0, 400 );
+			}
+			size_t checksum = 0;
+
+			// previous approach: unordered map of units, order rebuilt through std::map of weights on every render
+			typedef std::unordered_map< size_t, unit_t* > tile_units_t;
+			const auto f_order = []( const tile_units_t& tile_units ) {
+				std::map< size_t, std::vector< size_t > > weights;
+				for ( auto& it : tile_units ) {
+					weights[ -it.second->weight ].push_back( it.first );
+				}
+				std::vector< size_t > result = {};
+				for ( const auto& it : weights ) {
+					for ( const auto& id : it.second ) {
+						result.push_back( id );
+					}
+				}
+				return result;
+			};
+			const auto f_render_old = [ &f_order, &checksum ]( const tile_units_t& tile_units ) {
+				const auto order = f_order( tile_units );
+				for ( size_t i = 0 ; i < order.size() && i < visible ; i++ ) {
+					checksum += tile_units.at( order[ i ] )->id;
+				}
+			};
+			// every move takes next unit to other tile
+			std::vector< size_t > locations( units.size() );
+			const auto f_reset = [ &locations ]() {
+				for ( size_t i = 0 ; i < locations.size() ; i++ ) {
+					locations[ i ] = i % 2;
+				}
+			};
+
+			std::vector< tile_units_t > old_tiles( 2 );
+			const auto old_ns = task->Measure(
+				[ &old_tiles, &units, &locations, &new_weights, &f_reset, &f_render_old ]() {
+					f_reset();
+					for ( auto& t : old_tiles ) {
+						t.clear();
+					}
+					for ( size_t i = 0 ; i < units.size() ; i++ ) {
+						old_tiles[ locations[ i ] ].insert( { units[ i ].id, &units[ i ] } );
+					}
+					for ( size_t i = 0 ; i < moves ; i++ ) {
+						const size_t u = i % units.size();
+						auto* unit = &units[ u ];
+						auto& src = old_tiles[ locations[ u ] ];
+						auto& dst = old_tiles[ 1 - locations[ u ] ];
+						locations[ u ] = 1 - locations[ u ];
+						src.erase( unit->id );
+						f_render_old( src );
+						dst.insert( { unit->id, unit } );
+						f_render_old( dst );
+						// weight change after move ( i.e. unit spent its moves ) rerenders tile again
+						unit->weight = new_weights[ i ];
+						f_render_old( dst );
+					}
+				}
+			);
+			task->LogRate( "unordered_map + order on render", moves, old_ns, "moves" );
+
+			// persistently sorted stack, updated in place
+			const auto f_before = []( const unit_t* a, const unit_t* b ) {
+				if ( a->weight != b->weight ) {
+					return a->weight > b->weight;
+				}
+				return a->id < b->id;
+			};
+			const auto f_render_new = [ &checksum ]( const std::vector< unit_t* >& stack ) {
+				for ( size_t i = 0 ; i < stack.size() && i < visible ; i++ ) {
+					checksum += stack[ i ]->id;
+				}
+			};
+			std::vector< std::vector< unit_t* > > new_tiles( 2 );
+			const auto new_ns = task->Measure(
+				[ &new_tiles, &units, &locations, &new_weights, &f_reset, &f_before, &f_render_new ]() {
+					f_reset();
+					for ( auto& t : new_tiles ) {
+						t.clear();
+					}
+					for ( size_t i = 0 ; i < units.size() ; i++ ) {
+						auto& stack = new_tiles[ locations[ i ] ];
+						stack.insert( std::lower_bound( stack.begin(), stack.end(), &units[ i ], f_before ), &units[ i ] );
+					}
+					for ( size_t i = 0 ; i < moves ; i++ ) {
+						const size_t u = i % units.size();
+						auto* unit = &units[ u ];
+						auto& src = new_tiles[ locations[ u ] ];
+						auto& dst = new_tiles[ 1 - locations[ u ] ];
+						locations[ u ] = 1 - locations[ u ];
+						src.erase( std::find( src.begin(), src.end(), unit ) );
+						f_render_new( src );
+						dst.insert( std::lower_bound( dst.begin(), dst.end(), unit, f_before ), unit );
+						f_render_new( dst );
+						unit->weight = new_weights[ i ];
+						const auto it = std::find( dst.begin(), dst.end(), unit );
+						const auto it_before = std::lower_bound( dst.begin(), it, unit, f_before );
+						if ( it_before != it ) {
+							std::rotate( it_before, it, it + 1 );
+						}
+						else {
+							std::rotate( it, it + 1, std::lower_bound( it + 1, dst.end(), unit, f_before ) );
+						}
+						f_render_new( dst );
+					}
+				}
+			);
+			task->LogRate( "sorted stack", moves, new_ns, "moves" );
+
+			task->LogBenchmark( "    ( checksum " + std::to_string( checksum ) + " )" );
+		}
+	);
+
+}
+
+}
+}
@@ -109,7 +109,7 @@ void GSEPrompt::Iterate() {
 	}
 }
 
-void GSEPrompt::GetReachableObjects( std::unordered_set< gc::Object* >& reachable_objects ) {
+void GSEPrompt::GetReachableObjects( gc::MarkStack& reachable_objects ) {
 	GC_DEBUG_BEGIN( "GSEPrompt" );
 	
 	if ( m_parser ) {
@@ -38,7 +38,7 @@ CLASS2( GSEPrompt, common::Task, gc::Object )
 	void Stop() override;
 	void Iterate() override;
 
-	void GetReachableObjects( std::unordered_set< gc::Object* >& reachable_objects ) override;
+	void GetReachableObjects( gc::MarkStack& reachable_objects ) override;
 
 private:
 	bool m_is_running = false;
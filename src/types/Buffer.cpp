@@ -1,9 +1,29 @@
 #include <cstring>
+#include <utility>
 
 #include "Buffer.h"
 
+#include "Serializable.h"
+
+#include "util/crc32/CRC32.h"
+
 namespace types {
 
+// low byte of crc32c is used as per-field checksum
+static inline Buffer::checksum_t FieldChecksum( const void* data, const uint32_t sz ) {
+	return (Buffer::checksum_t)util::crc32::CRC32::Calculate( data, sz );
+}
+
+// older data ( saves, maps ) used xor of all bytes as per-field checksum, it's still accepted on read if buffer is set to CV_XOR
+static Buffer::checksum_t LegacyFieldChecksum( const void* data, const uint32_t sz ) {
+	const Buffer::data_t* s = (const Buffer::data_t*)data;
+	Buffer::checksum_t c = 0;
+	for ( uint32_t i = 0 ; i < sz ; i++ ) {
+		c ^= s[ i ];
+	}
+	return c;
+}
+
 Buffer::Buffer() {
 	allocated_len = 0;
 	lenw = 0;
@@ -13,72 +33,157 @@ Buffer::Buffer() {
 	dr = nullptr;
 }
 
-Buffer::Buffer( const std::string& val ) {
+Buffer::Buffer( const std::string& val )
+	: Buffer( std::string_view( val ) ) {}
+
+Buffer::Buffer( const std::string_view& val ) {
 	allocated_len = val.size();
 	lenw = val.size();
 	lenr = 0;
-	data = (data_t*)malloc( lenw );
-	memcpy( ptr( data, 0, lenw ), val.data(), lenw );
+	if ( lenw > 0 ) {
+		data = (data_t*)malloc( lenw );
+		memcpy( ptr( data, 0, lenw ), val.data(), lenw );
+	}
+	else {
+		data = nullptr;
+	}
 	dw = data + lenw;
 	dr = data;
 }
 
 Buffer::~Buffer() {
-	if ( data ) {
-		free( data );
-	}
+	Free();
 }
 
 Buffer::Buffer( const Buffer& other ) {
-	allocated_len = other.allocated_len;
+	allocated_len = other.lenw;
 	lenw = other.lenw;
 	lenr = other.lenr;
-	if ( other.data ) {
+	if ( other.data && lenw > 0 ) {
 		data_t* newptr = (data_t*)malloc( lenw );
 		data = newptr;
-		memcpy( ptr( data, 0, lenw ), ptr( other.data, 0, other.lenw ), lenw );
+		memcpy( ptr( data, 0, lenw ), other.data, lenw ); // copy of view becomes regular buffer
 	}
 	else {
+		allocated_len = 0;
 		data = nullptr;
 	}
 	dw = data + lenw;
 	dr = data + lenr;
+	m_checksum_version = other.m_checksum_version;
+}
+
+Buffer::Buffer( Buffer&& other ) noexcept
+	: data( other.data )
+	, dw( other.dw )
+	, dr( other.dr )
+	, allocated_len( other.allocated_len )
+	, lenw( other.lenw )
+	, lenr( other.lenr )
+	, m_is_view( other.m_is_view )
+	, m_checksum_version( other.m_checksum_version ) {
+	other.allocated_len = 0;
+	other.lenw = 0;
+	other.lenr = 0;
+	other.data = nullptr;
+	other.dw = nullptr;
+	other.dr = nullptr;
+}
+
+Buffer& Buffer::operator=( const Buffer& other ) {
+	if ( this != &other ) {
+		Buffer copy( other );
+		*this = std::move( copy );
+	}
+	return *this;
+}
+
+Buffer& Buffer::operator=( Buffer&& other ) noexcept {
+	if ( this != &other ) {
+		Free();
+		allocated_len = other.allocated_len;
+		lenw = other.lenw;
+		lenr = other.lenr;
+		data = other.data;
+		dw = other.dw;
+		dr = other.dr;
+		m_is_view = other.m_is_view;
+		m_checksum_version = other.m_checksum_version;
+		other.allocated_len = 0;
+		other.lenw = 0;
+		other.lenr = 0;
+		other.data = nullptr;
+		other.dw = nullptr;
+		other.dr = nullptr;
+	}
+	return *this;
+}
+
+void Buffer::Reserve( const uint32_t size ) {
+	if ( m_is_view ) {
+		THROW( "can't reserve in buffer view" );
+	}
+	if ( size > allocated_len ) {
+		Realloc( size );
+	}
 }
 
 void Buffer::Alloc( uint32_t size ) {
+	if ( m_is_view ) {
+		THROW( "can't write to buffer view" );
+	}
 	const uint32_t new_size = lenw + size;
 	if ( new_size > allocated_len ) {
-		while ( new_size > allocated_len ) {
-			allocated_len += BUFFER_ALLOC_CHUNK;
-		}
-		if ( data ) {
-			//Log( "Reallocating " + to_string( allocated_len ) + " bytes" );
-			data = (data_t*)realloc( data, allocated_len );
-		}
-		else {
-			//Log( "Allocating " + to_string( allocated_len ) + " bytes" );
-			data = (data_t*)malloc( allocated_len );
+		// grow geometrically to keep amortized cost of sequential writes constant
+		uint32_t new_allocated_len = allocated_len
+			? allocated_len
+			: BUFFER_ALLOC_CHUNK;
+		while ( new_size > new_allocated_len ) {
+			new_allocated_len = new_allocated_len < UINT32_MAX / 2
+				? new_allocated_len * 2
+				: UINT32_MAX;
 		}
-		dw = ptr( data, lenw, 0 );
-		dr = ptr( data, lenr, 0 );
+		Realloc( new_allocated_len );
 	}
 	lenw = new_size;
 }
 
+void Buffer::Realloc( const uint32_t new_allocated_len ) {
+	allocated_len = new_allocated_len;
+	if ( data ) {
+		//Log( "Reallocating " + to_string( allocated_len ) + " bytes" );
+		data = (data_t*)realloc( data, allocated_len );
+	}
+	else {
+		//Log( "Allocating " + to_string( allocated_len ) + " bytes" );
+		data = (data_t*)malloc( allocated_len );
+	}
+	dw = ptr( data, lenw, 0 );
+	dr = ptr( data, lenr, 0 );
+}
+
+void Buffer::Free() {
+	if ( data ) {
+		if ( !m_is_view ) {
+			free( data );
+		}
+		data = nullptr;
+	}
+}
+
 // note: mostly THROWs instead of ASSERTs, because we need that validation in release mode too to prevent buffer overflows
 void Buffer::WriteImpl( type_t type, const char* s, const uint32_t sz ) {
 	ASSERT( type > T_NONE && type < T_MAX, "invalid buffer write type " + std::to_string( type ) );
 	//Log( "Writing " + to_string( sz ) + " bytes (type=" + to_string( type ) + ")" );
-	checksum_t c = 0;
-	Alloc( sizeof( type ) + sizeof( sz ) + sz + sizeof( c ) );
+	Alloc( sizeof( type ) + sizeof( sz ) + sz + sizeof( checksum_t ) );
 	memcpy( dw, &type, sizeof( type ) );
 	dw += sizeof( type );
 	memcpy( dw, &sz, sizeof( sz ) );
 	dw += sizeof( sz );
 
-	for ( uint32_t i = 0 ; i < sz ; i++ ) {
-		c ^= ( *( dw++ ) = *( s++ ) );
-	}
+	memcpy( dw, s, sz );
+	const checksum_t c = FieldChecksum( dw, sz );
+	dw += sz;
 
 	//Log( "Writing checksum (" + to_string( c ) + ")" );
 	*( dw++ ) = c;
@@ -87,7 +192,7 @@ void Buffer::WriteImpl( type_t type, const char* s, const uint32_t sz ) {
 	//Log( "Written successfully" );
 }
 
-char* Buffer::ReadImpl( type_t need_type, char* s, uint32_t* sz, const uint32_t need_sz ) {
+const char* Buffer::ReadViewImpl( type_t need_type, uint32_t* sz, const uint32_t need_sz ) {
 	ASSERT( need_type > T_NONE && need_type < T_MAX, "invalid buffer read type " + std::to_string( need_type ) );
 	type_t type = T_NONE;
 	if ( lenw < lenr + sizeof( type ) + sizeof( *sz ) ) {
@@ -103,22 +208,17 @@ char* Buffer::ReadImpl( type_t need_type, char* s, uint32_t* sz, const uint32_t
 	if ( need_sz && ( need_sz != *sz ) ) {
 		THROW( "buffer read size mismatch ( " + std::to_string( need_sz ) + " != " + std::to_string( *sz ) + " )" );
 	}
-	checksum_t need_c = 0;
-	lenr += sizeof( type ) + sizeof( *sz ) + *sz + sizeof( need_c );
+	lenr += sizeof( type ) + sizeof( *sz ) + *sz + sizeof( checksum_t );
 	if ( lenw < lenr ) {
 		THROW( "buffer ends prematurely (while reading data)" );
 	}
 	//Log( "Reading " + std::to_string( *sz ) + " bytes (type=" + std::to_string( type ) + ")" );
 
-	if ( s == nullptr && *sz > 0 ) {
-		s = (char*)malloc( *sz );
-	}
-
-	char* s_ptr = s;
-
-	for ( uint32_t i = 0 ; i < *sz ; i++ ) {
-		need_c ^= ( *( s_ptr++ ) = *( dr++ ) );
-	}
+	const char* s = (const char*)dr;
+	const checksum_t need_c = m_checksum_version == CV_XOR
+		? LegacyFieldChecksum( s, *sz )
+		: FieldChecksum( s, *sz );
+	dr += *sz;
 
 	//Log( "Checking checksum (" + to_string( need_c ) + ")" );
 	checksum_t c = *( dr++ );
@@ -131,6 +231,17 @@ char* Buffer::ReadImpl( type_t need_type, char* s, uint32_t* sz, const uint32_t
 	return s;
 }
 
+char* Buffer::ReadImpl( type_t need_type, char* s, uint32_t* sz, const uint32_t need_sz ) {
+	const char* src = ReadViewImpl( need_type, sz, need_sz );
+	if ( *sz > 0 ) {
+		if ( s == nullptr ) {
+			s = (char*)malloc( *sz );
+		}
+		memcpy( s, src, *sz );
+	}
+	return s;
+}
+
 void Buffer::WriteBool( const bool val ) {
 	const uint8_t bval = val
 		? 1
@@ -167,21 +278,18 @@ const float Buffer::ReadFloat() {
 	return val;
 }
 
-void Buffer::WriteString( const std::string& val ) {
+void Buffer::WriteString( const std::string_view& val ) {
 	WriteImpl( T_STRING, val.data(), val.size() );
 }
 
 const std::string Buffer::ReadString() {
+	return std::string( ReadStringView() );
+}
+
+const std::string_view Buffer::ReadStringView() {
 	uint32_t sz = 0;
-	char* res_data = ReadImpl( T_STRING, nullptr, &sz );
-	if ( sz > 0 ) {
-		std::string result = std::string( res_data, sz );
-		free( res_data );
-		return result;
-	}
-	else {
-		return "";
-	}
+	const char* res_data = ReadViewImpl( T_STRING, &sz );
+	return std::string_view( res_data, sz );
 }
 
 void Buffer::WriteVec2u( const Vec2< uint32_t > val ) {
@@ -243,10 +351,95 @@ const void* Buffer::ReadData( const uint32_t len ) {
 	return val;
 }
 
+const void* Buffer::ReadDataView( const uint32_t len ) {
+	uint32_t sz = 0;
+	const void* val = ReadViewImpl( T_DATA, &sz );
+	ASSERT( sz == len, "buffer data read size mismatch" );
+	return val;
+}
+
+void Buffer::WriteNested( const Serializable& child ) {
+	const auto header_offset = BeginNested();
+	child.Serialize( *this );
+	EndNested( header_offset );
+}
+
+void Buffer::WriteNested( const std::function< void( Buffer& buf ) >& f ) {
+	const auto header_offset = BeginNested();
+	f( *this );
+	EndNested( header_offset );
+}
+
+Buffer Buffer::ReadNested() {
+	// nested data used to be written as strings, accept those too to keep older saves loadable
+	const type_t type = ( lenr < lenw && *dr == T_STRING )
+		? T_STRING
+		: T_NESTED;
+	uint32_t sz = 0;
+	const char* s = ReadViewImpl( type, &sz );
+	Buffer result;
+	result.m_is_view = true;
+	result.data = (data_t*)s;
+	result.dw = result.data + sz;
+	result.dr = result.data;
+	result.allocated_len = sz;
+	result.lenw = sz;
+	result.lenr = 0;
+	result.m_checksum_version = m_checksum_version;
+	return result;
+}
+
+void Buffer::Append( const Buffer& other ) {
+	if ( other.lenw > 0 ) {
+		Alloc( other.lenw );
+		memcpy( dw, other.data, other.lenw );
+		dw += other.lenw;
+	}
+}
+
+const uint32_t Buffer::BeginNested() {
+	const type_t type = T_NESTED;
+	const uint32_t sz = 0; // will be known in EndNested
+	const uint32_t header_offset = lenw;
+	Alloc( sizeof( type ) + sizeof( sz ) );
+	memcpy( dw, &type, sizeof( type ) );
+	dw += sizeof( type );
+	memcpy( dw, &sz, sizeof( sz ) );
+	dw += sizeof( sz );
+	return header_offset;
+}
+
+void Buffer::EndNested( const uint32_t header_offset ) {
+	const uint32_t data_offset = header_offset + sizeof( type_t ) + sizeof( uint32_t );
+	if ( lenw < data_offset ) {
+		THROW( "nested buffer overflow" );
+	}
+	const uint32_t sz = lenw - data_offset;
+	memcpy( data + header_offset + sizeof( type_t ), &sz, sizeof( sz ) );
+	const checksum_t c = FieldChecksum( data + data_offset, sz );
+	Alloc( sizeof( c ) );
+	*( dw++ ) = c;
+	ASSERT( dw - data == lenw, "buffer write bytes count mismatch ( " + std::to_string( dw - data ) + " != " + std::to_string( lenw ) + " )" );
+}
+
 const std::string Buffer::ToString() const {
 	return data
 		? std::string( (const char*)data, lenw )
 		: "";
 }
 
+const std::string_view Buffer::ToStringView() const {
+	return data
+		? std::string_view( (const char*)data, lenw )
+		: std::string_view();
+}
+
+void Buffer::SetChecksumVersion( const checksum_version_t version ) {
+	m_checksum_version = version;
+}
+
+const bool Buffer::IsNextString() const {
+	return lenr < lenw && *dr == T_STRING;
+}
+
 }
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <string_view>
+#include <functional>
+
 #include "common/Common.h"
 
 #include "types/Vec2.h"
@@ -8,18 +11,33 @@
 
 namespace types {
 
+class Serializable;
+
 CLASS( Buffer, common::Class )
 
-	static constexpr uint32_t BUFFER_ALLOC_CHUNK = 1024;
+	static constexpr uint32_t BUFFER_ALLOC_CHUNK = 1024; // minimum allocation, grows geometrically after that
 
 	typedef uint8_t data_t;
 	typedef uint8_t checksum_t;
 
+	// how per-field checksums are calculated
+	enum checksum_version_t : uint8_t {
+		CV_XOR, // xor of all bytes, used by data written before crc32c
+		CV_CRC32C, // low byte of crc32c
+	};
+
 	Buffer();
 	Buffer( const std::string& strval );
+	explicit Buffer( const std::string_view& strval );
 	~Buffer();
 
 	Buffer( const Buffer& other );
+	Buffer( Buffer&& other ) noexcept;
+	Buffer& operator=( const Buffer& other );
+	Buffer& operator=( Buffer&& other ) noexcept;
+
+	// preallocate storage for at least this many bytes in total ( to avoid reallocations if approximate size is known )
+	void Reserve( const uint32_t size );
 
 	data_t* data;
 	data_t* dw;
@@ -34,8 +52,10 @@ CLASS( Buffer, common::Class )
 	const long long int ReadInt();
 	void WriteFloat( const float val );
 	const float ReadFloat();
-	void WriteString( const std::string& val );
+	void WriteString( const std::string_view& val );
 	const std::string ReadString();
+	// returned view points into buffer storage, it's only valid until buffer is written to or destroyed
+	const std::string_view ReadStringView();
 	void WriteVec2u( const Vec2< uint32_t > val );
 	const Vec2< uint32_t > ReadVec2u();
 	void WriteVec2f( const Vec2< float > val );
@@ -46,8 +66,24 @@ CLASS( Buffer, common::Class )
 	void ReadColor( Color& val );
 	void WriteData( const void* data, const uint32_t len );
 	const void* ReadData( const uint32_t len );
+	// same as ReadData but returns pointer into buffer storage instead of malloc'ed copy
+	const void* ReadDataView( const uint32_t len );
+
+	// nested data is written directly into this buffer ( with length prefix ) and read back as bounded view over it, without intermediate copies
+	void WriteNested( const Serializable& child );
+	void WriteNested( const std::function< void( Buffer& buf ) >& f );
+	// returned buffer references storage of this buffer, it's only valid until this buffer is written to or destroyed
+	Buffer ReadNested();
+	// appends all fields of other buffer as they are
+	void Append( const Buffer& other );
 
 	const std::string ToString() const;
+	const std::string_view ToStringView() const;
+
+	// checksums are always written as CV_CRC32C, older version is only accepted on read when explicitly set for legacy data
+	void SetChecksumVersion( const checksum_version_t version );
+	// true if next field is string ( i.e. file header ), doesn't read anything
+	const bool IsNextString() const;
 
 private:
 
@@ -63,13 +99,25 @@ private:
 		T_VEC3,
 		T_COLOR,
 		T_DATA,
+		T_NESTED,
 
 		T_MAX
 	};
 
 	void WriteImpl( const type_t type, const char* s, const uint32_t sz );
 	char* ReadImpl( const type_t need_type, char* s, uint32_t* sz, const uint32_t need_sz = 0 );
+	const char* ReadViewImpl( const type_t need_type, uint32_t* sz, const uint32_t need_sz = 0 );
 	void Alloc( uint32_t size );
+	void Realloc( const uint32_t new_allocated_len );
+	void Free();
+
+	const uint32_t BeginNested();
+	void EndNested( const uint32_t header_offset );
+
+	// view buffers don't own their data and can't be written to
+	bool m_is_view = false;
+
+	checksum_version_t m_checksum_version = CV_CRC32C;
 
 };
 
@@ -62,6 +62,7 @@ const types::Buffer Packet::Serialize() const {
 		}
 		case PT_DOWNLOAD_RESPONSE: {
 			buf.WriteInt( data.num ); // total size of serialized data
+			buf.WriteInt( udata.download.size ); // chunk size
 			break;
 		}
 		case PT_DOWNLOAD_NEXT_CHUNK_REQUEST: {
@@ -72,6 +73,7 @@ const types::Buffer Packet::Serialize() const {
 		case PT_DOWNLOAD_NEXT_CHUNK_RESPONSE: {
 			buf.WriteInt( udata.download.offset );
 			buf.WriteInt( udata.download.size );
+			buf.WriteBool( data.boolean ); // is compressed
 			buf.WriteString( data.str ); // serialized chunk
 			break;
 		}
@@ -152,6 +154,7 @@ void Packet::Deserialize( types::Buffer buf ) {
 		}
 		case PT_DOWNLOAD_RESPONSE: {
 			data.num = buf.ReadInt(); // total size of serialized data
+			udata.download.size = buf.ReadInt(); // chunk size
 			break;
 		}
 		case PT_DOWNLOAD_NEXT_CHUNK_REQUEST: {
@@ -162,6 +165,7 @@ void Packet::Deserialize( types::Buffer buf ) {
 		case PT_DOWNLOAD_NEXT_CHUNK_RESPONSE: {
 			udata.download.offset = buf.ReadInt();
 			udata.download.size = buf.ReadInt();
+			data.boolean = buf.ReadBool(); // is compressed
 			data.str = buf.ReadString(); // serialized chunk
 			break;
 		}
@@ -14,6 +14,11 @@ public:
 
 	virtual const types::Buffer Serialize() const = 0;
 
+	// writes into existing buffer ( used by Buffer::WriteNested ), override to skip temporary buffer
+	virtual void Serialize( types::Buffer& buf ) const {
+		buf.Append( Serialize() );
+	}
+
 	virtual void Deserialize( types::Buffer buffer ) = 0;
 
 	virtual void operator=( const Serializable& other ) {
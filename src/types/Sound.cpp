@@ -1,11 +0,0 @@
-#include "Sound.h"
-
-namespace types {
-
-Sound::~Sound() {
-	if ( m_buffer ) {
-		free( m_buffer );
-	}
-}
-
-}
@@ -2,6 +2,7 @@
 
 #include <string>
 #include <cstdint>
+#include <memory>
 
 #include "common/Common.h"
 
@@ -9,9 +10,9 @@ namespace types {
 
 CLASS( Sound, common::Class )
 
-	~Sound();
-
-	unsigned char* m_buffer = nullptr;
+	// pcm in native format of audio mixer, never modified after loading so it can be shared
+	std::shared_ptr< const unsigned char[] > m_data = nullptr;
+	const unsigned char* m_buffer = nullptr; // m_data.get()
 	size_t m_buffer_size = 0;
 
 	// based on SDL_AudioSpec so some adapting maybe needed for other sound loaders / audio modules
@@ -141,7 +141,11 @@ const Mesh::mesh_type_t Mesh::GetType() const {
 
 const types::Buffer Mesh::Serialize() const {
 	types::Buffer buf;
+	Serialize( buf );
+	return buf;
+}
 
+void Mesh::Serialize( types::Buffer& buf ) const {
 	buf.WriteInt( m_mesh_type );
 
 	buf.WriteInt( m_vertex_count );
@@ -154,8 +158,6 @@ const types::Buffer Mesh::Serialize() const {
 	buf.WriteData( m_index_data, GetIndexDataSize() );
 
 	buf.WriteBool( m_is_final );
-
-	return buf;
 }
 
 void Mesh::Deserialize( types::Buffer buf ) {
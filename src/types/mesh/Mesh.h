@@ -59,6 +59,7 @@ CLASS( Mesh, Serializable )
 	const mesh_type_t GetType() const;
 
 	const types::Buffer Serialize() const override;
+	void Serialize( types::Buffer& buf ) const override;
 	void Deserialize( types::Buffer buf ) override;
 
 protected:
@@ -885,6 +885,7 @@ Texture* Texture::FromColor( const Color& color ) {
 
 void Texture::Update( const updated_area_t updated_area ) {
 	//Log( "Need texture update [ "+ std::to_string( updated_area.left ) + " " + std::to_string( updated_area.top ) + " " + std::to_string( updated_area.right ) + " " + std::to_string( updated_area.bottom ) + " ]" );
+	std::lock_guard< std::mutex > guard( m_updated_areas_mutex );
 	m_updated_areas.push_back( updated_area );
 	m_update_counter++;
 }
@@ -910,6 +911,7 @@ const Texture::updated_areas_t& Texture::GetUpdatedAreas() const {
 }
 
 void Texture::ClearUpdatedAreas() {
+	std::lock_guard< std::mutex > guard( m_updated_areas_mutex );
 	m_updated_areas.clear();
 }
 
@@ -942,7 +944,11 @@ unsigned char* Texture::CopyBitmap( const size_t x1, const size_t y1, const size
 
 const types::Buffer Texture::Serialize() const {
 	types::Buffer buf;
+	Serialize( buf );
+	return buf;
+}
 
+void Texture::Serialize( types::Buffer& buf ) const {
 	buf.WriteString( m_filename );
 	buf.WriteInt( m_width );
 	buf.WriteInt( m_height );
@@ -953,8 +959,6 @@ const types::Buffer Texture::Serialize() const {
 	buf.WriteData( m_bitmap, m_bitmap_size );
 
 	buf.WriteBool( m_is_tiled );
-
-	return buf;
 }
 
 void Texture::Deserialize( types::Buffer buf ) {
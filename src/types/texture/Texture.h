@@ -2,6 +2,7 @@
 
 #include <string>
 #include <vector>
+#include <mutex>
 
 #include "types/Serializable.h"
 
@@ -108,12 +109,15 @@ CLASS( Texture, Serializable )
 	virtual unsigned char* CopyBitmap( const size_t x1, const size_t y1, const size_t x2, const size_t y2 ) const;
 
 	virtual const types::Buffer Serialize() const override;
+	virtual void Serialize( types::Buffer& buf ) const override;
 	virtual void Deserialize( types::Buffer buf ) override;
 
 	const bool HasFlag( const texture_flag_t flag ) const;
 	const texture_flag_t GetFlags() const;
 
 private:
+	// areas can be updated from multiple threads at once ( i.e. parallel tile generation )
+	std::mutex m_updated_areas_mutex;
 	size_t m_update_counter = 0;
 
 	const texture_flag_t m_flags = TF_NONE;
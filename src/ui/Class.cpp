@@ -273,7 +273,7 @@ void Class::WrapSetStatic( gse::Wrappable* wrapobj, const std::string& key, gse:
 	( (Class*)wrapobj )->WrapSet( key, value, GSE_CALL );
 }
 
-void Class::GetReachableObjects( std::unordered_set< Object* >& reachable_objects ) {
+void Class::GetReachableObjects( gc::MarkStack& reachable_objects ) {
 	gse::GCWrappable::GetReachableObjects( reachable_objects );
 
 	GC_DEBUG_BEGIN( "Class" );
@@ -36,7 +36,7 @@ public:
 	virtual void WrapSet( const std::string& key, gse::Value* const value, GSE_CALLABLE );
 	static void WrapSetStatic( gse::Wrappable* wrapobj, const std::string& key, gse::Value* const value, GSE_CALLABLE );
 
-	void GetReachableObjects( std::unordered_set< gc::Object* >& reachable_objects ) override;
+	void GetReachableObjects( gc::MarkStack& reachable_objects ) override;
 
 private:
 	const UI* const m_ui;
@@ -122,7 +122,7 @@ WRAPIMPL_BEGIN( UI )
 						Log( "Creating UI class: " + name );
 						it = m_classes.insert({ name, new ui::Class( gc_space, this, name ) }).first;
 						if ( arguments.size() >= 2 ) {
-							const gse::value::object_properties_t* properties = nullptr;
+							const gse::value::Object::properties_t* properties = nullptr;
 							const std::string* parent_class = nullptr;
 							if ( arguments.size() == 2 ) {
 								if ( arguments.at(1)->type == gse::Value::T_STRING ) {
@@ -175,11 +175,11 @@ WRAPIMPL_BEGIN( UI )
 									on_close->Run( GSE_CALL, {} );
 									Unpersist( on_close );
 								}
-								return VALUE( gse::value::Bool,, true );
+								return VALUE_SHARED( gse::value::Bool,, true );
 							} )
 						},
 					}; } );
-					return VALUE( gse::value::Undefined );
+					return VALUE_SHARED( gse::value::Undefined );
 				} )
 			},
 		};
@@ -240,7 +240,7 @@ void UI::Destroy( GSE_CALLABLE ) {
 	m_root->Destroy( GSE_CALL );
 }
 
-void UI::GetReachableObjects( std::unordered_set< gc::Object* >& reachable_objects ) {
+void UI::GetReachableObjects( gc::MarkStack& reachable_objects ) {
 	gse::GCWrappable::GetReachableObjects( reachable_objects );
 
 	GC_DEBUG_BEGIN( "UI" );
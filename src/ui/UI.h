@@ -72,7 +72,7 @@ CLASS( UI, gse::GCWrappable )
 
 	void Destroy( GSE_CALLABLE );
 
-	void GetReachableObjects( std::unordered_set< gc::Object* >& reachable_objects ) override;
+	void GetReachableObjects( gc::MarkStack& reachable_objects ) override;
 
 	typedef std::function< void( GSE_CALLABLE ) > gse_func_t;
 
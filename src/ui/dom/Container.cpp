@@ -208,7 +208,7 @@ void Container::Destroy( GSE_CALLABLE ) {
 	Area::Destroy( GSE_CALL );
 }
 
-void Container::GetReachableObjects( std::unordered_set< gc::Object* >& reachable_objects ) {
+void Container::GetReachableObjects( gc::MarkStack& reachable_objects ) {
 	Object::GetReachableObjects( reachable_objects );
 
 	GC_DEBUG_BEGIN( "Container" );
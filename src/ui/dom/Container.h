@@ -33,7 +33,7 @@ public:
 
 	void Destroy( GSE_CALLABLE ) override;
 
-	void GetReachableObjects( std::unordered_set< gc::Object* >& reachable_objects ) override;
+	void GetReachableObjects( gc::MarkStack& reachable_objects ) override;
 
 	void WrapSet( const std::string& key, gse::Value* const value, GSE_CALLABLE ) override;
 
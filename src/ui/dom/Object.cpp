@@ -226,7 +226,7 @@ void Object::Refresh() {
 	}
 }
 
-void Object::GetReachableObjects( std::unordered_set< gc::Object* >& reachable_objects ) {
+void Object::GetReachableObjects( gc::MarkStack& reachable_objects ) {
 	gse::GCWrappable::GetReachableObjects( reachable_objects );
 
 	GC_DEBUG_BEGIN( "Object" );
@@ -452,13 +452,13 @@ void Object::WrapEvent( GSE_CALLABLE, const input::Event& e, gse::value::object_
 			);
 			gse::value::object_properties_t modifier_props = {};
 			if ( e.data.key.modifiers & input::KM_SHIFT ) {
-				modifier_props.insert({"shift", VALUE( gse::value::Bool,, true )});
+				modifier_props.insert({"shift", VALUE_SHARED( gse::value::Bool,, true )});
 			}
 			if ( e.data.key.modifiers & input::KM_CTRL ) {
-				modifier_props.insert({"ctrl", VALUE( gse::value::Bool,, true )});
+				modifier_props.insert({"ctrl", VALUE_SHARED( gse::value::Bool,, true )});
 			}
 			if ( e.data.key.modifiers & input::KM_ALT ) {
-				modifier_props.insert({"alt", VALUE( gse::value::Bool,, true )});
+				modifier_props.insert({"alt", VALUE_SHARED( gse::value::Bool,, true )});
 			}
 			obj.insert({"modifiers", VALUE( gse::value::Object,, ctx, {}, ep, modifier_props ) } );
 			break;
@@ -27,7 +27,7 @@ Window::Window( DOM_ARGS )
 		g->SetRight( 0 );
 		// block clickthroughs
 		m_blocker->On( GSE_CALL, "*", NATIVE_CALL( this ) {
-			return VALUE( gse::value::Bool,, true );
+			return VALUE_SHARED( gse::value::Bool,, true );
 		} ) );
 	}
 	{
@@ -356,7 +356,7 @@ const std::string FS::ReadTextFile( const std::string& path, const char path_sep
 	return data.str();
 }
 
-const void FS::WriteFile( const std::string& path, const std::string& data, const char path_separator ) {
+const void FS::WriteFile( const std::string& path, const std::string_view& data, const char path_separator ) {
 	//Log( "Writing file: " + path );
 	std::ofstream out( NormalizePath( path, path_separator ), std::ios_base::binary );
 	out << data;
@@ -2,6 +2,7 @@
 
 #include <vector>
 #include <string>
+#include <string_view>
 
 #include "Util.h"
 
@@ -54,7 +55,7 @@ CLASS( FS, Util )
 
 	static void ReadFile( std::vector< unsigned char >& buffer, const std::string& path, const char path_separator = PATH_SEPARATOR );
 	static const std::string ReadTextFile( const std::string& path, const char path_separator = PATH_SEPARATOR );
-	static const void WriteFile( const std::string& path, const std::string& data, const char path_separator = PATH_SEPARATOR );
+	static const void WriteFile( const std::string& path, const std::string_view& data, const char path_separator = PATH_SEPARATOR );
 
 	static const std::vector< unsigned char >& GetEmbeddedFile( const std::string& key );
 
@@ -6,7 +6,9 @@ namespace util {
 
 class LogHelper {
 public:
+	// doesn't flush, call Flush() when needed
 	static void Print( const std::string& text );
+	// flushes every line
 	static void Println( const std::string& text );
 	static void Flush();
 };
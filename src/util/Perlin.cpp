@@ -291,7 +291,7 @@ Perlin::Perlin( unsigned int seed ) {
 	p.insert( p.end(), p.begin(), p.end() );
 }
 
-float Perlin::Noise( float x, float y, float z ) {
+float Perlin::Noise( float x, float y, float z ) const {
 
 	// Find the unit cube that contains the point
 	int X = (int)floor( x ) & 255;
@@ -327,7 +327,7 @@ float Perlin::Noise( float x, float y, float z ) {
 	return res;
 }
 
-float Perlin::Noise( float x, float y, float z, size_t passes ) {
+float Perlin::Noise( float x, float y, float z, size_t passes ) const {
 	float res = 0;
 	float scale = 1.0f;
 	for ( size_t i = 0 ; i < passes ; i++ ) {
@@ -341,15 +341,15 @@ float Perlin::Noise( float x, float y, float z, size_t passes ) {
 	return res;
 }
 
-float Perlin::Fade( float t ) {
+float Perlin::Fade( float t ) const {
 	return t * t * t * ( t * ( t * 6 - 15 ) + 10 );
 }
 
-float Perlin::Lerp( float t, float a, float b ) {
+float Perlin::Lerp( float t, float a, float b ) const {
 	return a + t * ( b - a );
 }
 
-float Perlin::Grad( int hash, float x, float y, float z ) {
+float Perlin::Grad( int hash, float x, float y, float z ) const {
 	int h = hash & 15;
 	// Convert lower 4 bits of hash into 12 Gradient directions
 	float u = h < 8
@@ -14,19 +14,19 @@ CLASS( Perlin, Util )
 	Perlin( unsigned int seed );
 
 	// Get a noise value, for 2D images z can have any value
-	float Noise( float x, float y, float z );
+	float Noise( float x, float y, float z ) const;
 
 	// multi-level noise
-	float Noise( float x, float y, float z, size_t passes );
+	float Noise( float x, float y, float z, size_t passes ) const;
 
 private:
 
 	// The permutation vector
 	std::vector< int > p;
 
-	float Fade( float t );
-	float Lerp( float t, float a, float b );
-	float Grad( int hash, float x, float y, float z );
+	float Fade( float t ) const;
+	float Lerp( float t, float a, float b ) const;
+	float Grad( int hash, float x, float y, float z ) const;
 };
 
 }
@@ -1,10 +1,143 @@
 #include "CRC32.h"
 
+#include <array>
+#include <cstring>
+
+#if defined( __GNUC__ ) && defined( __x86_64__ )
+#define CRC32_HW_X86 1
+#include <nmmintrin.h>
+#elif defined( __GNUC__ ) && defined( __aarch64__ ) && defined( __ARM_FEATURE_CRC32 )
+#define CRC32_HW_ARM 1
+#include <arm_acle.h>
+#endif
+
 namespace util {
 namespace crc32 {
 
+static constexpr crc_t POLYNOMIAL = 0x82f63b78; // reversed Castagnoli
+
+typedef std::array< std::array< crc_t, 256 >, 8 > tables_t;
+
+static constexpr tables_t GenerateTables() {
+	tables_t tables = {};
+	for ( crc_t i = 0 ; i < 256 ; i++ ) {
+		crc_t c = i;
+		for ( uint8_t bit = 0 ; bit < 8 ; bit++ ) {
+			c = ( c & 1 )
+				? ( c >> 1 ) ^ POLYNOMIAL
+				: c >> 1;
+		}
+		tables[ 0 ][ i ] = c;
+	}
+	for ( crc_t i = 0 ; i < 256 ; i++ ) {
+		for ( uint8_t t = 1 ; t < 8 ; t++ ) {
+			const auto prev = tables[ t - 1 ][ i ];
+			tables[ t ][ i ] = ( prev >> 8 ) ^ tables[ 0 ][ prev & 0xff ];
+		}
+	}
+	return tables;
+}
+
+static constexpr tables_t s_tables = GenerateTables();
+
+static crc_t CalculateSliceBy8( const uint8_t* p, size_t len, crc_t c ) {
+#if defined( __BYTE_ORDER__ ) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+	while ( len >= 8 ) {
+		uint32_t lo, hi;
+		memcpy( &lo, p, sizeof( lo ) );
+		memcpy( &hi, p + 4, sizeof( hi ) );
+		lo ^= c;
+		c =
+			s_tables[ 7 ][ lo & 0xff ] ^
+				s_tables[ 6 ][ ( lo >> 8 ) & 0xff ] ^
+				s_tables[ 5 ][ ( lo >> 16 ) & 0xff ] ^
+				s_tables[ 4 ][ lo >> 24 ] ^
+				s_tables[ 3 ][ hi & 0xff ] ^
+				s_tables[ 2 ][ ( hi >> 8 ) & 0xff ] ^
+				s_tables[ 1 ][ ( hi >> 16 ) & 0xff ] ^
+				s_tables[ 0 ][ hi >> 24 ];
+		p += 8;
+		len -= 8;
+	}
+#endif
+	while ( len-- ) {
+		c = ( c >> 8 ) ^ s_tables[ 0 ][ ( c ^ *( p++ ) ) & 0xff ];
+	}
+	return c;
+}
+
+#if defined( CRC32_HW_X86 )
+
+__attribute__(( target( "sse4.2" ) ))
+static crc_t CalculateHardware( const uint8_t* p, size_t len, crc_t c ) {
+	uint64_t c64 = c;
+	while ( len >= 8 ) {
+		uint64_t v;
+		memcpy( &v, p, sizeof( v ) );
+		c64 = _mm_crc32_u64( c64, v );
+		p += 8;
+		len -= 8;
+	}
+	c = (crc_t)c64;
+	while ( len-- ) {
+		c = _mm_crc32_u8( c, *( p++ ) );
+	}
+	return c;
+}
+
+static const bool DetectHardwareSupport() {
+	__builtin_cpu_init(); // may be called before libgcc initialized cpu info ( i.e. from static initializers )
+	return __builtin_cpu_supports( "sse4.2" );
+}
+
+#elif defined( CRC32_HW_ARM )
+
+static crc_t CalculateHardware( const uint8_t* p, size_t len, crc_t c ) {
+	while ( len >= 8 ) {
+		uint64_t v;
+		memcpy( &v, p, sizeof( v ) );
+		c = __crc32cd( c, v );
+		p += 8;
+		len -= 8;
+	}
+	while ( len-- ) {
+		c = __crc32cb( c, *( p++ ) );
+	}
+	return c;
+}
+
+static const bool DetectHardwareSupport() {
+	return true; // compiler was told cpu has crc extension
+}
+
+#else
+
+static const bool DetectHardwareSupport() {
+	return false;
+}
+
+#endif
+
+const crc_t CRC32::Calculate( const void* data, const size_t len, const crc_t crc ) {
+#if defined( CRC32_HW_X86 ) || defined( CRC32_HW_ARM )
+	static const bool s_has_hardware_support = DetectHardwareSupport();
+	if ( s_has_hardware_support ) {
+		return ~CalculateHardware( (const uint8_t*)data, len, ~crc );
+	}
+#endif
+	return ~CalculateSliceBy8( (const uint8_t*)data, len, ~crc );
+}
+
 const crc_t CRC32::CalculateFromBuffer( const types::Buffer& buf ) {
-	return 0;
+	return Calculate( buf.data, buf.lenw );
+}
+
+const crc_t CRC32::CalculatePortable( const void* data, const size_t len, const crc_t crc ) {
+	return ~CalculateSliceBy8( (const uint8_t*)data, len, ~crc );
+}
+
+const bool CRC32::HasHardwareSupport() {
+	return DetectHardwareSupport();
 }
 
 }
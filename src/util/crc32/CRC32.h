@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+
 #include "util/Util.h"
 
 #include "types/Buffer.h"
@@ -8,10 +10,22 @@
 namespace util {
 namespace crc32 {
 
+/**
+ * CRC-32C ( Castagnoli )
+ *   uses hardware crc32 instructions when cpu supports them ( SSE4.2 on x86-64, CRC extension on ARMv8 )
+ *   falls back to portable slice-by-8 otherwise, both give identical results so hosts with different cpus can compare checksums
+ */
 CLASS( CRC32, Util )
 
+	// pass result of previous call as crc to continue checksum over multiple chunks
+	static const crc_t Calculate( const void* data, const size_t len, const crc_t crc = 0 );
 	static const crc_t CalculateFromBuffer( const types::Buffer& buf );
 
+	// same as Calculate but never uses hardware instructions ( for testing and benchmarking )
+	static const crc_t CalculatePortable( const void* data, const size_t len, const crc_t crc = 0 );
+
+	static const bool HasHardwareSupport();
+
 };
 
 }
@@ -0,0 +1,151 @@
+#include "LZ.h"
+
+#include <vector>
+#include <cstring>
+#include <cstdint>
+
+namespace util {
+namespace lz {
+
+static constexpr size_t MIN_MATCH = 4;
+static constexpr size_t MAX_OFFSET = 65535;
+static constexpr uint8_t HASH_BITS = 12;
+
+static inline const uint32_t Read32( const uint8_t* p ) {
+	uint32_t v;
+	memcpy( &v, p, sizeof( v ) );
+	return v;
+}
+
+static inline const uint32_t Hash( const uint32_t v ) {
+	return ( v * 2654435761u ) >> ( 32 - HASH_BITS );
+}
+
+// lengths that don't fit into 4 bits of token continue in following bytes
+static inline void WriteLength( std::string& out, size_t len ) {
+	while ( len >= 255 ) {
+		out.push_back( (char)255 );
+		len -= 255;
+	}
+	out.push_back( (char)len );
+}
+
+static inline const bool ReadLength( const uint8_t*& ptr, const uint8_t* const end, size_t& len ) {
+	uint8_t b;
+	do {
+		if ( ptr >= end ) {
+			return false;
+		}
+		b = *( ptr++ );
+		len += b;
+	}
+	while ( b == 255 );
+	return true;
+}
+
+// token is literals count ( high 4 bits ) and match length - MIN_MATCH ( low 4 bits ), then literals, then 2-byte offset
+// last sequence has literals only
+static void WriteSequence( std::string& out, const uint8_t* literals, const size_t literals_len, const size_t offset, const size_t match_len ) {
+	const size_t ml = match_len
+		? match_len - MIN_MATCH
+		: 0;
+	out.push_back(
+		(char)(
+			( ( literals_len < 15
+				? literals_len
+				: 15
+			) << 4 ) | ( ml < 15
+				? ml
+				: 15
+			)
+		)
+	);
+	if ( literals_len >= 15 ) {
+		WriteLength( out, literals_len - 15 );
+	}
+	out.append( (const char*)literals, literals_len );
+	if ( match_len ) {
+		out.push_back( (char)( offset & 0xff ) );
+		out.push_back( (char)( offset >> 8 ) );
+		if ( ml >= 15 ) {
+			WriteLength( out, ml - 15 );
+		}
+	}
+}
+
+void LZ::Compress( const char* data, const size_t len, std::string& out ) {
+	const auto* const in = (const uint8_t*)data;
+	std::vector< int32_t > table( 1 << HASH_BITS, -1 );
+	out.reserve( out.size() + len / 2 + 16 );
+
+	size_t pos = 0;
+	size_t anchor = 0;
+	while ( pos + MIN_MATCH <= len ) {
+		const uint32_t seq = Read32( in + pos );
+		auto& slot = table[ Hash( seq ) ];
+		const int32_t candidate = slot;
+		slot = (int32_t)pos;
+		if ( candidate >= 0 && pos - candidate <= MAX_OFFSET && Read32( in + candidate ) == seq ) {
+			size_t match_len = MIN_MATCH;
+			while ( pos + match_len < len && in[ candidate + match_len ] == in[ pos + match_len ] ) {
+				match_len++;
+			}
+			WriteSequence( out, in + anchor, pos - anchor, pos - candidate, match_len );
+			pos += match_len;
+			anchor = pos;
+		}
+		else {
+			pos++;
+		}
+	}
+	WriteSequence( out, in + anchor, len - anchor, 0, 0 );
+}
+
+const bool LZ::Decompress( const char* data, const size_t len, std::string& out, const size_t max_len ) {
+	const auto* ptr = (const uint8_t*)data;
+	const auto* const end = ptr + len;
+	const size_t start = out.size();
+	out.reserve( start + max_len );
+	while ( ptr < end ) {
+		const uint8_t token = *( ptr++ );
+		size_t literals_len = token >> 4;
+		if ( literals_len == 15 && !ReadLength( ptr, end, literals_len ) ) {
+			return false;
+		}
+		if ( literals_len > (size_t)( end - ptr ) || out.size() - start + literals_len > max_len ) {
+			return false;
+		}
+		out.append( (const char*)ptr, literals_len );
+		ptr += literals_len;
+		if ( ptr == end ) {
+			break; // last sequence
+		}
+		if ( end - ptr < 2 ) {
+			return false;
+		}
+		const size_t offset = ptr[ 0 ] | ( ptr[ 1 ] << 8 );
+		ptr += 2;
+		size_t match_len = token & 0x0f;
+		if ( match_len == 15 && !ReadLength( ptr, end, match_len ) ) {
+			return false;
+		}
+		match_len += MIN_MATCH;
+		if ( !offset || offset > out.size() - start || out.size() - start + match_len > max_len ) {
+			return false;
+		}
+		const size_t from = out.size() - offset;
+		if ( offset >= match_len ) {
+			out.append( out, from, match_len );
+		}
+		else {
+			// overlaps with itself ( repeating pattern ), so byte by byte
+			for ( size_t i = 0 ; i < match_len ; i++ ) {
+				out.push_back( out[ from + i ] );
+			}
+		}
+	}
+	return true;
+}
+
+}
+}
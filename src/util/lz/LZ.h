@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "util/Util.h"
+
+namespace util {
+namespace lz {
+
+/**
+ * small LZ77 block compressor ( similar to LZ4 block format, not compatible with it )
+ *   fast on both sides and good enough for repetitive data like serialized tiles
+ *   every block is independent so data can be compressed in chunks and decompressed as chunks arrive
+ */
+CLASS( LZ, Util )
+
+	// appends compressed data to out
+	static void Compress( const char* data, const size_t len, std::string& out );
+
+	// appends decompressed data to out, returns false if data is malformed or decompresses to more than max_len bytes
+	static const bool Decompress( const char* data, const size_t len, std::string& out, const size_t max_len );
+
+};
+
+}
+}
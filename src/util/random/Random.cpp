@@ -17,26 +17,41 @@ Random::Random( const value_t seed ) {
 	);
 }
 
+Random::Random( const state_t& state )
+	: m_state( state ) {
+	//
+}
+
 #define rot32( x, k ) (((x)<<(k))|((x)>>(32-(k))))
 
-const value_t Random::Generate() {
-	value_t e = m_state.a - rot32( m_state.b, 27 );
-	m_state.a = m_state.b ^ rot32( m_state.c, 17 );
-	m_state.b = m_state.c + m_state.d;
-	m_state.c = m_state.d + e;
-	m_state.d = e + m_state.a;
-	return m_state.d;
+const value_t Random::Generate( state_t& state ) {
+	value_t e = state.a - rot32( state.b, 27 );
+	state.a = state.b ^ rot32( state.c, 17 );
+	state.b = state.c + state.d;
+	state.c = state.d + e;
+	state.d = e + state.a;
+	return state.d;
 }
 
 #undef rot32
 
+const value_t Random::Generate() {
+	return Generate( m_state );
+}
+
 void Random::SetSeed( const value_t seed ) {
 	//Log( "Setting seed " + std::to_string( seed ) );
-	m_state.a = 0xf1ea5eed, m_state.b = m_state.c = m_state.d = seed;
+	m_state = GetSeedState( seed );
+	Log( "State set to " + GetStateString() );
+}
+
+const state_t Random::GetSeedState( const value_t seed ) {
+	state_t state = {};
+	state.a = 0xf1ea5eed, state.b = state.c = state.d = seed;
 	for ( value_t i = 0 ; i < 20 ; ++i ) {
-		(void)Generate();
+		(void)Generate( state );
 	}
-	Log( "State set to " + GetStateString() );
+	return state;
 }
 
 const value_t Random::NewSeed() {
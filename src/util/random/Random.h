@@ -19,9 +19,13 @@ namespace random {
 CLASS( Random, Util )
 
 	Random( const value_t seed = 0 );
+	// continues existing stream, doesn't log ( cheap enough to create per tile )
+	Random( const state_t& state );
 
 	void SetSeed( const value_t seed );
 	static const value_t NewSeed();
+	// state that SetSeed would produce, without logging
+	static const state_t GetSeedState( const value_t seed );
 
 	static constexpr char s_state_divisor = ':';
 
@@ -46,6 +50,7 @@ private:
 	state_t m_state = {};
 
 	const value_t Generate();
+	static const value_t Generate( state_t& state );
 };
 
 }